@@ -12,6 +12,8 @@
 
 #include "simplechess_types.h"
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -125,6 +127,131 @@ game_t* simple_chess_make_move(const game_t* game, piece_move_t move);
  */
 game_t* simple_chess_make_move_with_draw_offer(const game_t* game, piece_move_t move, bool offer_draw);
 
+/**
+ * \brief Factory function to create a new game from a FEN position,
+ * reporting why it failed.
+ *
+ * \param fen The representation of the initial position in
+ *            Forsyth-Edwards Notation.
+ * \param draw_enforcement Controls whether mandatory FIDE draw conditions
+ *        are automatically enforced or only claimable.
+ * \param game Receives the new game object on success. Left untouched
+ *        otherwise.
+ *
+ * \return ErrorCodeNone on success, or the reason why the game could not
+ *         be created: ErrorCodeInvalidArgument, ErrorCodeInvalidFen,
+ *         ErrorCodeInvalidPosition or ErrorCodeOutOfMemory.
+ *
+ * \note The caller is responsible for freeing the returned game object
+ *       using destroy_game().
+ */
+error_code_t simple_chess_try_create_game_from_fen(const char* fen, draw_enforcement_t draw_enforcement, game_t** game);
+
+/**
+ * \brief Make a move and optionally offer a draw, reporting why it failed.
+ *
+ * \param game Current game state.
+ * \param move The move to make.
+ * \param offer_draw True to offer a draw with this move, false otherwise.
+ * \param result Receives the new game state on success. Left untouched
+ *        otherwise.
+ *
+ * \return ErrorCodeNone on success, or the reason why the move could not
+ *         be made: ErrorCodeInvalidArgument, ErrorCodeGameFinished,
+ *         ErrorCodeIllegalMove (including moves with squares outside the
+ *         board) or ErrorCodeOutOfMemory.
+ *
+ * \note The caller is responsible for freeing the returned game object
+ *       using destroy_game().
+ */
+error_code_t simple_chess_try_make_move(const game_t* game, piece_move_t move, bool offer_draw, game_t** result);
+
+/**
+ * \brief Make a move for the player whose turn it is to play, updating
+ * the game in place.
+ *
+ * Unlike simple_chess_make_move(), the game is not rebuilt: the new
+ * history entry is appended (growing the history array geometrically when
+ * it is full) and only the current stage, the available moves and the
+ * state of the game are rewritten, directly from the internal
+ * representation of the position.
+ *
+ * The first call on a game records the positions of its history which can
+ * still be repeated, which parses their FEN strings. Afterwards, no memory
+ * is allocated unless the arrays of the game have to grow, and only the
+ * positions reached since the last capture or pawn advance are looked at
+ * to apply the repetition rules, so the cost of a move does not depend on
+ * the length of the game.
+ *
+ * \param game Current game state, created by this library. Must not be NULL.
+ * \param move The move to make. Must be a legal move in the current position.
+ *
+ * \return True if the move was made, or false (leaving the game unchanged)
+ *         in the following circumstances:
+ *         - The game has already concluded (state is not GameStatePlaying)
+ *         - The move is not valid for the current player
+ *         - The history is full (65535 moves)
+ *         - Memory allocation failure
+ *
+ * \note The history and available_moves pointers of the game may change.
+ */
+bool simple_chess_apply_move_inplace(game_t* game, piece_move_t move);
+
+/**
+ * \brief Make a move and optionally offer a draw, updating the game in
+ * place.
+ *
+ * \see simple_chess_apply_move_inplace()
+ */
+bool simple_chess_apply_move_inplace_with_draw_offer(game_t* game, piece_move_t move, bool offer_draw);
+
+/**
+ * \brief Make a sequence of moves in a single call.
+ *
+ * All the moves are applied internally and the resulting game is only
+ * built once at the end, which is much faster than calling
+ * simple_chess_make_move() for every move (e.g. when loading a saved
+ * game). The resulting game is the same as if the moves had been made one
+ * by one, without draw offers.
+ *
+ * \param game Current game state. Must not be NULL.
+ * \param moves The moves to make, in order. May be NULL if n is 0.
+ * \param n The number of moves.
+ * \param failed_index Optional. On failure, receives the index of the
+ *        first move which could not be made, or n if the failure is not
+ *        caused by any move.
+ *
+ * \return Pointer to new game state after all the moves, or NULL in the
+ *         following circumstances:
+ *         - The game concludes before all the moves have been made
+ *         - Any of the moves is not valid in the position it is made in
+ *         - Memory allocation failure
+ *
+ * \note The caller is responsible for freeing the returned game object
+ *       using destroy_game().
+ */
+game_t* simple_chess_apply_moves(const game_t* game, const piece_move_t* moves, size_t n, size_t* failed_index);
+
+/**
+ * \brief Make a sequence of moves in UCI notation in a single call.
+ *
+ * Same as simple_chess_apply_moves(), but the moves are given as a
+ * whitespace-separated list in UCI notation (e.g. "e2e4 e7e5 g1f3").
+ *
+ * \param game Current game state. Must not be NULL.
+ * \param uci_moves The moves to make. Must not be NULL.
+ * \param failed_index Optional. On failure, receives the index of the
+ *        first move which could not be parsed or made, or the number of
+ *        moves if the failure is not caused by any move.
+ *
+ * \return Pointer to new game state after all the moves, or NULL on
+ *         failure (see simple_chess_apply_moves()).
+ *
+ * \note The caller is responsible for freeing the returned game object
+ *       using destroy_game().
+ */
+game_t* simple_chess_apply_uci_moves(const game_t* game, const char* uci_moves, size_t* failed_index);
+
 /**
  * \brief Claim a draw if one is available.
  *
@@ -162,6 +289,76 @@ game_t* simple_chess_claim_draw(const game_t* game);
  */
 game_t* simple_chess_resign(const game_t* game, color_t resigner);
 
+/**
+ * \brief Pack a game stage in 32 bytes.
+ *
+ * The position is read from the board, active color, castling rights,
+ * en passant target and move counters of the stage (its FEN string is
+ * ignored).
+ *
+ * \param stage The stage to pack. Must not be NULL.
+ * \param packed Receives the packed stage. Must not be NULL.
+ *
+ * \return True on success, false if any argument is NULL, the stage
+ *         is malformed or it has more than 32 pieces.
+ */
+bool simple_chess_pack_position(const game_stage_t* stage, packed_position_t* packed);
+
+/**
+ * \brief Unpack a game stage packed by simple_chess_pack_position().
+ *
+ * \param packed The packed stage. Must not be NULL.
+ * \param stage Receives the unpacked stage, including its FEN string and
+ *        check status. Must not be NULL.
+ *
+ * \return True on success, false if any argument is NULL, the packed
+ *         bytes are malformed or they do not describe a valid position
+ *         (see simple_chess_create_game_from_fen_ex()).
+ */
+bool simple_chess_unpack_position(const packed_position_t* packed, game_stage_t* stage);
+
+/**
+ * \brief Factory function to create a new game from a packed position.
+ *
+ * The position is validated in the same way as by
+ * simple_chess_create_game_from_fen_ex().
+ *
+ * \param packed The packed position. Must not be NULL.
+ * \param draw_enforcement Controls whether mandatory FIDE draw conditions
+ *        are automatically enforced or only claimable.
+ *
+ * \return Pointer to new game object, or NULL if the packed position is
+ *         malformed or invalid, or memory allocation fails.
+ *
+ * \note The caller is responsible for freeing the returned game object
+ *       using destroy_game().
+ */
+game_t* simple_chess_create_game_from_packed_position(const packed_position_t* packed, draw_enforcement_t draw_enforcement);
+
+/**
+ * \brief Get the legal moves and check status of a position without
+ * creating a game.
+ *
+ * The FEN string is validated in the same way as by
+ * simple_chess_create_game_from_fen(), but no game is built, so this is
+ * much cheaper when only the moves of a position are needed. A position
+ * is checkmate if its check status is CheckTypeCheckMate, and stalemate if
+ * it has no legal moves and its check status is CheckTypeNone.
+ *
+ * \param fen The position in Forsyth-Edwards Notation. Must not be NULL.
+ * \param moves Output array for the legal moves. May be NULL if
+ *        \p capacity is 0.
+ * \param capacity Number of moves which fit in \p moves. Only the first
+ *        \p capacity moves are written.
+ * \param check_status Optional output for the check status of the active
+ *        color.
+ *
+ * \return The total number of legal moves (which may exceed \p capacity),
+ *         or -1 if the FEN string is NULL, invalid or describes an invalid
+ *         position.
+ */
+int simple_chess_position_moves(const char* fen, piece_move_t* moves, uint16_t capacity, check_type_t* check_status);
+
 /**
  * \brief Convert a board index to a square structure.
  *
@@ -202,10 +399,313 @@ uint8_t simple_chess_index_from_square(square_t square);
  * \note After calling this function, the game pointer becomes invalid
  *       and must not be used.
  * \note This function must be called for every game object created by
- *       the library to avoid memory leaks.
+ *       the library to avoid memory leaks, except for games allocated from
+ *       an arena, for which it does nothing.
  */
 void destroy_game(game_t* game);
 
+/**
+ * \brief Opaque arena which games can be allocated from.
+ *
+ * Games allocated from an arena (with the simple_chess_arena_* functions)
+ * are placed in large blocks owned by the arena, each game followed by its
+ * history and available moves, instead of in three separate heap
+ * allocations. They are not released one by one: all of them are released
+ * at once when the arena is reset or destroyed, and the memory of its
+ * blocks is reused after a reset.
+ *
+ * Games allocated from an arena can be used with every other function of
+ * this library. The games returned by those functions are allocated on
+ * their own, except for simple_chess_apply_move_inplace(), which grows the
+ * arrays of the game from its arena.
+ *
+ * An arena must not be used from several threads at the same time.
+ */
+typedef struct sc_arena sc_arena;
+
+/**
+ * \brief Create an empty arena.
+ *
+ * \param block_size Size in bytes of the blocks the arena allocates, or 0
+ *        for a default size. Larger games get a block of their own.
+ *
+ * \return Pointer to the new arena, or NULL on memory allocation failure.
+ *
+ * \note The caller is responsible for freeing the arena using
+ *       simple_chess_arena_destroy().
+ */
+sc_arena* simple_chess_arena_create(size_t block_size);
+
+/**
+ * \brief Release all the games allocated from an arena, keeping its
+ * memory for later allocations.
+ *
+ * \param arena The arena to reset. Can be NULL (no operation performed).
+ *
+ * \note All the games allocated from the arena become invalid.
+ */
+void simple_chess_arena_reset(sc_arena* arena);
+
+/**
+ * \brief Number of bytes allocated from an arena since it was created or
+ * last reset.
+ *
+ * \param arena The arena. Must not be NULL.
+ */
+size_t simple_chess_arena_bytes_used(const sc_arena* arena);
+
+/**
+ * \brief Free an arena and all the games allocated from it.
+ *
+ * \param arena The arena to destroy. Can be NULL (no operation performed).
+ */
+void simple_chess_arena_destroy(sc_arena* arena);
+
+/**
+ * \brief Create a new game from the standard starting position in an
+ * arena.
+ *
+ * \return Pointer to new game object, or NULL if \p arena is NULL or
+ *         memory allocation fails.
+ *
+ * \see simple_chess_create_new_game_ex()
+ */
+game_t* simple_chess_arena_create_new_game(sc_arena* arena, draw_enforcement_t draw_enforcement);
+
+/**
+ * \brief Create a new game from a FEN string in an arena.
+ *
+ * \return Pointer to new game object, or NULL if \p arena or \p fen is
+ *         NULL, the FEN string is invalid, or memory allocation fails.
+ *
+ * \see simple_chess_create_game_from_fen_ex()
+ */
+game_t* simple_chess_arena_create_game_from_fen(sc_arena* arena, const char* fen, draw_enforcement_t draw_enforcement);
+
+/**
+ * \brief Copy a game into an arena.
+ *
+ * \return Pointer to the copy, or NULL if \p arena or \p game is NULL or
+ *         memory allocation fails.
+ */
+game_t* simple_chess_arena_copy_game(sc_arena* arena, const game_t* game);
+
+/**
+ * \brief Make a move and optionally offer a draw, allocating the resulting
+ * game in an arena.
+ *
+ * \see simple_chess_make_move_with_draw_offer()
+ */
+game_t* simple_chess_arena_make_move(sc_arena* arena, const game_t* game, piece_move_t move, bool offer_draw);
+
+/**
+ * \brief Make a sequence of moves, allocating the resulting game in an
+ * arena.
+ *
+ * \see simple_chess_apply_moves()
+ */
+game_t* simple_chess_arena_apply_moves(sc_arena* arena, const game_t* game, const piece_move_t* moves, size_t n, size_t* failed_index);
+
+/**
+ * \brief Make a sequence of moves in UCI notation, allocating the
+ * resulting game in an arena.
+ *
+ * \see simple_chess_apply_uci_moves()
+ */
+game_t* simple_chess_arena_apply_uci_moves(sc_arena* arena, const game_t* game, const char* uci_moves, size_t* failed_index);
+
+/**
+ * \brief Opaque handle to a live game.
+ *
+ * Unlike game_t, which is a full snapshot rebuilt on every call, a handle
+ * keeps the internal state of the game alive between calls and is updated
+ * in place. Its state is read through the simple_chess_handle_* accessor
+ * functions, and a game_t snapshot can be taken at any point with
+ * simple_chess_handle_snapshot().
+ *
+ * A handle must not be used from several threads at the same time.
+ */
+typedef struct sc_game_handle sc_game_handle;
+
+/**
+ * \brief Create a handle to a new game from the standard starting position.
+ *
+ * \param draw_enforcement Controls whether mandatory FIDE draw conditions
+ *        are automatically enforced or only claimable.
+ *
+ * \return The new handle, or NULL on memory allocation failure.
+ *
+ * \note The caller is responsible for freeing the returned handle using
+ *       simple_chess_handle_destroy().
+ */
+sc_game_handle* simple_chess_handle_create_new_game(draw_enforcement_t draw_enforcement);
+
+/**
+ * \brief Create a handle to a new game from a FEN position.
+ *
+ * \param fen The initial position in Forsyth-Edwards Notation. Must be a
+ *        valid FEN string.
+ * \param draw_enforcement Controls whether mandatory FIDE draw conditions
+ *        are automatically enforced or only claimable.
+ *
+ * \return The new handle, or NULL if the FEN string is invalid or memory
+ *         allocation fails.
+ *
+ * \note The caller is responsible for freeing the returned handle using
+ *       simple_chess_handle_destroy().
+ */
+sc_game_handle* simple_chess_handle_create_from_fen(const char* fen, draw_enforcement_t draw_enforcement);
+
+/**
+ * \brief Create a handle to the game described by a game_t snapshot.
+ *
+ * This is the only handle function which has to rebuild the state of the
+ * game from the snapshot, so it is meant for migrating existing games.
+ *
+ * \param game The game. Must not be NULL.
+ *
+ * \return The new handle, or NULL if the game is invalid or memory
+ *         allocation fails.
+ *
+ * \note The caller is responsible for freeing the returned handle using
+ *       simple_chess_handle_destroy().
+ */
+sc_game_handle* simple_chess_handle_create_from_game(const game_t* game);
+
+/**
+ * \brief Make a move for the player whose turn it is to play, updating
+ * the handle in place.
+ *
+ * \param handle The game. Must not be NULL.
+ * \param move The move to make. Must be a legal move in the current position.
+ * \param offer_draw True to offer a draw with this move, false otherwise.
+ *
+ * \return True if the move was made, false if the handle is NULL, the
+ *         game has already concluded or the move is not valid. The game
+ *         is left unchanged on failure.
+ */
+bool simple_chess_handle_make_move(sc_game_handle* handle, piece_move_t move, bool offer_draw);
+
+/**
+ * \brief Claim a draw if one is available, updating the handle in place.
+ *
+ * \return True if the draw was claimed, false if the handle is NULL, no
+ *         draw is claimable or the game has already concluded.
+ */
+bool simple_chess_handle_claim_draw(sc_game_handle* handle);
+
+/**
+ * \brief Resign the game for the specified player, updating the handle in
+ * place.
+ *
+ * \return True if the game was resigned, false if the handle is NULL or
+ *         the game has already concluded.
+ */
+bool simple_chess_handle_resign(sc_game_handle* handle, color_t resigner);
+
+/**
+ * \brief Get the state of the game.
+ *
+ * \param handle The game. Must not be NULL.
+ */
+game_state_t simple_chess_handle_state(const sc_game_handle* handle);
+
+/**
+ * \brief Get the reason why the game was drawn.
+ *
+ * \param handle The game. Must not be NULL.
+ * \param reason Receives the reason. Must not be NULL.
+ *
+ * \return True if the game was drawn, false otherwise.
+ */
+bool simple_chess_handle_draw_reason(const sc_game_handle* handle, draw_reason_t* reason);
+
+/**
+ * \brief Get the reason why the player to move can claim a draw.
+ *
+ * \param handle The game. Must not be NULL.
+ * \param reason Receives the reason. Must not be NULL.
+ *
+ * \return True if a draw can be claimed, false otherwise.
+ */
+bool simple_chess_handle_draw_claimable(const sc_game_handle* handle, draw_reason_t* reason);
+
+/**
+ * \brief Get the color of the player whose turn it is to play.
+ *
+ * \param handle The game. Must not be NULL.
+ */
+color_t simple_chess_handle_active_color(const sc_game_handle* handle);
+
+/**
+ * \brief Get the FEN string of the current position.
+ *
+ * \param handle The game. Must not be NULL.
+ *
+ * \return The FEN string, owned by the handle. It remains valid until the
+ *         handle is modified or destroyed.
+ */
+const char* simple_chess_handle_fen(const sc_game_handle* handle);
+
+/**
+ * \brief Get the current stage of the game.
+ *
+ * \param handle The game. Must not be NULL.
+ * \param stage Receives the current stage. Must not be NULL.
+ */
+void simple_chess_handle_current_stage(const sc_game_handle* handle, game_stage_t* stage);
+
+/**
+ * \brief Get the moves available to the player whose turn it is to play.
+ *
+ * \param handle The game. Must not be NULL.
+ * \param moves Receives up to \p capacity moves. Can be NULL if
+ *        \p capacity is 0.
+ * \param capacity Size of the \p moves array.
+ *
+ * \return The total number of available moves, which may be greater than
+ *         \p capacity.
+ */
+uint16_t simple_chess_handle_available_moves(const sc_game_handle* handle, piece_move_t* moves, uint16_t capacity);
+
+/**
+ * \brief Get the number of moves played so far.
+ *
+ * \param handle The game. Must not be NULL.
+ */
+uint16_t simple_chess_handle_history_size(const sc_game_handle* handle);
+
+/**
+ * \brief Get one entry of the history of the game.
+ *
+ * \param handle The game. Must not be NULL.
+ * \param index Index of the entry, starting at 0 for the first move.
+ * \param entry Receives the entry. Must not be NULL.
+ *
+ * \return True on success, false if \p index is out of range.
+ */
+bool simple_chess_handle_history_entry(const sc_game_handle* handle, uint16_t index, game_history_entry_t* entry);
+
+/**
+ * \brief Take a full snapshot of the game.
+ *
+ * \param handle The game. Must not be NULL.
+ *
+ * \return Pointer to new game object, or NULL on memory allocation failure.
+ *
+ * \note The caller is responsible for freeing the returned game object
+ *       using destroy_game(). The snapshot is not affected by later
+ *       changes to the handle.
+ */
+game_t* simple_chess_handle_snapshot(const sc_game_handle* handle);
+
+/**
+ * \brief Free a game handle.
+ *
+ * \param handle The handle to destroy. Can be NULL (no operation performed).
+ */
+void simple_chess_handle_destroy(sc_game_handle* handle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -397,6 +397,53 @@ extern "C" {
 		DrawEnforcementClaimOnly
 	};
 
+	/**
+	 * \brief Reasons why a function reporting an error code may fail.
+	 */
+	enum error_code_t {
+		/**
+		 * \brief The function succeeded.
+		 */
+		ErrorCodeNone,
+
+		/**
+		 * \brief A required pointer was NULL, or a game was malformed.
+		 */
+		ErrorCodeInvalidArgument,
+
+		/**
+		 * \brief The string is not a valid FEN string.
+		 */
+		ErrorCodeInvalidFen,
+
+		/**
+		 * \brief The FEN string is well formed, but the position it
+		 * describes cannot be the stage of a game.
+		 */
+		ErrorCodeInvalidPosition,
+
+		/**
+		 * \brief The game has already concluded.
+		 */
+		ErrorCodeGameFinished,
+
+		/**
+		 * \brief The move is not valid for the current player.
+		 */
+		ErrorCodeIllegalMove,
+
+		/**
+		 * \brief Memory allocation failed.
+		 */
+		ErrorCodeOutOfMemory
+	};
+
+	/**
+	 * \brief Arena which games can be allocated from (see
+	 * simple_chess_arena_create()).
+	 */
+	struct sc_arena;
+
 	/**
 	 * \brief Represents a complete chess game with all state information.
 	 *
@@ -455,6 +502,46 @@ extern "C" {
 		 * \brief The draw enforcement mode of this game.
 		 */
 		draw_enforcement_t draw_enforcement;
+
+		/**
+		 * \brief Number of entries allocated for history (0 means exactly
+		 * history_size). Used by simple_chess_apply_move_inplace().
+		 */
+		uint16_t history_capacity;
+
+		/**
+		 * \brief Number of entries allocated for available_moves (0 means
+		 * exactly available_move_count). Used by
+		 * simple_chess_apply_move_inplace().
+		 */
+		uint16_t available_move_capacity;
+
+		/**
+		 * \brief The arena the game was allocated from, or NULL if it was
+		 * allocated on its own and must be released with destroy_game().
+		 */
+		sc_arena* arena;
+
+		/**
+		 * \brief Opaque record of the positions of the history which can
+		 * still be repeated, kept alongside the history by
+		 * simple_chess_apply_move_inplace(), or NULL until that function
+		 * first updates the game. It is released with the game.
+		 */
+		struct sc_reached_position* reached_positions;
+	};
+
+	/**
+	 * \brief A game stage packed in 32 bytes.
+	 *
+	 * Equal stages always have the same packed bytes, so they can be
+	 * compared with memcmp() and used as keys or fixed-size payloads.
+	 */
+	struct packed_position_t {
+		/**
+		 * \brief The packed bytes
+		 */
+		uint8_t bytes[32];
 	};
 
 #ifdef __cplusplus
@@ -0,0 +1,78 @@
+#ifndef ATTACK_MAPS_H_F0B9A5C9_CCAA_4E96_9188_7D6E6D65DE89
+#define ATTACK_MAPS_H_F0B9A5C9_CCAA_4E96_9188_7D6E6D65DE89
+
+#include <cpp/simplechess/GameStage.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace simplechess
+{
+	/**
+	 * \brief The pieces of many positions, stored as one array per color
+	 * and type of piece ("structure of arrays") so that several positions
+	 * can be processed at once.
+	 *
+	 * Each array holds one bitboard per position, in which bit \c i is set
+	 * if there is such a piece on the \c i-th square (a1 is 0, b1 is 1,
+	 * ..., h8 is 63). Arrays are indexed by \ref Color and \ref PieceType
+	 * converted to integers.
+	 */
+	struct PositionBatch
+	{
+		std::array<std::array<std::vector<uint64_t>, 6>, 2> pieces;
+
+		/**
+		 * \brief The number of positions in the batch.
+		 */
+		size_t size() const
+		{
+			return pieces[0][0].size();
+		}
+
+		/**
+		 * \brief Appends the pieces of \p stage to the batch.
+		 */
+		void add(const GameStage& stage);
+	};
+
+	/**
+	 * \brief The squares attacked in each position of a \ref
+	 * PositionBatch, with the same layout.
+	 *
+	 * A square is attacked by a piece if the piece could capture an enemy
+	 * piece on it, whatever actually stands on it. Sliding pieces are
+	 * stopped by the first piece in their way, of either color.
+	 */
+	struct AttackMaps
+	{
+		/**
+		 * \brief The squares attacked by the pieces of each color and
+		 * type.
+		 */
+		std::array<std::array<std::vector<uint64_t>, 6>, 2> byPiece;
+
+		/**
+		 * \brief The squares attacked by any piece of each color.
+		 */
+		std::array<std::vector<uint64_t>, 2> byColor;
+	};
+
+	/**
+	 * \brief Computes the squares attacked in every position of \p batch.
+	 *
+	 * All the pieces of a kind are processed at once, using shifts of
+	 * whole bitboards rather than looking at each piece. Several positions
+	 * are processed at the same time with AVX2 (4) or AVX-512 (8) when the
+	 * library was built with them and the processor supports them, or one
+	 * by one otherwise. The results are the same either way.
+	 *
+	 * \throws std::invalid_argument if the arrays of \p batch do not all
+	 * have the same size.
+	 */
+	AttackMaps computeAttackMaps(const PositionBatch& batch);
+}
+
+#endif
@@ -5,6 +5,8 @@
 #include <cpp/simplechess/PieceMove.h>
 #include <cpp/simplechess/Square.h>
 
+#include <cstddef>
+#include <memory_resource>
 #include <optional>
 
 #include <map>
@@ -18,10 +20,33 @@ namespace simplechess
 	 *
 	 * This representation is absent of any context beyond the position of the
 	 * pieces on the board.
+	 *
+	 * The pieces are kept in a \c std::pmr container, so a plain copy uses
+	 * the default resource; use the constructor taking an allocator to copy
+	 * a board into a given resource.
 	 */
 	class Board
 	{
 		public:
+			using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+			Board(const Board& other) = default;
+			Board(Board&& other) = default;
+
+			/**
+			 * \brief Copies \p other, allocating from \p allocator.
+			 */
+			Board(const Board& other, const allocator_type& allocator);
+
+			/**
+			 * \brief Moves \p other, allocating from \p allocator if it
+			 * does not use the same resource.
+			 */
+			Board(Board&& other, const allocator_type& allocator);
+
+			Board& operator=(const Board& other) = default;
+			Board& operator=(Board&& other) = default;
+
 			/**
 			 * \brief Returns the piece at the specified \p square or an empty
 			 * optional if the \p square is empty.
@@ -38,7 +63,12 @@ namespace simplechess
 			 *
 			 * \return A collection of all occupied squares.
 			 */
-			const std::map<Square, Piece>& occupiedSquares() const;
+			const std::pmr::map<Square, Piece>& occupiedSquares() const;
+
+			/**
+			 * \brief Returns the allocator the board allocates from.
+			 */
+			allocator_type get_allocator() const;
 
 		private:
 			friend class BoardBuilder;
@@ -46,13 +76,14 @@ namespace simplechess
 			/**
 			 * \brief Constructor.
 			 *
-			 * Instantiates a \c Board from a series of \c Piece positions.
+			 * Instantiates a \c Board from a series of \c Piece positions,
+			 * allocating from the same resource as them.
 			 *
 			 * \param piecePositions The positions of the pieces in the board.
 			 */
-			Board(const std::map<Square, Piece>& piecePositions);
+			explicit Board(std::pmr::map<Square, Piece> piecePositions);
 
-			std::map<Square, Piece> mPiecePositions;
+			std::pmr::map<Square, Piece> mPiecePositions;
 	};
 }
 
@@ -0,0 +1,43 @@
+#ifndef EVALUATION_H_A42F91C6_3E7B_4D15_B80C_5F6D2E19A873
+#define EVALUATION_H_A42F91C6_3E7B_4D15_B80C_5F6D2E19A873
+
+#include <cpp/simplechess/GameStage.h>
+#include <cpp/simplechess/PackedPosition.h>
+
+#include <vector>
+
+namespace simplechess
+{
+	/**
+	 * \brief Returns the static evaluation of \p stage in centipawns, from
+	 * the point of view of white (positive if white is better).
+	 *
+	 * The evaluation is the one used by \ref findBestMove(): material and
+	 * piece-square values blended between the middlegame and the endgame
+	 * according to the material left, the mobility of the pieces and the
+	 * pawn structure (doubled, isolated and passed pawns). It does not
+	 * look at any move, so it is only meaningful in quiet positions, and
+	 * it does not detect checkmate, stalemate or draws.
+	 */
+	int evaluatePosition(const GameStage& stage);
+
+	/**
+	 * \brief Returns the evaluation of each of \p stages, as given by \ref
+	 * evaluatePosition().
+	 *
+	 * It is faster than evaluating the positions one by one, since the
+	 * pawn structure of positions which share it is only evaluated once.
+	 */
+	std::vector<int> evaluatePositions(const std::vector<GameStage>& stages);
+
+	/**
+	 * \brief Same as \ref evaluatePositions(const std::vector<GameStage>&),
+	 * for packed positions.
+	 *
+	 * \throws std::invalid_argument if any of \p positions is malformed
+	 * or does not describe a valid position (see \ref unpackPosition()).
+	 */
+	std::vector<int> evaluatePositions(const std::vector<PackedPosition>& positions);
+}
+
+#endif
@@ -4,9 +4,14 @@
 #include <cpp/simplechess/Exceptions.h>
 #include <cpp/simplechess/GameStage.h>
 #include <cpp/simplechess/PieceMove.h>
+#include <cpp/simplechess/PieceMoveRange.h>
 #include <cpp/simplechess/PlayedMove.h>
 #include <cpp/simplechess/Square.h>
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
 #include <optional>
 
 #include <set>
@@ -133,10 +138,36 @@ namespace simplechess
 	 *
 	 * The class is immutable, so all methods which would change its state
 	 * instead return a new copy of the object with the updated state.
+	 *
+	 * A game is bound to a \c std::pmr::memory_resource, which the games
+	 * derived from it keep using (see \ref makeMove()). The resource backs
+	 * the history, the stages and boards in it, the available moves and the
+	 * scratch memory needed to play a move. As with any \c std::pmr type, a
+	 * plain copy uses the default resource instead; use the constructor
+	 * taking an allocator to copy a game into a given resource.
 	 */
 	class Game
 	{
 		public:
+			using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+			Game(const Game& other) = default;
+			Game(Game&& other) = default;
+
+			/**
+			 * \brief Copies \p other, allocating from \p allocator.
+			 */
+			Game(const Game& other, const allocator_type& allocator);
+
+			/**
+			 * \brief Moves \p other, allocating from \p allocator if it
+			 * does not use the same resource.
+			 */
+			Game(Game&& other, const allocator_type& allocator);
+
+			Game& operator=(const Game& other) = default;
+			Game& operator=(Game&& other) = default;
+
 			/**
 			 * \brief Returns the current state of the game.
 			 *
@@ -165,7 +196,7 @@ namespace simplechess
 			 *
 			 * \return The history of the game as position-move pairs.
 			 */
-			const std::vector<std::pair<GameStage, PlayedMove>>& history() const;
+			const std::pmr::vector<std::pair<GameStage, PlayedMove>>& history() const;
 
 			/**
 			 * \brief Returns the latest stage of the game.
@@ -189,15 +220,33 @@ namespace simplechess
 			 * in the board.
 			 *
 			 * If the square is empty or does not contain a piece of the player
-			 * whose turn it is to play, an empty set is returned.
+			 * whose turn it is to play, an empty range is returned.
+			 *
+			 * The moves are grouped by origin square when the game is built,
+			 * so this is a constant-time lookup which does not allocate.
 			 *
 			 * \note Castling is considered a King's move, so it's only listed
 			 * as such.
 			 *
 			 * \param square The \ref Square whose piece is being queried.
-			 * \return All the possible moves for the piece.
+			 * \return All the possible moves for the piece, in the same
+			 * order as in \ref allAvailableMoves(). The range is only valid
+			 * while this \c Game is alive.
+			 */
+			PieceMoveRange availableMovesForPiece(const Square& square) const;
+
+			/**
+			 * \brief Returns whether \p move is one of the available moves
+			 * for the player whose turn it is to play.
+			 *
+			 * Only the few moves from the origin square of \p move are
+			 * compared, so the cost does not depend on the number of
+			 * available moves.
+			 *
+			 * \param move The move to check.
+			 * \return \c true if \p move can be played, \c false otherwise.
 			 */
-			std::set<PieceMove> availableMovesForPiece(const Square& square) const;
+			bool isLegal(const PieceMove& move) const;
 
 			/**
 			 * \brief Returns all available moves for the player whose turn it
@@ -205,7 +254,7 @@ namespace simplechess
 			 *
 			 * \return All the possible moves for the current player.
 			 */
-			const std::set<PieceMove>& allAvailableMoves() const;
+			const std::pmr::set<PieceMove>& allAvailableMoves() const;
 
 			/**
 			 * \brief Returns an optional value containing the reason under
@@ -250,23 +299,35 @@ namespace simplechess
 			 */
 			DrawEnforcement drawEnforcement() const;
 
+			/**
+			 * \brief Returns the allocator the game allocates from.
+			 */
+			allocator_type get_allocator() const;
+
 		private:
 			friend class GameBuilder;
 
 			Game(
 					GameState gameState,
 					const std::optional<DrawReason>& drawReason,
-					const std::vector<std::pair<GameStage, PlayedMove>>& history,
-					const GameStage& currentStage,
-					const std::set<PieceMove>& allAvailableMoves,
+					std::pmr::vector<std::pair<GameStage, PlayedMove>> history,
+					GameStage currentStage,
+					std::pmr::set<PieceMove> allAvailableMoves,
 					const std::optional<DrawReason>& reasonToClaimDraw,
-					DrawEnforcement drawEnforcement);
+					DrawEnforcement drawEnforcement,
+					const allocator_type& allocator);
 
 			GameState mGameState;
 			std::optional<DrawReason> mReasonGameWasDrawn;
-			std::vector<std::pair<GameStage, PlayedMove>> mHistory;
+			std::pmr::vector<std::pair<GameStage, PlayedMove>> mHistory;
 			GameStage mCurrentStage;
-			std::set<PieceMove> mAllAvailableMoves;
+			std::pmr::set<PieceMove> mAllAvailableMoves;
+
+			// The available moves grouped by the index of their origin
+			// square (rank-major, a1 = 0). The moves from square i are
+			// those in [mSourceOffsets[i], mSourceOffsets[i + 1]).
+			std::pmr::vector<PieceMove> mMovesBySource;
+			std::array<uint16_t, 65> mSourceOffsets;
 			std::optional<DrawReason> mReasonToClaimDraw;
 			DrawEnforcement mDrawEnforcement;
 	};
@@ -0,0 +1,103 @@
+#ifndef GAME_CODEC_H_6C1E8A47_92D3_4B5F_A7E0_3F8D1B6C2A95
+#define GAME_CODEC_H_6C1E8A47_92D3_4B5F_A7E0_3F8D1B6C2A95
+
+#include <cpp/simplechess/Game.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace simplechess
+{
+	/**
+	 * \brief Returns the compact binary record of \p game.
+	 *
+	 * Every move is stored in a single byte, as its index in the list of
+	 * legal moves of the position in which it was played, sorted by origin
+	 * square, destination square and promotion. The record also stores
+	 * the initial position (only if it is not the standard one), the draw
+	 * enforcement mode, the moves which offered a draw and the final state
+	 * of the game, so that resignations and accepted or claimed draws are
+	 * restored too.
+	 *
+	 * Records are self-delimiting, so several of them can be concatenated
+	 * in the same buffer or stream.
+	 *
+	 * The layout of a record is:
+	 * - A flags byte: the \ref GameState in bits 0-1, whether the initial
+	 *   position is given in bit 2, whether draws are only claimable in bit
+	 *   3 and whether any move offered a draw in bit 4.
+	 * - A byte with the \ref DrawReason plus one, or zero if the game was
+	 *   not drawn.
+	 * - If the initial position is given, its FEN string, preceded by its
+	 *   length.
+	 * - The number of moves.
+	 * - If any move offered a draw, the number of such moves followed by
+	 *   the distance from each of them to the previous one (or to the first
+	 *   move).
+	 * - The index of every move.
+	 *
+	 * Numbers, except for the move indices, are stored as unsigned LEB128
+	 * variable-length integers.
+	 */
+	std::vector<uint8_t> encodeGame(const Game& game);
+
+	/**
+	 * \brief Appends the binary record of \p game to \p output.
+	 *
+	 * \see encodeGame(const Game&)
+	 */
+	void encodeGame(const Game& game, std::vector<uint8_t>& output);
+
+	/**
+	 * \brief Writes the binary record of \p game to \p output.
+	 *
+	 * \see encodeGame(const Game&)
+	 */
+	void encodeGame(const Game& game, std::ostream& output);
+
+	/**
+	 * \brief Returns the game described by the binary record at the
+	 * beginning of the \p size bytes at \p data.
+	 *
+	 * The moves are replayed on a compact board representation, so the
+	 * history of the game is restored without going through \ref
+	 * makeMove() for every move.
+	 *
+	 * \throws std::invalid_argument if the record is truncated or
+	 * malformed, or does not describe a valid game.
+	 *
+	 * \param data The bytes to decode.
+	 * \param size The number of bytes available at \p data.
+	 * \param consumed If not null, it receives the size of the record, so
+	 * that the next record can be decoded from \p data + \p *consumed.
+	 * \return The decoded game.
+	 */
+	Game decodeGame(
+			const uint8_t* data,
+			size_t size,
+			size_t* consumed = nullptr);
+
+	/**
+	 * \brief Returns the game described by the binary record at the
+	 * beginning of \p data.
+	 *
+	 * \see decodeGame(const uint8_t*, size_t, size_t*)
+	 */
+	Game decodeGame(const std::vector<uint8_t>& data);
+
+	/**
+	 * \brief Reads the next binary record from \p input and returns the
+	 * game it describes.
+	 *
+	 * Only the bytes of the record are extracted from \p input.
+	 *
+	 * \throws std::invalid_argument if the record is truncated or
+	 * malformed, or does not describe a valid game.
+	 */
+	Game decodeGame(std::istream& input);
+}
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef GAME_MANAGER_H_C34ED7E4_C7E6_4817_A844_A3F95E79172A
+#define GAME_MANAGER_H_C34ED7E4_C7E6_4817_A844_A3F95E79172A
+
+#include <cpp/simplechess/Color.h>
+#include <cpp/simplechess/Game.h>
+#include <cpp/simplechess/PieceMove.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace simplechess
+{
+	/**
+	 * \brief Contention figures of one shard of a \ref GameManager.
+	 *
+	 * Counters start at 0 when the manager is created. A lock is contended
+	 * when it cannot be taken at the first attempt.
+	 */
+	struct GameManagerShardStatistics
+	{
+		/**
+		 * \brief The number of games in the shard.
+		 */
+		size_t games;
+
+		/**
+		 * \brief How many times the table of the shard was locked, to
+		 * look up, add or remove a game.
+		 */
+		uint64_t lookups;
+
+		/**
+		 * \brief How many of \ref lookups were contended.
+		 */
+		uint64_t contendedLookups;
+
+		/**
+		 * \brief How many times a game of the shard was updated.
+		 */
+		uint64_t updates;
+
+		/**
+		 * \brief How many of \ref updates had to wait for another update
+		 * of the same game.
+		 */
+		uint64_t contendedUpdates;
+	};
+
+	/**
+	 * \brief Hosts many live games which are played and observed from
+	 * several threads at once.
+	 *
+	 * Games are spread over shards, each with its own lock, so operations
+	 * on different games rarely wait for each other. The lock of a shard
+	 * is only held to find a game in it. Updates of the same game are
+	 * applied one at a time under a lock of their own. Readers never wait
+	 * for updates: they get an immutable snapshot of the game, shared
+	 * with the manager rather than copied.
+	 */
+	class GameManager
+	{
+		public:
+			/**
+			 * \brief Identifier of a game in a manager.
+			 */
+			typedef uint64_t GameId;
+
+			/**
+			 * \brief Constructor.
+			 *
+			 * \param shards The number of shards, which is rounded up to a
+			 * power of two, or 0 to use four per hardware thread.
+			 */
+			explicit GameManager(size_t shards = 0);
+
+			GameManager(const GameManager&) = delete;
+			GameManager& operator=(const GameManager&) = delete;
+
+			~GameManager();
+
+			/**
+			 * \brief Starts hosting \p game, and returns its identifier.
+			 */
+			GameId add(Game game);
+
+			/**
+			 * \brief Stops hosting the game \p id.
+			 *
+			 * Updates of the game which are in progress complete, but
+			 * their result is lost.
+			 *
+			 * \return \c false if there was no such game.
+			 */
+			bool remove(GameId id);
+
+			/**
+			 * \brief Returns the current snapshot of the game \p id, or
+			 * \c nullptr if there is no such game.
+			 *
+			 * The snapshot is not affected by later updates of the game.
+			 */
+			std::shared_ptr<const Game> get(GameId id) const;
+
+			/**
+			 * \brief Makes a move in the game \p id, as \ref
+			 * simplechess::makeMove() does.
+			 *
+			 * \throws std::invalid_argument if there is no such game.
+			 * \throws IllegalStateException if the move cannot be made,
+			 * in which case the game is not modified.
+			 *
+			 * \return The snapshot of the game after the move.
+			 */
+			std::shared_ptr<const Game> makeMove(
+					GameId id,
+					const PieceMove& move,
+					bool offerDraw = false);
+
+			/**
+			 * \brief Claims a draw in the game \p id, as \ref
+			 * simplechess::claimDraw() does.
+			 *
+			 * \throws std::invalid_argument if there is no such game.
+			 * \throws IllegalStateException if no draw can be claimed, in
+			 * which case the game is not modified.
+			 */
+			std::shared_ptr<const Game> claimDraw(GameId id);
+
+			/**
+			 * \brief Resigns the game \p id on behalf of \p
+			 * resigningPlayer, as \ref simplechess::resign() does.
+			 *
+			 * \throws std::invalid_argument if there is no such game.
+			 * \throws IllegalStateException if the game has already
+			 * concluded.
+			 */
+			std::shared_ptr<const Game> resign(GameId id, Color resigningPlayer);
+
+			/**
+			 * \brief The number of games hosted.
+			 */
+			size_t size() const;
+
+			/**
+			 * \brief The number of shards.
+			 */
+			size_t shards() const;
+
+			/**
+			 * \brief Returns the contention figures of every shard.
+			 */
+			std::vector<GameManagerShardStatistics> statistics() const;
+
+		private:
+			struct Entry;
+			struct Shard;
+
+			Shard& shardOf(GameId id) const;
+			std::shared_ptr<Entry> find(GameId id) const;
+			std::shared_ptr<const Game> update(
+					GameId id,
+					const std::function<Game(const Game&)>& transition);
+
+			std::unique_ptr<Shard[]> mShards;
+			size_t mShardMask;
+			std::atomic<GameId> mNextId;
+	};
+}
+
+#endif
@@ -7,9 +7,12 @@
 #include <cpp/simplechess/PlayedMove.h>
 #include <cpp/simplechess/Square.h>
 
+#include <cstddef>
+#include <memory_resource>
 #include <optional>
 
 #include <string>
+#include <string_view>
 
 namespace simplechess
 {
@@ -49,10 +52,33 @@ namespace simplechess
 	 * additional context from the game which cannot be inferred from it (which
 	 * color plays the next move, what castling rights remain, etc.), along
 	 * with the move which was last played to achieve the position.
+	 *
+	 * The board and the FEN string are kept in \c std::pmr containers, so a
+	 * plain copy uses the default resource; use the constructor taking an
+	 * allocator to copy a stage into a given resource.
 	 */
 	class GameStage
 	{
 		public:
+			using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+			GameStage(const GameStage& other) = default;
+			GameStage(GameStage&& other) = default;
+
+			/**
+			 * \brief Copies \p other, allocating from \p allocator.
+			 */
+			GameStage(const GameStage& other, const allocator_type& allocator);
+
+			/**
+			 * \brief Moves \p other, allocating from \p allocator if it
+			 * does not use the same resource.
+			 */
+			GameStage(GameStage&& other, const allocator_type& allocator);
+
+			GameStage& operator=(const GameStage& other) = default;
+			GameStage& operator=(GameStage&& other) = default;
+
 			/**
 			 * \brief Returns the state of the board in the current stage.
 			 * \return The state of the board in the current stage.
@@ -99,7 +125,7 @@ namespace simplechess
 			 * Forsyth-Edwards Notation.
 			 * \return The description of the state of the board in FEN format.
 			 */
-			const std::string& fen() const;
+			const std::pmr::string& fen() const;
 
 			/**
 			 * \brief Returns the en passant target square if available.
@@ -119,6 +145,11 @@ namespace simplechess
 			 */
 			CheckType checkStatus() const;
 
+			/**
+			 * \brief Returns the allocator the stage allocates from.
+			 */
+			allocator_type get_allocator() const;
+
 		private:
 			friend class GameStageBuilder;
 
@@ -136,15 +167,18 @@ namespace simplechess
 			 * \param fen The FEN string representation of this position.
 			 * \param enPassantTarget The en passant target square, if any.
 			 * \param checkStatus The check status for the active player.
+			 * \param allocator The allocator of the board and the FEN
+			 * string.
 			 */
-			GameStage(const Board& board,
+			GameStage(Board board,
 					Color activeColor,
 					uint8_t castlingRights,
 					uint16_t halfmoveClock,
 					uint16_t fullmoveClock,
-					const std::string& fen,
+					std::string_view fen,
 					const std::optional<Square>& enPassantTarget,
-					CheckType checkStatus);
+					CheckType checkStatus,
+					const allocator_type& allocator);
 
 		private:
 			Board mBoard;
@@ -152,7 +186,7 @@ namespace simplechess
 			uint8_t mCastlingRights;
 			uint16_t mHalfmoveClock;
 			uint16_t mFullmoveClock;
-			std::string mFen;
+			std::pmr::string mFen;
 			std::optional<Square> mEnPassantTarget;
 			CheckType mCheckStatus;
 	};
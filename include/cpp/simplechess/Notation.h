@@ -0,0 +1,65 @@
+#ifndef NOTATION_H_91D2C6A4_3E7B_4A0F_B5C8_6D4E2F1A7B39
+#define NOTATION_H_91D2C6A4_3E7B_4A0F_B5C8_6D4E2F1A7B39
+
+#include <cpp/simplechess/GameStage.h>
+#include <cpp/simplechess/PieceMove.h>
+
+#include <string>
+
+namespace simplechess
+{
+	/**
+	 * \brief Returns the \ref PieceMove described by \p san in a given
+	 * stage of the game.
+	 *
+	 * \p san must describe the move in Standard Algebraic Notation (e.g.
+	 * "Nbd7", "exd6", "e8=Q+" or "O-O-O"). Check and mate indicators,
+	 * annotation glyphs and the draw offer suffix produced by \ref
+	 * PlayedMove::inAlgebraicNotation() are accepted and ignored.
+	 *
+	 * The move is resolved directly from the destination square, without
+	 * generating the list of all available moves.
+	 *
+	 * \throws std::invalid_argument if \p san is malformed, ambiguous or
+	 * does not describe a legal move in \p stage.
+	 *
+	 * \param stage The stage of the game in which the move is played.
+	 * \param san The move in Standard Algebraic Notation.
+	 * \return The described move.
+	 */
+	PieceMove pieceMoveFromAlgebraicNotation(
+			const GameStage& stage,
+			const std::string& san);
+
+	/**
+	 * \brief Returns the \ref PieceMove described by \p uci in a given
+	 * stage of the game.
+	 *
+	 * \p uci must describe the move in the long algebraic notation used by
+	 * the Universal Chess Interface: the origin and destination squares,
+	 * followed by the lowercase letter of the promoted piece if any (e.g.
+	 * "e2e4", "e7e8q"). Castling is described as the move of the king
+	 * ("e1g1").
+	 *
+	 * \throws std::invalid_argument if \p uci is malformed or does not
+	 * describe a legal move in \p stage.
+	 *
+	 * \param stage The stage of the game in which the move is played.
+	 * \param uci The move in UCI notation.
+	 * \return The described move.
+	 */
+	PieceMove pieceMoveFromUci(
+			const GameStage& stage,
+			const std::string& uci);
+
+	/**
+	 * \brief Returns the description of \p move in the long algebraic
+	 * notation used by the Universal Chess Interface.
+	 *
+	 * \param move The move to describe.
+	 * \return The move in UCI notation (e.g. "e2e4", "e7e8q").
+	 */
+	std::string pieceMoveToUci(const PieceMove& move);
+}
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef PACKED_POSITION_H_E47B2D90_15A8_4C63_9F2E_8B0D6A3C51F7
+#define PACKED_POSITION_H_E47B2D90_15A8_4C63_9F2E_8B0D6A3C51F7
+
+#include <cpp/simplechess/Game.h>
+#include <cpp/simplechess/GameStage.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace simplechess
+{
+	/**
+	 * \brief A stage of the game packed in 32 bytes.
+	 *
+	 * It holds the occupied squares as a bitboard, a 4-bit code for every
+	 * piece, the active color, the castling rights, the en passant target
+	 * and both move counters. Equal stages always have the same packed
+	 * bytes, so it can be used as a key in caches and indices, or sent
+	 * as a fixed-size payload.
+	 */
+	struct PackedPosition
+	{
+		/**
+		 * \brief Size in bytes of a packed position.
+		 */
+		static constexpr size_t Size = 32;
+
+		/**
+		 * \brief The packed bytes.
+		 */
+		std::array<uint8_t, Size> bytes;
+
+		bool operator==(const PackedPosition& other) const
+		{
+			return bytes == other.bytes;
+		}
+
+		bool operator!=(const PackedPosition& other) const
+		{
+			return bytes != other.bytes;
+		}
+	};
+
+	/**
+	 * \brief Returns the packed representation of \p stage.
+	 *
+	 * \throws std::invalid_argument if there are more than 32 pieces on
+	 * the board.
+	 */
+	PackedPosition packPosition(const GameStage& stage);
+
+	/**
+	 * \brief Returns the stage of the game packed in \p packed.
+	 *
+	 * The position is validated in the same way as by \ref
+	 * createGameFromFen().
+	 *
+	 * \throws std::invalid_argument if \p packed is malformed or does not
+	 * describe a valid position.
+	 */
+	GameStage unpackPosition(const PackedPosition& packed);
+
+	/**
+	 * \brief Factory method to create a new game from a packed position.
+	 *
+	 * The position is validated in the same way as by \ref
+	 * createGameFromFen().
+	 *
+	 * \throws std::invalid_argument if \p packed is malformed or does not
+	 * describe a valid position.
+	 */
+	Game createGameFromPackedPosition(
+			const PackedPosition& packed,
+			DrawEnforcement drawEnforcement = DrawEnforcement::Automatic);
+}
+
+namespace std
+{
+	template <>
+	struct hash<simplechess::PackedPosition>
+	{
+		size_t operator()(const simplechess::PackedPosition& packed) const
+		{
+			// FNV-1a
+			uint64_t result = 0xCBF29CE484222325ULL;
+
+			for (const uint8_t byte : packed.bytes)
+			{
+				result = (result ^ byte) * 0x100000001B3ULL;
+			}
+
+			return static_cast<size_t>(result);
+		}
+	};
+}
+
+#endif
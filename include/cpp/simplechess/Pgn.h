@@ -0,0 +1,260 @@
+#ifndef PGN_H_0A6E3C59_7B21_4D8F_9E14_C3F5B8D27A60
+#define PGN_H_0A6E3C59_7B21_4D8F_9E14_C3F5B8D27A60
+
+#include <cpp/simplechess/Game.h>
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace simplechess
+{
+	/**
+	 * \brief An ordered list of PGN tag pairs, as (name, value).
+	 */
+	typedef std::vector<std::pair<std::string, std::string>> PgnTags;
+
+	/**
+	 * \brief Writes games in Portable Game Notation to an output sink.
+	 *
+	 * The text is composed directly in a fixed-size buffer, which is handed
+	 * to the sink whenever it fills up, so no intermediate string is built
+	 * per move or per game.
+	 *
+	 * Each game is written with:
+	 * - The Seven Tag Roster (Event, Site, Date, Round, White, Black and
+	 *   Result), using the values given by the caller or the PGN defaults
+	 *   ("?", "????.??.??"). The Result tag is always derived from the
+	 *   state of the game.
+	 * - Any other tag given by the caller, in the given order.
+	 * - The SetUp and FEN tags if the game does not start from the standard
+	 *   initial position.
+	 * - The movetext, with move numbers, moves in algebraic notation, a
+	 *   "{draw offer}" comment after every move which offered a draw, and
+	 *   the result. Lines are wrapped at 80 characters.
+	 *
+	 * \note Output is only guaranteed to have reached the sink after \ref
+	 * flush() is called. The destructor flushes too, but it cannot report
+	 * errors.
+	 */
+	class PgnWriter
+	{
+		public:
+			/**
+			 * \brief Callback which receives chunks of the output.
+			 */
+			typedef std::function<void(const char* data, size_t size)> Sink;
+
+			/**
+			 * \brief Default size of the output buffer.
+			 */
+			static constexpr size_t DefaultBufferSize = 64 * 1024;
+
+			/**
+			 * \brief Constructor.
+			 *
+			 * \param sink The callback which receives the output.
+			 * \param bufferSize The size of the output buffer, which is
+			 * allocated once.
+			 */
+			explicit PgnWriter(
+					Sink sink,
+					size_t bufferSize = DefaultBufferSize);
+
+			/**
+			 * \brief Returns a writer which writes to the file descriptor
+			 * \p fd, which is not closed by the writer.
+			 *
+			 * \throws std::system_error when flushing, if writing to \p fd
+			 * fails.
+			 */
+			static PgnWriter toFileDescriptor(
+					int fd,
+					size_t bufferSize = DefaultBufferSize);
+
+			/**
+			 * \brief Returns a writer which writes to \p stream.
+			 */
+			static PgnWriter toStream(
+					std::ostream& stream,
+					size_t bufferSize = DefaultBufferSize);
+
+			/**
+			 * \brief Returns a writer which appends its output to \p
+			 * output.
+			 *
+			 * The caller can reserve the expected capacity of \p output
+			 * beforehand to avoid any reallocation.
+			 */
+			static PgnWriter toString(
+					std::string& output,
+					size_t bufferSize = DefaultBufferSize);
+
+			PgnWriter(PgnWriter&& other) = default;
+			PgnWriter(const PgnWriter&) = delete;
+			PgnWriter& operator=(const PgnWriter&) = delete;
+
+			/**
+			 * \brief Destructor. Flushes any pending output, ignoring
+			 * errors.
+			 */
+			~PgnWriter();
+
+			/**
+			 * \brief Writes \p game, followed by an empty line.
+			 *
+			 * \param game The game to write.
+			 * \param tags The tags of the game. Tags of the Seven Tag
+			 * Roster which are not given take their default value.
+			 */
+			void write(const Game& game, const PgnTags& tags = {});
+
+			/**
+			 * \brief Writes every game in \p games, all of them with the
+			 * same \p tags.
+			 */
+			void write(const std::vector<Game>& games, const PgnTags& tags = {});
+
+			/**
+			 * \brief Hands all the pending output to the sink.
+			 */
+			void flush();
+
+		private:
+			void append(std::string_view text);
+			void append(char c);
+			void appendTag(std::string_view name, std::string_view value);
+			void appendMovetextToken(std::string_view token);
+
+			Sink mSink;
+			std::vector<char> mBuffer;
+			size_t mCapacity;
+			size_t mLineLength;
+	};
+
+	/**
+	 * \brief Returns the description of \p game in Portable Game Notation.
+	 *
+	 * \see PgnWriter
+	 */
+	std::string gameToPgn(const Game& game, const PgnTags& tags = {});
+
+	/**
+	 * \brief A game read from a PGN database and replayed.
+	 */
+	struct PgnGameRecord
+	{
+		/**
+		 * \brief Position of the game in the database, starting at 0.
+		 */
+		size_t index;
+
+		/**
+		 * \brief The tags of the game, in the order they appear.
+		 */
+		PgnTags tags;
+
+		/**
+		 * \brief The moves of the game which could be replayed.
+		 */
+		std::vector<PieceMove> moves;
+
+		/**
+		 * \brief The result at the end of the movetext ("1-0", "0-1",
+		 * "1/2-1/2" or "*"), or an empty string if it is missing.
+		 */
+		std::string result;
+
+		/**
+		 * \brief The game after replaying all of its moves, or an empty
+		 * value if it could not be replayed.
+		 *
+		 * Only the final position is analysed to determine the state of
+		 * the game. Its history contains the moves of the record (see
+		 * \ref createGameFromUciMoves()).
+		 */
+		std::optional<Game> game;
+
+		/**
+		 * \brief Why the game could not be replayed (malformed tags,
+		 * invalid FEN tag, an illegal, ambiguous or malformed move, or a
+		 * move played after the game had finished), or an empty value if
+		 * it was replayed.
+		 */
+		std::optional<std::string> error;
+	};
+
+	/**
+	 * \brief Options of \ref ingestPgn() and \ref ingestPgnFile().
+	 */
+	struct PgnIngestionOptions
+	{
+		/**
+		 * \brief The number of threads to use, or 0 to use one per
+		 * hardware thread.
+		 */
+		unsigned threads = 0;
+
+		/**
+		 * \brief The draw enforcement mode of the replayed games.
+		 */
+		DrawEnforcement drawEnforcement = DrawEnforcement::Automatic;
+	};
+
+	/**
+	 * \brief Callback which receives each game of a PGN database.
+	 *
+	 * \note It is called concurrently from several threads, and games are
+	 * not delivered in any particular order (see \ref
+	 * PgnGameRecord::index).
+	 */
+	typedef std::function<void(const PgnGameRecord&)> PgnGameCallback;
+
+	/**
+	 * \brief Reads and replays every game in the PGN database \p
+	 * database, in parallel.
+	 *
+	 * The database is split into chunks which are scanned for game
+	 * boundaries in parallel. The games are then replayed by a pool of
+	 * threads which balance the load among themselves by work stealing.
+	 * Moves are resolved from their algebraic notation and validated
+	 * according to the rules of the library, without generating FEN
+	 * strings or algebraic notation for the intermediate positions.
+	 *
+	 * A game starts at a tag line which does not follow another tag line.
+	 * Games whose replay fails are still delivered, with \ref
+	 * PgnGameRecord::error set.
+	 *
+	 * \throws Any exception thrown by \p onGame, after every thread has
+	 * stopped.
+	 *
+	 * \param database The contents of the PGN database.
+	 * \param onGame The callback which receives every game.
+	 * \param options The options of the ingestion.
+	 * \return The number of games in the database.
+	 */
+	size_t ingestPgn(
+			std::string_view database,
+			const PgnGameCallback& onGame,
+			const PgnIngestionOptions& options = {});
+
+	/**
+	 * \brief Reads and replays every game in the PGN database stored in
+	 * the file at \p path, which is mapped into memory.
+	 *
+	 * \see ingestPgn()
+	 *
+	 * \throws std::system_error if the file cannot be opened or mapped.
+	 */
+	size_t ingestPgnFile(
+			const std::string& path,
+			const PgnGameCallback& onGame,
+			const PgnIngestionOptions& options = {});
+}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef PIECE_MOVE_RANGE_H_9B61D2F4_3C7E_4A85_8E0F_52A4C71D6B3E
+#define PIECE_MOVE_RANGE_H_9B61D2F4_3C7E_4A85_8E0F_52A4C71D6B3E
+
+#include <cpp/simplechess/PieceMove.h>
+
+#include <cstddef>
+
+namespace simplechess
+{
+	/**
+	 * \brief A read-only view of a contiguous sequence of \ref PieceMove.
+	 *
+	 * The range does not own the moves, so it is only valid while the
+	 * object which returned it is alive.
+	 */
+	class PieceMoveRange
+	{
+		public:
+			using const_iterator = const PieceMove*;
+
+			/**
+			 * \brief Constructs an empty range.
+			 */
+			PieceMoveRange()
+				: mBegin(nullptr),
+				  mEnd(nullptr)
+			{
+			}
+
+			/**
+			 * \brief Constructs a view of the moves in [\p begin, \p end).
+			 */
+			PieceMoveRange(const PieceMove* begin, const PieceMove* end)
+				: mBegin(begin),
+				  mEnd(end)
+			{
+			}
+
+			const_iterator begin() const
+			{
+				return mBegin;
+			}
+
+			const_iterator end() const
+			{
+				return mEnd;
+			}
+
+			size_t size() const
+			{
+				return static_cast<size_t>(mEnd - mBegin);
+			}
+
+			bool empty() const
+			{
+				return mBegin == mEnd;
+			}
+
+			const PieceMove& operator[](const size_t index) const
+			{
+				return mBegin[index];
+			}
+
+		private:
+			const PieceMove* mBegin;
+			const PieceMove* mEnd;
+	};
+}
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef POLYGLOT_BOOK_H_2E0CD59C_CC47_49C4_B89F_50CECCDA96BF
+#define POLYGLOT_BOOK_H_2E0CD59C_CC47_49C4_B89F_50CECCDA96BF
+
+#include <cpp/simplechess/Game.h>
+#include <cpp/simplechess/GameStage.h>
+#include <cpp/simplechess/PieceMove.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace simplechess
+{
+	namespace details
+	{
+		class MappedFile;
+	}
+
+	/**
+	 * \brief The 781 random numbers from which Polyglot keys are built.
+	 *
+	 * Entries 0 to 767 are for a piece on a square, 768 to 771 for the
+	 * castling rights, 772 to 779 for the file of the en passant target and
+	 * 780 for white to move, as laid out by the Polyglot book format.
+	 * Books made by Polyglot and compatible tools use the \c Random64 array
+	 * published with the format (see \ref polyglotRandom64()).
+	 */
+	using PolyglotRandom64 = std::array<uint64_t, 781>;
+
+	/**
+	 * \brief Returns the \c Random64 array published with the Polyglot
+	 * format.
+	 */
+	const PolyglotRandom64& polyglotRandom64();
+
+	/**
+	 * \brief Returns the Polyglot key of \p stage, built from \p
+	 * random64.
+	 *
+	 * As required by the format, the en passant file only counts if a pawn
+	 * of the active color is next to the pawn which just moved, even if the
+	 * capture would not be legal.
+	 */
+	uint64_t polyglotKey(const GameStage& stage, const PolyglotRandom64& random64);
+
+	/**
+	 * \brief Returns the Polyglot key of \p stage, as found in the books
+	 * made by Polyglot and compatible tools.
+	 */
+	uint64_t polyglotKey(const GameStage& stage);
+
+	/**
+	 * \brief A move found in a \ref PolyglotBook.
+	 */
+	struct BookMove
+	{
+		PieceMove move;
+
+		/**
+		 * \brief How often the move should be played, relative to the
+		 * other moves of the same position.
+		 */
+		uint16_t weight;
+	};
+
+	/**
+	 * \brief An opening book in the Polyglot \c .bin format.
+	 *
+	 * The file is mapped into memory and searched in place: nothing is read
+	 * up front and the entries are never copied. Lookups do not modify the
+	 * book, and copies share the same mapping, so a single book can serve
+	 * any number of games from any number of threads.
+	 */
+	class PolyglotBook
+	{
+		public:
+			/**
+			 * \brief Size in bytes of an entry of the book.
+			 */
+			static constexpr size_t EntrySize = 16;
+
+			/**
+			 * \brief Maps the book at \p path, whose keys are built from
+			 * the \c Random64 array published with the format.
+			 *
+			 * \throws std::system_error if the file cannot be mapped.
+			 * \throws std::invalid_argument if its size is not a whole
+			 * number of entries.
+			 */
+			explicit PolyglotBook(const std::string& path);
+
+			/**
+			 * \brief Maps the book at \p path, whose keys are built from
+			 * \p random64.
+			 *
+			 * The entries must be sorted by key, as in every Polyglot
+			 * book.
+			 *
+			 * \throws std::system_error if the file cannot be mapped.
+			 * \throws std::invalid_argument if its size is not a whole
+			 * number of entries.
+			 */
+			PolyglotBook(const std::string& path, const PolyglotRandom64& random64);
+
+			/**
+			 * \brief The number of entries of the book.
+			 */
+			size_t size() const;
+
+			/**
+			 * \brief Returns the book moves for the current stage of \p
+			 * game, in the order of the book.
+			 *
+			 * Entries which are not among the available moves of \p game
+			 * (e.g. because of a collision of keys) and entries with a
+			 * weight of 0 are left out.
+			 */
+			std::vector<BookMove> moves(const Game& game) const;
+
+			/**
+			 * \brief Chooses one of the book moves for \p game with a
+			 * probability proportional to its weight, or nothing if the
+			 * book has no move for it.
+			 *
+			 * \param game The game to choose a move for.
+			 * \param random Any uniformly distributed random number, e.g.
+			 * from \c std::mt19937_64.
+			 */
+			std::optional<PieceMove> chooseMove(const Game& game, uint64_t random) const;
+
+		private:
+			std::shared_ptr<const details::MappedFile> mFile;
+			std::shared_ptr<const PolyglotRandom64> mRandom64;
+	};
+}
+
+#endif
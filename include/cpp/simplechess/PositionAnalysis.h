@@ -0,0 +1,65 @@
+#ifndef POSITION_ANALYSIS_H_6D1F3A87_C25B_4E90_A7D4_0B8E52F9C163
+#define POSITION_ANALYSIS_H_6D1F3A87_C25B_4E90_A7D4_0B8E52F9C163
+
+#include <cpp/simplechess/Color.h>
+#include <cpp/simplechess/PieceMove.h>
+#include <cpp/simplechess/PlayedMove.h>
+
+#include <string>
+#include <vector>
+
+namespace simplechess
+{
+	/**
+	 * \brief The legal moves and check status of a single position, with
+	 * no game around it.
+	 */
+	struct PositionAnalysis
+	{
+		/**
+		 * \brief The color whose turn it is to play.
+		 */
+		Color activeColor;
+
+		/**
+		 * \brief Whether the active color is in check or checkmated.
+		 */
+		CheckType checkStatus;
+
+		/**
+		 * \brief All the legal moves of the active color, in the same
+		 * order as in \ref Game::allAvailableMoves().
+		 */
+		std::vector<PieceMove> availableMoves;
+
+		bool isCheckmate() const
+		{
+			return checkStatus == CheckType::CheckMate;
+		}
+
+		bool isStalemate() const
+		{
+			return checkStatus == CheckType::NoCheck && availableMoves.empty();
+		}
+	};
+
+	/**
+	 * \brief Returns the legal moves and check status of the position
+	 * described by \p fen.
+	 *
+	 * The FEN string is parsed straight into the internal representation
+	 * of the library, without building a \ref Game, so this is much
+	 * cheaper than \ref createGameFromFen() when only the moves of a
+	 * position are needed. The position is validated in the same way.
+	 *
+	 * \note Draws are not evaluated, since most of the draw rules depend
+	 * on the history of the game. A stalemate is reported through \ref
+	 * PositionAnalysis::isStalemate().
+	 *
+	 * \throws std::invalid_argument if \p fen is not a valid FEN string or
+	 * does not describe a valid position.
+	 */
+	PositionAnalysis analyzePosition(const std::string& fen);
+}
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef POSITION_INDEX_H_6F1A0C3E_94B2_4D57_8E61_B0D7C24A59E3
+#define POSITION_INDEX_H_6F1A0C3E_94B2_4D57_8E61_B0D7C24A59E3
+
+#include <cpp/simplechess/Game.h>
+#include <cpp/simplechess/GameStage.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace simplechess
+{
+	namespace details
+	{
+		class MappedFile;
+	}
+
+	/**
+	 * \brief A game which reached a position, as found in a \ref
+	 * PositionIndex.
+	 */
+	struct PositionPosting
+	{
+		/**
+		 * \brief The identifier the game was added with.
+		 */
+		uint64_t gameId;
+
+		/**
+		 * \brief The number of half-moves played when the position was
+		 * reached, starting at 0 for the initial position of the game.
+		 */
+		uint32_t ply;
+
+		bool operator==(const PositionPosting& other) const
+		{
+			return gameId == other.gameId && ply == other.ply;
+		}
+
+		bool operator!=(const PositionPosting& other) const
+		{
+			return !(*this == other);
+		}
+	};
+
+	/**
+	 * \brief Options of a \ref PositionIndexBuilder.
+	 */
+	struct PositionIndexOptions
+	{
+		/**
+		 * \brief The number of threads to replay games with, or 0 to use
+		 * one per hardware thread.
+		 */
+		unsigned threads = 0;
+
+		/**
+		 * \brief Approximate maximum number of bytes of postings kept in
+		 * memory. Beyond that, they are sorted and moved to temporary
+		 * files next to the index, which are merged at the end.
+		 */
+		size_t memoryLimit = 256 * 1024 * 1024;
+	};
+
+	/**
+	 * \brief Writes the index of the positions reached by a collection of
+	 * games, to be queried with \ref PositionIndex.
+	 *
+	 * Games are replayed in parallel and every position they go through
+	 * is recorded along with the game and the ply. The records are sorted
+	 * externally, so the memory used does not grow with the number of
+	 * games.
+	 *
+	 * Games can be added from several threads at once.
+	 */
+	class PositionIndexBuilder
+	{
+		public:
+			/**
+			 * \brief Largest game identifier which can be indexed.
+			 */
+			static constexpr uint64_t MaxGameId = (uint64_t(1) << 40) - 1;
+
+			/**
+			 * \brief Largest number of half-moves of an indexed game.
+			 */
+			static constexpr uint32_t MaxPly = (uint32_t(1) << 24) - 1;
+
+			/**
+			 * \brief Constructor.
+			 *
+			 * \param path The path of the index, which is written by
+			 * \ref finish().
+			 * \param options The options of the builder.
+			 */
+			explicit PositionIndexBuilder(
+					const std::string& path,
+					const PositionIndexOptions& options = {});
+
+			PositionIndexBuilder(const PositionIndexBuilder&) = delete;
+			PositionIndexBuilder& operator=(const PositionIndexBuilder&) = delete;
+
+			/**
+			 * \brief Destructor. Removes any temporary file.
+			 */
+			~PositionIndexBuilder();
+
+			/**
+			 * \brief Adds every game of \p games, with consecutive
+			 * identifiers starting at \p firstGameId.
+			 *
+			 * \throws std::invalid_argument if an identifier is larger
+			 * than \ref MaxGameId or a game is longer than \ref MaxPly.
+			 * \throws std::system_error if a temporary file cannot be
+			 * written.
+			 * \throws IllegalStateException if the index was already
+			 * written.
+			 */
+			void add(const std::vector<Game>& games, uint64_t firstGameId);
+
+			/**
+			 * \brief Adds every game of the PGN database in the file at
+			 * \p path, with identifiers \p firstGameId plus their index
+			 * in the database. Games which cannot be replayed are
+			 * skipped.
+			 *
+			 * \throws std::invalid_argument if an identifier is larger
+			 * than \ref MaxGameId or a game is longer than \ref MaxPly.
+			 * \throws std::system_error if the database cannot be mapped
+			 * or a temporary file cannot be written.
+			 * \throws IllegalStateException if the index was already
+			 * written.
+			 *
+			 * \return The number of games in the database.
+			 */
+			size_t addPgnFile(const std::string& path, uint64_t firstGameId);
+
+			/**
+			 * \brief Writes the index. No game can be added afterwards.
+			 *
+			 * \throws std::system_error if the index cannot be written.
+			 * \throws IllegalStateException if it was already written.
+			 */
+			void finish();
+
+		private:
+			void add(uint64_t gameId, const Game& game);
+			void spill();
+
+			std::string mPath;
+			PositionIndexOptions mOptions;
+
+			std::mutex mMutex;
+			std::vector<std::pair<uint64_t, uint64_t>> mPostings;
+			std::vector<std::string> mRuns;
+			bool mFinished;
+	};
+
+	/**
+	 * \brief The index of the positions reached by a collection of games,
+	 * written by a \ref PositionIndexBuilder.
+	 *
+	 * The postings are sorted by the hash of their position and searched
+	 * in the mapped file. Only every 256th hash is kept in memory, so that
+	 * a query reads a single page of the file. Queries do not modify the
+	 * index, and copies share the same mapping, so an index can be
+	 * queried from several threads.
+	 */
+	class PositionIndex
+	{
+		public:
+			/**
+			 * \brief Maps the index at \p path.
+			 *
+			 * \throws std::system_error if the file cannot be mapped.
+			 * \throws std::invalid_argument if it is not a valid index.
+			 */
+			explicit PositionIndex(const std::string& path);
+
+			/**
+			 * \brief The number of postings in the index.
+			 */
+			size_t size() const;
+
+			/**
+			 * \brief Returns the games which reached \p stage, sorted by
+			 * game and ply.
+			 *
+			 * Positions are the same if they are for the purpose of the
+			 * n-fold repetition rule, so the move counters of \p stage do
+			 * not matter. They are identified by a 64-bit hash, so a
+			 * different position can very rarely be reported too.
+			 */
+			std::vector<PositionPosting> find(const GameStage& stage) const;
+
+		private:
+			std::shared_ptr<const details::MappedFile> mFile;
+			std::shared_ptr<const std::vector<uint64_t>> mFences;
+			size_t mSize;
+	};
+}
+
+#endif
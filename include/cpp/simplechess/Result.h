@@ -0,0 +1,104 @@
+#ifndef RESULT_H_2C8F4B17_9E3A_4D60_A5B2_7F1E0C93D846
+#define RESULT_H_2C8F4B17_9E3A_4D60_A5B2_7F1E0C93D846
+
+#include <optional>
+#include <utility>
+
+namespace simplechess
+{
+	/**
+	 * \brief Reasons why an operation reporting a \ref Result may fail.
+	 */
+	enum class ErrorCode
+	{
+		/**
+		 * The string is not a valid FEN string.
+		 */
+		InvalidFen,
+
+		/**
+		 * The FEN string is well formed, but the position it describes
+		 * cannot be the stage of a game.
+		 */
+		InvalidPosition,
+
+		/**
+		 * The game has already concluded.
+		 */
+		GameFinished,
+
+		/**
+		 * The move is not valid for the current player.
+		 */
+		IllegalMove
+	};
+
+	/**
+	 * \brief Either the value produced by an operation or the \ref
+	 * ErrorCode describing why it failed.
+	 *
+	 * Operations returning a \c Result report their errors without
+	 * throwing exceptions, so they are suited for code which validates
+	 * large amounts of untrusted input.
+	 */
+	template <typename T>
+	class Result
+	{
+		public:
+			/**
+			 * \brief Constructs a successful result holding \p value.
+			 */
+			Result(T value)
+				: mValue(std::move(value)),
+				  mError()
+			{
+			}
+
+			/**
+			 * \brief Constructs a failed result.
+			 */
+			Result(ErrorCode error)
+				: mValue(),
+				  mError(error)
+			{
+			}
+
+			/**
+			 * \brief Whether the operation succeeded.
+			 */
+			bool ok() const
+			{
+				return mValue.has_value();
+			}
+
+			explicit operator bool() const
+			{
+				return ok();
+			}
+
+			/**
+			 * \brief The value produced by the operation.
+			 *
+			 * \throws std::bad_optional_access if the operation failed.
+			 */
+			const T& value() const
+			{
+				return mValue.value();
+			}
+
+			/**
+			 * \brief The reason why the operation failed. Only meaningful
+			 * if \ref ok() is \c false.
+			 */
+			ErrorCode error() const
+			{
+				return mError;
+			}
+
+		private:
+			std::optional<T> mValue;
+			ErrorCode mError;
+	};
+}
+
+#endif
@@ -0,0 +1,185 @@
+#ifndef SEARCH_H_8D2F6A41_B73C_4E19_A5D0_3C9E71B84F26
+#define SEARCH_H_8D2F6A41_B73C_4E19_A5D0_3C9E71B84F26
+
+#include <cpp/simplechess/Game.h>
+#include <cpp/simplechess/GameStage.h>
+#include <cpp/simplechess/PieceMove.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace simplechess
+{
+	/**
+	 * \brief Limits of \ref findBestMove().
+	 *
+	 * The search stops as soon as any of the limits which are set is
+	 * reached. If none of \ref depth, \ref nodes and \ref time is set, the
+	 * search stops at \ref DefaultDepth.
+	 */
+	struct SearchLimits
+	{
+		/**
+		 * \brief Depth searched when no other limit is given.
+		 */
+		static constexpr unsigned DefaultDepth = 6;
+
+		/**
+		 * \brief Maximum depth to search, in plies, or 0 for no limit.
+		 */
+		unsigned depth = 0;
+
+		/**
+		 * \brief Approximate maximum number of positions to visit, or 0
+		 * for no limit.
+		 */
+		uint64_t nodes = 0;
+
+		/**
+		 * \brief Maximum time to search for, or 0 for no limit.
+		 */
+		std::chrono::milliseconds time = std::chrono::milliseconds(0);
+
+		/**
+		 * \brief The number of threads to use, or 0 to use one per
+		 * hardware thread.
+		 */
+		unsigned threads = 0;
+
+		/**
+		 * \brief Size in bytes of the transposition table shared by all
+		 * threads.
+		 */
+		size_t hashSize = 16 * 1024 * 1024;
+	};
+
+	/**
+	 * \brief Result of \ref findBestMove().
+	 */
+	struct SearchResult
+	{
+		/**
+		 * \brief The best move found.
+		 */
+		PieceMove bestMove;
+
+		/**
+		 * \brief Score of the position in centipawns, from the point of
+		 * view of the player to move.
+		 */
+		int score;
+
+		/**
+		 * \brief If the search found a forced mate, the number of moves
+		 * until mate: positive if the player to move mates, negative if
+		 * they are mated.
+		 */
+		std::optional<int> mateIn;
+
+		/**
+		 * \brief The last depth which was searched completely.
+		 */
+		unsigned depth;
+
+		/**
+		 * \brief Number of positions visited by all threads.
+		 */
+		uint64_t nodes;
+
+		/**
+		 * \brief The sequence of moves the search expects to be played,
+		 * starting with \ref bestMove.
+		 */
+		std::vector<PieceMove> principalVariation;
+	};
+
+	/**
+	 * \brief Searches for the best move for the player whose turn it is to
+	 * play.
+	 *
+	 * The search is a principal variation search with iterative deepening,
+	 * a transposition table, killer and history move ordering and a
+	 * quiescence search of captures. With several threads, every thread
+	 * searches the whole tree and they share the transposition table
+	 * (Lazy SMP). The threads are started by the first search with a given
+	 * number of threads and reused by the later ones, and concurrent
+	 * searches with the same number of threads run one after the other.
+	 *
+	 * Draws follow the same rules as the rest of the library: stalemate,
+	 * insufficient material and the seventy-five-move rule score as draws,
+	 * a player is assumed to claim a draw whenever \ref
+	 * Game::reasonToClaimDraw() would allow it, and a position repeated
+	 * within the search scores as a draw.
+	 *
+	 * \throws IllegalStateException if \p game has already concluded.
+	 *
+	 * \param game The game to search.
+	 * \param limits When to stop searching.
+	 * \return The best move found and its score.
+	 */
+	SearchResult findBestMove(
+			const Game& game,
+			const SearchLimits& limits = SearchLimits());
+
+	/**
+	 * \brief Moves \ref solveMate() considers for the attacker.
+	 */
+	enum class MateMoves
+	{
+		/**
+		 * \brief Only checking moves. Much faster, but it only finds
+		 * mates in which every move of the attacker is a check.
+		 */
+		Checks,
+
+		/**
+		 * \brief Every legal move.
+		 */
+		All
+	};
+
+	/**
+	 * \brief A first move which forces mate.
+	 */
+	struct MateSolution
+	{
+		/**
+		 * \brief The first move of the attacker.
+		 */
+		PieceMove move;
+
+		/**
+		 * \brief Number of moves of the attacker in the shortest forced
+		 * mate which starts with \ref move, counting \ref move itself.
+		 */
+		unsigned moves;
+	};
+
+	/**
+	 * \brief Finds every first move with which the player to move in \p
+	 * stage forces checkmate in at most \p moves moves.
+	 *
+	 * The solver only generates evasions for the defender and, for the
+	 * last move of the attacker, checking moves. It proves or refutes
+	 * every first move (so that a puzzle can be checked to have a unique
+	 * solution), and remembers solved positions so that transpositions
+	 * are only solved once.
+	 *
+	 * Draw rules other than stalemate are ignored.
+	 *
+	 * \param stage The position to solve.
+	 * \param moves Maximum number of moves of the attacker.
+	 * \param attackerMoves Which moves the attacker may play.
+	 * \return The mating first moves, sorted by the length of their
+	 * mates and then in the order of \ref Game::allAvailableMoves().
+	 */
+	std::vector<MateSolution> solveMate(
+			const GameStage& stage,
+			unsigned moves,
+			MateMoves attackerMoves = MateMoves::Checks);
+}
+
+#endif
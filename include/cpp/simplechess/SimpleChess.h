@@ -4,8 +4,11 @@
 #include <cpp/simplechess/Color.h>
 #include <cpp/simplechess/Game.h>
 #include <cpp/simplechess/PieceMove.h>
+#include <cpp/simplechess/Result.h>
 
+#include <memory_resource>
 #include <string>
+#include <vector>
 
 namespace simplechess
 {
@@ -17,11 +20,15 @@ namespace simplechess
 	 * conditions (fivefold repetition, 75-move rule, insufficient
 	 * material) are automatically enforced or only claimable.
 	 * Defaults to \ref DrawEnforcement::Automatic.
+	 * \param resource The memory resource the game, and the games derived
+	 * from it, use for their internal storage and scratch memory (see \ref
+	 * Game).
 	 *
 	 * \return The constructed Game.
 	 */
 	Game createNewGame(
-			DrawEnforcement drawEnforcement = DrawEnforcement::Automatic);
+			DrawEnforcement drawEnforcement = DrawEnforcement::Automatic,
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
 	/**
 	 * \brief Factory method to create a new game from a given board
@@ -44,12 +51,69 @@ namespace simplechess
 	 * \param drawEnforcement Controls whether mandatory FIDE draw
 	 * conditions are automatically enforced or only claimable.
 	 * Defaults to \ref DrawEnforcement::Automatic.
+	 * \param resource The memory resource the game, and the games derived
+	 * from it, use for their internal storage and scratch memory (see \ref
+	 * Game).
 	 *
 	 * \return The constructed Game.
 	 */
 	Game createGameFromFen(
 			const std::string& fen,
-			DrawEnforcement drawEnforcement = DrawEnforcement::Automatic);
+			DrawEnforcement drawEnforcement = DrawEnforcement::Automatic,
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+	/**
+	 * \brief Same as \ref createGameFromFen(), but reports errors without
+	 * throwing exceptions.
+	 *
+	 * \return The constructed Game, \ref ErrorCode::InvalidFen if \p fen
+	 * is not a valid FEN string or \ref ErrorCode::InvalidPosition if it
+	 * describes a position which cannot be the stage of a game.
+	 */
+	Result<Game> tryCreateGameFromFen(
+			const std::string& fen,
+			DrawEnforcement drawEnforcement = DrawEnforcement::Automatic,
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+	/**
+	 * \brief Factory method to create a game from a starting position and
+	 * a list of moves in UCI notation, as in the UCI command "position fen
+	 * <fen> moves <moves>".
+	 *
+	 * The moves are applied on a compact internal representation and
+	 * only the final position is analysed to determine the state of the
+	 * game, so no state or available moves are computed for the
+	 * intermediate positions.
+	 *
+	 * The history of the resulting \ref Game contains the moves which
+	 * were applied, as if they had been played with \ref makeMove(), so
+	 * the n-fold repetition rules also apply to positions repeated after
+	 * further moves.
+	 *
+	 * \throws std::invalid_argument if \p fen is not a valid FEN string
+	 * or if any of \p moves is malformed or not legal in the position in
+	 * which it is played.
+	 * \throws IllegalStateException if the game has finished before all
+	 * of \p uciMoves have been played, as \ref makeMove() would.
+	 *
+	 * \param fen The representation of the initial position in
+	 * Forsyth-Edwards Notation.
+	 * \param uciMoves The moves to apply, in UCI notation (see \ref
+	 * pieceMoveFromUci()).
+	 * \param drawEnforcement Controls whether mandatory FIDE draw
+	 * conditions are automatically enforced or only claimable.
+	 * Defaults to \ref DrawEnforcement::Automatic.
+	 * \param resource The memory resource the game, and the games derived
+	 * from it, use for their internal storage and scratch memory (see \ref
+	 * Game).
+	 *
+	 * \return The constructed Game.
+	 */
+	Game createGameFromUciMoves(
+			const std::string& fen,
+			const std::vector<std::string>& uciMoves,
+			DrawEnforcement drawEnforcement = DrawEnforcement::Automatic,
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
 	/**
 	 * \brief Make a move for the player whose turn it is to play.
@@ -65,13 +129,54 @@ namespace simplechess
 	 * to draw to the opponent, \c false otherwise.
 	 *
 	 * \return A new copy of the Game in which the specified move has
-	 * been played.
+	 * been played. It uses the same memory resource as \p game,
+	 * as do the games returned by \ref tryMakeMove(), \ref claimDraw()
+	 * and \ref resign().
 	 */
 	Game makeMove(
 			const Game& game,
 			const PieceMove& move,
 			bool offerDraw=false);
 
+	/**
+	 * \brief Same as \ref makeMove(), but reports errors without throwing
+	 * exceptions.
+	 *
+	 * \return The new copy of the Game, \ref ErrorCode::GameFinished if
+	 * \p game has already concluded or \ref ErrorCode::IllegalMove if \p
+	 * move is not a valid move for the current player.
+	 */
+	Result<Game> tryMakeMove(
+			const Game& game,
+			const PieceMove& move,
+			bool offerDraw=false);
+
+	/**
+	 * \brief Makes a move in each of many independent games, in parallel.
+	 *
+	 * The \c i-th move of \p moves is made in the \c i-th game of \p
+	 * games as \ref tryMakeMove() does, and its result is the \c i-th
+	 * result returned, whatever the order in which the games are
+	 * processed. The games are shared among the threads by work stealing,
+	 * so the batch takes about as long as its slowest games.
+	 *
+	 * The threads are started by the first call for a given number of
+	 * threads and reused by the later ones. Concurrent calls for the same
+	 * number of threads are processed one after the other.
+	 *
+	 * \throws std::invalid_argument if \p games and \p moves do not have
+	 * the same size.
+	 *
+	 * \param games The games in which to make the moves.
+	 * \param moves The move to make in each game.
+	 * \param threads The number of threads to use, or 0 to use one per
+	 * hardware thread.
+	 */
+	std::vector<Result<Game>> makeMoves(
+			const std::vector<Game>& games,
+			const std::vector<PieceMove>& moves,
+			unsigned threads=0);
+
 	/**
 	 * \brief Claim a draw.
 	 *
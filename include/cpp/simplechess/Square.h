@@ -116,6 +116,8 @@ namespace simplechess
 			std::string toString() const;
 
 		private:
+			friend class SquareBuilder;
+
 			Square(uint8_t rank, char file);
 			uint8_t mRank;
 			char mFile;
@@ -0,0 +1,117 @@
+#ifndef TABLEBASE_H_4B81E7D2_C05A_4F39_9E26_A73D18F0B5C4
+#define TABLEBASE_H_4B81E7D2_C05A_4F39_9E26_A73D18F0B5C4
+
+#include <cpp/simplechess/GameStage.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace simplechess
+{
+	namespace details
+	{
+		class TablebaseData;
+	}
+
+	/**
+	 * \brief Result of a game with perfect play, for the player to move.
+	 */
+	enum class TablebaseOutcome
+	{
+		Loss,
+		Draw,
+		Win
+	};
+
+	/**
+	 * \brief What a \ref Tablebase knows about a position.
+	 */
+	struct TablebaseResult
+	{
+		TablebaseOutcome outcome;
+
+		/**
+		 * \brief Number of plies until checkmate with perfect play
+		 * (the winner mates as soon as possible and the loser delays it
+		 * as long as possible), or 0 for a draw. A checkmated position
+		 * is a loss in 0 plies.
+		 */
+		unsigned pliesToMate;
+	};
+
+	/**
+	 * \brief Exact results of endings with few pieces, computed by
+	 * retrograde analysis.
+	 *
+	 * Endings are named after the pieces of white and then black, each
+	 * starting with its king, e.g. \c KQK, \c KRK, \c KPK, \c KBNK or \c
+	 * KRKP. Each ending covers the same material with the colors swapped
+	 * too. Up to four pieces are supported (kings included), as long as
+	 * only one side has pawns.
+	 *
+	 * Results ignore the fifty-move rule and any draw by repetition.
+	 * Copies share the same tables, which are never modified, so a
+	 * tablebase can be probed from several threads.
+	 */
+	class Tablebase
+	{
+		public:
+			/**
+			 * \brief Generates the tables of \p endings, and of every
+			 * ending they can turn into by a capture or a promotion.
+			 *
+			 * \param endings The endings to generate.
+			 * \param threads The number of threads to use, or 0 to use
+			 * one per hardware thread.
+			 *
+			 * \throws std::invalid_argument if an ending is malformed or
+			 * not supported.
+			 */
+			static Tablebase generate(
+					const std::vector<std::string>& endings,
+					unsigned threads = 0);
+
+			/**
+			 * \brief Maps the tables saved by \ref save() at \p path.
+			 *
+			 * The file is mapped into memory rather than read, so
+			 * loading is almost instant and the tables are shared with
+			 * other processes mapping the same file.
+			 *
+			 * \throws std::system_error if the file cannot be mapped.
+			 * \throws std::invalid_argument if it is not a valid
+			 * tablebase file.
+			 */
+			static Tablebase load(const std::string& path);
+
+			/**
+			 * \brief Saves every table to the file at \p path.
+			 *
+			 * \throws std::system_error if the file cannot be written.
+			 */
+			void save(const std::string& path) const;
+
+			/**
+			 * \brief The endings with a table.
+			 */
+			std::vector<std::string> endings() const;
+
+			/**
+			 * \brief Returns the result of \p stage with perfect play,
+			 * or nothing if no table covers it.
+			 *
+			 * Positions with castling rights are never covered, and
+			 * bare kings are always a draw.
+			 */
+			std::optional<TablebaseResult> probe(const GameStage& stage) const;
+
+		private:
+			explicit Tablebase(std::shared_ptr<const details::TablebaseData> data);
+
+			std::shared_ptr<const details::TablebaseData> mData;
+	};
+}
+
+#endif
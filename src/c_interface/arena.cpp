@@ -0,0 +1,88 @@
+#include "arena.h"
+
+#include <algorithm>
+#include <new>
+
+namespace {
+	constexpr size_t DefaultBlockSize = 256 * 1024;
+
+	size_t align_up(size_t offset, size_t alignment) {
+		return (offset + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+sc_arena::sc_arena(const size_t blockSize)
+	: mBlockSize(blockSize ? blockSize : ::DefaultBlockSize),
+	  mBlocks(),
+	  mCurrentBlock(0),
+	  mOffset(0),
+	  mBytesUsed(0)
+{
+}
+
+void sc_arena::reserve(const size_t size) {
+	// Leave room for the worst alignment padding
+	const size_t needed = size + alignof(std::max_align_t);
+
+	if (mCurrentBlock == mBlocks.size() || mOffset + needed > mBlocks[mCurrentBlock].size) {
+		nextBlock(needed);
+	}
+}
+
+void* sc_arena::allocateBytes(const size_t size, const size_t alignment) {
+	if (mCurrentBlock == mBlocks.size()
+			|| ::align_up(mOffset, alignment) + size > mBlocks[mCurrentBlock].size) {
+		nextBlock(size + alignment);
+	}
+
+	// Blocks are aligned to alignof(std::max_align_t), so aligning the
+	// offset aligns the address
+	const size_t start = ::align_up(mOffset, alignment);
+
+	mBytesUsed += start + size - mOffset;
+	mOffset = start + size;
+
+	return mBlocks[mCurrentBlock].data.get() + start;
+}
+
+void sc_arena::nextBlock(const size_t size) {
+	if (mCurrentBlock < mBlocks.size()) {
+		++mCurrentBlock;
+	}
+
+	mOffset = 0;
+
+	// Blocks left over from before the last reset are reused if they are
+	// large enough
+	for (; mCurrentBlock < mBlocks.size(); ++mCurrentBlock) {
+		if (mBlocks[mCurrentBlock].size >= size) return;
+	}
+
+	const size_t blockSize = std::max(mBlockSize, size);
+	mBlocks.push_back({std::unique_ptr<unsigned char[]>(new unsigned char[blockSize]), blockSize});
+	mCurrentBlock = mBlocks.size() - 1;
+}
+
+void sc_arena::reset() {
+	mCurrentBlock = 0;
+	mOffset = 0;
+	mBytesUsed = 0;
+}
+
+sc_arena* simple_chess_arena_create(size_t block_size) {
+	return new (std::nothrow) sc_arena(block_size);
+}
+
+void simple_chess_arena_reset(sc_arena* arena) {
+	if (!arena) return;
+
+	arena->reset();
+}
+
+size_t simple_chess_arena_bytes_used(const sc_arena* arena) {
+	return arena->bytesUsed();
+}
+
+void simple_chess_arena_destroy(sc_arena* arena) {
+	delete arena;
+}
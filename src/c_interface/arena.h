@@ -0,0 +1,72 @@
+#ifndef ARENA_H_3C9E61B2_4A7D_4F08_B5E3_92D0C6A1F847
+#define ARENA_H_3C9E61B2_4A7D_4F08_B5E3_92D0C6A1F847
+
+#include <c/simplechess/simplechess.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * Bump allocator behind the sc_arena C type. Memory is handed out from a
+ * list of blocks which are only released when the arena is destroyed;
+ * resetting the arena makes all of them available again.
+ */
+struct sc_arena {
+	public:
+		explicit sc_arena(size_t blockSize);
+
+		/**
+		 * Makes sure that \p size bytes can be allocated from the current
+		 * block, so that the following allocations are contiguous.
+		 *
+		 * \throws std::bad_alloc if a new block cannot be allocated.
+		 */
+		void reserve(size_t size);
+
+		/**
+		 * Returns uninitialised, suitably aligned memory for \p count
+		 * objects of type \p T.
+		 *
+		 * \throws std::bad_alloc if a new block cannot be allocated.
+		 */
+		template <typename T>
+		T* allocate(size_t count) {
+			return static_cast<T*>(allocateBytes(count * sizeof(T), alignof(T)));
+		}
+
+		/**
+		 * Makes all the memory of the arena available again.
+		 */
+		void reset();
+
+		/**
+		 * Number of bytes handed out since the arena was created or last
+		 * reset, including alignment padding.
+		 */
+		size_t bytesUsed() const {
+			return mBytesUsed;
+		}
+
+	private:
+		struct Block {
+			std::unique_ptr<unsigned char[]> data;
+			size_t size;
+		};
+
+		size_t mBlockSize;
+		std::vector<Block> mBlocks;
+		size_t mCurrentBlock;
+		size_t mOffset;
+		size_t mBytesUsed;
+
+		void* allocateBytes(size_t size, size_t alignment);
+
+		/**
+		 * Moves to the first block with room for \p size bytes, allocating
+		 * a new one if there is none.
+		 */
+		void nextBlock(size_t size);
+};
+
+#endif
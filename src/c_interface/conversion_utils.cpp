@@ -1,8 +1,11 @@
 #include "conversion_utils.h"
+#include "arena.h"
 #include "cpp/simplechess/SimpleChess.h"
 #include "../core/Builders.h"
 #include "../core/details/fen/FenUtils.h"
 #include <cstring>
+#include <new>
+#include <utility>
 
 // C++ to C conversions
 color_t conversion_utils::c_color(simplechess::Color color) {
@@ -122,7 +125,7 @@ board_t conversion_utils::c_board(const simplechess::Board& board) {
 	for (int i = 0; i < 64; ++i) {
 		uint8_t row = 1 + (i / 8);
 		char col = 'a' + (i % 8);
-		const auto square = simplechess::Square::fromRankAndFile(row, col);
+		const auto square = simplechess::SquareBuilder::build(row, col);
 
 		const auto piece = board.pieceAt(square);
 		result.occupied[i] = piece.has_value();
@@ -214,25 +217,65 @@ draw_enforcement_t conversion_utils::c_draw_enforcement(simplechess::DrawEnforce
 	return DrawEnforcementAutomatic;
 }
 
-game_t* conversion_utils::c_game(const simplechess::Game& game) {
-	game_t* result = new game_t();
+error_code_t conversion_utils::c_error_code(simplechess::ErrorCode error) {
+	switch (error) {
+		case simplechess::ErrorCode::InvalidFen:
+			return ErrorCodeInvalidFen;
+		case simplechess::ErrorCode::InvalidPosition:
+			return ErrorCodeInvalidPosition;
+		case simplechess::ErrorCode::GameFinished:
+			return ErrorCodeGameFinished;
+		case simplechess::ErrorCode::IllegalMove:
+			return ErrorCodeIllegalMove;
+	}
+
+	// Suppress warning
+	return ErrorCodeInvalidArgument;
+}
+
+game_history_entry_t conversion_utils::c_history_entry(const std::pair<simplechess::GameStage, simplechess::PlayedMove>& entry) {
+	game_history_entry_t result;
+	strncpy(result.fen, entry.first.fen().c_str(), sizeof(result.fen) - 1);
+	result.fen[sizeof(result.fen) - 1] = '\0';
+	result.played_move = c_played_move(entry.second);
+	return result;
+}
+
+game_t* conversion_utils::c_game(const simplechess::Game& game, sc_arena* arena) {
+	const uint16_t historySize = static_cast<uint16_t>(game.history().size());
+	const uint16_t availableMoveCount = static_cast<uint16_t>(game.allAvailableMoves().size());
+
+	game_t* result = nullptr;
+	if (arena) {
+		// The game and its arrays are laid out contiguously
+		arena->reserve(sizeof(game_t)
+				+ historySize * sizeof(game_history_entry_t)
+				+ availableMoveCount * sizeof(piece_move_t));
+
+		result = new (arena->allocate<game_t>(1)) game_t();
+		result->arena = arena;
+		if (historySize)
+			result->history = arena->allocate<game_history_entry_t>(historySize);
+		if (availableMoveCount)
+			result->available_moves = arena->allocate<piece_move_t>(availableMoveCount);
+	} else {
+		result = new game_t();
+		if (historySize)
+			result->history = new game_history_entry_t[historySize];
+		if (availableMoveCount)
+			result->available_moves = new piece_move_t[availableMoveCount];
+	}
+
 	result->state = c_game_state(game.gameState());
 	if (game.gameState() == simplechess::GameState::Drawn)
 		result->draw_reason = c_draw_reason(game.drawReason());
 
-	result->history_size = static_cast<uint16_t>(game.history().size());
-	if (result->history_size)
-		result->history = new game_history_entry_t[result->history_size];
-
+	result->history_size = historySize;
 	for (uint16_t i = 0; i < result->history_size; ++i) {
-		strncpy(result->history[i].fen, game.history()[i].first.fen().c_str(), sizeof(result->history[i].fen) - 1);
-		result->history[i].fen[sizeof(result->history[i].fen) - 1] = '\0';
-		result->history[i].played_move = c_played_move(game.history()[i].second);
+		result->history[i] = c_history_entry(game.history()[i]);
 	}
 
-	result->available_move_count = static_cast<uint16_t>(game.allAvailableMoves().size());
-	if (result->available_move_count)
-		result->available_moves = new piece_move_t[result->available_move_count];
+	result->available_move_count = availableMoveCount;
 
 	uint16_t i = 0;
 	for (const auto& pieceMove : game.allAvailableMoves()) {
@@ -248,6 +291,8 @@ game_t* conversion_utils::c_game(const simplechess::Game& game) {
 		}
 	}
 	result->draw_enforcement = c_draw_enforcement(game.drawEnforcement());
+	result->history_capacity = result->history_size;
+	result->available_move_capacity = result->available_move_count;
 
 	return result;
 }
@@ -266,7 +311,7 @@ simplechess::Color conversion_utils::cpp_color(color_t color) {
 }
 
 simplechess::Square conversion_utils::cpp_square(const square_t& square) {
-	return simplechess::Square::fromRankAndFile(
+	return simplechess::SquareBuilder::build(
 			std::clamp<uint8_t>(square.rank, 1, 8),
 			std::clamp<char>(std::tolower(square.file), 'a', 'h'));
 }
@@ -377,7 +422,7 @@ uint8_t conversion_utils::cpp_castling_rights(uint8_t rights) {
 }
 
 simplechess::Board conversion_utils::cpp_board(const board_t& board) {
-	std::map<simplechess::Square, simplechess::Piece> position;
+	std::pmr::map<simplechess::Square, simplechess::Piece> position;
 	for (uint8_t index = 0; index < 64; ++index) {
 		if (!board.occupied[index]) continue;
 		position.insert({
@@ -385,7 +430,7 @@ simplechess::Board conversion_utils::cpp_board(const board_t& board) {
 				cpp_piece(board.piece_at[index])
 				});
 	}
-	return simplechess::BoardBuilder::build(position);
+	return simplechess::BoardBuilder::build(std::move(position));
 }
 
 simplechess::GameStage conversion_utils::cpp_game_stage(const game_stage_t& stage) {
@@ -439,7 +484,7 @@ simplechess::Game conversion_utils::cpp_game(const game_t& game) {
 		? std::make_optional(cpp_draw_reason(game.draw_reason))
 		: std::nullopt;
 
-	std::vector<std::pair<simplechess::GameStage, simplechess::PlayedMove>> history;
+	std::pmr::vector<std::pair<simplechess::GameStage, simplechess::PlayedMove>> history;
 	for (uint16_t index = 0; index < game.history_size; ++index) {
 		history.push_back({
 				simplechess::details::FenUtils::fromFenString(game.history[index].fen),
@@ -447,7 +492,7 @@ simplechess::Game conversion_utils::cpp_game(const game_t& game) {
 	}
 
 	simplechess::GameStage currentStage = cpp_game_stage(game.current_stage);
-	std::set<simplechess::PieceMove> allAvailableMoves;
+	std::pmr::set<simplechess::PieceMove> allAvailableMoves;
 	for (uint16_t index = 0; index < game.available_move_count; ++index) {
 		allAvailableMoves.insert(cpp_piece_move(game.available_moves[index]));
 	}
@@ -462,9 +507,9 @@ simplechess::Game conversion_utils::cpp_game(const game_t& game) {
 	return simplechess::GameBuilder::build(
 			state,
 			drawReason,
-			history,
-			currentStage,
-			allAvailableMoves,
+			std::move(history),
+			std::move(currentStage),
+			std::move(allAvailableMoves),
 			reasonToClaimDraw,
 			drawEnforcement);
 }
@@ -20,7 +20,8 @@ namespace conversion_utils {
 	game_stage_t     c_game_stage(const simplechess::GameStage& stage);
 	game_state_t     c_game_state(simplechess::GameState state);
 	draw_reason_t    c_draw_reason(simplechess::DrawReason reason);
-	game_t*          c_game(const simplechess::Game& game);
+	game_history_entry_t c_history_entry(const std::pair<simplechess::GameStage, simplechess::PlayedMove>& entry);
+	game_t*          c_game(const simplechess::Game& game, sc_arena* arena = nullptr);
 
 	// C to C++ conversions
 	simplechess::Color         cpp_color(color_t color);
@@ -38,6 +39,7 @@ namespace conversion_utils {
 	simplechess::DrawReason    cpp_draw_reason(draw_reason_t reason);
 	simplechess::DrawEnforcement cpp_draw_enforcement(draw_enforcement_t enforcement);
 	draw_enforcement_t         c_draw_enforcement(simplechess::DrawEnforcement enforcement);
+	error_code_t               c_error_code(simplechess::ErrorCode error);
 	simplechess::Game          cpp_game(const game_t& game);
 } // namespace conversion_utils
 
@@ -0,0 +1,331 @@
+#include <c/simplechess/simplechess.h>
+#include <cpp/simplechess/SimpleChess.h>
+
+#include "conversion_utils.h"
+#include "../core/Builders.h"
+#include "../core/details/AlgebraicNotationGenerator.h"
+#include "../core/details/GameStateDetector.h"
+#include "../core/details/bitboard/Position.h"
+#include "../core/details/fen/FenUtils.h"
+
+#include <new>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace conversion_utils;
+
+/**
+ * The live game behind an sc_game_handle. Moves update it in place: the
+ * history only grows by one entry, and the positions which can still be
+ * repeated are counted incrementally, so a move does not depend on the
+ * length of the game.
+ */
+struct sc_game_handle {
+	/**
+	 * A position reached since the last capture or pawn advance, and the
+	 * relevant fields of its FEN string once it has been reached twice.
+	 */
+	struct Repetition {
+		uint8_t count;
+		std::string fen;
+	};
+
+	explicit sc_game_handle(const simplechess::Game& game);
+
+	/**
+	 * Counts one more time the position of \p stage, whose Zobrist hash is
+	 * \p hash. Leaves the counts unchanged if it throws.
+	 */
+	void countRepetition(uint64_t hash, const simplechess::GameStage& stage);
+
+	simplechess::GameState state;
+	std::optional<simplechess::DrawReason> drawReason;
+	std::optional<simplechess::DrawReason> reasonToClaimDraw;
+	simplechess::DrawEnforcement drawEnforcement;
+	simplechess::details::Position position;
+	simplechess::GameStage stage;
+	std::pmr::set<simplechess::PieceMove> availableMoves;
+	std::pmr::vector<std::pair<simplechess::GameStage, simplechess::PlayedMove>> history;
+
+	// The positions of the history which can still be repeated, by Zobrist
+	// hash, and those reached at least twice, keyed by views into the FEN
+	// strings of the former. Positions reached once cannot make any n-fold
+	// repetition, so they are left out of the latter.
+	std::unordered_map<uint64_t, Repetition> reached;
+	simplechess::details::RepetitionCounts repeated;
+};
+
+sc_game_handle::sc_game_handle(const simplechess::Game& game)
+	: state(game.gameState()),
+	  drawReason(game.gameState() == simplechess::GameState::Drawn
+			  ? std::make_optional(game.drawReason())
+			  : std::nullopt),
+	  reasonToClaimDraw(game.gameState() == simplechess::GameState::Playing
+			  ? game.reasonToClaimDraw()
+			  : std::nullopt),
+	  drawEnforcement(game.drawEnforcement()),
+	  position(simplechess::details::Position::fromStage(game.currentStage())),
+	  stage(game.currentStage()),
+	  availableMoves(game.allAvailableMoves()),
+	  history(game.history()),
+	  reached(),
+	  repeated()
+{
+	// Only the positions since the last capture or pawn advance can be
+	// repeated
+	size_t first = history.size();
+	uint16_t halfmoveClock = stage.halfMovesSinceLastCaptureOrPawnAdvance();
+
+	while (first > 0 && halfmoveClock != 0) {
+		--first;
+		halfmoveClock = history[first].first.halfMovesSinceLastCaptureOrPawnAdvance();
+	}
+
+	for (size_t i = first; i < history.size(); ++i) {
+		const simplechess::GameStage& reachedStage = history[i].first;
+		countRepetition(
+				simplechess::details::Position::fromStage(reachedStage).hash(),
+				reachedStage);
+	}
+}
+
+void sc_game_handle::countRepetition(const uint64_t hash, const simplechess::GameStage& reachedStage) {
+	const auto [it, inserted] = reached.try_emplace(hash);
+	Repetition& repetition = it->second;
+
+	try {
+		if (repetition.count == 1) {
+			repetition.fen = simplechess::details::FenUtils::fenForRepetitions(reachedStage.fen());
+		}
+
+		if (repetition.count >= 1) {
+			repeated[repetition.fen] = static_cast<uint8_t>(repetition.count + 1);
+		}
+	} catch (...) {
+		if (inserted) reached.erase(it);
+		throw;
+	}
+
+	++repetition.count;
+}
+
+namespace {
+	sc_game_handle* new_handle(const simplechess::Game& game) {
+		return new (std::nothrow) sc_game_handle(game);
+	}
+
+	/**
+	 * Plays \p move, which must be legal, on \p handle. The handle is only
+	 * modified once everything which may fail has been done.
+	 */
+	void play(sc_game_handle& handle, const simplechess::details::Move& move, const bool offerDraw) {
+		using namespace simplechess;
+
+		details::Position next = handle.position;
+		next.makeMove(move);
+		GameStage nextStage = next.toStage();
+
+		// As in makeMove, the position being left is not counted yet, and
+		// none of the positions counted can follow a capture or pawn advance
+		const details::RepetitionCounts none;
+		const details::GameStateInformation information = details::GameStateDetector::detect(
+				nextStage,
+				offerDraw,
+				(next.halfmoveClock() == 0) ? none : handle.repeated,
+				handle.drawEnforcement);
+
+		std::pair<GameStage, PlayedMove> entry(
+				handle.stage,
+				PlayedMoveBuilder::build(
+					handle.position.toPieceMove(move),
+					handle.position.pieceAt(move.dst),
+					offerDraw,
+					information.checkType,
+					details::AlgebraicNotationGenerator::toAlgebraicNotation(
+						handle.position,
+						move,
+						offerDraw,
+						information.checkType)));
+
+		std::pmr::set<PieceMove> availableMoves = information.availableMoves;
+		handle.history.reserve(handle.history.size() + 1);
+
+		// After a capture or pawn advance no position counted so far can be
+		// reached again, including the one being left
+		if (next.halfmoveClock() == 0) {
+			handle.repeated.clear();
+			handle.reached.clear();
+		} else {
+			handle.countRepetition(handle.position.hash(), handle.stage);
+		}
+
+		handle.history.push_back(std::move(entry));
+		handle.position = next;
+		handle.stage = std::move(nextStage);
+		handle.availableMoves.swap(availableMoves);
+		handle.state = information.gameState;
+		handle.drawReason = information.reasonItWasDrawn;
+		handle.reasonToClaimDraw = information.reasonToClaimDraw;
+	}
+
+	/**
+	 * Ends the game on \p handle with \p state.
+	 */
+	void finish(
+			sc_game_handle& handle,
+			const simplechess::GameState state,
+			const std::optional<simplechess::DrawReason>& drawReason) {
+		handle.state = state;
+		handle.drawReason = drawReason;
+		handle.reasonToClaimDraw.reset();
+		handle.availableMoves.clear();
+	}
+}
+
+sc_game_handle* simple_chess_handle_create_new_game(draw_enforcement_t draw_enforcement) {
+	try {
+		return new_handle(simplechess::createNewGame(cpp_draw_enforcement(draw_enforcement)));
+	} catch (...) {
+		return nullptr;
+	}
+}
+
+sc_game_handle* simple_chess_handle_create_from_fen(const char* fen, draw_enforcement_t draw_enforcement) {
+	if (!fen) return nullptr;
+
+	try {
+		return new_handle(simplechess::createGameFromFen(fen, cpp_draw_enforcement(draw_enforcement)));
+	} catch (...) {
+		return nullptr;
+	}
+}
+
+sc_game_handle* simple_chess_handle_create_from_game(const game_t* game) {
+	if (!game) return nullptr;
+
+	try {
+		return new_handle(cpp_game(*game));
+	} catch (...) {
+		return nullptr;
+	}
+}
+
+bool simple_chess_handle_make_move(sc_game_handle* handle, piece_move_t move, bool offer_draw) {
+	if (!handle || handle->state != simplechess::GameState::Playing) return false;
+
+	try {
+		using namespace simplechess;
+
+		const PieceMove pieceMove = cpp_piece_move(move);
+		const details::Move internalMove = details::moveFromPieceMove(pieceMove);
+
+		if (!handle->position.isLegal(internalMove)
+				|| !(handle->position.toPieceMove(internalMove) == pieceMove)) {
+			return false;
+		}
+
+		::play(*handle, internalMove, offer_draw);
+		return true;
+	} catch (...) {
+		return false;
+	}
+}
+
+bool simple_chess_handle_claim_draw(sc_game_handle* handle) {
+	if (!handle
+			|| handle->state != simplechess::GameState::Playing
+			|| !handle->reasonToClaimDraw) {
+		return false;
+	}
+
+	::finish(*handle, simplechess::GameState::Drawn, handle->reasonToClaimDraw);
+	return true;
+}
+
+bool simple_chess_handle_resign(sc_game_handle* handle, color_t resigner) {
+	if (!handle || handle->state != simplechess::GameState::Playing) return false;
+
+	::finish(*handle,
+			(cpp_color(resigner) == simplechess::Color::White)
+				? simplechess::GameState::BlackWon
+				: simplechess::GameState::WhiteWon,
+			std::nullopt);
+	return true;
+}
+
+game_state_t simple_chess_handle_state(const sc_game_handle* handle) {
+	return c_game_state(handle->state);
+}
+
+bool simple_chess_handle_draw_reason(const sc_game_handle* handle, draw_reason_t* reason) {
+	if (handle->state != simplechess::GameState::Drawn) return false;
+
+	*reason = c_draw_reason(*handle->drawReason);
+	return true;
+}
+
+bool simple_chess_handle_draw_claimable(const sc_game_handle* handle, draw_reason_t* reason) {
+	if (handle->state != simplechess::GameState::Playing || !handle->reasonToClaimDraw) {
+		return false;
+	}
+
+	*reason = c_draw_reason(*handle->reasonToClaimDraw);
+	return true;
+}
+
+color_t simple_chess_handle_active_color(const sc_game_handle* handle) {
+	return c_color(handle->stage.activeColor());
+}
+
+const char* simple_chess_handle_fen(const sc_game_handle* handle) {
+	return handle->stage.fen().c_str();
+}
+
+void simple_chess_handle_current_stage(const sc_game_handle* handle, game_stage_t* stage) {
+	*stage = c_game_stage(handle->stage);
+}
+
+uint16_t simple_chess_handle_available_moves(const sc_game_handle* handle, piece_move_t* moves, uint16_t capacity) {
+	const std::pmr::set<simplechess::PieceMove>& available = handle->availableMoves;
+
+	uint16_t i = 0;
+	for (auto it = available.begin(); it != available.end() && i < capacity; ++it, ++i) {
+		moves[i] = c_piece_move(*it);
+	}
+
+	return static_cast<uint16_t>(available.size());
+}
+
+uint16_t simple_chess_handle_history_size(const sc_game_handle* handle) {
+	return static_cast<uint16_t>(handle->history.size());
+}
+
+bool simple_chess_handle_history_entry(const sc_game_handle* handle, uint16_t index, game_history_entry_t* entry) {
+	if (index >= handle->history.size()) return false;
+
+	*entry = c_history_entry(handle->history[index]);
+	return true;
+}
+
+game_t* simple_chess_handle_snapshot(const sc_game_handle* handle) {
+	try {
+		return c_game(simplechess::GameBuilder::build(
+					handle->state,
+					handle->drawReason,
+					handle->history,
+					handle->stage,
+					handle->availableMoves,
+					handle->reasonToClaimDraw,
+					handle->drawEnforcement));
+	} catch (...) {
+		return nullptr;
+	}
+}
+
+void simple_chess_handle_destroy(sc_game_handle* handle) {
+	delete handle;
+}
@@ -1,10 +1,386 @@
 #include <c/simplechess/simplechess.h>
+#include <cpp/simplechess/PackedPosition.h>
+#include <cpp/simplechess/PositionAnalysis.h>
 #include <cpp/simplechess/SimpleChess.h>
 
+#include "arena.h"
 #include "conversion_utils.h"
+#include "../core/Builders.h"
+#include "../core/details/AlgebraicNotationGenerator.h"
+#include "../core/details/GameReplayer.h"
+#include "../core/details/GameStateDetector.h"
+#include "../core/details/UciNotation.h"
+#include "../core/details/bitboard/Position.h"
+#include "../core/details/fen/FenUtils.h"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
 
 using namespace conversion_utils;
 
+namespace {
+	/**
+	 * Builds the position of a stage from its board and fields, without
+	 * parsing its FEN string. Returns an empty value if the en passant
+	 * target is not a valid square.
+	 */
+	std::optional<simplechess::details::Position> position_of(const game_stage_t& stage) {
+		uint8_t squares[64] = {};
+		for (uint8_t index = 0; index < 64; ++index) {
+			if (stage.board.occupied[index]) {
+				squares[index] = simplechess::details::pieceCode(
+						cpp_piece_type(stage.board.piece_at[index].type),
+						cpp_color(stage.board.piece_at[index].color));
+			}
+		}
+
+		const std::optional<uint8_t> epSquare = stage.has_en_passant_target
+			? std::optional<uint8_t>(simple_chess_index_from_square(stage.en_passant_target))
+			: std::nullopt;
+
+		if (epSquare && *epSquare >= 64) return std::nullopt;
+
+		return simplechess::details::Position::fromMailbox(
+				squares,
+				cpp_color(stage.active_color),
+				cpp_castling_rights(stage.castling_rights),
+				epSquare,
+				stage.half_moves_since_last_capture_or_pawn_advance,
+				stage.full_moves);
+	}
+
+	/**
+	 * Makes sure that \p array, which holds \p size elements in an
+	 * allocation of \p capacity elements (0 meaning \p size), can hold
+	 * \p needed elements, reallocating it geometrically otherwise. Arrays
+	 * of games allocated from an arena are reallocated from the same
+	 * arena, and the old array is left to be released with it.
+	 */
+	template <typename T>
+	void reserve(sc_arena* arena, T*& array, uint16_t size, uint16_t& capacity, uint32_t needed) {
+		const uint32_t current = std::max(capacity, size);
+		if (needed <= current) {
+			capacity = static_cast<uint16_t>(current);
+			return;
+		}
+
+		const uint32_t grown = std::min<uint32_t>(
+				UINT16_MAX,
+				std::max<uint32_t>(needed, std::max<uint32_t>(16, current * 2)));
+
+		T* result = arena ? arena->allocate<T>(grown) : new T[grown];
+		std::copy(array, array + size, result);
+		if (!arena) delete[] array;
+
+		array = result;
+		capacity = static_cast<uint16_t>(grown);
+	}
+
+	/**
+	 * The positions kept alongside the history of \p game by
+	 * simple_chess_apply_move_inplace(), one per history entry. Only those
+	 * since the last capture or pawn advance are meaningful.
+	 */
+	simplechess::details::ReachedPosition* reached_positions(const game_t& game) {
+		return reinterpret_cast<simplechess::details::ReachedPosition*>(game.reached_positions);
+	}
+
+	/**
+	 * Returns how many times the position with hash \p hash has been
+	 * reached, counting the positions in \p previous and this time.
+	 */
+	uint8_t count_reached(const simplechess::details::ReachedPosition* previous, size_t count, uint64_t hash) {
+		const uint8_t times = simplechess::details::DrawEvaluator::timesReached(previous, count, hash);
+		return (times == UINT8_MAX) ? times : static_cast<uint8_t>(times + 1);
+	}
+
+	/**
+	 * Works out the positions of the history of \p game which can still be
+	 * repeated from their FEN strings, into the matching elements of \p
+	 * reached.
+	 */
+	void count_reached_positions(const game_t& game, simplechess::details::ReachedPosition* reached) {
+		using namespace simplechess;
+
+		uint16_t first = game.history_size;
+		uint16_t halfmoveClock = game.current_stage.half_moves_since_last_capture_or_pawn_advance;
+
+		while (first > 0 && halfmoveClock != 0) {
+			--first;
+			const details::Position position = details::Position::fromStage(
+					details::FenUtils::fromFenString(game.history[first].fen));
+			reached[first].hash = position.hash();
+			halfmoveClock = position.halfmoveClock();
+		}
+
+		for (uint16_t i = first; i < game.history_size; ++i) {
+			reached[i].timesReached = count_reached(reached + first, i - first, reached[i].hash);
+		}
+	}
+
+	/**
+	 * Makes sure that the history of \p game and the positions kept
+	 * alongside it can hold \p needed entries, growing both arrays
+	 * geometrically together and recording the positions the first time.
+	 * The game is left unchanged if it throws.
+	 */
+	void reserve_history(game_t& game, uint32_t needed) {
+		using namespace simplechess;
+
+		details::ReachedPosition* reached = reached_positions(game);
+		const uint32_t current = std::max(game.history_capacity, game.history_size);
+
+		if (reached && needed <= current) {
+			game.history_capacity = static_cast<uint16_t>(current);
+			return;
+		}
+
+		const uint32_t grown = (needed <= current)
+			? current
+			: std::min<uint32_t>(
+					UINT16_MAX,
+					std::max<uint32_t>(needed, std::max<uint32_t>(16, current * 2)));
+
+		std::unique_ptr<details::ReachedPosition[]> ownedReached;
+		std::unique_ptr<game_history_entry_t[]> ownedHistory;
+		details::ReachedPosition* grownReached = nullptr;
+		game_history_entry_t* grownHistory = game.history;
+
+		if (game.arena) {
+			grownReached = game.arena->allocate<details::ReachedPosition>(grown);
+			if (grown > current) grownHistory = game.arena->allocate<game_history_entry_t>(grown);
+		} else {
+			ownedReached.reset(new details::ReachedPosition[grown]);
+			grownReached = ownedReached.get();
+			if (grown > current) {
+				ownedHistory.reset(new game_history_entry_t[grown]);
+				grownHistory = ownedHistory.get();
+			}
+		}
+
+		if (reached) {
+			std::copy(reached, reached + game.history_size, grownReached);
+		} else {
+			count_reached_positions(game, grownReached);
+		}
+
+		if (grownHistory != game.history) {
+			std::copy(game.history, game.history + game.history_size, grownHistory);
+		}
+
+		if (!game.arena) {
+			if (ownedHistory) delete[] game.history;
+			delete[] reached;
+			ownedHistory.release();
+			ownedReached.release();
+		}
+
+		game.history = grownHistory;
+		game.history_capacity = static_cast<uint16_t>(grown);
+		game.reached_positions = reinterpret_cast<sc_reached_position*>(grownReached);
+	}
+
+	/**
+	 * Builds the stage of a game at \p position, whose check status is \p
+	 * checkType, without going through a \ref simplechess::GameStage.
+	 */
+	game_stage_t stage_of(const simplechess::details::Position& position, simplechess::CheckType checkType) {
+		using namespace simplechess;
+
+		game_stage_t stage = {};
+		for (uint8_t index = 0; index < 64; ++index) {
+			const uint8_t code = position.pieceCodeAt(index);
+			stage.board.occupied[index] = (code != details::NoPiece);
+			if (code != details::NoPiece) {
+				stage.board.piece_at[index] = {
+					c_piece_type(details::pieceTypeOf(code)),
+					c_color(details::colorOf(code))};
+			}
+		}
+
+		stage.active_color = c_color(position.activeColor());
+		stage.castling_rights = c_castling_rights(position.castlingRights());
+		stage.half_moves_since_last_capture_or_pawn_advance = position.halfmoveClock();
+		stage.full_moves = position.fullmoveCounter();
+
+		const std::optional<uint8_t> epSquare = position.enPassantSquare();
+		stage.has_en_passant_target = epSquare.has_value();
+		if (epSquare) {
+			stage.en_passant_target = simple_chess_square_from_index(*epSquare);
+		}
+
+		stage.check_status = c_check_type(checkType);
+
+		char fen[details::FenUtils::MaxFenLength + 1];
+		const size_t length = details::FenUtils::generateFen(position, fen);
+		const size_t copied = std::min(length, sizeof(stage.fen) - 1);
+		std::copy(fen, fen + copied, stage.fen);
+		stage.fen[copied] = '\0';
+
+		return stage;
+	}
+
+	/**
+	 * Returns the move described by an element of the sequence given to
+	 * apply_moves(), if it is legal in \p position.
+	 */
+	std::optional<simplechess::details::Move> legal_move(
+			const simplechess::details::Position& position,
+			const simplechess::PieceMove& pieceMove) {
+		const simplechess::details::Move move = simplechess::details::moveFromPieceMove(pieceMove);
+
+		if (!position.isLegal(move) || !(position.toPieceMove(move) == pieceMove)) {
+			return std::nullopt;
+		}
+
+		return move;
+	}
+
+	std::optional<simplechess::details::Move> legal_move(
+			const simplechess::details::Position& position,
+			const std::string& uci) {
+		return simplechess::details::UciNotation::parse(position, uci);
+	}
+
+	/**
+	 * Plays every move on a single replayer and only builds the resulting
+	 * game once, at the end. Returns NULL if any move cannot be played,
+	 * setting \p failed_index to the index of the first one.
+	 */
+	template <typename T>
+	game_t* apply_moves(sc_arena* arena, const simplechess::Game& initialGame, const std::vector<T>& moves, size_t& failed_index) {
+		using namespace simplechess;
+
+		if (moves.empty()) return c_game(initialGame, arena);
+		if (initialGame.history().size() + moves.size() > UINT16_MAX) return nullptr;
+
+		if (initialGame.gameState() != GameState::Playing) {
+			failed_index = 0;
+			return nullptr;
+		}
+
+		details::GameReplayer replayer(initialGame, true);
+
+		for (size_t i = 0; i < moves.size(); ++i) {
+			const std::optional<details::Move> move = !replayer.hasFinished()
+				? legal_move(replayer.position(), moves[i])
+				: std::nullopt;
+
+			if (!move) {
+				failed_index = i;
+				return nullptr;
+			}
+
+			replayer.play(*move);
+		}
+
+		return c_game(replayer.build(), arena);
+	}
+
+	game_t* apply_piece_moves(sc_arena* arena, const game_t* game, const piece_move_t* moves, size_t n, size_t* failed_index) {
+		if (!game || (!moves && n != 0)) return nullptr;
+
+		size_t failed = n;
+		game_t* result = nullptr;
+
+		try {
+			using namespace simplechess;
+
+			std::vector<PieceMove> pieceMoves;
+			pieceMoves.reserve(n);
+			for (size_t i = 0; i < n; ++i) {
+				try {
+					pieceMoves.push_back(cpp_piece_move(moves[i]));
+				} catch (...) {
+					// A move which cannot be converted fails like an illegal one
+					failed = i;
+					throw;
+				}
+			}
+
+			result = apply_moves(arena, cpp_game(*game), pieceMoves, failed);
+		} catch (...) {
+			result = nullptr;
+		}
+
+		if (!result && failed_index) *failed_index = failed;
+		return result;
+	}
+
+	game_t* apply_uci_moves(sc_arena* arena, const game_t* game, const char* uci_moves, size_t* failed_index) {
+		if (!game || !uci_moves) return nullptr;
+
+		size_t failed = 0;
+		game_t* result = nullptr;
+
+		try {
+			std::vector<std::string> tokens;
+			std::istringstream input(uci_moves);
+			for (std::string token; input >> token;) {
+				tokens.push_back(token);
+			}
+
+			failed = tokens.size();
+			result = apply_moves(arena, cpp_game(*game), tokens, failed);
+		} catch (...) {
+			result = nullptr;
+		}
+
+		if (!result && failed_index) *failed_index = failed;
+		return result;
+	}
+
+	bool is_on_board(const square_t& square) {
+		return simplechess::Square::isInsideBoundaries(square.rank, square.file);
+	}
+
+	error_code_t try_create_game(sc_arena* arena, const char* fen, draw_enforcement_t draw_enforcement, game_t** game) {
+		if (!fen || !game) return ErrorCodeInvalidArgument;
+
+		try {
+			const simplechess::Result<simplechess::Game> created
+				= simplechess::tryCreateGameFromFen(fen, cpp_draw_enforcement(draw_enforcement));
+			if (!created) return c_error_code(created.error());
+
+			*game = c_game(created.value(), arena);
+			return ErrorCodeNone;
+		} catch (...) {
+			return ErrorCodeOutOfMemory;
+		}
+	}
+
+	error_code_t try_make_move(sc_arena* arena, const game_t* game, piece_move_t move, bool offer_draw, game_t** result) {
+		if (!game || !result) return ErrorCodeInvalidArgument;
+		if (game->state != GameStatePlaying) return ErrorCodeGameFinished;
+		if (!is_on_board(move.src) || !is_on_board(move.dst)) return ErrorCodeIllegalMove;
+
+		std::optional<simplechess::Game> cppGame;
+		try {
+			cppGame = cpp_game(*game);
+		} catch (const std::bad_alloc&) {
+			return ErrorCodeOutOfMemory;
+		} catch (...) {
+			return ErrorCodeInvalidArgument;
+		}
+
+		try {
+			const simplechess::Result<simplechess::Game> updated
+				= simplechess::tryMakeMove(*cppGame, cpp_piece_move(move), offer_draw);
+			if (!updated) return c_error_code(updated.error());
+
+			*result = c_game(updated.value(), arena);
+			return ErrorCodeNone;
+		} catch (...) {
+			return ErrorCodeOutOfMemory;
+		}
+	}
+}
+
 game_t* simple_chess_create_new_game() {
 	try {
 		return c_game(simplechess::createNewGame());
@@ -22,71 +398,232 @@ game_t* simple_chess_create_new_game_ex(draw_enforcement_t draw_enforcement) {
 }
 
 game_t* simple_chess_create_game_from_fen(const char* fen) {
-	if (!fen) return nullptr;
-
-	try {
-		return c_game(simplechess::createGameFromFen(fen));
-	} catch (...) {
-		return nullptr;
-	}
+	return simple_chess_create_game_from_fen_ex(fen, DrawEnforcementAutomatic);
 }
 
 game_t* simple_chess_create_game_from_fen_ex(const char* fen, draw_enforcement_t draw_enforcement) {
-	if (!fen) return nullptr;
+	game_t* game = nullptr;
+	try_create_game(nullptr, fen, draw_enforcement, &game);
+	return game;
+}
+
+game_t* simple_chess_make_move(const game_t* game, piece_move_t move) {
+	return simple_chess_make_move_with_draw_offer(game, move, false);
+}
+
+game_t* simple_chess_make_move_with_draw_offer(const game_t* game, piece_move_t move, bool offer_draw) {
+	game_t* result = nullptr;
+	try_make_move(nullptr, game, move, offer_draw, &result);
+	return result;
+}
+
+error_code_t simple_chess_try_create_game_from_fen(const char* fen, draw_enforcement_t draw_enforcement, game_t** game) {
+	return try_create_game(nullptr, fen, draw_enforcement, game);
+}
+
+error_code_t simple_chess_try_make_move(const game_t* game, piece_move_t move, bool offer_draw, game_t** result) {
+	return try_make_move(nullptr, game, move, offer_draw, result);
+}
+
+bool simple_chess_apply_move_inplace(game_t* game, piece_move_t move) {
+	return simple_chess_apply_move_inplace_with_draw_offer(game, move, false);
+}
+
+bool simple_chess_apply_move_inplace_with_draw_offer(game_t* game, piece_move_t move, bool offer_draw) {
+	if (!game || game->state != GameStatePlaying || game->history_size == UINT16_MAX) return false;
 
 	try {
-		return c_game(simplechess::createGameFromFen(fen, cpp_draw_enforcement(draw_enforcement)));
+		using namespace simplechess;
+
+		const std::optional<details::Position> position = position_of(game->current_stage);
+		if (!position) return false;
+
+		const PieceMove pieceMove = cpp_piece_move(move);
+		const details::Move internalMove = details::moveFromPieceMove(pieceMove);
+
+		if (!position->isLegal(internalMove)
+				|| !(position->toPieceMove(internalMove) == pieceMove)) {
+			return false;
+		}
+
+		details::Position next = *position;
+		next.makeMove(internalMove);
+
+		details::MoveList legalMoves;
+		next.legalMoves(legalMoves);
+
+		// Grow the arrays before modifying anything, so that the game is
+		// left unchanged if the allocation fails
+		reserve_history(*game, game->history_size + 1u);
+		reserve(game->arena, game->available_moves, game->available_move_count, game->available_move_capacity,
+				static_cast<uint32_t>(legalMoves.size));
+
+		// Only the positions reached since the last capture or pawn move
+		// can be repeated. As in makeMove, the position being left is not
+		// counted yet
+		details::ReachedPosition* const reached = reached_positions(*game);
+		const uint16_t reversible = std::min<uint16_t>(game->history_size, position->halfmoveClock());
+		const details::ReachedPosition* const previous = reached + (game->history_size - reversible);
+
+		const details::PositionStateInformation information = details::GameStateDetector::detect(
+				next,
+				legalMoves,
+				offer_draw,
+				previous,
+				(next.halfmoveClock() != 0) ? reversible : 0,
+				cpp_draw_enforcement(game->draw_enforcement));
+
+		game_history_entry_t& entry = game->history[game->history_size];
+		std::copy(std::begin(game->current_stage.fen), std::end(game->current_stage.fen), entry.fen);
+
+		const std::optional<Piece> captured = position->pieceAt(internalMove.dst);
+		entry.played_move = {};
+		entry.played_move.move = c_piece_move(pieceMove);
+		entry.played_move.is_capture = captured.has_value();
+		if (captured) {
+			entry.played_move.captured_piece = c_piece(*captured);
+		}
+		entry.played_move.check_type = c_check_type(information.checkType);
+		entry.played_move.offers_draw = offer_draw;
+
+		char notation[details::AlgebraicNotationGenerator::MaxLength + 1];
+		const size_t length = std::min(
+				details::AlgebraicNotationGenerator::toAlgebraicNotation(
+					*position,
+					internalMove,
+					offer_draw,
+					information.checkType,
+					notation),
+				sizeof(entry.played_move.in_algebraic_notation) - 1);
+		std::copy(notation, notation + length, entry.played_move.in_algebraic_notation);
+		entry.played_move.in_algebraic_notation[length] = '\0';
+
+		reached[game->history_size] = {position->hash(), count_reached(previous, reversible, position->hash())};
+		++game->history_size;
+
+		game->current_stage = stage_of(next, information.checkType);
+
+		// In the same order as the available moves of a Game
+		std::sort(legalMoves.moves, legalMoves.moves + legalMoves.size,
+				[&next](const details::Move& lhs, const details::Move& rhs) {
+					return next.toPieceMove(lhs) < next.toPieceMove(rhs);
+				});
+
+		game->available_move_count = 0;
+		for (const details::Move& available : legalMoves) {
+			game->available_moves[game->available_move_count++] = c_piece_move(next.toPieceMove(available));
+		}
+
+		game->state = c_game_state(information.gameState);
+		if (information.reasonItWasDrawn) {
+			game->draw_reason = c_draw_reason(*information.reasonItWasDrawn);
+		}
+
+		// As in finished Games, no draw can be claimed once the game is over
+		game->is_draw_claimable = information.gameState == GameState::Playing
+			&& information.reasonToClaimDraw.has_value();
+		if (game->is_draw_claimable) {
+			game->reason_to_claim_draw = c_draw_reason(*information.reasonToClaimDraw);
+		}
+
+		return true;
 	} catch (...) {
-		return nullptr;
+		return false;
 	}
 }
 
-game_t* simple_chess_make_move(const game_t* game, piece_move_t move) {
+game_t* simple_chess_apply_moves(const game_t* game, const piece_move_t* moves, size_t n, size_t* failed_index) {
+	return apply_piece_moves(nullptr, game, moves, n, failed_index);
+}
+
+game_t* simple_chess_apply_uci_moves(const game_t* game, const char* uci_moves, size_t* failed_index) {
+	return apply_uci_moves(nullptr, game, uci_moves, failed_index);
+}
+
+game_t* simple_chess_claim_draw(const game_t* game) {
 	if (!game) return nullptr;
 
 	try {
-		return simple_chess_make_move_with_draw_offer(game, move, false);
+		const simplechess::Game cppGame = cpp_game(*game);
+		const simplechess::Game updatedGame = simplechess::claimDraw(cppGame);
+		return c_game(updatedGame);
 	} catch (...) {
 		return nullptr;
 	}
 }
 
-game_t* simple_chess_make_move_with_draw_offer(const game_t* game, piece_move_t move, bool offer_draw) {
+game_t* simple_chess_resign(const game_t* game, color_t resigner) {
 	if (!game) return nullptr;
 
 	try {
 		const simplechess::Game cppGame = cpp_game(*game);
-		const simplechess::Game updatedGame = simplechess::makeMove(cppGame, cpp_piece_move(move), offer_draw);
+		const simplechess::Game updatedGame = simplechess::resign(cppGame, cpp_color(resigner));
 		return c_game(updatedGame);
 	} catch (...) {
 		return nullptr;
 	}
 }
 
-game_t* simple_chess_claim_draw(const game_t* game) {
-	if (!game) return nullptr;
+bool simple_chess_pack_position(const game_stage_t* stage, packed_position_t* packed) {
+	if (!stage || !packed) return false;
 
 	try {
-		const simplechess::Game cppGame = cpp_game(*game);
-		const simplechess::Game updatedGame = simplechess::claimDraw(cppGame);
-		return c_game(updatedGame);
+		const std::optional<simplechess::details::Position> position = position_of(*stage);
+		if (!position) return false;
+
+		position->pack(packed->bytes);
+		return true;
 	} catch (...) {
-		return nullptr;
+		return false;
 	}
 }
 
-game_t* simple_chess_resign(const game_t* game, color_t resigner) {
-	if (!game) return nullptr;
+bool simple_chess_unpack_position(const packed_position_t* packed, game_stage_t* stage) {
+	if (!packed || !stage) return false;
 
 	try {
-		const simplechess::Game cppGame = cpp_game(*game);
-		const simplechess::Game updatedGame = simplechess::resign(cppGame, cpp_color(resigner));
-		return c_game(updatedGame);
+		simplechess::PackedPosition cppPacked;
+		std::copy(packed->bytes, packed->bytes + 32, cppPacked.bytes.begin());
+		*stage = c_game_stage(simplechess::unpackPosition(cppPacked));
+		return true;
+	} catch (...) {
+		return false;
+	}
+}
+
+game_t* simple_chess_create_game_from_packed_position(const packed_position_t* packed, draw_enforcement_t draw_enforcement) {
+	if (!packed) return nullptr;
+
+	try {
+		simplechess::PackedPosition cppPacked;
+		std::copy(packed->bytes, packed->bytes + 32, cppPacked.bytes.begin());
+		return c_game(simplechess::createGameFromPackedPosition(
+					cppPacked,
+					cpp_draw_enforcement(draw_enforcement)));
 	} catch (...) {
 		return nullptr;
 	}
 }
 
+int simple_chess_position_moves(const char* fen, piece_move_t* moves, uint16_t capacity, check_type_t* check_status) {
+	if (!fen || (!moves && capacity != 0)) return -1;
+
+	try {
+		const simplechess::PositionAnalysis analysis = simplechess::analyzePosition(fen);
+
+		const size_t count = std::min<size_t>(capacity, analysis.availableMoves.size());
+		for (size_t i = 0; i < count; ++i) {
+			moves[i] = c_piece_move(analysis.availableMoves[i]);
+		}
+
+		if (check_status) *check_status = c_check_type(analysis.checkStatus);
+
+		return static_cast<int>(analysis.availableMoves.size());
+	} catch (...) {
+		return -1;
+	}
+}
+
 square_t simple_chess_square_from_index(uint8_t index) {
 	uint8_t row = 1 + (index / 8);
 	char col = 'a' + (index % 8);
@@ -101,10 +638,59 @@ uint8_t simple_chess_index_from_square(square_t square) {
 }
 
 void destroy_game(game_t* game) {
-	if (!game) return;
+	if (!game || game->arena) return;
 
 	delete[] game->history;
 	delete[] game->available_moves;
+	delete[] reached_positions(*game);
 	delete game;
 }
 
+game_t* simple_chess_arena_create_new_game(sc_arena* arena, draw_enforcement_t draw_enforcement) {
+	if (!arena) return nullptr;
+
+	try {
+		return c_game(simplechess::createNewGame(cpp_draw_enforcement(draw_enforcement)), arena);
+	} catch (...) {
+		return nullptr;
+	}
+}
+
+game_t* simple_chess_arena_create_game_from_fen(sc_arena* arena, const char* fen, draw_enforcement_t draw_enforcement) {
+	if (!arena) return nullptr;
+
+	game_t* game = nullptr;
+	try_create_game(arena, fen, draw_enforcement, &game);
+	return game;
+}
+
+game_t* simple_chess_arena_copy_game(sc_arena* arena, const game_t* game) {
+	if (!arena || !game) return nullptr;
+
+	try {
+		return c_game(cpp_game(*game), arena);
+	} catch (...) {
+		return nullptr;
+	}
+}
+
+game_t* simple_chess_arena_make_move(sc_arena* arena, const game_t* game, piece_move_t move, bool offer_draw) {
+	if (!arena) return nullptr;
+
+	game_t* result = nullptr;
+	try_make_move(arena, game, move, offer_draw, &result);
+	return result;
+}
+
+game_t* simple_chess_arena_apply_moves(sc_arena* arena, const game_t* game, const piece_move_t* moves, size_t n, size_t* failed_index) {
+	if (!arena) return nullptr;
+
+	return apply_piece_moves(arena, game, moves, n, failed_index);
+}
+
+game_t* simple_chess_arena_apply_uci_moves(sc_arena* arena, const game_t* game, const char* uci_moves, size_t* failed_index) {
+	if (!arena) return nullptr;
+
+	return apply_uci_moves(arena, game, uci_moves, failed_index);
+}
+
@@ -0,0 +1,55 @@
+#include <cpp/simplechess/AttackMaps.h>
+
+#include "details/bitboard/AttackKernels.h"
+#include "details/bitboard/Position.h"
+
+#include <stdexcept>
+
+using namespace simplechess;
+
+void PositionBatch::add(const GameStage& stage)
+{
+	const details::Position position = details::Position::fromStage(stage);
+
+	for (const Color color : {Color::White, Color::Black})
+	{
+		for (size_t type = 0; type < 6; ++type)
+		{
+			pieces[static_cast<size_t>(color)][type].push_back(
+					position.pieces(color, static_cast<PieceType>(type)));
+		}
+	}
+}
+
+AttackMaps simplechess::computeAttackMaps(const PositionBatch& batch)
+{
+	const size_t size = batch.size();
+
+	AttackMaps result;
+	details::attacks::BatchView view;
+	view.size = size;
+
+	for (size_t color = 0; color < 2; ++color)
+	{
+		for (size_t type = 0; type < 6; ++type)
+		{
+			if (batch.pieces[color][type].size() != size)
+			{
+				throw std::invalid_argument(
+						"Every array of a position batch must have the same size");
+			}
+
+			result.byPiece[color][type].resize(size);
+
+			view.pieces[color][type] = batch.pieces[color][type].data();
+			view.pieceAttacks[color][type] = result.byPiece[color][type].data();
+		}
+
+		result.byColor[color].resize(size);
+		view.colorAttacks[color] = result.byColor[color].data();
+	}
+
+	details::attacks::compute(details::attacks::fastestKernel(), view);
+
+	return result;
+}
@@ -1,16 +1,28 @@
 #include <cpp/simplechess/Board.h>
 #include "details/BoardAnalyzer.h"
 
+#include <utility>
+
 using namespace simplechess;
 
-Board::Board(const std::map<Square, Piece>& piecePositions)
-	: mPiecePositions(piecePositions)
+Board::Board(std::pmr::map<Square, Piece> piecePositions)
+	: mPiecePositions(std::move(piecePositions))
+{
+}
+
+Board::Board(const Board& other, const allocator_type& allocator)
+	: mPiecePositions(other.mPiecePositions, allocator)
+{
+}
+
+Board::Board(Board&& other, const allocator_type& allocator)
+	: mPiecePositions(std::move(other.mPiecePositions), allocator)
 {
 }
 
 std::optional<Piece> Board::pieceAt(const Square& square) const
 {
-	const std::map<Square, Piece>::const_iterator it
+	const std::pmr::map<Square, Piece>::const_iterator it
 		= mPiecePositions.find(square);
 	if (it == mPiecePositions.end())
 	{
@@ -22,7 +34,12 @@ std::optional<Piece> Board::pieceAt(const Square& square) const
 	}
 }
 
-const std::map<Square, Piece>& Board::occupiedSquares() const
+const std::pmr::map<Square, Piece>& Board::occupiedSquares() const
 {
 	return mPiecePositions;
 }
+
+Board::allocator_type Board::get_allocator() const
+{
+	return mPiecePositions.get_allocator();
+}
@@ -5,6 +5,8 @@
 #include "details/BoardAnalyzer.h"
 #include "details/MoveValidator.h"
 
+#include <utility>
+
 using namespace simplechess;
 
 GameStage GameStageBuilder::build(
@@ -13,17 +15,9 @@ GameStage GameStageBuilder::build(
 		const uint8_t castlingRights,
 		const uint16_t halfmoveClock,
 		const uint16_t fullmoveClock,
-		const std::optional<Square>& enPassantTarget)
+		const std::optional<Square>& enPassantTarget,
+		const GameStage::allocator_type& allocator)
 {
-	// Generate FEN string
-	const std::string fen = details::FenUtils::generateFen(
-		board,
-		activeColor,
-		castlingRights,
-		enPassantTarget,
-		halfmoveClock,
-		fullmoveClock);
-
 	// Calculate check status
 	const bool isInCheck = details::BoardAnalyzer::isInCheck(board, activeColor);
 	CheckType checkStatus = CheckType::NoCheck;
@@ -36,40 +30,101 @@ GameStage GameStageBuilder::build(
 		checkStatus = (availableMoves.empty()) ? CheckType::CheckMate : CheckType::Check;
 	}
 
-	return GameStage(
+	return build(
+		board,
+		activeColor,
+		castlingRights,
+		halfmoveClock,
+		fullmoveClock,
+		enPassantTarget,
+		checkStatus,
+		allocator);
+}
+
+GameStage GameStageBuilder::build(
+		const Board& board,
+		const Color activeColor,
+		const uint8_t castlingRights,
+		const uint16_t halfmoveClock,
+		const uint16_t fullmoveClock,
+		const std::optional<Square>& enPassantTarget,
+		const CheckType checkStatus,
+		const GameStage::allocator_type& allocator)
+{
+	// Generate FEN string
+	const std::string fen = details::FenUtils::generateFen(
 		board,
 		activeColor,
 		castlingRights,
+		enPassantTarget,
+		halfmoveClock,
+		fullmoveClock);
+
+	return build(
+		Board(board, allocator),
+		activeColor,
+		castlingRights,
+		halfmoveClock,
+		fullmoveClock,
+		enPassantTarget,
+		checkStatus,
+		fen,
+		allocator);
+}
+
+GameStage GameStageBuilder::build(
+		Board board,
+		const Color activeColor,
+		const uint8_t castlingRights,
+		const uint16_t halfmoveClock,
+		const uint16_t fullmoveClock,
+		const std::optional<Square>& enPassantTarget,
+		const CheckType checkStatus,
+		const std::string_view fen,
+		const GameStage::allocator_type& allocator)
+{
+	return GameStage(
+		std::move(board),
+		activeColor,
+		castlingRights,
 		halfmoveClock,
 		fullmoveClock,
 		fen,
 		enPassantTarget,
-		checkStatus);
+		checkStatus,
+		allocator);
 }
 
 Game GameBuilder::build(
 		const GameState gameState,
 		const std::optional<DrawReason>& drawReason,
-		const std::vector<std::pair<GameStage, PlayedMove>>& history,
-		const GameStage& currentStage,
-		const std::set<PieceMove>& allAvailableMoves,
+		std::pmr::vector<std::pair<GameStage, PlayedMove>> history,
+		GameStage currentStage,
+		std::pmr::set<PieceMove> allAvailableMoves,
 		const std::optional<DrawReason>& reasonToClaimDraw,
-		const DrawEnforcement drawEnforcement)
+		const DrawEnforcement drawEnforcement,
+		const Game::allocator_type& allocator)
 {
 	return {
 		gameState,
 		drawReason,
-		history,
-		currentStage,
-		allAvailableMoves,
+		std::move(history),
+		std::move(currentStage),
+		std::move(allAvailableMoves),
 		reasonToClaimDraw,
-		drawEnforcement };
+		drawEnforcement,
+		allocator };
+}
+
+Square SquareBuilder::build(const uint8_t rank, const char file)
+{
+	return {rank, file};
 }
 
 Board BoardBuilder::build(
-		const std::map<Square, Piece> positions)
+		std::pmr::map<Square, Piece> positions)
 {
-	return {positions};
+	return Board(std::move(positions));
 }
 
 PlayedMove PlayedMoveBuilder::build(
@@ -25,7 +25,33 @@ namespace simplechess
 				uint8_t castlingRights,
 				uint16_t halfmoveClock,
 				uint16_t fullmoveClock,
-				const std::optional<Square>& enPassantTarget);
+				const std::optional<Square>& enPassantTarget,
+				const GameStage::allocator_type& allocator = {});
+
+			static GameStage build(
+				const Board& board,
+				Color toPlay,
+				uint8_t castlingRights,
+				uint16_t halfmoveClock,
+				uint16_t fullmoveClock,
+				const std::optional<Square>& enPassantTarget,
+				CheckType checkStatus,
+				const GameStage::allocator_type& allocator = {});
+
+			/**
+			 * Builds a stage whose FEN string is already known, so that
+			 * nothing but \p allocator is allocated from.
+			 */
+			static GameStage build(
+				Board board,
+				Color toPlay,
+				uint8_t castlingRights,
+				uint16_t halfmoveClock,
+				uint16_t fullmoveClock,
+				const std::optional<Square>& enPassantTarget,
+				CheckType checkStatus,
+				std::string_view fen,
+				const GameStage::allocator_type& allocator = {});
 	};
 
 	class GameBuilder
@@ -34,18 +60,34 @@ namespace simplechess
 			static Game build(
 					GameState gameState,
 					const std::optional<DrawReason>& drawReason,
-					const std::vector<std::pair<GameStage, PlayedMove>>& history,
-					const GameStage& currentStage,
-					const std::set<PieceMove>& allAvailableMoves,
+					std::pmr::vector<std::pair<GameStage, PlayedMove>> history,
+					GameStage currentStage,
+					std::pmr::set<PieceMove> allAvailableMoves,
 					const std::optional<DrawReason>& reasonToClaimDraw,
-					DrawEnforcement drawEnforcement = DrawEnforcement::Automatic);
+					DrawEnforcement drawEnforcement = DrawEnforcement::Automatic,
+					const Game::allocator_type& allocator = {});
+	};
+
+	/**
+	 * Builds squares without validating their coordinates, for internal
+	 * code which already knows them to be inside the board (\p file must be
+	 * lowercase).
+	 */
+	class SquareBuilder
+	{
+		public:
+			static Square build(uint8_t rank, char file);
 	};
 
 	class BoardBuilder
 	{
 		public:
+			/**
+			 * Builds a board which allocates from the same resource as \p
+			 * positions.
+			 */
 			static Board build(
-					const std::map<Square, Piece> positions);
+					std::pmr::map<Square, Piece> positions);
 	};
 
 	class PlayedMoveBuilder
@@ -0,0 +1,60 @@
+#include <cpp/simplechess/Evaluation.h>
+
+#include "details/PositionValidator.h"
+#include "details/bitboard/Position.h"
+#include "details/search/Evaluator.h"
+
+#include <stdexcept>
+
+using namespace simplechess;
+
+int simplechess::evaluatePosition(const GameStage& stage)
+{
+	// A single position has nothing to share with others, so there is no
+	// point in caching its pawn structure
+	details::Evaluator evaluator(0);
+	return evaluator.evaluateForWhite(details::Position::fromStage(stage));
+}
+
+std::vector<int> simplechess::evaluatePositions(const std::vector<GameStage>& stages)
+{
+	details::Evaluator evaluator;
+	std::vector<int> result;
+	result.reserve(stages.size());
+
+	for (const GameStage& stage : stages)
+	{
+		result.push_back(evaluator.evaluateForWhite(details::Position::fromStage(stage)));
+	}
+
+	return result;
+}
+
+std::vector<int> simplechess::evaluatePositions(const std::vector<PackedPosition>& positions)
+{
+	details::Evaluator evaluator;
+	std::vector<int> result;
+	result.reserve(positions.size());
+
+	for (const PackedPosition& packed : positions)
+	{
+		const std::optional<details::Position> position
+			= details::Position::unpack(packed.bytes.data());
+
+		if (!position)
+		{
+			throw std::invalid_argument("Malformed packed position");
+		}
+
+		const char* error = details::PositionValidator::validate(*position);
+
+		if (error)
+		{
+			throw std::invalid_argument(error);
+		}
+
+		result.push_back(evaluator.evaluateForWhite(*position));
+	}
+
+	return result;
+}
@@ -3,6 +3,7 @@
 #include "details/BoardAnalyzer.h"
 #include "details/DrawEvaluator.h"
 #include "details/MoveValidator.h"
+#include "details/bitboard/Bitboard.h"
 #include "details/fen/FenParser.h"
 #include "details/fen/FenUtils.h"
 
@@ -11,22 +12,26 @@
 #include <boost/tuple/tuple.hpp>
 
 #include <algorithm>
+#include <utility>
 
 using namespace simplechess;
 
 Game::Game(
 		const GameState gameState,
 		const std::optional<DrawReason>& drawReason,
-		const std::vector<std::pair<GameStage, PlayedMove>>& history,
-		const GameStage& currentStage,
-		const std::set<PieceMove>& allAvailableMoves,
+		std::pmr::vector<std::pair<GameStage, PlayedMove>> history,
+		GameStage currentStage,
+		std::pmr::set<PieceMove> allAvailableMoves,
 		const std::optional<DrawReason>& reasonToClaimDraw,
-		const DrawEnforcement drawEnforcement)
+		const DrawEnforcement drawEnforcement,
+		const allocator_type& allocator)
 	: mGameState(gameState),
 	  mReasonGameWasDrawn(drawReason),
-	  mHistory(history),
-	  mCurrentStage(currentStage),
-	  mAllAvailableMoves(allAvailableMoves),
+	  mHistory(std::move(history), allocator),
+	  mCurrentStage(std::move(currentStage), allocator),
+	  mAllAvailableMoves(std::move(allAvailableMoves), allocator),
+	  mMovesBySource(allocator),
+	  mSourceOffsets(),
 	  mReasonToClaimDraw(reasonToClaimDraw),
 	  mDrawEnforcement(drawEnforcement)
 {
@@ -36,6 +41,59 @@ Game::Game(
 		throw std::invalid_argument(
 				"Inconsistent arguments related to draw reason");
 	}
+
+	// Group the moves by origin square, keeping the order of the set
+	// within each square. Unlike std::stable_sort, std::sort does not
+	// allocate a buffer outside of the resource
+	mMovesBySource.assign(mAllAvailableMoves.begin(), mAllAvailableMoves.end());
+	std::sort(
+			mMovesBySource.begin(),
+			mMovesBySource.end(),
+			[](const PieceMove& lhs, const PieceMove& rhs)
+			{
+				const uint8_t lhsSquare = details::squareIndex(lhs.src());
+				const uint8_t rhsSquare = details::squareIndex(rhs.src());
+
+				return (lhsSquare != rhsSquare)
+					? lhsSquare < rhsSquare
+					: lhs < rhs;
+			});
+
+	for (const PieceMove& move : mMovesBySource)
+	{
+		++mSourceOffsets[details::squareIndex(move.src()) + 1];
+	}
+
+	for (size_t square = 1; square < mSourceOffsets.size(); ++square)
+	{
+		mSourceOffsets[square] += mSourceOffsets[square - 1];
+	}
+}
+
+Game::Game(const Game& other, const allocator_type& allocator)
+	: mGameState(other.mGameState),
+	  mReasonGameWasDrawn(other.mReasonGameWasDrawn),
+	  mHistory(other.mHistory, allocator),
+	  mCurrentStage(other.mCurrentStage, allocator),
+	  mAllAvailableMoves(other.mAllAvailableMoves, allocator),
+	  mMovesBySource(other.mMovesBySource, allocator),
+	  mSourceOffsets(other.mSourceOffsets),
+	  mReasonToClaimDraw(other.mReasonToClaimDraw),
+	  mDrawEnforcement(other.mDrawEnforcement)
+{
+}
+
+Game::Game(Game&& other, const allocator_type& allocator)
+	: mGameState(other.mGameState),
+	  mReasonGameWasDrawn(other.mReasonGameWasDrawn),
+	  mHistory(std::move(other.mHistory), allocator),
+	  mCurrentStage(std::move(other.mCurrentStage), allocator),
+	  mAllAvailableMoves(std::move(other.mAllAvailableMoves), allocator),
+	  mMovesBySource(std::move(other.mMovesBySource), allocator),
+	  mSourceOffsets(other.mSourceOffsets),
+	  mReasonToClaimDraw(other.mReasonToClaimDraw),
+	  mDrawEnforcement(other.mDrawEnforcement)
+{
 }
 
 const GameStage& Game::currentStage() const
@@ -59,7 +117,7 @@ DrawReason Game::drawReason() const
 	return *mReasonGameWasDrawn;
 }
 
-const std::vector<std::pair<GameStage, PlayedMove>>& Game::history() const
+const std::pmr::vector<std::pair<GameStage, PlayedMove>>& Game::history() const
 {
 	return mHistory;
 }
@@ -69,22 +127,22 @@ Color Game::activeColor() const
 	return currentStage().activeColor();
 }
 
-std::set<PieceMove> Game::availableMovesForPiece(const Square& square) const
+PieceMoveRange Game::availableMovesForPiece(const Square& square) const
 {
-	std::set<PieceMove> result;
+	const uint8_t index = details::squareIndex(square);
 
-	for (const auto& move : allAvailableMoves())
-	{
-		if (move.src() == square)
-		{
-			result.insert(move);
-		}
-	}
+	return {
+		mMovesBySource.data() + mSourceOffsets[index],
+		mMovesBySource.data() + mSourceOffsets[index + 1]};
+}
 
-	return result;
+bool Game::isLegal(const PieceMove& move) const
+{
+	const PieceMoveRange moves = availableMovesForPiece(move.src());
+	return std::find(moves.begin(), moves.end(), move) != moves.end();
 }
 
-const std::set<PieceMove>& Game::allAvailableMoves() const
+const std::pmr::set<PieceMove>& Game::allAvailableMoves() const
 {
 	return mAllAvailableMoves;
 }
@@ -104,3 +162,8 @@ DrawEnforcement Game::drawEnforcement() const
 {
 	return mDrawEnforcement;
 }
+
+Game::allocator_type Game::get_allocator() const
+{
+	return mMovesBySource.get_allocator();
+}
@@ -0,0 +1,459 @@
+#include <cpp/simplechess/GameCodec.h>
+#include <cpp/simplechess/SimpleChess.h>
+
+#include "Builders.h"
+#include "details/GameReplayer.h"
+#include "details/bitboard/Position.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+using namespace simplechess;
+
+namespace
+{
+	const std::string InitialPositionFen
+		= "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+	enum RecordFlags
+	{
+		StateMask = 0x03,
+		CustomInitialPosition = 0x04,
+		ClaimOnlyEnforcement = 0x08,
+		DrawOffers = 0x10,
+		ReservedMask = 0xE0
+	};
+
+	constexpr uint8_t NumberOfDrawReasons
+		= static_cast<uint8_t>(DrawReason::OpponentInsufficientMaterial) + 1;
+
+	/**
+	 * Longest FEN string accepted when decoding, to reject corrupt lengths
+	 * before allocating anything.
+	 */
+	constexpr uint64_t MaxFenLength = 128;
+
+	/**
+	 * Key which sorts moves by origin square, destination square and
+	 * promotion (no promotion first).
+	 */
+	uint16_t sortKey(const details::Move& move)
+	{
+		return static_cast<uint16_t>(
+				(move.src << 9)
+				| (move.dst << 3)
+				| static_cast<int>(move.promotion));
+	}
+
+	void writeVarint(std::vector<uint8_t>& output, uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			output.push_back(static_cast<uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+
+		output.push_back(static_cast<uint8_t>(value));
+	}
+
+	class BufferReader
+	{
+		public:
+			BufferReader(const uint8_t* data, const size_t size)
+				: mData(data),
+				  mSize(size),
+				  mOffset(0)
+			{
+			}
+
+			uint8_t next()
+			{
+				if (mOffset == mSize)
+				{
+					throw std::invalid_argument("Truncated game record");
+				}
+
+				return mData[mOffset++];
+			}
+
+			size_t offset() const
+			{
+				return mOffset;
+			}
+
+		private:
+			const uint8_t* mData;
+			size_t mSize;
+			size_t mOffset;
+	};
+
+	class StreamReader
+	{
+		public:
+			explicit StreamReader(std::istream& input)
+				: mInput(input)
+			{
+			}
+
+			uint8_t next()
+			{
+				const std::istream::int_type c = mInput.get();
+
+				if (c == std::istream::traits_type::eof())
+				{
+					throw std::invalid_argument("Truncated game record");
+				}
+
+				return static_cast<uint8_t>(c);
+			}
+
+		private:
+			std::istream& mInput;
+	};
+
+	template <typename Reader>
+	uint64_t readVarint(Reader& reader)
+	{
+		uint64_t value = 0;
+
+		for (unsigned shift = 0; shift < 64; shift += 7)
+		{
+			const uint8_t byte = reader.next();
+			value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+			if ((byte & 0x80) == 0)
+			{
+				return value;
+			}
+		}
+
+		throw std::invalid_argument("Malformed number in game record");
+	}
+
+	template <typename Reader>
+	Game decode(Reader& reader)
+	{
+		const uint8_t flags = reader.next();
+		const uint8_t drawReasonByte = reader.next();
+
+		if ((flags & RecordFlags::ReservedMask) != 0
+				|| drawReasonByte > NumberOfDrawReasons)
+		{
+			throw std::invalid_argument("Malformed game record header");
+		}
+
+		const GameState finalState
+			= static_cast<GameState>(flags & RecordFlags::StateMask);
+
+		const std::optional<DrawReason> finalDrawReason = (drawReasonByte != 0)
+			? std::optional<DrawReason>(
+					static_cast<DrawReason>(drawReasonByte - 1))
+			: std::nullopt;
+
+		if ((finalState == GameState::Drawn) != finalDrawReason.has_value())
+		{
+			throw std::invalid_argument(
+					"Inconsistent draw reason in game record");
+		}
+
+		const DrawEnforcement drawEnforcement
+			= ((flags & RecordFlags::ClaimOnlyEnforcement) != 0)
+				? DrawEnforcement::ClaimOnly
+				: DrawEnforcement::Automatic;
+
+		std::string fen = ::InitialPositionFen;
+
+		if ((flags & RecordFlags::CustomInitialPosition) != 0)
+		{
+			const uint64_t length = ::readVarint(reader);
+
+			if (length > ::MaxFenLength)
+			{
+				throw std::invalid_argument("Malformed FEN in game record");
+			}
+
+			fen.resize(static_cast<size_t>(length));
+
+			for (char& c : fen)
+			{
+				c = static_cast<char>(reader.next());
+			}
+		}
+
+		const uint64_t numberOfMoves = ::readVarint(reader);
+
+		// Indices of the moves which offered a draw, in increasing order
+		std::vector<uint64_t> drawOffers;
+
+		if ((flags & RecordFlags::DrawOffers) != 0)
+		{
+			const uint64_t numberOfOffers = ::readVarint(reader);
+
+			if (numberOfOffers == 0 || numberOfOffers > numberOfMoves)
+			{
+				throw std::invalid_argument(
+						"Malformed draw offers in game record");
+			}
+
+			uint64_t previous = 0;
+
+			for (uint64_t i = 0; i < numberOfOffers; ++i)
+			{
+				const uint64_t ply = previous + ::readVarint(reader);
+
+				if (ply >= numberOfMoves || (i > 0 && ply == previous))
+				{
+					throw std::invalid_argument(
+							"Malformed draw offers in game record");
+				}
+
+				drawOffers.push_back(ply);
+				previous = ply;
+			}
+		}
+
+		const Game initialGame = createGameFromFen(fen, drawEnforcement);
+		std::optional<Game> game;
+
+		if (numberOfMoves == 0)
+		{
+			game = initialGame;
+		}
+		else
+		{
+			if (initialGame.gameState() != GameState::Playing)
+			{
+				throw std::invalid_argument(
+						"Game record has moves after the end of the game");
+			}
+
+			details::GameReplayer replayer(initialGame, true);
+			auto nextOffer = drawOffers.begin();
+
+			for (uint64_t ply = 0; ply < numberOfMoves; ++ply)
+			{
+				details::MoveList moves;
+				replayer.position().legalMoves(moves);
+
+				const uint8_t index = reader.next();
+
+				if (index >= moves.size)
+				{
+					throw std::invalid_argument(
+							"Illegal move index in game record");
+				}
+
+				std::nth_element(
+						moves.moves,
+						moves.moves + index,
+						moves.moves + moves.size,
+						[](const details::Move& lhs, const details::Move& rhs)
+						{
+							return ::sortKey(lhs) < ::sortKey(rhs);
+						});
+
+				const bool offerDraw
+					= nextOffer != drawOffers.end() && *nextOffer == ply;
+
+				if (offerDraw)
+				{
+					++nextOffer;
+				}
+
+				replayer.play(moves.moves[index], offerDraw);
+			}
+
+			game = replayer.build();
+		}
+
+		const std::optional<DrawReason> drawReason
+			= (game->gameState() == GameState::Drawn)
+				? std::optional<DrawReason>(game->drawReason())
+				: std::nullopt;
+
+		if (game->gameState() == finalState && drawReason == finalDrawReason)
+		{
+			return *game;
+		}
+
+		// Otherwise the game must have been resigned, or drawn by accepting
+		// the draw offered with the last move or by claiming a draw which
+		// could be claimed
+		const auto& history = game->history();
+
+		const bool agreedDraw = finalDrawReason == DrawReason::OfferedAndAccepted
+			&& !history.empty()
+			&& history.back().second.isDrawOffered();
+
+		const bool consistent = game->gameState() == GameState::Playing
+			&& (finalState != GameState::Drawn
+				|| agreedDraw
+				|| finalDrawReason == game->reasonToClaimDraw());
+
+		if (!consistent)
+		{
+			throw std::invalid_argument(
+					"Inconsistent final state in game record");
+		}
+
+		return GameBuilder::build(
+				finalState,
+				finalDrawReason,
+				game->history(),
+				game->currentStage(),
+				{},
+				{},
+				drawEnforcement);
+	}
+}
+
+void simplechess::encodeGame(const Game& game, std::vector<uint8_t>& output)
+{
+	const auto& history = game.history();
+	const GameStage& initialStage = history.empty()
+		? game.currentStage()
+		: history.front().first;
+
+	const bool customInitialPosition
+		= std::string_view(initialStage.fen()) != ::InitialPositionFen;
+
+	std::vector<uint64_t> drawOffers;
+
+	for (size_t ply = 0; ply < history.size(); ++ply)
+	{
+		if (history[ply].second.isDrawOffered())
+		{
+			drawOffers.push_back(ply);
+		}
+	}
+
+	uint8_t flags = static_cast<uint8_t>(game.gameState());
+
+	if (customInitialPosition)
+	{
+		flags |= RecordFlags::CustomInitialPosition;
+	}
+
+	if (game.drawEnforcement() == DrawEnforcement::ClaimOnly)
+	{
+		flags |= RecordFlags::ClaimOnlyEnforcement;
+	}
+
+	if (!drawOffers.empty())
+	{
+		flags |= RecordFlags::DrawOffers;
+	}
+
+	output.push_back(flags);
+	output.push_back(
+			(game.gameState() == GameState::Drawn)
+				? static_cast<uint8_t>(static_cast<int>(game.drawReason()) + 1)
+				: 0);
+
+	if (customInitialPosition)
+	{
+		::writeVarint(output, initialStage.fen().size());
+		output.insert(
+				output.end(),
+				initialStage.fen().begin(),
+				initialStage.fen().end());
+	}
+
+	::writeVarint(output, history.size());
+
+	if (!drawOffers.empty())
+	{
+		::writeVarint(output, drawOffers.size());
+
+		uint64_t previous = 0;
+
+		for (const uint64_t ply : drawOffers)
+		{
+			::writeVarint(output, ply - previous);
+			previous = ply;
+		}
+	}
+
+	details::Position position = details::Position::fromStage(initialStage);
+
+	for (const auto& [stage, playedMove] : history)
+	{
+		const details::Move move
+			= details::moveFromPieceMove(playedMove.pieceMove());
+		const uint16_t key = ::sortKey(move);
+
+		details::MoveList moves;
+		position.legalMoves(moves);
+
+		// The index of the move is the number of legal moves sorted before
+		// it, so the list does not need to be sorted
+		uint8_t index = 0;
+		bool found = false;
+
+		for (const details::Move& other : moves)
+		{
+			const uint16_t otherKey = ::sortKey(other);
+
+			if (otherKey < key)
+			{
+				++index;
+			}
+
+			found = found || otherKey == key;
+		}
+
+		if (!found)
+		{
+			throw std::invalid_argument(
+					"Game history contains an illegal move");
+		}
+
+		output.push_back(index);
+		position.makeMove(move);
+	}
+}
+
+std::vector<uint8_t> simplechess::encodeGame(const Game& game)
+{
+	std::vector<uint8_t> result;
+	encodeGame(game, result);
+	return result;
+}
+
+void simplechess::encodeGame(const Game& game, std::ostream& output)
+{
+	const std::vector<uint8_t> record = encodeGame(game);
+
+	output.write(
+			reinterpret_cast<const char*>(record.data()),
+			static_cast<std::streamsize>(record.size()));
+}
+
+Game simplechess::decodeGame(
+		const uint8_t* data,
+		const size_t size,
+		size_t* consumed)
+{
+	::BufferReader reader(data, size);
+	Game game = ::decode(reader);
+
+	if (consumed)
+	{
+		*consumed = reader.offset();
+	}
+
+	return game;
+}
+
+Game simplechess::decodeGame(const std::vector<uint8_t>& data)
+{
+	return decodeGame(data.data(), data.size());
+}
+
+Game simplechess::decodeGame(std::istream& input)
+{
+	::StreamReader reader(input);
+	return ::decode(reader);
+}
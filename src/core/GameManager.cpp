@@ -0,0 +1,238 @@
+#include <cpp/simplechess/GameManager.h>
+#include <cpp/simplechess/SimpleChess.h>
+
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+using namespace simplechess;
+
+/**
+ * A hosted game. The snapshot is replaced atomically, so readers can load
+ * it without taking the mutex, which only serializes updates.
+ */
+struct GameManager::Entry
+{
+	std::mutex mutex;
+	std::shared_ptr<const Game> game;
+};
+
+/**
+ * Shards are aligned to cache lines so that threads working on different
+ * shards do not share the lines of their locks and counters.
+ */
+struct alignas(64) GameManager::Shard
+{
+	mutable std::shared_mutex mutex;
+	std::unordered_map<GameId, std::shared_ptr<Entry>> games;
+
+	mutable std::atomic<uint64_t> lookups{0};
+	mutable std::atomic<uint64_t> contendedLookups{0};
+	std::atomic<uint64_t> updates{0};
+	std::atomic<uint64_t> contendedUpdates{0};
+
+	/**
+	 * Takes \p lock, counting whether it had to wait.
+	 */
+	template <typename Lock>
+	void acquire(Lock& lock) const
+	{
+		lookups.fetch_add(1, std::memory_order_relaxed);
+
+		if (!lock.try_lock())
+		{
+			contendedLookups.fetch_add(1, std::memory_order_relaxed);
+			lock.lock();
+		}
+	}
+};
+
+namespace
+{
+	size_t roundUpToPowerOfTwo(const size_t value)
+	{
+		size_t result = 1;
+
+		while (result < value)
+		{
+			result <<= 1;
+		}
+
+		return result;
+	}
+}
+
+GameManager::GameManager(size_t shards)
+	: mShards(),
+	  mShardMask(0),
+	  mNextId(1)
+{
+	if (shards == 0)
+	{
+		shards = 4 * std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	shards = ::roundUpToPowerOfTwo(shards);
+
+	mShards = std::make_unique<Shard[]>(shards);
+	mShardMask = shards - 1;
+}
+
+GameManager::~GameManager() = default;
+
+GameManager::Shard& GameManager::shardOf(const GameId id) const
+{
+	// Identifiers are consecutive, so they are mixed to spread them
+	uint64_t mixed = id * 0x9E3779B97F4A7C15ULL;
+	mixed ^= mixed >> 32;
+
+	return mShards[static_cast<size_t>(mixed) & mShardMask];
+}
+
+std::shared_ptr<GameManager::Entry> GameManager::find(const GameId id) const
+{
+	const Shard& shard = shardOf(id);
+
+	std::shared_lock<std::shared_mutex> lock(shard.mutex, std::defer_lock);
+	shard.acquire(lock);
+
+	const auto it = shard.games.find(id);
+	return (it != shard.games.end()) ? it->second : nullptr;
+}
+
+GameManager::GameId GameManager::add(Game game)
+{
+	auto entry = std::make_shared<Entry>();
+	entry->game = std::make_shared<const Game>(std::move(game));
+
+	const GameId id = mNextId.fetch_add(1, std::memory_order_relaxed);
+	Shard& shard = shardOf(id);
+
+	std::unique_lock<std::shared_mutex> lock(shard.mutex, std::defer_lock);
+	shard.acquire(lock);
+
+	shard.games.emplace(id, std::move(entry));
+
+	return id;
+}
+
+bool GameManager::remove(const GameId id)
+{
+	Shard& shard = shardOf(id);
+
+	std::unique_lock<std::shared_mutex> lock(shard.mutex, std::defer_lock);
+	shard.acquire(lock);
+
+	return shard.games.erase(id) != 0;
+}
+
+std::shared_ptr<const Game> GameManager::get(const GameId id) const
+{
+	const std::shared_ptr<Entry> entry = find(id);
+	return entry ? std::atomic_load(&entry->game) : nullptr;
+}
+
+std::shared_ptr<const Game> GameManager::update(
+		const GameId id,
+		const std::function<Game(const Game&)>& transition)
+{
+	const std::shared_ptr<Entry> entry = find(id);
+
+	if (!entry)
+	{
+		throw std::invalid_argument("Unknown game");
+	}
+
+	Shard& shard = shardOf(id);
+	shard.updates.fetch_add(1, std::memory_order_relaxed);
+
+	std::unique_lock<std::mutex> lock(entry->mutex, std::try_to_lock);
+
+	if (!lock.owns_lock())
+	{
+		shard.contendedUpdates.fetch_add(1, std::memory_order_relaxed);
+		lock.lock();
+	}
+
+	// Only updates replace the snapshot, and they hold the mutex
+	std::shared_ptr<const Game> next
+		= std::make_shared<const Game>(transition(*entry->game));
+
+	std::atomic_store(&entry->game, next);
+
+	return next;
+}
+
+std::shared_ptr<const Game> GameManager::makeMove(
+		const GameId id,
+		const PieceMove& move,
+		const bool offerDraw)
+{
+	return update(id, [&](const Game& game)
+			{
+				return simplechess::makeMove(game, move, offerDraw);
+			});
+}
+
+std::shared_ptr<const Game> GameManager::claimDraw(const GameId id)
+{
+	return update(id, [](const Game& game)
+			{
+				return simplechess::claimDraw(game);
+			});
+}
+
+std::shared_ptr<const Game> GameManager::resign(const GameId id, const Color resigningPlayer)
+{
+	return update(id, [&](const Game& game)
+			{
+				return simplechess::resign(game, resigningPlayer);
+			});
+}
+
+size_t GameManager::size() const
+{
+	size_t result = 0;
+
+	for (size_t i = 0; i <= mShardMask; ++i)
+	{
+		std::shared_lock<std::shared_mutex> lock(mShards[i].mutex);
+		result += mShards[i].games.size();
+	}
+
+	return result;
+}
+
+size_t GameManager::shards() const
+{
+	return mShardMask + 1;
+}
+
+std::vector<GameManagerShardStatistics> GameManager::statistics() const
+{
+	std::vector<GameManagerShardStatistics> result;
+	result.reserve(shards());
+
+	for (size_t i = 0; i <= mShardMask; ++i)
+	{
+		const Shard& shard = mShards[i];
+
+		size_t games = 0;
+		{
+			std::shared_lock<std::shared_mutex> lock(shard.mutex);
+			games = shard.games.size();
+		}
+
+		result.push_back({
+				games,
+				shard.lookups.load(std::memory_order_relaxed),
+				shard.contendedLookups.load(std::memory_order_relaxed),
+				shard.updates.load(std::memory_order_relaxed),
+				shard.contendedUpdates.load(std::memory_order_relaxed)});
+	}
+
+	return result;
+}
@@ -1,28 +1,55 @@
 #include <cpp/simplechess/GameStage.h>
 
+#include <utility>
+
 using namespace simplechess;
 
 GameStage::GameStage(
-		const Board& board,
+		Board board,
 		const Color toPlay,
 		const uint8_t castlingRights,
 		const uint16_t halfmoveClock,
 		const uint16_t fullmoveClock,
-		const std::string& fen,
+		const std::string_view fen,
 		const std::optional<Square>& enPassantTarget,
-		const CheckType checkStatus)
-	: mBoard(board),
+		const CheckType checkStatus,
+		const allocator_type& allocator)
+	: mBoard(std::move(board), allocator),
 	  mActiveColor(toPlay),
 	  mCastlingRights(castlingRights),
 	  mHalfmoveClock(halfmoveClock),
 	  mFullmoveClock(fullmoveClock),
-	  mFen(fen),
+	  mFen(fen, allocator),
 	  mEnPassantTarget(enPassantTarget),
 	  mCheckStatus(checkStatus)
 {
 	// This constructor assumes the position is valid since it's only called from validated contexts
 }
 
+GameStage::GameStage(const GameStage& other, const allocator_type& allocator)
+	: mBoard(other.mBoard, allocator),
+	  mActiveColor(other.mActiveColor),
+	  mCastlingRights(other.mCastlingRights),
+	  mHalfmoveClock(other.mHalfmoveClock),
+	  mFullmoveClock(other.mFullmoveClock),
+	  mFen(other.mFen, allocator),
+	  mEnPassantTarget(other.mEnPassantTarget),
+	  mCheckStatus(other.mCheckStatus)
+{
+}
+
+GameStage::GameStage(GameStage&& other, const allocator_type& allocator)
+	: mBoard(std::move(other.mBoard), allocator),
+	  mActiveColor(other.mActiveColor),
+	  mCastlingRights(other.mCastlingRights),
+	  mHalfmoveClock(other.mHalfmoveClock),
+	  mFullmoveClock(other.mFullmoveClock),
+	  mFen(std::move(other.mFen), allocator),
+	  mEnPassantTarget(other.mEnPassantTarget),
+	  mCheckStatus(other.mCheckStatus)
+{
+}
+
 const Board& GameStage::board() const
 {
 	return mBoard;
@@ -49,7 +76,7 @@ uint16_t GameStage::fullMoveCounter() const
 	return mFullmoveClock;
 }
 
-const std::string& GameStage::fen() const
+const std::pmr::string& GameStage::fen() const
 {
 	return mFen;
 }
@@ -63,3 +90,8 @@ CheckType GameStage::checkStatus() const
 {
 	return mCheckStatus;
 }
+
+GameStage::allocator_type GameStage::get_allocator() const
+{
+	return mFen.get_allocator();
+}
@@ -0,0 +1,52 @@
+#include <cpp/simplechess/Notation.h>
+
+#include "details/AlgebraicNotationParser.h"
+#include "details/UciNotation.h"
+#include "details/bitboard/Position.h"
+
+#include <stdexcept>
+
+using namespace simplechess;
+
+PieceMove simplechess::pieceMoveFromAlgebraicNotation(
+		const GameStage& stage,
+		const std::string& san)
+{
+	const details::Position position = details::Position::fromStage(stage);
+
+	const std::optional<details::Move> move
+		= details::AlgebraicNotationParser::parse(position, san);
+
+	if (!move)
+	{
+		throw std::invalid_argument(
+				san + " is not a legal move in algebraic notation in "
+				+ std::string(stage.fen()));
+	}
+
+	return position.toPieceMove(*move);
+}
+
+PieceMove simplechess::pieceMoveFromUci(
+		const GameStage& stage,
+		const std::string& uci)
+{
+	const details::Position position = details::Position::fromStage(stage);
+
+	const std::optional<details::Move> move
+		= details::UciNotation::parse(position, uci);
+
+	if (!move)
+	{
+		throw std::invalid_argument(
+				uci + " is not a legal move in UCI notation in "
+				+ std::string(stage.fen()));
+	}
+
+	return position.toPieceMove(*move);
+}
+
+std::string simplechess::pieceMoveToUci(const PieceMove& move)
+{
+	return details::UciNotation::toString(details::moveFromPieceMove(move));
+}
@@ -0,0 +1,49 @@
+#include <cpp/simplechess/PackedPosition.h>
+#include <cpp/simplechess/SimpleChess.h>
+
+#include "details/PositionValidator.h"
+#include "details/bitboard/Position.h"
+
+#include <stdexcept>
+
+using namespace simplechess;
+
+static_assert(
+		PackedPosition::Size == details::Position::PackedSize,
+		"Packed position sizes differ");
+
+PackedPosition simplechess::packPosition(const GameStage& stage)
+{
+	PackedPosition result;
+	details::Position::fromStage(stage).pack(result.bytes.data());
+	return result;
+}
+
+GameStage simplechess::unpackPosition(const PackedPosition& packed)
+{
+	const std::optional<details::Position> position
+		= details::Position::unpack(packed.bytes.data());
+
+	if (!position)
+	{
+		throw std::invalid_argument("Malformed packed position");
+	}
+
+	const char* error = details::PositionValidator::validate(*position);
+
+	if (error)
+	{
+		throw std::invalid_argument(error);
+	}
+
+	return position->toStage();
+}
+
+Game simplechess::createGameFromPackedPosition(
+		const PackedPosition& packed,
+		const DrawEnforcement drawEnforcement)
+{
+	return createGameFromFen(
+			std::string(unpackPosition(packed).fen()),
+			drawEnforcement);
+}
@@ -0,0 +1,358 @@
+#include <cpp/simplechess/Pgn.h>
+
+#include <cerrno>
+#include <system_error>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace simplechess;
+
+namespace
+{
+	constexpr size_t MaxLineLength = 80;
+
+	const std::string InitialPositionFen
+		= "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+	const std::pair<std::string_view, std::string_view> SevenTagRoster[] = {
+		{"Event", "?"},
+		{"Site", "?"},
+		{"Date", "????.??.??"},
+		{"Round", "?"},
+		{"White", "?"},
+		{"Black", "?"}
+	};
+
+	std::string_view resultOf(const Game& game)
+	{
+		switch (game.gameState())
+		{
+			case GameState::WhiteWon:
+				return "1-0";
+			case GameState::BlackWon:
+				return "0-1";
+			case GameState::Drawn:
+				return "1/2-1/2";
+			default:
+				return "*";
+		}
+	}
+
+	const std::string* findTag(const PgnTags& tags, const std::string_view name)
+	{
+		for (const auto& [tagName, value] : tags)
+		{
+			if (tagName == name)
+			{
+				return &value;
+			}
+		}
+
+		return nullptr;
+	}
+
+	bool isSevenTagRosterName(const std::string_view name)
+	{
+		if (name == "Result")
+		{
+			return true;
+		}
+
+		for (const auto& [rosterName, defaultValue] : SevenTagRoster)
+		{
+			if (rosterName == name)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/**
+	 * Writes the decimal representation of \p number at the end of \p
+	 * buffer and returns a pointer to its first character.
+	 */
+	char* formatNumber(unsigned number, char* bufferEnd)
+	{
+		char* begin = bufferEnd;
+
+		do
+		{
+			*--begin = static_cast<char>('0' + number % 10);
+			number /= 10;
+		} while (number != 0);
+
+		return begin;
+	}
+
+	void writeToFileDescriptor(const int fd, const char* data, size_t size)
+	{
+		while (size > 0)
+		{
+#ifdef _WIN32
+			const int written = ::_write(fd, data, static_cast<unsigned>(size));
+#else
+			const ssize_t written = ::write(fd, data, size);
+#endif
+
+			if (written < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+
+				throw std::system_error(
+						errno,
+						std::generic_category(),
+						"Failed to write PGN output");
+			}
+
+			data += written;
+			size -= static_cast<size_t>(written);
+		}
+	}
+}
+
+PgnWriter::PgnWriter(Sink sink, const size_t bufferSize)
+	: mSink(std::move(sink)),
+	  mBuffer(),
+	  mCapacity(bufferSize > 0 ? bufferSize : 1),
+	  mLineLength(0)
+{
+	mBuffer.reserve(mCapacity);
+}
+
+PgnWriter PgnWriter::toFileDescriptor(const int fd, const size_t bufferSize)
+{
+	return PgnWriter(
+			[fd](const char* data, const size_t size)
+			{
+				::writeToFileDescriptor(fd, data, size);
+			},
+			bufferSize);
+}
+
+PgnWriter PgnWriter::toStream(std::ostream& stream, const size_t bufferSize)
+{
+	return PgnWriter(
+			[&stream](const char* data, const size_t size)
+			{
+				stream.write(data, static_cast<std::streamsize>(size));
+			},
+			bufferSize);
+}
+
+PgnWriter PgnWriter::toString(std::string& output, const size_t bufferSize)
+{
+	return PgnWriter(
+			[&output](const char* data, const size_t size)
+			{
+				output.append(data, size);
+			},
+			bufferSize);
+}
+
+PgnWriter::~PgnWriter()
+{
+	try
+	{
+		flush();
+	}
+	catch (...)
+	{
+		// Destructors cannot report errors
+	}
+}
+
+void PgnWriter::flush()
+{
+	if (!mBuffer.empty())
+	{
+		mSink(mBuffer.data(), mBuffer.size());
+		mBuffer.clear();
+	}
+}
+
+void PgnWriter::append(const std::string_view text)
+{
+	if (mBuffer.size() + text.size() > mCapacity)
+	{
+		flush();
+
+		if (text.size() > mCapacity)
+		{
+			mSink(text.data(), text.size());
+			return;
+		}
+	}
+
+	mBuffer.insert(mBuffer.end(), text.begin(), text.end());
+}
+
+void PgnWriter::append(const char c)
+{
+	if (mBuffer.size() == mCapacity)
+	{
+		flush();
+	}
+
+	mBuffer.push_back(c);
+}
+
+void PgnWriter::appendTag(const std::string_view name, const std::string_view value)
+{
+	append('[');
+	append(name);
+	append(" \"");
+
+	for (const char c : value)
+	{
+		if (c == '"' || c == '\\')
+		{
+			append('\\');
+		}
+
+		append(c);
+	}
+
+	append("\"]\n");
+}
+
+void PgnWriter::appendMovetextToken(const std::string_view token)
+{
+	if (mLineLength > 0)
+	{
+		if (mLineLength + 1 + token.size() > MaxLineLength)
+		{
+			append('\n');
+			mLineLength = 0;
+		}
+		else
+		{
+			append(' ');
+			++mLineLength;
+		}
+	}
+
+	append(token);
+	mLineLength += token.size();
+}
+
+void PgnWriter::write(const Game& game, const PgnTags& tags)
+{
+	const auto& history = game.history();
+	const GameStage& initialStage = history.empty()
+		? game.currentStage()
+		: history.front().first;
+
+	const std::string_view result = ::resultOf(game);
+
+	// Tag pair section
+	for (const auto& [name, defaultValue] : ::SevenTagRoster)
+	{
+		const std::string* value = ::findTag(tags, name);
+		appendTag(name, value ? std::string_view(*value) : defaultValue);
+	}
+
+	appendTag("Result", result);
+
+	for (const auto& [name, value] : tags)
+	{
+		if (!::isSevenTagRosterName(name))
+		{
+			appendTag(name, value);
+		}
+	}
+
+	if (std::string_view(initialStage.fen()) != ::InitialPositionFen
+			&& !::findTag(tags, "FEN"))
+	{
+		if (!::findTag(tags, "SetUp"))
+		{
+			appendTag("SetUp", "1");
+		}
+
+		appendTag("FEN", initialStage.fen());
+	}
+
+	append('\n');
+
+	// Movetext section
+	constexpr std::string_view drawOfferSuffix = "(=)";
+	char numberBuffer[16];
+	char* const numberEnd = numberBuffer + sizeof(numberBuffer);
+
+	mLineLength = 0;
+	bool first = true;
+
+	for (const auto& [stage, move] : history)
+	{
+		const bool white = stage.activeColor() == Color::White;
+
+		if (white || first)
+		{
+			// Move number, followed by "." for white and "..." for black
+			char* end = numberEnd - 3;
+			char* begin = ::formatNumber(stage.fullMoveCounter(), end);
+			*end++ = '.';
+
+			if (!white)
+			{
+				*end++ = '.';
+				*end++ = '.';
+			}
+
+			appendMovetextToken(std::string_view(
+						begin,
+						static_cast<size_t>(end - begin)));
+		}
+
+		std::string_view san = move.inAlgebraicNotation();
+
+		if (move.isDrawOffered()
+				&& san.size() >= drawOfferSuffix.size()
+				&& san.substr(san.size() - drawOfferSuffix.size()) == drawOfferSuffix)
+		{
+			san.remove_suffix(drawOfferSuffix.size());
+		}
+
+		appendMovetextToken(san);
+
+		if (move.isDrawOffered())
+		{
+			appendMovetextToken("{draw offer}");
+		}
+
+		first = false;
+	}
+
+	appendMovetextToken(result);
+	append("\n\n");
+	mLineLength = 0;
+}
+
+void PgnWriter::write(const std::vector<Game>& games, const PgnTags& tags)
+{
+	for (const Game& game : games)
+	{
+		write(game, tags);
+	}
+}
+
+std::string simplechess::gameToPgn(const Game& game, const PgnTags& tags)
+{
+	std::string result;
+
+	{
+		PgnWriter writer = PgnWriter::toString(result, 4096);
+		writer.write(game, tags);
+	}
+
+	return result;
+}
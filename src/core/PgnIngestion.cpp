@@ -0,0 +1,175 @@
+#include <cpp/simplechess/Pgn.h>
+#include <cpp/simplechess/SimpleChess.h>
+
+#include "details/AlgebraicNotationParser.h"
+#include "details/GameReplayer.h"
+#include "details/MappedFile.h"
+#include "details/PgnParser.h"
+#include "details/WorkStealingPool.h"
+
+#include <algorithm>
+
+using namespace simplechess;
+
+namespace
+{
+	/**
+	 * Smallest chunk of the database scanned for game boundaries by a
+	 * single task.
+	 */
+	constexpr size_t MinChunkSize = 1 << 20;
+
+	std::vector<size_t> findGameStarts(
+			const std::string_view database,
+			const details::WorkStealingPool& pool)
+	{
+		const size_t chunks = std::max<size_t>(
+				1,
+				std::min<size_t>(
+					pool.threads() * 4,
+					database.size() / MinChunkSize));
+
+		std::vector<std::vector<size_t>> startsPerChunk(chunks);
+
+		pool.run(chunks, [&](const size_t chunk)
+		{
+			startsPerChunk[chunk] = details::PgnParser::findGameStarts(
+					database.data(),
+					database.size(),
+					database.size() * chunk / chunks,
+					database.size() * (chunk + 1) / chunks);
+		});
+
+		std::vector<size_t> result;
+
+		// Movetext before the first tag section is a game without tags
+		const size_t firstStart = (startsPerChunk[0].empty())
+			? database.size()
+			: startsPerChunk[0].front();
+
+		if (database.substr(0, firstStart).find_first_not_of(" \t\r\n") != std::string_view::npos)
+		{
+			result.push_back(0);
+		}
+
+		for (const std::vector<size_t>& starts : startsPerChunk)
+		{
+			result.insert(result.end(), starts.begin(), starts.end());
+		}
+
+		return result;
+	}
+
+	PgnGameRecord replayGame(
+			const std::string_view text,
+			const size_t index,
+			const Game& initialGame,
+			const DrawEnforcement drawEnforcement)
+	{
+		PgnGameRecord record;
+		record.index = index;
+
+		try
+		{
+			details::ParsedPgnGame parsed = details::PgnParser::parseGame(text);
+			record.tags = std::move(parsed.tags);
+			record.result = std::string(parsed.result);
+
+			std::optional<Game> customInitialGame;
+
+			for (const auto& [name, value] : record.tags)
+			{
+				if (name == "FEN")
+				{
+					customInitialGame = createGameFromFen(value, drawEnforcement);
+				}
+			}
+
+			const Game& start = customInitialGame ? *customInitialGame : initialGame;
+
+			if (parsed.moves.empty())
+			{
+				record.game = start;
+				return record;
+			}
+
+			details::GameReplayer replayer(start, true);
+			record.moves.reserve(parsed.moves.size());
+
+			for (const std::string_view san : parsed.moves)
+			{
+				// As makeMove would, reject moves played once the game is
+				// over (checkmate and stalemate leave no legal move, so
+				// they are caught below)
+				if (replayer.hasFinished())
+				{
+					record.error = std::string(san)
+						+ " is played after the game has finished at ply "
+						+ std::to_string(record.moves.size() + 1);
+					return record;
+				}
+
+				const std::optional<details::Move> move
+					= details::AlgebraicNotationParser::parse(replayer.position(), san);
+
+				if (!move)
+				{
+					record.error = std::string(san)
+						+ " is not a legal move in algebraic notation at ply "
+						+ std::to_string(record.moves.size() + 1);
+					return record;
+				}
+
+				record.moves.push_back(replayer.position().toPieceMove(*move));
+				replayer.play(*move);
+			}
+
+			record.game = replayer.build();
+		}
+		catch (const std::exception& e)
+		{
+			record.error = e.what();
+		}
+
+		return record;
+	}
+}
+
+size_t simplechess::ingestPgn(
+		const std::string_view database,
+		const PgnGameCallback& onGame,
+		const PgnIngestionOptions& options)
+{
+	const details::WorkStealingPool pool(options.threads);
+	const std::vector<size_t> starts = ::findGameStarts(database, pool);
+	const Game initialGame = createNewGame(options.drawEnforcement);
+
+	pool.run(starts.size(), [&](const size_t index)
+	{
+		const size_t begin = starts[index];
+		const size_t end = (index + 1 < starts.size())
+			? starts[index + 1]
+			: database.size();
+
+		onGame(::replayGame(
+					database.substr(begin, end - begin),
+					index,
+					initialGame,
+					options.drawEnforcement));
+	});
+
+	return starts.size();
+}
+
+size_t simplechess::ingestPgnFile(
+		const std::string& path,
+		const PgnGameCallback& onGame,
+		const PgnIngestionOptions& options)
+{
+	const details::MappedFile file(path);
+
+	return ingestPgn(
+			std::string_view(file.data(), file.size()),
+			onGame,
+			options);
+}
@@ -0,0 +1,48 @@
+#include <cpp/simplechess/PositionAnalysis.h>
+
+#include "details/PositionValidator.h"
+#include "details/bitboard/Position.h"
+#include "details/fen/FenParser.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace simplechess;
+
+PositionAnalysis simplechess::analyzePosition(const std::string& fen)
+{
+	const details::Position position = details::FenParser::parsePosition(fen);
+	const char* error = details::PositionValidator::validate(position);
+
+	if (error)
+	{
+		throw std::invalid_argument(error);
+	}
+
+	details::MoveList moves;
+	position.legalMoves(moves);
+
+	PositionAnalysis result;
+	result.activeColor = position.activeColor();
+	result.availableMoves.reserve(moves.size);
+
+	for (const details::Move& move : moves)
+	{
+		result.availableMoves.push_back(position.toPieceMove(move));
+	}
+
+	std::sort(result.availableMoves.begin(), result.availableMoves.end());
+
+	if (!position.inCheck())
+	{
+		result.checkStatus = CheckType::NoCheck;
+	}
+	else
+	{
+		result.checkStatus = result.availableMoves.empty()
+			? CheckType::CheckMate
+			: CheckType::Check;
+	}
+
+	return result;
+}
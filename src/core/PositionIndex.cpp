@@ -0,0 +1,582 @@
+#include <cpp/simplechess/PositionIndex.h>
+#include <cpp/simplechess/Exceptions.h>
+#include <cpp/simplechess/Pgn.h>
+#include <cpp/simplechess/SimpleChess.h>
+
+#include "details/MappedFile.h"
+#include "details/WorkStealingPool.h"
+#include "details/bitboard/Position.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <system_error>
+
+using namespace simplechess;
+
+namespace
+{
+	/**
+	 * An index starts with a header (magic, version, number of postings
+	 * and fence stride), followed by the postings sorted by hash and the
+	 * fences. A posting is the hash of the position followed by the game
+	 * identifier and the ply packed in 40 and 24 bits. A fence is the hash
+	 * of every FenceStride-th posting. Numbers are little-endian.
+	 */
+	const char Magic[4] = {'S', 'C', 'P', 'I'};
+	constexpr uint32_t Version = 1;
+	constexpr size_t HeaderSize = 32;
+	constexpr size_t PostingSize = 16;
+	constexpr size_t FenceSize = 8;
+	constexpr unsigned PlyBits = 24;
+
+	/**
+	 * Postings per fence, so that the postings between two fences fill a
+	 * 4 KiB page.
+	 */
+	constexpr uint64_t FenceStride = 256;
+
+	/**
+	 * Postings read at once from each temporary file when merging them.
+	 */
+	constexpr size_t RunBufferPostings = 4096;
+
+	/**
+	 * A posting as kept in memory: the hash of the position, and the game
+	 * identifier and ply packed in a single number, so that sorting the
+	 * pairs sorts by hash, game and ply.
+	 */
+	typedef std::pair<uint64_t, uint64_t> Posting;
+
+	void writeNumber(char* output, const uint64_t value, const size_t bytes)
+	{
+		for (size_t i = 0; i < bytes; ++i)
+		{
+			output[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+		}
+	}
+
+	uint64_t readNumber(const char* data, const size_t bytes)
+	{
+		uint64_t value = 0;
+
+		for (size_t i = 0; i < bytes; ++i)
+		{
+			value |= static_cast<uint64_t>(static_cast<uint8_t>(data[i])) << (8 * i);
+		}
+
+		return value;
+	}
+
+	void throwWriteError(const std::string& path)
+	{
+		throw std::system_error(
+				errno != 0 ? errno : EIO,
+				std::generic_category(),
+				"Cannot write position index file " + path);
+	}
+
+	/**
+	 * Appends the postings of \p position and of every position reached
+	 * from it by playing \p moves.
+	 */
+	void collect(
+			std::vector<Posting>& output,
+			const uint64_t gameId,
+			details::Position position,
+			const std::vector<PieceMove>& moves)
+	{
+		if (gameId > PositionIndexBuilder::MaxGameId)
+		{
+			throw std::invalid_argument("Game identifier too large to index");
+		}
+
+		if (moves.size() > PositionIndexBuilder::MaxPly)
+		{
+			throw std::invalid_argument("Game too long to index");
+		}
+
+		const uint64_t game = gameId << ::PlyBits;
+
+		output.push_back({position.hash(), game});
+
+		for (size_t ply = 0; ply < moves.size(); ++ply)
+		{
+			position.makeMove(details::moveFromPieceMove(moves[ply]));
+			output.push_back({position.hash(), game | (ply + 1)});
+		}
+	}
+
+	/**
+	 * Writes postings in order to a file, either a temporary file (with
+	 * postings only) or an index (with the header and fences too).
+	 */
+	class PostingWriter
+	{
+		public:
+			PostingWriter(const std::string& path, const bool index)
+				: mPath(path),
+				  mOutput(path, std::ios::binary | std::ios::trunc),
+				  mIndex(index),
+				  mCount(0),
+				  mBuffer(),
+				  mFences()
+			{
+				if (!mOutput)
+				{
+					::throwWriteError(mPath);
+				}
+
+				if (mIndex)
+				{
+					// Filled in by close()
+					const char header[::HeaderSize] = {};
+					mOutput.write(header, sizeof(header));
+				}
+
+				mBuffer.reserve(::RunBufferPostings * ::PostingSize);
+			}
+
+			void push(const Posting& posting)
+			{
+				if (mIndex && mCount % ::FenceStride == 0)
+				{
+					mFences.push_back(posting.first);
+				}
+
+				char bytes[::PostingSize];
+				::writeNumber(bytes, posting.first, 8);
+				::writeNumber(bytes + 8, posting.second, 8);
+				mBuffer.insert(mBuffer.end(), bytes, bytes + sizeof(bytes));
+
+				++mCount;
+
+				if (mBuffer.size() == mBuffer.capacity())
+				{
+					flushBuffer();
+				}
+			}
+
+			void close()
+			{
+				flushBuffer();
+
+				if (mIndex)
+				{
+					for (const uint64_t fence : mFences)
+					{
+						char bytes[::FenceSize];
+						::writeNumber(bytes, fence, sizeof(bytes));
+						mOutput.write(bytes, sizeof(bytes));
+					}
+
+					char header[::HeaderSize] = {};
+					std::memcpy(header, ::Magic, sizeof(::Magic));
+					::writeNumber(header + 4, ::Version, 4);
+					::writeNumber(header + 8, mCount, 8);
+					::writeNumber(header + 16, ::FenceStride, 4);
+
+					mOutput.seekp(0);
+					mOutput.write(header, sizeof(header));
+				}
+
+				mOutput.close();
+
+				if (!mOutput)
+				{
+					::throwWriteError(mPath);
+				}
+			}
+
+		private:
+			void flushBuffer()
+			{
+				mOutput.write(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+				mBuffer.clear();
+			}
+
+			std::string mPath;
+			std::ofstream mOutput;
+			bool mIndex;
+			uint64_t mCount;
+			std::vector<char> mBuffer;
+			std::vector<uint64_t> mFences;
+	};
+
+	/**
+	 * Reads the postings of a temporary file in order, a block at a time.
+	 */
+	class RunReader
+	{
+		public:
+			explicit RunReader(const std::string& path)
+				: mInput(path, std::ios::binary),
+				  mBuffer(::RunBufferPostings * ::PostingSize),
+				  mSize(0),
+				  mOffset(0)
+			{
+				if (!mInput)
+				{
+					throw std::system_error(
+							errno != 0 ? errno : EIO,
+							std::generic_category(),
+							"Cannot read temporary file " + path);
+				}
+
+				fill();
+			}
+
+			bool done() const
+			{
+				return mOffset == mSize;
+			}
+
+			Posting current() const
+			{
+				const char* data = mBuffer.data() + mOffset;
+				return {::readNumber(data, 8), ::readNumber(data + 8, 8)};
+			}
+
+			void advance()
+			{
+				mOffset += ::PostingSize;
+
+				if (mOffset == mSize)
+				{
+					fill();
+				}
+			}
+
+		private:
+			void fill()
+			{
+				mInput.read(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+				mSize = static_cast<size_t>(mInput.gcount());
+				mOffset = 0;
+			}
+
+			std::ifstream mInput;
+			std::vector<char> mBuffer;
+			size_t mSize;
+			size_t mOffset;
+	};
+}
+
+PositionIndexBuilder::PositionIndexBuilder(
+		const std::string& path,
+		const PositionIndexOptions& options)
+	: mPath(path),
+	  mOptions(options),
+	  mMutex(),
+	  mPostings(),
+	  mRuns(),
+	  mFinished(false)
+{
+}
+
+PositionIndexBuilder::~PositionIndexBuilder()
+{
+	for (const std::string& run : mRuns)
+	{
+		std::remove(run.c_str());
+	}
+}
+
+void PositionIndexBuilder::add(const std::vector<Game>& games, const uint64_t firstGameId)
+{
+	if (!games.empty() && firstGameId > MaxGameId - (games.size() - 1))
+	{
+		throw std::invalid_argument("Game identifier too large to index");
+	}
+
+	const details::WorkStealingPool pool(mOptions.threads);
+
+	pool.run(games.size(), [&](const size_t i)
+			{
+				add(firstGameId + i, games[i]);
+			});
+}
+
+size_t PositionIndexBuilder::addPgnFile(const std::string& path, const uint64_t firstGameId)
+{
+	if (firstGameId > MaxGameId)
+	{
+		throw std::invalid_argument("Game identifier too large to index");
+	}
+
+	PgnIngestionOptions ingestion;
+	ingestion.threads = mOptions.threads;
+
+	return ingestPgnFile(
+			path,
+			[&](const PgnGameRecord& record)
+			{
+				if (!record.game)
+				{
+					return;
+				}
+
+				// The replayed game has no history, so the moves are
+				// played again from the initial position
+				const auto fen = std::find_if(
+						record.tags.begin(),
+						record.tags.end(),
+						[](const std::pair<std::string, std::string>& tag)
+						{
+							return tag.first == "FEN";
+						});
+
+				const Game initial = (fen != record.tags.end())
+					? createGameFromFen(fen->second)
+					: createNewGame();
+
+				std::vector<::Posting> postings;
+				::collect(
+						postings,
+						firstGameId + record.index,
+						details::Position::fromStage(initial.currentStage()),
+						record.moves);
+
+				const std::lock_guard<std::mutex> lock(mMutex);
+				mPostings.insert(mPostings.end(), postings.begin(), postings.end());
+				spill();
+			},
+			ingestion);
+}
+
+void PositionIndexBuilder::add(const uint64_t gameId, const Game& game)
+{
+	const auto& history = game.history();
+
+	std::vector<PieceMove> moves;
+	moves.reserve(history.size());
+
+	for (const auto& entry : history)
+	{
+		moves.push_back(entry.second.pieceMove());
+	}
+
+	std::vector<::Posting> postings;
+	::collect(
+			postings,
+			gameId,
+			details::Position::fromStage(
+				history.empty() ? game.currentStage() : history.front().first),
+			moves);
+
+	const std::lock_guard<std::mutex> lock(mMutex);
+	mPostings.insert(mPostings.end(), postings.begin(), postings.end());
+	spill();
+}
+
+void PositionIndexBuilder::spill()
+{
+	if (mFinished)
+	{
+		throw IllegalStateException("Position index already written");
+	}
+
+	if (mPostings.size() * sizeof(::Posting) < mOptions.memoryLimit)
+	{
+		return;
+	}
+
+	std::sort(mPostings.begin(), mPostings.end());
+
+	const std::string run = mPath + ".run" + std::to_string(mRuns.size());
+	mRuns.push_back(run);
+
+	::PostingWriter writer(run, false);
+
+	for (const ::Posting& posting : mPostings)
+	{
+		writer.push(posting);
+	}
+
+	writer.close();
+	mPostings.clear();
+}
+
+void PositionIndexBuilder::finish()
+{
+	const std::lock_guard<std::mutex> lock(mMutex);
+
+	if (mFinished)
+	{
+		throw IllegalStateException("Position index already written");
+	}
+
+	mFinished = true;
+
+	std::sort(mPostings.begin(), mPostings.end());
+
+	::PostingWriter writer(mPath, true);
+
+	if (mRuns.empty())
+	{
+		for (const ::Posting& posting : mPostings)
+		{
+			writer.push(posting);
+		}
+	}
+	else
+	{
+		std::vector<std::unique_ptr<::RunReader>> readers;
+
+		for (const std::string& run : mRuns)
+		{
+			readers.push_back(std::make_unique<::RunReader>(run));
+		}
+
+		// Postings still in memory are merged as one more run
+		size_t next = 0;
+
+		typedef std::pair<::Posting, size_t> Head;
+		std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+
+		for (size_t i = 0; i < readers.size(); ++i)
+		{
+			if (!readers[i]->done())
+			{
+				heads.push({readers[i]->current(), i});
+			}
+		}
+
+		if (next < mPostings.size())
+		{
+			heads.push({mPostings[next], readers.size()});
+		}
+
+		while (!heads.empty())
+		{
+			const auto [posting, source] = heads.top();
+			heads.pop();
+
+			writer.push(posting);
+
+			if (source == readers.size())
+			{
+				if (++next < mPostings.size())
+				{
+					heads.push({mPostings[next], source});
+				}
+			}
+			else
+			{
+				readers[source]->advance();
+
+				if (!readers[source]->done())
+				{
+					heads.push({readers[source]->current(), source});
+				}
+			}
+		}
+	}
+
+	writer.close();
+
+	for (const std::string& run : mRuns)
+	{
+		std::remove(run.c_str());
+	}
+
+	mRuns.clear();
+	mPostings = {};
+}
+
+PositionIndex::PositionIndex(const std::string& path)
+	: mFile(std::make_shared<const details::MappedFile>(path)),
+	  mFences(),
+	  mSize(0)
+{
+	const char* data = mFile->data();
+	const size_t size = mFile->size();
+
+	if (size < ::HeaderSize
+			|| std::memcmp(data, ::Magic, sizeof(::Magic)) != 0
+			|| ::readNumber(data + 4, 4) != ::Version
+			|| ::readNumber(data + 16, 4) != ::FenceStride)
+	{
+		throw std::invalid_argument("Malformed position index file");
+	}
+
+	const uint64_t count = ::readNumber(data + 8, 8);
+	const uint64_t fenceCount = (count + ::FenceStride - 1) / ::FenceStride;
+
+	if (count > (size - ::HeaderSize) / ::PostingSize
+			|| size != ::HeaderSize + count * ::PostingSize + fenceCount * ::FenceSize)
+	{
+		throw std::invalid_argument("Malformed position index file");
+	}
+
+	mSize = static_cast<size_t>(count);
+
+	auto fences = std::make_shared<std::vector<uint64_t>>();
+	fences->reserve(static_cast<size_t>(fenceCount));
+
+	const char* fence = data + ::HeaderSize + count * ::PostingSize;
+
+	for (uint64_t i = 0; i < fenceCount; ++i, fence += ::FenceSize)
+	{
+		fences->push_back(::readNumber(fence, ::FenceSize));
+	}
+
+	mFences = fences;
+}
+
+size_t PositionIndex::size() const
+{
+	return mSize;
+}
+
+std::vector<PositionPosting> PositionIndex::find(const GameStage& stage) const
+{
+	const uint64_t hash = details::Position::fromStage(stage).hash();
+	const char* const postings = mFile->data() + ::HeaderSize;
+
+	const auto hashAt = [postings](const size_t i)
+	{
+		return ::readNumber(postings + i * ::PostingSize, 8);
+	};
+
+	// The first posting of the position is after the last fence below its
+	// hash, and no later than the next fence
+	const size_t fence = static_cast<size_t>(
+			std::lower_bound(mFences->begin(), mFences->end(), hash) - mFences->begin());
+
+	size_t first = (fence == 0) ? 0 : (fence - 1) * ::FenceStride;
+	size_t count = std::min<size_t>(fence * ::FenceStride, mSize) - first;
+
+	while (count > 0)
+	{
+		const size_t step = count / 2;
+
+		if (hashAt(first + step) < hash)
+		{
+			first += step + 1;
+			count -= step + 1;
+		}
+		else
+		{
+			count = step;
+		}
+	}
+
+	std::vector<PositionPosting> result;
+
+	for (size_t i = first; i < mSize && hashAt(i) == hash; ++i)
+	{
+		const uint64_t value = ::readNumber(postings + i * ::PostingSize + 8, 8);
+
+		result.push_back({
+				value >> ::PlyBits,
+				static_cast<uint32_t>(value & ((uint64_t(1) << ::PlyBits) - 1))});
+	}
+
+	return result;
+}
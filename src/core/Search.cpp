@@ -0,0 +1,195 @@
+#include <cpp/simplechess/Search.h>
+#include <cpp/simplechess/Exceptions.h>
+
+#include "details/WorkStealingPool.h"
+#include "details/search/MateSolver.h"
+#include "details/search/Searcher.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+
+using namespace simplechess;
+
+namespace
+{
+	/**
+	 * Hashes of the positions of \p game before the current one since the
+	 * last capture or pawn move, which are the only ones which can be
+	 * repeated.
+	 */
+	std::vector<uint64_t> repeatableHashes(const Game& game)
+	{
+		const auto& history = game.history();
+		size_t first = history.size();
+
+		while (first > 0
+				&& game.currentStage().halfMovesSinceLastCaptureOrPawnAdvance()
+					> history.size() - first)
+		{
+			--first;
+		}
+
+		std::vector<uint64_t> result;
+		result.reserve(history.size() - first);
+
+		for (size_t i = first; i < history.size(); ++i)
+		{
+			result.push_back(details::Position::fromStage(history[i].first).hash());
+		}
+
+		return result;
+	}
+
+	/**
+	 * Returns the pool used by findBestMove for \p threads threads. Each
+	 * pool is created on first use and kept for the lifetime of the
+	 * program, so that its threads are only started once.
+	 */
+	const details::WorkStealingPool& searchPool(const unsigned threads)
+	{
+		static std::mutex mutex;
+		static std::map<unsigned, std::unique_ptr<details::WorkStealingPool>> pools;
+
+		const std::lock_guard<std::mutex> lock(mutex);
+		std::unique_ptr<details::WorkStealingPool>& pool = pools[threads];
+
+		if (!pool)
+		{
+			pool = std::make_unique<details::WorkStealingPool>(threads);
+		}
+
+		return *pool;
+	}
+}
+
+SearchResult simplechess::findBestMove(const Game& game, const SearchLimits& limits)
+{
+	if (game.gameState() != GameState::Playing)
+	{
+		throw IllegalStateException("Cannot search a finished game");
+	}
+
+	details::SharedSearch shared(
+			details::Position::fromStage(game.currentStage()),
+			::repeatableHashes(game),
+			limits.hashSize);
+
+	if (limits.depth != 0)
+	{
+		shared.maxDepth = static_cast<int>(
+				std::min<unsigned>(limits.depth, details::score::MaxPly - 1));
+	}
+	else if (limits.nodes == 0 && limits.time.count() == 0)
+	{
+		shared.maxDepth = SearchLimits::DefaultDepth;
+	}
+	else
+	{
+		shared.maxDepth = details::score::MaxPly - 1;
+	}
+
+	shared.nodeLimit = limits.nodes;
+
+	if (limits.time.count() != 0)
+	{
+		shared.deadline = shared.start + limits.time;
+	}
+
+	const details::WorkStealingPool& pool = ::searchPool(limits.threads);
+	std::vector<std::unique_ptr<details::Searcher>> searchers;
+
+	for (unsigned i = 0; i < pool.threads(); ++i)
+	{
+		searchers.push_back(std::make_unique<details::Searcher>(shared, i));
+	}
+
+	pool.run(
+			searchers.size(),
+			[&searchers](const size_t i)
+			{
+				searchers[i]->run();
+			});
+
+	const details::Searcher& main = *searchers.front();
+
+	std::vector<PieceMove> principalVariation;
+	details::Position position = shared.root;
+
+	for (const details::Move& move : main.principalVariation())
+	{
+		principalVariation.push_back(position.toPieceMove(move));
+		position.makeMove(move);
+	}
+
+	if (principalVariation.empty())
+	{
+		// Only possible if the search was stopped before any move was
+		// searched
+		principalVariation.push_back(*game.allAvailableMoves().begin());
+	}
+
+	std::optional<int> mateIn;
+
+	if (std::abs(main.score()) > details::score::MateBound)
+	{
+		const int plies = details::score::Mate - std::abs(main.score());
+		mateIn = (main.score() > 0) ? (plies + 1) / 2 : -(plies / 2);
+	}
+
+	return {
+		principalVariation.front(),
+		main.score(),
+		mateIn,
+		static_cast<unsigned>(main.completedDepth()),
+		shared.nodes,
+		principalVariation};
+}
+
+std::vector<MateSolution> simplechess::solveMate(
+		const GameStage& stage,
+		const unsigned moves,
+		const MateMoves attackerMoves)
+{
+	const details::Position root = details::Position::fromStage(stage);
+
+	details::MoveList candidates;
+	root.legalMoves(candidates);
+
+	details::MateSolver solver(attackerMoves == MateMoves::Checks);
+	std::vector<MateSolution> result;
+
+	// Deepen one move at a time, so that each mate is found at its
+	// shortest length and the shallower results help the deeper ones
+	for (unsigned depth = 1; depth <= moves && candidates.size != 0; ++depth)
+	{
+		const size_t found = result.size();
+		details::MoveList unsolved;
+
+		for (const details::Move& move : candidates)
+		{
+			if (solver.isMatingMove(root, move, depth))
+			{
+				result.push_back({root.toPieceMove(move), depth});
+			}
+			else
+			{
+				unsolved.push(move);
+			}
+		}
+
+		std::sort(
+				result.begin() + static_cast<std::ptrdiff_t>(found),
+				result.end(),
+				[](const MateSolution& lhs, const MateSolution& rhs)
+				{
+					return lhs.move < rhs.move;
+				});
+
+		candidates = unsolved;
+	}
+
+	return result;
+}
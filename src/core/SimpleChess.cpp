@@ -1,216 +1,388 @@
 #include <cpp/simplechess/SimpleChess.h>
 
 #include "Builders.h"
+#include "details/AlgebraicNotationGenerator.h"
 #include "details/BoardAnalyzer.h"
+#include "details/GameReplayer.h"
 #include "details/GameStageUpdater.h"
 #include "details/GameStateDetector.h"
+#include "details/PositionValidator.h"
+#include "details/UciNotation.h"
+#include "details/WorkStealingPool.h"
 #include "details/fen/FenParser.h"
 #include "details/fen/FenUtils.h"
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
 using namespace simplechess;
 
 namespace internal
 {
-	void validateGamePosition(const Board& board, Color activeColor, uint8_t castlingRights)
+	/**
+	 * Returns the positions of the history of \p game which can still be
+	 * repeated, in the order they were reached, as described in \ref
+	 * details::DrawEvaluator::reasonToDraw(). Only the positions since the
+	 * last capture or pawn advance are returned, as no older position can
+	 * be reached again.
+	 */
+	std::pmr::vector<details::ReachedPosition> getPreviouslyReachedPositions(
+			const Game& game,
+			std::pmr::memory_resource* resource)
 	{
-		// 1. Validate that there is exactly one King per side
-		uint8_t whiteKings = 0;
-		uint8_t blackKings = 0;
+		const auto& history = game.history();
+		size_t first = history.size();
+		uint16_t halfmoveClock
+			= game.currentStage().halfMovesSinceLastCaptureOrPawnAdvance();
 
-		for (const auto& entry : board.occupiedSquares())
+		while (first > 0 && halfmoveClock != 0)
 		{
-			if (entry.second.type() == PieceType::King)
-			{
-				if (entry.second.color() == Color::White)
-				{
-					whiteKings++;
-				}
-				else
-				{
-					blackKings++;
-				}
-			}
+			--first;
+			halfmoveClock
+				= history[first].first.halfMovesSinceLastCaptureOrPawnAdvance();
 		}
 
-		if (whiteKings != 1 || blackKings != 1)
-		{
-			throw std::invalid_argument("Invalid number of kings on board");
-		}
+		std::pmr::vector<details::ReachedPosition> result(resource);
+		result.reserve(history.size() - first);
 
-		// 2. Validate that the color to move cannot be checking the opposite King
-		if (details::BoardAnalyzer::isInCheck(board, oppositeColor(activeColor)))
+		for (size_t i = first; i < history.size(); ++i)
 		{
-			throw std::invalid_argument("Color to move is already checking");
+			const uint64_t hash
+				= details::Position::fromStage(history[i].first).hash();
+			const uint8_t timesReached = details::DrawEvaluator::timesReached(
+					result.data(),
+					result.size(),
+					hash);
+
+			result.push_back({
+					hash,
+					(timesReached == UINT8_MAX)
+						? timesReached
+						: static_cast<uint8_t>(timesReached + 1)});
 		}
 
-		// 3. Validate castling rights consistency
-		const Piece whiteKing = {PieceType::King, Color::White};
-		const Piece blackKing = {PieceType::King, Color::Black};
-		const Piece whiteRook = {PieceType::Rook, Color::White};
-		const Piece blackRook = {PieceType::Rook, Color::Black};
-
-		if ((castlingRights & static_cast<uint8_t>(CastlingRight::WhiteKingSide))
-				&& (*board.pieceAt(Square::fromString("e1")) != whiteKing
-					|| *board.pieceAt(Square::fromString("h1")) != whiteRook))
-		{
-			throw std::invalid_argument(
-					"Kingside castling right for white is inconsistent with board state");
-		}
+		return result;
+	}
 
-		if ((castlingRights & static_cast<uint8_t>(CastlingRight::WhiteQueenSide))
-				&& (*board.pieceAt(Square::fromString("e1")) != whiteKing
-					|| *board.pieceAt(Square::fromString("a1")) != whiteRook))
+	/**
+	 * Plays \p move, which must be one of the available moves of \p game.
+	 * Everything is allocated from the resource of \p game.
+	 */
+	Game makeValidMove(
+			const Game& game,
+			const PieceMove& move,
+			bool offerDraw)
+	{
+		const Game::allocator_type allocator = game.get_allocator();
+		const DrawEnforcement drawEnforcement = game.drawEnforcement();
+
+		const details::Position position
+			= details::Position::fromStage(game.currentStage());
+		const details::Move internalMove = details::moveFromPieceMove(move);
+
+		details::Position next = position;
+		next.makeMove(internalMove);
+
+		details::MoveList legalMoves;
+		next.legalMoves(legalMoves);
+
+		// The reached positions are only needed during the call, so they
+		// come from the stack, falling back to the resource of the game
+		std::array<std::byte, 4096> buffer;
+		std::pmr::monotonic_buffer_resource scratch(
+				buffer.data(),
+				buffer.size(),
+				allocator.resource());
+
+		const std::pmr::vector<details::ReachedPosition> reachedPositions
+			= getPreviouslyReachedPositions(game, &scratch);
+
+		const details::PositionStateInformation information
+			= details::GameStateDetector::detect(
+					next,
+					legalMoves,
+					offerDraw,
+					reachedPositions.data(),
+					(next.halfmoveClock() != 0) ? reachedPositions.size() : 0,
+					drawEnforcement);
+
+		std::pmr::set<PieceMove> availableMoves(allocator);
+
+		for (const details::Move& available : legalMoves)
 		{
-			throw std::invalid_argument(
-					"Queenside castling right for white is inconsistent with board state");
+			availableMoves.insert(next.toPieceMove(available));
 		}
 
-		if ((castlingRights & static_cast<uint8_t>(CastlingRight::BlackKingSide))
-				&& (*board.pieceAt(Square::fromString("e8")) != blackKing
-					|| *board.pieceAt(Square::fromString("h8")) != blackRook))
-		{
-			throw std::invalid_argument(
-					"Kingside castling right for black is inconsistent with board state");
-		}
+		std::pmr::vector<std::pair<GameStage, PlayedMove>> nextHistory(allocator);
+		nextHistory.reserve(game.history().size() + 1);
+		nextHistory.insert(
+				nextHistory.end(),
+				game.history().begin(),
+				game.history().end());
+		nextHistory.emplace_back(
+				game.currentStage(),
+				PlayedMoveBuilder::build(
+						move,
+						position.pieceAt(internalMove.dst),
+						offerDraw,
+						information.checkType,
+						details::AlgebraicNotationGenerator::toAlgebraicNotation(
+							position,
+							internalMove,
+							offerDraw,
+							information.checkType)));
 
-		if ((castlingRights & static_cast<uint8_t>(CastlingRight::BlackQueenSide))
-				&& (*board.pieceAt(Square::fromString("e8")) != blackKing
-					|| *board.pieceAt(Square::fromString("a8")) != blackRook))
-		{
-			throw std::invalid_argument(
-					"Queenside castling right for black is inconsistent with board state");
-		}
+		return GameBuilder::build(
+				information.gameState,
+				information.reasonItWasDrawn,
+				std::move(nextHistory),
+				next.toStage(allocator),
+				std::move(availableMoves),
+				information.reasonToClaimDraw,
+				drawEnforcement,
+				allocator);
 	}
 
-	std::map<std::string, uint8_t> getPreviouslyReachedPositionsMap(
-			const std::vector<std::pair<GameStage, PlayedMove>>& history)
+	/**
+	 * Returns the pool used by makeMoves for \p threads threads. Each pool
+	 * is created on first use and kept for the lifetime of the program, so
+	 * that its threads are only started once.
+	 */
+	const details::WorkStealingPool& movePool(const unsigned threads)
 	{
-		std::map<std::string, uint8_t> result;
+		static std::mutex mutex;
+		static std::map<unsigned, std::unique_ptr<details::WorkStealingPool>> pools;
 
-		for (const auto& [stage, move] : history)
-		{
-			const std::string repetitionFen
-				= details::FenUtils::fenForRepetitions(stage.fen());
+		const std::lock_guard<std::mutex> lock(mutex);
+		std::unique_ptr<details::WorkStealingPool>& pool = pools[threads];
 
-			if (result.count(repetitionFen))
-			{
-				result.at(repetitionFen)++;
-			}
-			else
-			{
-				result.insert({repetitionFen, 1});
-			}
+		if (!pool)
+		{
+			pool = std::make_unique<details::WorkStealingPool>(threads);
 		}
 
-		return result;
+		return *pool;
 	}
-}
 
-Game simplechess::createNewGame(const DrawEnforcement drawEnforcement)
-{
-	const std::string fenOfInitialPosition
-		= "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
-	return createGameFromFen(fenOfInitialPosition, drawEnforcement);
-}
+	/**
+	 * Builds the game for a position which has already been validated.
+	 */
+	Game buildGame(
+			const Board& board,
+			const Color activeColor,
+			const uint8_t castlingRights,
+			const std::optional<Square>& epSquare,
+			const uint16_t halfmoveClock,
+			const uint16_t fullmoveCounter,
+			const DrawEnforcement drawEnforcement,
+			std::pmr::memory_resource* resource)
+	{
+		const Game::allocator_type allocator(resource);
 
-Game simplechess::createGameFromFen(
-		const std::string& fen,
-		const DrawEnforcement drawEnforcement)
-{
-	const details::FenParser parsedState = details::FenParser::parse(fen);
+		if (!epSquare)
+		{
+			const GameStage currentStage = GameStageBuilder::build(
+				board,
+				activeColor,
+				castlingRights,
+				halfmoveClock,
+				fullmoveCounter,
+				epSquare,
+				allocator);
+
+			const details::GameStateInformation information
+				= details::GameStateDetector::detect(currentStage, false, {}, drawEnforcement);
+
+			return GameBuilder::build(
+					information.gameState,
+					information.reasonItWasDrawn,
+					{},
+					currentStage,
+					information.availableMoves,
+					information.reasonToClaimDraw,
+					drawEnforcement,
+					allocator);
+		}
 
-	// We can infer the prior move if there is an en passant target
-	const std::optional<Square> epSquare = parsedState.enPassantTarget();
-	std::optional<PieceMove> lastMove;
-	if (epSquare)
-	{
-		const Piece pawn(
-				PieceType::Pawn,
-				(epSquare->rank() == 3)
-					? Color::White
-					: Color::Black);
+		// We can infer the last move from the en passant target, so we want
+		// to start the history of the game one stage sooner.
+		const Piece pawn(PieceType::Pawn, oppositeColor(activeColor));
 
-		const Square src = Square::fromRankAndFile(
+		const Square src = SquareBuilder::build(
 				((pawn.color() == Color::White)
 					? 2
 					: 7),
 				epSquare->file());
 
-		const Square dst = Square::fromRankAndFile(
+		const Square dst = SquareBuilder::build(
 				((pawn.color() == Color::White)
 					? 4
 					: 5),
 				epSquare->file());
 
-		lastMove = { PieceMove::regularMove(pawn, src, dst) };
+		const PieceMove lastMove = PieceMove::regularMove(pawn, src, dst);
+
+		// We get the original board state by making a backwards pawn move.
+		const Board originalBoardState =
+			details::BoardAnalyzer::makeMoveOnBoard(
+					board,
+					PieceMove::regularMove(pawn, dst, src));
+
+		const uint16_t fullMoveCounterDecrease
+			= (activeColor == Color::White)
+				? 1
+				: 0;
+
+		const GameStage originalStage = GameStageBuilder::build(
+			originalBoardState,
+			pawn.color(),
+			castlingRights,
+			0, // Reset halfmove clock
+			static_cast<uint16_t>(fullmoveCounter - fullMoveCounterDecrease),
+			std::nullopt, // No en passant target
+			allocator);
+
+		const details::GameStateInformation information
+			= details::GameStateDetector::detect(originalStage, false, {}, drawEnforcement);
+
+		const Game originalGame = GameBuilder::build(
+			information.gameState,
+			information.reasonItWasDrawn,
+			{}, // empty history
+			originalStage,
+			information.availableMoves,
+			information.reasonToClaimDraw,
+			drawEnforcement,
+			allocator);
+
+		return makeValidMove(originalGame, lastMove, false);
 	}
+}
+
+Game simplechess::createNewGame(
+		const DrawEnforcement drawEnforcement,
+		std::pmr::memory_resource* resource)
+{
+	const std::string fenOfInitialPosition
+		= "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+	return createGameFromFen(fenOfInitialPosition, drawEnforcement, resource);
+}
+
+Game simplechess::createGameFromFen(
+		const std::string& fen,
+		const DrawEnforcement drawEnforcement,
+		std::pmr::memory_resource* resource)
+{
+	const details::FenParser parsedState = details::FenParser::parse(fen);
 
 	// Validate the parsed position
-	internal::validateGamePosition(parsedState.board(), parsedState.activeColor(), parsedState.castlingRights());
+	const char* error = details::PositionValidator::validate(
+			details::Position::fromBoard(
+				parsedState.board(),
+				parsedState.activeColor(),
+				parsedState.castlingRights(),
+				parsedState.enPassantTarget(),
+				parsedState.halfMovesSinceLastCaptureOrPawnAdvance(),
+				parsedState.fullMoveCounter()));
 
-	if (!lastMove)
+	if (error)
 	{
-		const GameStage currentStage = GameStageBuilder::build(
+		throw std::invalid_argument(error);
+	}
+
+	return internal::buildGame(
 			parsedState.board(),
 			parsedState.activeColor(),
 			parsedState.castlingRights(),
+			parsedState.enPassantTarget(),
 			parsedState.halfMovesSinceLastCaptureOrPawnAdvance(),
 			parsedState.fullMoveCounter(),
-			parsedState.enPassantTarget());
+			drawEnforcement,
+			resource);
+}
 
-		const details::GameStateInformation information
-			= details::GameStateDetector::detect(currentStage, false, {}, drawEnforcement);
+Result<Game> simplechess::tryCreateGameFromFen(
+		const std::string& fen,
+		const DrawEnforcement drawEnforcement,
+		std::pmr::memory_resource* resource)
+{
+	const std::optional<details::Position> position
+		= details::FenParser::tryParsePosition(fen);
 
-		return GameBuilder::build(
-				information.gameState,
-				information.reasonItWasDrawn,
-				{},
-				{currentStage},
-				information.availableMoves,
-				information.reasonToClaimDraw,
-				drawEnforcement);
+	if (!position)
+	{
+		return ErrorCode::InvalidFen;
 	}
 
-	// We can infer the last move, so we want to start the history of the game
-	// one stage sooner.
-	// We get the original board state by making a backwards pawn move.
-	const Board originalBoardState =
-		details::BoardAnalyzer::makeMoveOnBoard(
-				parsedState.board(),
-				PieceMove::regularMove(
-					lastMove->piece(),
-					lastMove->dst(),
-					lastMove->src()));
-
-	// Validate the original position too
-	internal::validateGamePosition(originalBoardState, oppositeColor(parsedState.activeColor()), parsedState.castlingRights());
-
-	const uint16_t fullMoveCounterDecrease
-		= (parsedState.activeColor() == Color::White)
-			? 1
-			: 0;
-
-	const GameStage originalStage = GameStageBuilder::build(
-		originalBoardState,
-		oppositeColor(parsedState.activeColor()),
-		parsedState.castlingRights(),
-		0, // Reset halfmove clock
-		static_cast<uint16_t>(parsedState.fullMoveCounter() - fullMoveCounterDecrease),
-		std::nullopt); // No en passant target
-
-	const details::GameStateInformation information
-		= details::GameStateDetector::detect(originalStage, false, {}, drawEnforcement);
-
-	const Game originalGame = GameBuilder::build(
-		information.gameState,
-		information.reasonItWasDrawn,
-		{}, // empty history
-		originalStage,
-		information.availableMoves,
-		information.reasonToClaimDraw,
-		drawEnforcement);
-
-	return makeMove(originalGame, *lastMove, false);
+	if (details::PositionValidator::validate(*position))
+	{
+		return ErrorCode::InvalidPosition;
+	}
+
+	const std::optional<uint8_t> epSquare = position->enPassantSquare();
+
+	return internal::buildGame(
+			position->toBoard(),
+			position->activeColor(),
+			position->castlingRights(),
+			epSquare
+				? std::optional<Square>(details::squareFromIndex(*epSquare))
+				: std::nullopt,
+			position->halfmoveClock(),
+			position->fullmoveCounter(),
+			drawEnforcement,
+			resource);
+}
+
+Game simplechess::createGameFromUciMoves(
+		const std::string& fen,
+		const std::vector<std::string>& uciMoves,
+		const DrawEnforcement drawEnforcement,
+		std::pmr::memory_resource* resource)
+{
+	Game initialGame = createGameFromFen(fen, drawEnforcement, resource);
+
+	if (uciMoves.empty())
+	{
+		return initialGame;
+	}
+
+	details::GameReplayer replayer(initialGame, true);
+
+	for (const std::string& uci : uciMoves)
+	{
+		if (replayer.hasFinished())
+		{
+			throw IllegalStateException("Attempted to make a move in finished game");
+		}
+
+		const std::optional<details::Move> move
+			= details::UciNotation::parse(replayer.position(), uci);
+
+		if (!move)
+		{
+			// Checkmate and stalemate are not reported by hasFinished()
+			details::MoveList legalMoves;
+			replayer.position().legalMoves(legalMoves);
+
+			if (legalMoves.size == 0)
+			{
+				throw IllegalStateException("Attempted to make a move in finished game");
+			}
+
+			throw std::invalid_argument(
+					uci + " is not a legal move in UCI notation");
+		}
+
+		replayer.play(*move);
+	}
+
+	return replayer.build();
 }
 
 Game simplechess::makeMove(
@@ -223,43 +395,52 @@ Game simplechess::makeMove(
 		throw IllegalStateException("Attempted to make a move in finished game");
 	}
 
-	const std::set<PieceMove> validMoves = game.allAvailableMoves();
-
-	if (validMoves.count(move) == 0)
+	if (!game.isLegal(move))
 	{
 		throw IllegalStateException("Attempted to make invalid move");
 	}
 
-	const DrawEnforcement drawEnforcement = game.drawEnforcement();
+	return internal::makeValidMove(game, move, offerDraw);
+}
 
-	const GameStage nextStage = details::GameStageUpdater::makeMove(
-			game.currentStage(),
-			move,
-			offerDraw);
-
-	const details::GameStateInformation information
-		= details::GameStateDetector::detect(
-				nextStage,
-				offerDraw,
-				internal::getPreviouslyReachedPositionsMap(game.history()),
-				drawEnforcement);
-
-	auto nextHistory = game.history();
-	nextHistory.push_back(
-			{game.currentStage(),
-			PlayedMoveBuilder::build(
-					game.currentStage().board(),
-					move,
-					offerDraw)});
+Result<Game> simplechess::tryMakeMove(
+		const Game& game,
+		const PieceMove& move,
+		bool offerDraw)
+{
+	if (game.gameState() != GameState::Playing)
+	{
+		return ErrorCode::GameFinished;
+	}
 
-	return GameBuilder::build(
-			information.gameState,
-			information.reasonItWasDrawn,
-			nextHistory,
-			nextStage,
-			information.availableMoves,
-			information.reasonToClaimDraw,
-			drawEnforcement);
+	if (!game.isLegal(move))
+	{
+		return ErrorCode::IllegalMove;
+	}
+
+	return internal::makeValidMove(game, move, offerDraw);
+}
+
+std::vector<Result<Game>> simplechess::makeMoves(
+		const std::vector<Game>& games,
+		const std::vector<PieceMove>& moves,
+		const unsigned threads)
+{
+	if (games.size() != moves.size())
+	{
+		throw std::invalid_argument(
+				"There must be exactly one move per game");
+	}
+
+	// Overwritten by every task
+	std::vector<Result<Game>> results(games.size(), ErrorCode::IllegalMove);
+
+	internal::movePool(threads).run(games.size(), [&](const size_t i)
+			{
+				results[i] = tryMakeMove(games[i], moves[i]);
+			});
+
+	return results;
 }
 
 Game simplechess::claimDraw(const Game& game)
@@ -285,7 +466,8 @@ Game simplechess::claimDraw(const Game& game)
 			game.currentStage(),
 			{},
 			{},
-			game.drawEnforcement());
+			game.drawEnforcement(),
+			game.get_allocator());
 }
 
 Game simplechess::resign(const Game& game, Color resigningPlayer)
@@ -304,5 +486,6 @@ Game simplechess::resign(const Game& game, Color resigningPlayer)
 			game.currentStage(),
 			{},
 			{},
-			game.drawEnforcement());
+			game.drawEnforcement(),
+			game.get_allocator());
 }
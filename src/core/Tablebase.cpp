@@ -0,0 +1,98 @@
+#include <cpp/simplechess/Tablebase.h>
+
+#include "details/WorkStealingPool.h"
+#include "details/tablebase/EndgameTable.h"
+#include "details/tablebase/TablebaseData.h"
+#include "details/tablebase/TablebaseGenerator.h"
+
+using namespace simplechess;
+
+namespace
+{
+	/**
+	 * Returns the name of the ending \p name with the colors swapped.
+	 */
+	std::string swappedName(const std::string& name)
+	{
+		const size_t blackKing = name.find('K', 1);
+		return name.substr(blackKing) + name.substr(0, blackKing);
+	}
+
+	/**
+	 * Adds the table of \p ending to \p data, after the tables it depends
+	 * on.
+	 */
+	void addEnding(
+			details::TablebaseData& data,
+			const details::EndgameTable& ending,
+			const details::WorkStealingPool& pool)
+	{
+		if (data.contains(ending.name()) || data.contains(::swappedName(ending.name())))
+		{
+			return;
+		}
+
+		for (const std::string& successor : ending.successors())
+		{
+			::addEnding(data, details::EndgameTable(successor), pool);
+		}
+
+		data.add(ending, details::TablebaseGenerator::generate(ending, data, pool));
+	}
+}
+
+Tablebase::Tablebase(std::shared_ptr<const details::TablebaseData> data)
+	: mData(std::move(data))
+{
+}
+
+Tablebase Tablebase::generate(const std::vector<std::string>& endings, const unsigned threads)
+{
+	// Validate every name before generating anything
+	std::vector<details::EndgameTable> tables(endings.begin(), endings.end());
+
+	const details::WorkStealingPool pool(threads);
+	auto data = std::make_shared<details::TablebaseData>();
+
+	for (const details::EndgameTable& table : tables)
+	{
+		::addEnding(*data, table, pool);
+	}
+
+	return Tablebase(data);
+}
+
+Tablebase Tablebase::load(const std::string& path)
+{
+	return Tablebase(std::make_shared<details::TablebaseData>(path));
+}
+
+void Tablebase::save(const std::string& path) const
+{
+	mData->save(path);
+}
+
+std::vector<std::string> Tablebase::endings() const
+{
+	return mData->endings();
+}
+
+std::optional<TablebaseResult> Tablebase::probe(const GameStage& stage) const
+{
+	const std::optional<uint8_t> value
+		= mData->probe(details::Position::fromStage(stage));
+
+	if (!value)
+	{
+		return std::nullopt;
+	}
+
+	if (*value == details::tablebase::Draw)
+	{
+		return TablebaseResult{TablebaseOutcome::Draw, 0};
+	}
+
+	return TablebaseResult{
+		details::tablebase::isWin(*value) ? TablebaseOutcome::Win : TablebaseOutcome::Loss,
+		static_cast<unsigned>(*value - 1)};
+}
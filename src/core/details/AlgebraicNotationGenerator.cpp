@@ -33,7 +33,7 @@ namespace
 		return {};
 	}
 
-	std::string toString(const CheckType checkType)
+	const char* toString(const CheckType checkType)
 	{
 		switch (checkType)
 		{
@@ -46,7 +46,7 @@ namespace
 		}
 	}
 
-	std::string toString(const PieceType type)
+	const char* toString(const PieceType type)
 	{
 		switch (type)
 		{
@@ -110,6 +110,7 @@ namespace
 					move.piece().color());
 
 		uint8_t ambiguityMask = 0;
+		bool isAmbiguous = false;
 
 		for (const auto& otherMove : allPossibleMoves)
 		{
@@ -117,6 +118,8 @@ namespace
 					&& otherMove.dst() == move.dst()
 					&& otherMove.src() != move.src())
 			{
+				isAmbiguous = true;
+
 				// If another piece of the same type could move to the same
 				// square, the move is ambiguous
 				if (otherMove.src().rank() == move.src().rank())
@@ -131,6 +134,13 @@ namespace
 			}
 		}
 
+		if (isAmbiguous && ambiguityMask == 0)
+		{
+			// The other piece shares neither rank nor file, in which case
+			// the file is preferred to resolve the ambiguity
+			ambiguityMask |= AlgebraicAmbiguity::SameRank;
+		}
+
 		return ambiguityMask;
 	}
 }
@@ -219,3 +229,157 @@ std::string AlgebraicNotationGenerator::toAlgebraicNotation(
 
 	return ss.str();
 }
+
+std::string AlgebraicNotationGenerator::toAlgebraicNotation(
+		const Position& position,
+		const Move& move,
+		const bool drawOffered,
+		const CheckType checkType)
+{
+	char result[MaxLength + 1];
+	const size_t length = toAlgebraicNotation(
+			position,
+			move,
+			drawOffered,
+			checkType,
+			result);
+
+	return std::string(result, length);
+}
+
+size_t AlgebraicNotationGenerator::toAlgebraicNotation(
+		const Position& position,
+		const Move& move,
+		const bool drawOffered,
+		const CheckType checkType,
+		char (&output)[MaxLength + 1])
+{
+	const uint8_t code = position.pieceCodeAt(move.src);
+	const PieceType type = pieceTypeOf(code);
+	const Color color = colorOf(code);
+
+	const bool isCapture =
+		position.pieceCodeAt(move.dst) != NoPiece
+		|| (type == PieceType::Pawn && fileOf(move.src) != fileOf(move.dst));
+
+	size_t length = 0;
+
+	const auto append = [&output, &length](const char* text)
+	{
+		while (*text != '\0')
+		{
+			output[length++] = *text++;
+		}
+	};
+
+	if (type == PieceType::King
+			&& (fileOf(move.src) > fileOf(move.dst)
+				? fileOf(move.src) - fileOf(move.dst)
+				: fileOf(move.dst) - fileOf(move.src)) == 2)
+	{
+		append((fileOf(move.dst) > fileOf(move.src)) ? "O-O" : "O-O-O");
+		append(::toString(checkType));
+		append(drawOffered ? "(=)" : "");
+		output[length] = '\0';
+		return length;
+	}
+
+	// Pieces of the same type which could also reach the destination square
+	Bitboard candidates = 0;
+
+	switch (type)
+	{
+		case PieceType::Pawn:
+			// Only captures can be ambiguous, and only with another capture
+			candidates = isCapture
+				? pawnAttacks(oppositeColor(color), move.dst)
+				: 0;
+			break;
+		case PieceType::Knight:
+			candidates = knightAttacks(move.dst);
+			break;
+		case PieceType::Bishop:
+			candidates = bishopAttacks(move.dst, position.occupied());
+			break;
+		case PieceType::Rook:
+			candidates = rookAttacks(move.dst, position.occupied());
+			break;
+		case PieceType::Queen:
+			candidates = queenAttacks(move.dst, position.occupied());
+			break;
+		case PieceType::King:
+			break;
+	}
+
+	candidates &= position.pieces(color, type) & ~bit(move.src);
+
+	uint8_t ambiguityMask = 0;
+	bool isAmbiguous = false;
+
+	while (candidates)
+	{
+		const uint8_t other = popLsb(candidates);
+
+		if (!position.isLegal({other, move.dst, move.promotion}))
+		{
+			continue;
+		}
+
+		isAmbiguous = true;
+
+		if (rankOf(other) == rankOf(move.src))
+		{
+			ambiguityMask |= AlgebraicAmbiguity::SameRank;
+		}
+
+		if (fileOf(other) == fileOf(move.src))
+		{
+			ambiguityMask |= AlgebraicAmbiguity::SameFile;
+		}
+	}
+
+	if (isAmbiguous && ambiguityMask == 0)
+	{
+		// Neither rank nor file is shared, the file is preferred
+		ambiguityMask |= AlgebraicAmbiguity::SameRank;
+	}
+
+	const char srcFile = static_cast<char>('a' + fileOf(move.src));
+
+	append(::toString(type));
+
+	if ((ambiguityMask & AlgebraicAmbiguity::SameRank) != 0)
+	{
+		output[length++] = srcFile;
+	}
+
+	if ((ambiguityMask & AlgebraicAmbiguity::SameFile) != 0)
+	{
+		output[length++] = static_cast<char>('1' + rankOf(move.src));
+	}
+
+	if (isCapture)
+	{
+		if (type == PieceType::Pawn && length == 0)
+		{
+			output[length++] = srcFile;
+		}
+
+		output[length++] = 'x';
+	}
+
+	output[length++] = static_cast<char>('a' + fileOf(move.dst));
+	output[length++] = static_cast<char>('1' + rankOf(move.dst));
+
+	if (move.promotion != PieceType::Pawn)
+	{
+		output[length++] = '=';
+		append(::toString(move.promotion));
+	}
+
+	append(::toString(checkType));
+	append(drawOffered ? "(=)" : "");
+	output[length] = '\0';
+
+	return length;
+}
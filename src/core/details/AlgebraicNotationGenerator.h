@@ -1,10 +1,13 @@
 #ifndef ALGEBRAIC_NOTATION_GENERATOR_H_D2B88175_AF8F_49B0_99A5_05630DE54230
 #define ALGEBRAIC_NOTATION_GENERATOR_H_D2B88175_AF8F_49B0_99A5_05630DE54230
 
+#include "bitboard/Position.h"
+
 #include <cpp/simplechess/Board.h>
 #include <cpp/simplechess/PieceMove.h>
 #include <cpp/simplechess/PlayedMove.h>
 
+#include <cstddef>
 #include <string>
 
 namespace simplechess
@@ -19,6 +22,41 @@ namespace simplechess
 						const PieceMove& move,
 						const bool drawOffered,
 						const CheckType checkType);
+
+				/**
+				 * \brief Returns the algebraic notation of \p move, which
+				 * must be legal in \p position.
+				 *
+				 * The result is the same as the one of the \ref Board
+				 * overload, but ambiguity is resolved by looking up the
+				 * pieces which attack the destination square instead of
+				 * generating every available move.
+				 */
+				static std::string toAlgebraicNotation(
+						const Position& position,
+						const Move& move,
+						const bool drawOffered,
+						const CheckType checkType);
+
+				/**
+				 * \brief The length of the longest algebraic notation of a
+				 * move, such as "Qa1xb2#(=)".
+				 */
+				static constexpr size_t MaxLength = 10;
+
+				/**
+				 * \brief Writes the algebraic notation of \p move, which
+				 * must be legal in \p position, followed by a null
+				 * character into \p output, without allocating memory.
+				 *
+				 * \return The length of the notation.
+				 */
+				static size_t toAlgebraicNotation(
+						const Position& position,
+						const Move& move,
+						const bool drawOffered,
+						const CheckType checkType,
+						char (&output)[MaxLength + 1]);
 		};
 	}
 }
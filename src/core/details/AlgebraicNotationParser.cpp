@@ -0,0 +1,261 @@
+#include "AlgebraicNotationParser.h"
+
+using namespace simplechess;
+using namespace simplechess::details;
+
+namespace
+{
+	bool isFile(const char c)
+	{
+		return c >= 'a' && c <= 'h';
+	}
+
+	bool isRank(const char c)
+	{
+		return c >= '1' && c <= '8';
+	}
+
+	std::optional<PieceType> pieceTypeFromLetter(const char c)
+	{
+		switch (c)
+		{
+			case 'R':
+				return PieceType::Rook;
+			case 'N':
+				return PieceType::Knight;
+			case 'B':
+				return PieceType::Bishop;
+			case 'Q':
+				return PieceType::Queen;
+			case 'K':
+				return PieceType::King;
+			default:
+				return std::nullopt;
+		}
+	}
+
+	/**
+	 * Removes everything after the destination square which does not
+	 * change the meaning of the move: draw offers, check and mate
+	 * indicators and annotation glyphs.
+	 */
+	std::string_view stripSuffixes(std::string_view san)
+	{
+		constexpr std::string_view drawOffer = "(=)";
+
+		if (san.size() >= drawOffer.size()
+				&& san.substr(san.size() - drawOffer.size()) == drawOffer)
+		{
+			san.remove_suffix(drawOffer.size());
+		}
+
+		while (!san.empty()
+				&& (san.back() == '+' || san.back() == '#'
+					|| san.back() == '!' || san.back() == '?'))
+		{
+			san.remove_suffix(1);
+		}
+
+		return san;
+	}
+
+	std::optional<Move> legalCastling(
+			const Position& position,
+			const bool kingSide)
+	{
+		const uint8_t kingHome = squareIndex(
+				(position.activeColor() == Color::White) ? 1 : 8,
+				'e');
+
+		const Move move = {
+			kingHome,
+			static_cast<uint8_t>(kingSide ? kingHome + 2 : kingHome - 2),
+			PieceType::Pawn };
+
+		if (!position.isLegal(move))
+		{
+			return std::nullopt;
+		}
+
+		return move;
+	}
+
+	/**
+	 * Squares from which a pawn of the active color could reach \p dst
+	 * without capturing.
+	 */
+	Bitboard pawnPushOrigins(const Position& position, const uint8_t dst)
+	{
+		const Color us = position.activeColor();
+		const Bitboard pawns = position.pieces(us, PieceType::Pawn);
+		const int back = (us == Color::White) ? -8 : 8;
+
+		const int oneBehind = dst + back;
+		if (oneBehind < 0 || oneBehind > 63)
+		{
+			return 0;
+		}
+
+		if (pawns & bit(static_cast<uint8_t>(oneBehind)))
+		{
+			return bit(static_cast<uint8_t>(oneBehind));
+		}
+
+		const int twoBehind = oneBehind + back;
+		if (twoBehind < 0 || twoBehind > 63
+				|| (position.occupied() & bit(static_cast<uint8_t>(oneBehind))))
+		{
+			return 0;
+		}
+
+		return pawns & bit(static_cast<uint8_t>(twoBehind));
+	}
+}
+
+std::optional<Move> AlgebraicNotationParser::parse(
+		const Position& position,
+		std::string_view san)
+{
+	san = ::stripSuffixes(san);
+
+	// Castling is handled differently
+	if (san == "O-O" || san == "0-0")
+	{
+		return ::legalCastling(position, true);
+	}
+
+	if (san == "O-O-O" || san == "0-0-0")
+	{
+		return ::legalCastling(position, false);
+	}
+
+	if (san.size() < 2)
+	{
+		return std::nullopt;
+	}
+
+	// 1. Piece letter (absent for pawns)
+	size_t begin = 0;
+	PieceType type = PieceType::Pawn;
+
+	if (const std::optional<PieceType> letterType = ::pieceTypeFromLetter(san[0]))
+	{
+		type = *letterType;
+		begin = 1;
+	}
+
+	// 2. Promotion suffix, with or without the '=' sign
+	size_t end = san.size();
+	PieceType promotion = PieceType::Pawn;
+
+	if (type == PieceType::Pawn && end >= 3)
+	{
+		const std::optional<PieceType> promotedType
+			= ::pieceTypeFromLetter(san[end - 1]);
+
+		if (promotedType)
+		{
+			promotion = *promotedType;
+			--end;
+
+			if (san[end - 1] == '=')
+			{
+				--end;
+			}
+		}
+	}
+
+	// 3. Destination square
+	if (end < begin + 2
+			|| !::isFile(san[end - 2])
+			|| !::isRank(san[end - 1]))
+	{
+		return std::nullopt;
+	}
+
+	const uint8_t dst = squareIndex(
+			static_cast<uint8_t>(san[end - 1] - '0'),
+			san[end - 2]);
+	end -= 2;
+
+	// 4. Capture symbol
+	if (end > begin && san[end - 1] == 'x')
+	{
+		--end;
+	}
+
+	// 5. Disambiguation characters (for pawns, the original file)
+	Bitboard originMask = ~Bitboard(0);
+	bool hasOriginFile = false;
+
+	if (begin < end && ::isFile(san[begin]))
+	{
+		originMask &= FileA << (san[begin] - 'a');
+		hasOriginFile = true;
+		++begin;
+	}
+
+	if (begin < end && ::isRank(san[begin]))
+	{
+		originMask &= Rank1 << (8 * (san[begin] - '1'));
+		++begin;
+	}
+
+	if (begin != end)
+	{
+		return std::nullopt;
+	}
+
+	// Reverse attack lookup: which pieces of the right type could land on
+	// the destination square
+	const Color us = position.activeColor();
+	const Bitboard ours = position.pieces(us, type);
+	const Bitboard occupied = position.occupied();
+	Bitboard candidates = 0;
+
+	switch (type)
+	{
+		case PieceType::Pawn:
+			candidates = (hasOriginFile && (originMask & bit(dst)) == 0)
+				? pawnAttacks(oppositeColor(us), dst) & ours
+				: ::pawnPushOrigins(position, dst);
+			break;
+		case PieceType::Knight:
+			candidates = knightAttacks(dst) & ours;
+			break;
+		case PieceType::Bishop:
+			candidates = bishopAttacks(dst, occupied) & ours;
+			break;
+		case PieceType::Rook:
+			candidates = rookAttacks(dst, occupied) & ours;
+			break;
+		case PieceType::Queen:
+			candidates = queenAttacks(dst, occupied) & ours;
+			break;
+		case PieceType::King:
+			candidates = kingAttacks(dst) & ours;
+			break;
+	}
+
+	candidates &= originMask;
+
+	std::optional<Move> result;
+
+	while (candidates)
+	{
+		const Move move = {popLsb(candidates), dst, promotion};
+
+		if (position.isLegal(move))
+		{
+			if (result)
+			{
+				// More than one piece could make the move: ambiguous
+				return std::nullopt;
+			}
+
+			result = move;
+		}
+	}
+
+	return result;
+}
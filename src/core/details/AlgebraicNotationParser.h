@@ -0,0 +1,39 @@
+#ifndef ALGEBRAIC_NOTATION_PARSER_H_6C1A9E37_52D4_4B0F_A8E2_93F07D4B6C15
+#define ALGEBRAIC_NOTATION_PARSER_H_6C1A9E37_52D4_4B0F_A8E2_93F07D4B6C15
+
+#include "bitboard/Position.h"
+
+#include <optional>
+
+#include <string_view>
+
+namespace simplechess
+{
+	namespace details
+	{
+		class AlgebraicNotationParser
+		{
+			public:
+				/**
+				 * \brief Returns the legal move in \p position described by
+				 * \p san in Standard Algebraic Notation.
+				 *
+				 * Candidate source squares are found by looking up which
+				 * pieces of the right type attack the destination square,
+				 * so the full list of available moves is never generated.
+				 *
+				 * Check and mate indicators, annotation glyphs ("!", "?")
+				 * and the draw offer suffix produced by \ref
+				 * AlgebraicNotationGenerator are accepted and ignored.
+				 *
+				 * \return The described move, or an empty value if \p san
+				 * is malformed, ambiguous or does not describe a legal move.
+				 */
+				static std::optional<Move> parse(
+						const Position& position,
+						std::string_view san);
+		};
+	}
+}
+
+#endif
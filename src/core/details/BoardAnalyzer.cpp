@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <cstdlib>
 #include <stdexcept>
+#include <utility>
 
 using namespace simplechess;
 using namespace simplechess::details;
@@ -86,7 +87,7 @@ std::set<Square> BoardAnalyzer::reachableSquaresInDirection(
 					src.rank() + i*rankStep,
 					src.file() + i*fileStep))
 		{
-			const Square dst = Square::fromRankAndFile(
+			const Square dst = SquareBuilder::build(
 					src.rank() + i*rankStep,
 					src.file() + i*fileStep);
 
@@ -133,7 +134,9 @@ Board BoardAnalyzer::makeMoveOnBoard(
 		const Board& board,
 		const PieceMove& move)
 {
-	std::map<Square, Piece> positions = board.occupiedSquares();
+	std::pmr::map<Square, Piece> positions(
+			board.occupiedSquares(),
+			board.get_allocator());
 
 	if (move.piece().type() == PieceType::King
 			&& abs(move.dst().file() - move.src().file()) == 2)
@@ -145,17 +148,17 @@ Board BoardAnalyzer::makeMoveOnBoard(
 
 		// ... and the rook
 		const Square rookSrc = (move.dst().file() == 'g')
-			? Square::fromRankAndFile(move.dst().rank(), 'h')
-			: Square::fromRankAndFile(move.dst().rank(), 'a');
+			? SquareBuilder::build(move.dst().rank(), 'h')
+			: SquareBuilder::build(move.dst().rank(), 'a');
 
 		const Square rookDst = (move.dst().file() == 'g')
-			? Square::fromRankAndFile(move.dst().rank(), 'f')
-			: Square::fromRankAndFile(move.dst().rank(), 'd');
+			? SquareBuilder::build(move.dst().rank(), 'f')
+			: SquareBuilder::build(move.dst().rank(), 'd');
 
 		positions.insert({rookDst, positions.at(rookSrc)});
 		positions.erase(rookSrc);
 
-		return BoardBuilder::build(positions);
+		return BoardBuilder::build(std::move(positions));
 	}
 
 	if (move.piece().type() == PieceType::Pawn
@@ -168,11 +171,11 @@ Board BoardAnalyzer::makeMoveOnBoard(
 
 		// Remove the captured pawn
 		positions.erase(
-				Square::fromRankAndFile(
+				SquareBuilder::build(
 					move.dst().rank() + (move.dst().rank() == 6 ? -1 : 1),
 					move.dst().file()));
 
-		return BoardBuilder::build(positions);
+		return BoardBuilder::build(std::move(positions));
 	}
 
 	positions.erase(move.dst());
@@ -183,5 +186,5 @@ Board BoardAnalyzer::makeMoveOnBoard(
 				: move.piece()});
 
 	positions.erase(move.src());
-	return BoardBuilder::build(positions);
+	return BoardBuilder::build(std::move(positions));
 }
@@ -0,0 +1,21 @@
+#include "CpuFeatures.h"
+
+using namespace simplechess;
+
+bool details::processorHasAvx2()
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	return __builtin_cpu_supports("avx2");
+#else
+	return false;
+#endif
+}
+
+bool details::processorHasAvx512()
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	return __builtin_cpu_supports("avx512f");
+#else
+	return false;
+#endif
+}
@@ -0,0 +1,21 @@
+#ifndef CPU_FEATURES_H_DA1C0D03_DF54_45A2_8DAA_903972333CE9
+#define CPU_FEATURES_H_DA1C0D03_DF54_45A2_8DAA_903972333CE9
+
+namespace simplechess
+{
+	namespace details
+	{
+		/**
+		 * \brief Whether the processor running the library supports AVX2.
+		 */
+		bool processorHasAvx2();
+
+		/**
+		 * \brief Whether the processor running the library supports the
+		 * AVX-512 foundation instructions.
+		 */
+		bool processorHasAvx512();
+	}
+}
+
+#endif
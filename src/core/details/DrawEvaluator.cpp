@@ -5,6 +5,10 @@
 #include "MoveValidator.h"
 #include "fen/FenUtils.h"
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
 using namespace simplechess;
 using namespace simplechess::details;
 
@@ -37,10 +41,15 @@ namespace internal
 		//   - King + Bishop vs King
 		//   - King + Knight vs King
 		//   - King + Bishop vs King + Bishop (same coloured bishops)
-		std::set<Piece> whitePieces;
-		std::set<Piece> blackPieces;
+		//
+		// The sets hold at most 6 pieces each, so they fit in a buffer on
+		// the stack.
+		std::array<std::byte, 1024> buffer;
+		std::pmr::monotonic_buffer_resource scratch(buffer.data(), buffer.size());
+		std::pmr::set<Piece> whitePieces(&scratch);
+		std::pmr::set<Piece> blackPieces(&scratch);
 
-		const std::map<Square, Piece> occupiedSquares = board.occupiedSquares();
+		const std::pmr::map<Square, Piece>& occupiedSquares = board.occupiedSquares();
 
 		for (const auto& entry : occupiedSquares)
 		{
@@ -117,17 +126,16 @@ namespace internal
 		}
 
 		// One side has only the King and the other has King + some other piece
-		const std::set<Piece>& piecesOfRelevantSide
+		const std::pmr::set<Piece>& piecesOfRelevantSide
 			= (whitePieces.size() > 1)
 				? whitePieces
 				: blackPieces;
 
-		const std::set<PieceType> drawingTypes
-			= {PieceType::King, PieceType::Knight, PieceType::Bishop};
-
 		for (const Piece& piece : piecesOfRelevantSide)
 		{
-			if (drawingTypes.count(piece.type()) == 0)
+			if (piece.type() != PieceType::King
+					&& piece.type() != PieceType::Knight
+					&& piece.type() != PieceType::Bishop)
 			{
 				// Found one piece which is neither King, Bishop or Knight
 				return true;
@@ -141,15 +149,18 @@ namespace internal
 
 std::optional<DrawReason> DrawEvaluator::reasonToDraw(
 		const GameStage& stage,
-		const std::map<std::string, uint8_t>& previouslyReachedPositions,
+		const RepetitionCounts& previouslyReachedPositions,
 		bool drawOffered)
 {
-	const std::set<PieceMove> allPossibleMoves
+	const std::set<PieceMove> availableMoves
 		= MoveValidator::allAvailableMoves(
 				stage.board(),
 				stage.enPassantTarget(),
 				stage.castlingRights(),
 				stage.activeColor());
+	const std::pmr::set<PieceMove> allPossibleMoves(
+			availableMoves.begin(),
+			availableMoves.end());
 
 	const bool inCheck
 		= BoardAnalyzer::isInCheck(stage.board(), stage.activeColor());
@@ -165,8 +176,8 @@ std::optional<DrawReason> DrawEvaluator::reasonToDraw(
 std::optional<DrawReason> DrawEvaluator::reasonToDraw(
 		const GameStage& stage,
 		const bool isInCheck,
-		const std::set<PieceMove> allPossibleMoves,
-		const std::map<std::string, uint8_t>& previouslyReachedPositions,
+		const std::pmr::set<PieceMove>& allPossibleMoves,
+		const RepetitionCounts& previouslyReachedPositions,
 		bool drawOffered)
 {
 	if (stage.halfMovesSinceLastCaptureOrPawnAdvance() >= 150)
@@ -175,12 +186,13 @@ std::optional<DrawReason> DrawEvaluator::reasonToDraw(
 	}
 
 	// It is possible the current stage if the fifth repetition
-	const std::string relevantFen
-		= FenUtils::fenForRepetitions(stage.fen());
+	const RepetitionCounts::const_iterator timesReached
+		= previouslyReachedPositions.find(
+				FenUtils::fenForRepetitions(stage.fen()));
 
 	const uint8_t timesPositionAppearedPreviously =
-		(previouslyReachedPositions.count(relevantFen) != 0)
-			? previouslyReachedPositions.at(relevantFen)
+		(timesReached != previouslyReachedPositions.end())
+			? timesReached->second
 			: 0;
 
 	if (timesPositionAppearedPreviously >= 4)
@@ -223,6 +235,18 @@ std::optional<DrawReason> DrawEvaluator::reasonToDraw(
 		return { DrawReason::ThreeFoldRepetition };
 	}
 
+	// Playing every move is only worth it if some position has been
+	// reached twice already
+	const bool anyPositionReachedTwice = std::any_of(
+			previouslyReachedPositions.begin(),
+			previouslyReachedPositions.end(),
+			[](const auto& entry) { return entry.second >= 2; });
+
+	if (!anyPositionReachedTwice)
+	{
+		return {};
+	}
+
 	for (const auto& move : allPossibleMoves)
 	{
 		// To achieve the hypothetical next stage we don't care about draw
@@ -230,11 +254,95 @@ std::optional<DrawReason> DrawEvaluator::reasonToDraw(
 		const GameStage nextStage
 			= GameStageUpdater::makeMove(stage, move, false);
 
-		const std::string relevantFen
-			= FenUtils::fenForRepetitions(nextStage.fen());
+		const RepetitionCounts::const_iterator timesNextReached
+			= previouslyReachedPositions.find(
+					FenUtils::fenForRepetitions(nextStage.fen()));
+
+		if (timesNextReached != previouslyReachedPositions.end()
+				&& timesNextReached->second >= 2)
+		{
+			return { DrawReason::ThreeFoldRepetition };
+		}
+	}
+
+	return {};
+}
+
+std::optional<DrawReason> DrawEvaluator::reasonToDraw(
+		const Position& position,
+		const MoveList& legalMoves,
+		const ReachedPosition* previouslyReachedPositions,
+		const size_t previouslyReachedCount,
+		const bool drawOffered)
+{
+	if (position.halfmoveClock() >= 150)
+	{
+		return { DrawReason::SeventyFiveMoveRule };
+	}
+
+	const uint8_t timesPositionAppearedPreviously = timesReached(
+			previouslyReachedPositions,
+			previouslyReachedCount,
+			position.hash());
+
+	if (timesPositionAppearedPreviously >= 4)
+	{
+		return { DrawReason::FiveFoldRepetition };
+	}
+
+	if (legalMoves.size == 0 && !position.inCheck())
+	{
+		return { DrawReason::StaleMate };
+	}
+
+	if (isInsufficientMaterial(position))
+	{
+		return { DrawReason::InsufficientMaterial };
+	}
+
+	const Color opponent = oppositeColor(position.activeColor());
+
+	if (position.pieces(opponent) == position.pieces(opponent, PieceType::King))
+	{
+		return { DrawReason::OpponentInsufficientMaterial };
+	}
+
+	if (drawOffered)
+	{
+		return { DrawReason::OfferedAndAccepted };
+	}
+
+	if (position.halfmoveClock() >= 99)
+	{
+		return { DrawReason::FiftyMoveRule };
+	}
+
+	if (timesPositionAppearedPreviously >= 2)
+	{
+		return { DrawReason::ThreeFoldRepetition };
+	}
+
+	// As in the other overload, the moves are only played if some position
+	// has been reached twice already
+	const ReachedPosition* const end
+		= previouslyReachedPositions + previouslyReachedCount;
 
-		if (previouslyReachedPositions.count(relevantFen)
-				&& previouslyReachedPositions.at(relevantFen) >= 2)
+	const bool anyPositionReachedTwice = std::any_of(
+			previouslyReachedPositions,
+			end,
+			[](const ReachedPosition& reached) { return reached.timesReached >= 2; });
+
+	if (!anyPositionReachedTwice)
+	{
+		return {};
+	}
+
+	for (const Move& move : legalMoves)
+	{
+		Position next = position;
+		next.makeMove(move);
+
+		if (timesReached(previouslyReachedPositions, previouslyReachedCount, next.hash()) >= 2)
 		{
 			return { DrawReason::ThreeFoldRepetition };
 		}
@@ -242,3 +350,80 @@ std::optional<DrawReason> DrawEvaluator::reasonToDraw(
 
 	return {};
 }
+
+uint8_t DrawEvaluator::timesReached(
+		const ReachedPosition* positions,
+		const size_t count,
+		const uint64_t hash)
+{
+	// The last time the position was reached tells how many times it was
+	for (size_t i = count; i > 0; --i)
+	{
+		if (positions[i - 1].hash == hash)
+		{
+			return positions[i - 1].timesReached;
+		}
+	}
+
+	return 0;
+}
+
+bool DrawEvaluator::isInsufficientMaterial(const Position& position)
+{
+	for (const Color color : {Color::White, Color::Black})
+	{
+		if ((position.pieces(color, PieceType::Pawn)
+					| position.pieces(color, PieceType::Rook)
+					| position.pieces(color, PieceType::Queen)) != 0)
+		{
+			return false;
+		}
+	}
+
+	const auto typesOf = [&position](const Color color)
+	{
+		return 1
+			+ (position.pieces(color, PieceType::Knight) != 0 ? 1 : 0)
+			+ (position.pieces(color, PieceType::Bishop) != 0 ? 1 : 0);
+	};
+
+	const int whiteTypes = typesOf(Color::White);
+	const int blackTypes = typesOf(Color::Black);
+
+	if (whiteTypes > 2 || blackTypes > 2)
+	{
+		return false;
+	}
+
+	if (whiteTypes < 2 || blackTypes < 2)
+	{
+		// A lone king against king and knights or bishops
+		return true;
+	}
+
+	if (position.pieces(Color::White, PieceType::Bishop) == 0
+			|| position.pieces(Color::Black, PieceType::Bishop) == 0)
+	{
+		return false;
+	}
+
+	const Bitboard bishops
+		= position.pieces(Color::White, PieceType::Bishop)
+		| position.pieces(Color::Black, PieceType::Bishop);
+
+	int found = 0;
+	int squareColors[2] = {0, 0};
+
+	for (uint8_t key = 0; key < 64 && found < 2; ++key)
+	{
+		// Squares from a8 to h1, rank by rank
+		const uint8_t square = key ^ 56;
+
+		if (bishops & bit(square))
+		{
+			squareColors[found++] = (rankOf(square) + fileOf(square)) % 2;
+		}
+	}
+
+	return squareColors[0] == squareColors[1];
+}
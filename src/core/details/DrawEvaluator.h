@@ -1,17 +1,45 @@
 #ifndef DRAW_EVALUATOR_H_B4AF96CF_8DE1_4557_96AD_BF906AE79F49
 #define DRAW_EVALUATOR_H_B4AF96CF_8DE1_4557_96AD_BF906AE79F49
 
+#include "bitboard/Position.h"
+
 #include <cpp/simplechess/Game.h>
 #include <cpp/simplechess/GameStage.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
 #include <optional>
 
+#include <map>
 #include <set>
+#include <string_view>
 
 namespace simplechess
 {
 	namespace details
 	{
+		/**
+		 * \brief How many times each position has been reached, keyed by
+		 * the relevant fields of its FEN string (see \ref
+		 * FenUtils::fenForRepetitions()).
+		 *
+		 * The keys are views, so the FEN strings they point into must
+		 * outlive the map.
+		 */
+		using RepetitionCounts = std::pmr::map<std::string_view, uint8_t>;
+
+		/**
+		 * \brief A position reached in a game, described by its hash (see
+		 * \ref Position::hash()), and how many times it had been reached
+		 * since the last capture or pawn advance, including this time.
+		 */
+		struct ReachedPosition
+		{
+			uint64_t hash;
+			uint8_t timesReached;
+		};
+
 		/**
 		 * \brief Collection of static methods to evaluate and infer the state
 		 * of a \ref Game as it relates to drawing.
@@ -38,7 +66,7 @@ namespace simplechess
 				 */
 				static std::optional<DrawReason> reasonToDraw(
 						const GameStage& stage,
-						const std::map<std::string, uint8_t>& previouslyReachedPositions,
+						const RepetitionCounts& previouslyReachedPositions,
 						bool drawOffered = false);
 
 				/**
@@ -69,9 +97,56 @@ namespace simplechess
 				static std::optional<DrawReason> reasonToDraw(
 						const GameStage& stage,
 						bool isInCheck,
-						const std::set<PieceMove> allAvailableMoves,
-						const std::map<std::string, uint8_t>& previouslyReachedPositions,
+						const std::pmr::set<PieceMove>& allAvailableMoves,
+						const RepetitionCounts& previouslyReachedPositions,
+						bool drawOffered);
+
+				/**
+				 * \brief Returns a reason why a game at \p position could be
+				 * drawn, with the same rules as the other overloads, but
+				 * without generating any stage or allocating memory.
+				 *
+				 * \param position The position of the game being evaluated.
+				 * \param legalMoves All the moves available from \p
+				 * position.
+				 * \param previouslyReachedPositions The positions reached
+				 * before \p position since the last capture or pawn
+				 * advance, in the order they were reached. As with the map
+				 * of the other overloads, the position which was just left
+				 * is not included.
+				 * \param previouslyReachedCount The number of elements of
+				 * \p previouslyReachedPositions.
+				 *
+				 * \return A reason why the game could be drawn, or an empty
+				 * value if no such reason is found.
+				 */
+				static std::optional<DrawReason> reasonToDraw(
+						const Position& position,
+						const MoveList& legalMoves,
+						const ReachedPosition* previouslyReachedPositions,
+						size_t previouslyReachedCount,
 						bool drawOffered);
+
+				/**
+				 * \brief Returns how many times the position with hash \p
+				 * hash had been reached when it last appears in \p
+				 * positions, which holds \p count positions in the order
+				 * they were reached, or 0 if it does not appear.
+				 */
+				static uint8_t timesReached(
+						const ReachedPosition* positions,
+						size_t count,
+						uint64_t hash);
+
+				/**
+				 * \brief Whether neither side can mate at \p position.
+				 *
+				 * The rules are the same as those of the other methods,
+				 * which compare the sets of piece types of each side and,
+				 * for bishop against bishop, the first two bishops found
+				 * from a8 to h1.
+				 */
+				static bool isInsufficientMaterial(const Position& position);
 		};
 	}
 }
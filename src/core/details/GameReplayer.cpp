@@ -0,0 +1,211 @@
+#include "GameReplayer.h"
+
+#include "AlgebraicNotationGenerator.h"
+#include "GameStateDetector.h"
+#include "fen/FenUtils.h"
+
+#include "../Builders.h"
+
+#include <string>
+#include <utility>
+
+using namespace simplechess;
+using namespace simplechess::details;
+
+namespace
+{
+	/**
+	 * Builds the map of previously reached positions from the positions
+	 * themselves. Positions reached only once are left out, since they
+	 * cannot contribute to any n-fold repetition, so FEN strings are only
+	 * generated for the positions which actually repeat. They are stored
+	 * in \p fens, which the keys of the map point into.
+	 */
+	RepetitionCounts getPreviouslyReachedPositionsMap(
+			const std::vector<Position>& positions,
+			std::vector<std::string>& fens)
+	{
+		RepetitionCounts result;
+		std::vector<bool> counted(positions.size(), false);
+
+		// The keys must not be invalidated by a reallocation
+		fens.reserve(positions.size());
+
+		for (size_t i = 0; i < positions.size(); ++i)
+		{
+			if (counted[i])
+			{
+				continue;
+			}
+
+			uint8_t timesReached = 1;
+
+			for (size_t j = i + 1; j < positions.size(); ++j)
+			{
+				if (!counted[j] && positions[j].isRepetitionOf(positions[i]))
+				{
+					counted[j] = true;
+					++timesReached;
+				}
+			}
+
+			if (timesReached > 1)
+			{
+				fens.emplace_back(positions[i].toStage().fen());
+				result.insert({
+						FenUtils::fenForRepetitions(fens.back()),
+						timesReached});
+			}
+		}
+
+		return result;
+	}
+}
+
+GameReplayer::GameReplayer(const Game& initialGame, const bool recordHistory)
+	: mInitialGame(initialGame),
+	  mPosition(Position::fromStage(initialGame.currentStage())),
+	  mAnyMovePlayed(false),
+	  mLastMoveOfferedDraw(false),
+	  mRecordHistory(recordHistory),
+	  mHistory(initialGame.get_allocator()),
+	  mReversiblePositions()
+{
+	if (initialGame.gameState() != GameState::Playing)
+	{
+		throw IllegalStateException("Attempted to make a move in finished game");
+	}
+
+	if (recordHistory)
+	{
+		// The positions of the initial game may be repeated too
+		for (const auto& [stage, move] : initialGame.history())
+		{
+			if (stage.halfMovesSinceLastCaptureOrPawnAdvance() == 0)
+			{
+				mReversiblePositions.clear();
+			}
+
+			mReversiblePositions.push_back(Position::fromStage(stage));
+		}
+
+		if (mPosition.halfmoveClock() == 0)
+		{
+			mReversiblePositions.clear();
+		}
+	}
+}
+
+void GameReplayer::play(const Move& move, const bool offerDraw)
+{
+	if (mRecordHistory)
+	{
+		const GameStage stage = mPosition.toStage(mHistory.get_allocator());
+
+		Position afterMove = mPosition;
+		afterMove.makeMove(move);
+		const CheckType checkType = afterMove.checkStatus();
+
+		mHistory.push_back({
+				stage,
+				PlayedMoveBuilder::build(
+					mPosition.toPieceMove(move),
+					mPosition.pieceAt(move.dst),
+					offerDraw,
+					checkType,
+					AlgebraicNotationGenerator::toAlgebraicNotation(
+						mPosition,
+						move,
+						offerDraw,
+						checkType))});
+	}
+
+	mReversiblePositions.push_back(mPosition);
+	mPosition.makeMove(move);
+	mAnyMovePlayed = true;
+	mLastMoveOfferedDraw = offerDraw;
+
+	if (mPosition.halfmoveClock() == 0)
+	{
+		mReversiblePositions.clear();
+	}
+}
+
+bool GameReplayer::hasFinished() const
+{
+	if (!mAnyMovePlayed)
+	{
+		return false;
+	}
+
+	const Bitboard heavyPiecesAndPawns
+		= mPosition.pieces(Color::White, PieceType::Pawn)
+		| mPosition.pieces(Color::Black, PieceType::Pawn)
+		| mPosition.pieces(Color::White, PieceType::Rook)
+		| mPosition.pieces(Color::Black, PieceType::Rook)
+		| mPosition.pieces(Color::White, PieceType::Queen)
+		| mPosition.pieces(Color::Black, PieceType::Queen);
+
+	bool mightHaveFinished
+		= mPosition.halfmoveClock() >= 150 || heavyPiecesAndPawns == 0;
+
+	// Fivefold repetition
+	uint8_t timesReached = 0;
+
+	for (auto it = mReversiblePositions.rbegin();
+			!mightHaveFinished && it != mReversiblePositions.rend();
+			++it)
+	{
+		if (it->isRepetitionOf(mPosition) && ++timesReached >= 4)
+		{
+			mightHaveFinished = true;
+		}
+	}
+
+	return mightHaveFinished && build().gameState() != GameState::Playing;
+}
+
+Game GameReplayer::build() const
+{
+	if (!mAnyMovePlayed)
+	{
+		return Game(mInitialGame, mInitialGame.get_allocator());
+	}
+
+	const DrawEnforcement drawEnforcement = mInitialGame.drawEnforcement();
+	const GameStage currentStage = mPosition.toStage(mInitialGame.get_allocator());
+
+	std::vector<std::string> repeatedFens;
+
+	const GameStateInformation information
+		= GameStateDetector::detect(
+				currentStage,
+				mLastMoveOfferedDraw,
+				::getPreviouslyReachedPositionsMap(
+					mReversiblePositions,
+					repeatedFens),
+				drawEnforcement);
+
+	std::pmr::vector<std::pair<GameStage, PlayedMove>> history(
+			mInitialGame.get_allocator());
+
+	if (mRecordHistory)
+	{
+		history.reserve(mInitialGame.history().size() + mHistory.size());
+		history.insert(
+				history.end(),
+				mInitialGame.history().begin(),
+				mInitialGame.history().end());
+		history.insert(history.end(), mHistory.begin(), mHistory.end());
+	}
+
+	return GameBuilder::build(
+			information.gameState,
+			information.reasonItWasDrawn,
+			std::move(history),
+			currentStage,
+			information.availableMoves,
+			information.reasonToClaimDraw,
+			drawEnforcement,
+			mInitialGame.get_allocator());
+}
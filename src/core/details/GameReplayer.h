@@ -0,0 +1,102 @@
+#ifndef GAME_REPLAYER_H_5F2A8C14_D7E3_4B96_A0C1_3E8B6D94F725
+#define GAME_REPLAYER_H_5F2A8C14_D7E3_4B96_A0C1_3E8B6D94F725
+
+#include "bitboard/Position.h"
+
+#include <cpp/simplechess/Game.h>
+
+#include <utility>
+#include <vector>
+
+namespace simplechess
+{
+	namespace details
+	{
+		/**
+		 * \brief Replays a sequence of moves from a \ref Game on a \ref
+		 * Position, and builds the resulting \ref Game at the end.
+		 *
+		 * Unless the history is recorded, no \ref GameStage, FEN string or
+		 * algebraic notation is generated for the intermediate positions.
+		 * The positions reached since the last capture or pawn move are
+		 * kept, so that the n-fold repetition rules are applied to the
+		 * resulting game.
+		 */
+		class GameReplayer
+		{
+			public:
+				/**
+				 * \brief Constructor.
+				 *
+				 * \note \p initialGame must outlive the replayer.
+				 *
+				 * \throws IllegalStateException if \p initialGame has
+				 * already finished.
+				 *
+				 * \param initialGame The game to play the moves on.
+				 * \param recordHistory Whether every move played is
+				 * recorded in the history of the resulting game, as \ref
+				 * makeMove() would.
+				 */
+				explicit GameReplayer(
+						const Game& initialGame,
+						bool recordHistory = false);
+
+				/**
+				 * \brief The position reached so far.
+				 */
+				const Position& position() const
+				{
+					return mPosition;
+				}
+
+				/**
+				 * \brief Plays \p move, which must be legal in \ref
+				 * position(), optionally offering a draw with it.
+				 */
+				void play(const Move& move, bool offerDraw = false);
+
+				/**
+				 * \brief Whether the game has finished after the moves
+				 * played so far.
+				 *
+				 * Positions without legal moves are not detected here,
+				 * since no further move can be played on them anyway. The
+				 * game is only fully analysed when one of the automatic
+				 * draw rules might apply, so most calls are cheap.
+				 */
+				bool hasFinished() const;
+
+				/**
+				 * \brief Returns the game after all the moves played so far.
+				 *
+				 * Only the final position is analysed to determine the
+				 * state of the game. Unless the history is recorded, the
+				 * history of the returned game is empty. If no move was
+				 * played, the initial game is returned as is.
+				 */
+				Game build() const;
+
+			private:
+				const Game& mInitialGame;
+				Position mPosition;
+				bool mAnyMovePlayed;
+				bool mLastMoveOfferedDraw;
+				bool mRecordHistory;
+
+				/**
+				 * The moves played, if the history is recorded.
+				 */
+				std::pmr::vector<std::pair<GameStage, PlayedMove>> mHistory;
+
+				/**
+				 * Positions reached since the last capture or pawn move
+				 * (the only ones which can be repeated), excluding the
+				 * current one.
+				 */
+				std::vector<Position> mReversiblePositions;
+		};
+	}
+}
+
+#endif
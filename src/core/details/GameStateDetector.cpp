@@ -1,37 +1,32 @@
 #include "GameStateDetector.h"
 
-#include "BoardAnalyzer.h"
 #include "DrawEvaluator.h"
-#include "MoveValidator.h"
+#include "bitboard/Position.h"
 
 #include <boost/tuple/tuple.hpp>
 
+#include <utility>
+
 using namespace simplechess;
 using namespace simplechess::details;
 
 namespace internal
 {
-	std::optional<Square> enPassantTarget(
-			const GameStage& stage)
-	{
-		return stage.enPassantTarget();
-	}
-
-	boost::tuple<GameState, std::optional<DrawReason>> inferGameStateFromStage(
-			const GameStage& stage,
+	boost::tuple<GameState, std::optional<DrawReason>> inferGameState(
+			const Color activeColor,
 			const bool inCheck,
-			const std::set<PieceMove> allPossibleMoves,
+			const size_t availableMoveCount,
 			const std::optional<DrawReason> reasonToClaimDraw,
 			const DrawEnforcement drawEnforcement)
 	{
 		if (inCheck)
 		{
-			if (allPossibleMoves.size() == 0)
+			if (availableMoveCount == 0)
 			{
 				// If the active color can't move and is in check, it is check
 				// mate
 				return {
-					stage.activeColor() == Color::White
+					activeColor == Color::White
 						? GameState::BlackWon
 						: GameState::WhiteWon,
 						{} };
@@ -61,19 +56,23 @@ namespace internal
 GameStateInformation GameStateDetector::detect(
 		const GameStage& stage,
 		bool drawOffered,
-		const std::map<std::string, uint8_t>& previouslyReachedPositions,
+		const RepetitionCounts& previouslyReachedPositions,
 		const DrawEnforcement drawEnforcement)
 {
-	const bool inCheck = BoardAnalyzer::isInCheck(
-			stage.board(),
-			stage.activeColor());
+	// The moves are generated on the stack with the bitboard
+	// representation, which follows the same rules as MoveValidator
+	const Position position = Position::fromStage(stage);
+	const bool inCheck = position.inCheck();
+
+	MoveList moves;
+	position.legalMoves(moves);
 
-	const std::set<PieceMove> availableMoves
-		= MoveValidator::allAvailableMoves(
-				stage.board(),
-				internal::enPassantTarget(stage),
-				stage.castlingRights(),
-				stage.activeColor());
+	std::pmr::set<PieceMove> availableMoves;
+
+	for (const Move& move : moves)
+	{
+		availableMoves.insert(position.toPieceMove(move));
+	}
 
 	const CheckType checkType = (inCheck
 		? ((availableMoves.size() == 0)
@@ -90,18 +89,57 @@ GameStateInformation GameStateDetector::detect(
 				drawOffered);
 
 	const boost::tuple<GameState, std::optional<DrawReason>> gameState
-		= internal::inferGameStateFromStage(
-			stage,
+		= internal::inferGameState(
+			stage.activeColor(),
 			inCheck,
-			availableMoves,
+			availableMoves.size(),
 			reasonToClaimDraw,
 			drawEnforcement);
 
 	return {
 		gameState.get<0>(),
 			checkType,
-			availableMoves,
+			std::move(availableMoves),
 			gameState.get<1>(),
 			reasonToClaimDraw };
 
 }
+
+PositionStateInformation GameStateDetector::detect(
+		const Position& position,
+		const MoveList& legalMoves,
+		const bool drawOffered,
+		const ReachedPosition* previouslyReachedPositions,
+		const size_t previouslyReachedCount,
+		const DrawEnforcement drawEnforcement)
+{
+	const bool inCheck = position.inCheck();
+
+	const CheckType checkType = (inCheck
+		? ((legalMoves.size == 0)
+				? CheckType::CheckMate
+				: CheckType::Check)
+		: CheckType::NoCheck);
+
+	const std::optional<DrawReason> reasonToClaimDraw
+		= details::DrawEvaluator::reasonToDraw(
+				position,
+				legalMoves,
+				previouslyReachedPositions,
+				previouslyReachedCount,
+				drawOffered);
+
+	const boost::tuple<GameState, std::optional<DrawReason>> gameState
+		= internal::inferGameState(
+			position.activeColor(),
+			inCheck,
+			legalMoves.size,
+			reasonToClaimDraw,
+			drawEnforcement);
+
+	return {
+		gameState.get<0>(),
+			checkType,
+			gameState.get<1>(),
+			reasonToClaimDraw };
+}
@@ -1,8 +1,11 @@
 #ifndef GAME_STATE_DETECTOR_H_19318747_4966_4AD2_A8A4_173A832713DD
 #define GAME_STATE_DETECTOR_H_19318747_4966_4AD2_A8A4_173A832713DD
 
+#include "DrawEvaluator.h"
+
 #include <cpp/simplechess/Game.h>
-#include <map>
+
+#include <utility>
 
 namespace simplechess
 {
@@ -16,12 +19,12 @@ namespace simplechess
 			GameStateInformation(
 					const GameState gameState,
 					const CheckType checkType,
-					const std::set<PieceMove>& availableMoves,
+					std::pmr::set<PieceMove> availableMoves,
 					const std::optional<DrawReason>& reasonItWasDrawn,
 					const std::optional<DrawReason>& reasonToClaimDraw)
 				: gameState(gameState),
 				checkType(checkType),
-				availableMoves(availableMoves),
+				availableMoves(std::move(availableMoves)),
 				reasonItWasDrawn(reasonItWasDrawn),
 				reasonToClaimDraw(reasonToClaimDraw)
 			{
@@ -29,11 +32,23 @@ namespace simplechess
 
 			const GameState gameState;
 			const CheckType checkType;
-			const std::set<PieceMove> availableMoves;
+			const std::pmr::set<PieceMove> availableMoves;
 			const std::optional<DrawReason> reasonItWasDrawn;
 			const std::optional<DrawReason> reasonToClaimDraw;
 		};
 
+		/**
+		 * \brief Relevant information about the state of a game at a \ref
+		 * Position, whose available moves are already known.
+		 */
+		struct PositionStateInformation
+		{
+			GameState gameState;
+			CheckType checkType;
+			std::optional<DrawReason> reasonItWasDrawn;
+			std::optional<DrawReason> reasonToClaimDraw;
+		};
+
 		/**
 		 * \brief Collection of methods to detect all the relevant information
 		 * about the state of a game.
@@ -59,7 +74,33 @@ namespace simplechess
 				static GameStateInformation detect(
 						const GameStage& stage,
 						bool drawOffered,
-						const std::map<std::string, uint8_t>& previouslyReachedPositions,
+						const RepetitionCounts& previouslyReachedPositions,
+						DrawEnforcement drawEnforcement = DrawEnforcement::Automatic);
+
+				/**
+				 * \brief Returns the information about the state of the game
+				 * at \p position, with the same rules as the other overload
+				 * but without generating its stage or allocating memory.
+				 *
+				 * \param position The current position of the game.
+				 * \param legalMoves All the moves available from \p
+				 * position.
+				 * \param drawOffered Whether the previous player offered a
+				 * draw.
+				 * \param previouslyReachedPositions The positions reached
+				 * before \p position, as described in \ref
+				 * DrawEvaluator::reasonToDraw().
+				 * \param previouslyReachedCount The number of elements of
+				 * \p previouslyReachedPositions.
+				 * \param drawEnforcement Controls whether mandatory draw
+				 * rules are automatically enforced or only claimable.
+				 */
+				static PositionStateInformation detect(
+						const Position& position,
+						const MoveList& legalMoves,
+						bool drawOffered,
+						const ReachedPosition* previouslyReachedPositions,
+						size_t previouslyReachedCount,
 						DrawEnforcement drawEnforcement = DrawEnforcement::Automatic);
 		};
 	}
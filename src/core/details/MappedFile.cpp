@@ -0,0 +1,159 @@
+#include "MappedFile.h"
+
+#include <system_error>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace simplechess::details;
+
+#ifdef _WIN32
+
+namespace
+{
+	[[noreturn]] void fail(const std::string& what)
+	{
+		throw std::system_error(
+				static_cast<int>(::GetLastError()),
+				std::system_category(),
+				what);
+	}
+}
+
+MappedFile::MappedFile(const std::string& path)
+	: mData(nullptr),
+	  mSize(0),
+	  mFile(INVALID_HANDLE_VALUE),
+	  mMapping(nullptr)
+{
+	mFile = ::CreateFileA(
+			path.c_str(),
+			GENERIC_READ,
+			FILE_SHARE_READ,
+			nullptr,
+			OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+			nullptr);
+
+	if (mFile == INVALID_HANDLE_VALUE)
+	{
+		::fail("Cannot open " + path);
+	}
+
+	LARGE_INTEGER size;
+	if (!::GetFileSizeEx(mFile, &size))
+	{
+		::CloseHandle(mFile);
+		::fail("Cannot get the size of " + path);
+	}
+
+	mSize = static_cast<size_t>(size.QuadPart);
+
+	if (mSize == 0)
+	{
+		// Empty files cannot be mapped
+		return;
+	}
+
+	mMapping = ::CreateFileMappingA(mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mMapping)
+	{
+		::CloseHandle(mFile);
+		::fail("Cannot map " + path);
+	}
+
+	mData = static_cast<const char*>(
+			::MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+	if (!mData)
+	{
+		::CloseHandle(mMapping);
+		::CloseHandle(mFile);
+		::fail("Cannot map " + path);
+	}
+}
+
+MappedFile::~MappedFile()
+{
+	if (mData)
+	{
+		::UnmapViewOfFile(mData);
+	}
+
+	if (mMapping)
+	{
+		::CloseHandle(mMapping);
+	}
+
+	::CloseHandle(mFile);
+}
+
+#else
+
+namespace
+{
+	[[noreturn]] void fail(const std::string& what)
+	{
+		throw std::system_error(errno, std::generic_category(), what);
+	}
+}
+
+MappedFile::MappedFile(const std::string& path)
+	: mData(nullptr),
+	  mSize(0)
+{
+	const int fd = ::open(path.c_str(), O_RDONLY);
+
+	if (fd < 0)
+	{
+		::fail("Cannot open " + path);
+	}
+
+	struct stat status;
+	if (::fstat(fd, &status) != 0)
+	{
+		const int error = errno;
+		::close(fd);
+		errno = error;
+		::fail("Cannot get the size of " + path);
+	}
+
+	mSize = static_cast<size_t>(status.st_size);
+
+	if (mSize == 0)
+	{
+		// Empty files cannot be mapped
+		::close(fd);
+		return;
+	}
+
+	void* mapping = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+	const int error = errno;
+
+	// The mapping keeps its own reference to the file
+	::close(fd);
+
+	if (mapping == MAP_FAILED)
+	{
+		errno = error;
+		::fail("Cannot map " + path);
+	}
+
+	mData = static_cast<const char*>(mapping);
+}
+
+MappedFile::~MappedFile()
+{
+	if (mData)
+	{
+		::munmap(const_cast<char*>(mData), mSize);
+	}
+}
+
+#endif
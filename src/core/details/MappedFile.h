@@ -0,0 +1,54 @@
+#ifndef MAPPED_FILE_H_3C8E1A5B_92D7_4F60_A4B3_E6F05D2C8197
+#define MAPPED_FILE_H_3C8E1A5B_92D7_4F60_A4B3_E6F05D2C8197
+
+#include <string>
+
+#include <cstddef>
+
+namespace simplechess
+{
+	namespace details
+	{
+		/**
+		 * \brief A read-only view of the whole contents of a file, mapped
+		 * into memory.
+		 */
+		class MappedFile
+		{
+			public:
+				/**
+				 * \brief Maps the file at \p path.
+				 *
+				 * \throws std::system_error if the file cannot be opened or
+				 * mapped.
+				 */
+				explicit MappedFile(const std::string& path);
+
+				MappedFile(const MappedFile&) = delete;
+				MappedFile& operator=(const MappedFile&) = delete;
+
+				~MappedFile();
+
+				const char* data() const
+				{
+					return mData;
+				}
+
+				size_t size() const
+				{
+					return mSize;
+				}
+
+			private:
+				const char* mData;
+				size_t mSize;
+
+#ifdef _WIN32
+				void* mFile;
+				void* mMapping;
+#endif
+		};
+	}
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include "MoveValidator.h"
 
 #include "BoardAnalyzer.h"
+#include "../Builders.h"
 
 #include "moves/BishopMove.h"
 #include "moves/KingMove.h"
@@ -21,7 +22,7 @@ std::optional<Square> MoveValidator::enPassantTarget(
 	if (pieceMove.piece().type() == PieceType::Pawn
 			&& abs(pieceMove.dst().rank() - pieceMove.src().rank()) == 2)
 	{
-		const Square candidateTarget = Square::fromRankAndFile(
+		const Square candidateTarget = SquareBuilder::build(
 				((pieceMove.piece().color() == Color::White)
 				 ? 3
 				 : 6),
@@ -40,7 +41,7 @@ std::optional<Square> MoveValidator::enPassantTarget(
 			if (!Square::isInsideBoundaries(dstRank, adjFile))
 				continue;
 
-			const Square adjSquare = Square::fromRankAndFile(dstRank, adjFile);
+			const Square adjSquare = SquareBuilder::build(dstRank, adjFile);
 			if (board.pieceAt(adjSquare) != std::optional<Piece>(enemyPawn))
 				continue;
 
@@ -0,0 +1,287 @@
+#include "PgnParser.h"
+
+#include <stdexcept>
+
+using namespace simplechess;
+using namespace simplechess::details;
+
+namespace
+{
+	bool isSpace(const char c)
+	{
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+	}
+
+	bool isDigit(const char c)
+	{
+		return c >= '0' && c <= '9';
+	}
+
+	/**
+	 * Whether the line which starts at \p lineStart is the first line of
+	 * the tag section of a game.
+	 */
+	bool startsGame(const char* data, const size_t lineStart)
+	{
+		if (data[lineStart] != '[')
+		{
+			return false;
+		}
+
+		// Find the previous non-blank line
+		size_t position = lineStart;
+		while (position > 0 && ::isSpace(data[position - 1]))
+		{
+			--position;
+		}
+
+		if (position == 0)
+		{
+			return true;
+		}
+
+		while (position > 0 && data[position - 1] != '\n')
+		{
+			--position;
+		}
+
+		return data[position] != '[';
+	}
+
+	bool isResult(const std::string_view token)
+	{
+		return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*";
+	}
+
+	/**
+	 * Parses a tag pair starting at \p position (which points to '['),
+	 * and leaves \p position after the closing ']'.
+	 */
+	std::pair<std::string, std::string> parseTag(
+			const std::string_view text,
+			size_t& position)
+	{
+		const auto fail = []()
+		{
+			throw std::invalid_argument("Malformed PGN tag");
+		};
+
+		++position;
+		while (position < text.size() && ::isSpace(text[position]))
+		{
+			++position;
+		}
+
+		const size_t nameBegin = position;
+		while (position < text.size()
+				&& !::isSpace(text[position])
+				&& text[position] != '"'
+				&& text[position] != ']')
+		{
+			++position;
+		}
+
+		std::string name(text.substr(nameBegin, position - nameBegin));
+
+		while (position < text.size() && ::isSpace(text[position]))
+		{
+			++position;
+		}
+
+		if (name.empty() || position >= text.size() || text[position] != '"')
+		{
+			fail();
+		}
+
+		++position;
+		std::string value;
+
+		while (position < text.size() && text[position] != '"')
+		{
+			if (text[position] == '\\' && position + 1 < text.size())
+			{
+				++position;
+			}
+
+			value.push_back(text[position++]);
+		}
+
+		++position;
+		while (position < text.size() && text[position] != ']' && text[position] != '\n')
+		{
+			++position;
+		}
+
+		if (position >= text.size() || text[position] != ']')
+		{
+			fail();
+		}
+
+		++position;
+		return {std::move(name), std::move(value)};
+	}
+
+	/**
+	 * Skips a comment, variation or escaped line starting at \p position.
+	 */
+	void skipToClosing(
+			const std::string_view text,
+			size_t& position,
+			const char closing)
+	{
+		while (position < text.size() && text[position] != closing)
+		{
+			++position;
+		}
+
+		if (position < text.size())
+		{
+			++position;
+		}
+	}
+
+	void skipVariation(const std::string_view text, size_t& position)
+	{
+		int depth = 0;
+
+		while (position < text.size())
+		{
+			const char c = text[position];
+
+			if (c == '{')
+			{
+				::skipToClosing(text, position, '}');
+				continue;
+			}
+
+			if (c == ';')
+			{
+				::skipToClosing(text, position, '\n');
+				continue;
+			}
+
+			++position;
+
+			if (c == '(')
+			{
+				++depth;
+			}
+			else if (c == ')' && --depth == 0)
+			{
+				return;
+			}
+		}
+	}
+}
+
+std::vector<size_t> PgnParser::findGameStarts(
+		const char* data,
+		const size_t size,
+		const size_t begin,
+		const size_t end)
+{
+	std::vector<size_t> result;
+
+	for (size_t position = begin; position < end && position < size; ++position)
+	{
+		if ((position == 0 || data[position - 1] == '\n')
+				&& ::startsGame(data, position))
+		{
+			result.push_back(position);
+		}
+	}
+
+	return result;
+}
+
+ParsedPgnGame PgnParser::parseGame(const std::string_view text)
+{
+	ParsedPgnGame result;
+	size_t position = 0;
+
+	while (position < text.size())
+	{
+		const char c = text[position];
+		const bool lineStart = position == 0 || text[position - 1] == '\n';
+
+		if (::isSpace(c))
+		{
+			++position;
+		}
+		else if (lineStart && c == '%')
+		{
+			::skipToClosing(text, position, '\n');
+		}
+		else if (c == '[' && result.moves.empty())
+		{
+			result.tags.push_back(::parseTag(text, position));
+		}
+		else if (c == '{')
+		{
+			::skipToClosing(text, position, '}');
+		}
+		else if (c == ';')
+		{
+			::skipToClosing(text, position, '\n');
+		}
+		else if (c == '(')
+		{
+			::skipVariation(text, position);
+		}
+		else if (c == '$' || c == ')')
+		{
+			// Numeric annotation glyph (or a stray parenthesis)
+			++position;
+			while (position < text.size() && ::isDigit(text[position]))
+			{
+				++position;
+			}
+		}
+		else
+		{
+			size_t tokenEnd = position;
+			while (tokenEnd < text.size()
+					&& !::isSpace(text[tokenEnd])
+					&& text[tokenEnd] != '{'
+					&& text[tokenEnd] != '('
+					&& text[tokenEnd] != ')'
+					&& text[tokenEnd] != ';'
+					&& text[tokenEnd] != '$')
+			{
+				++tokenEnd;
+			}
+
+			std::string_view token = text.substr(position, tokenEnd - position);
+			position = tokenEnd;
+
+			if (::isResult(token))
+			{
+				result.result = token;
+				break;
+			}
+
+			// Move numbers ("12." or "12...") might be glued to the move
+			size_t digits = 0;
+			while (digits < token.size() && ::isDigit(token[digits]))
+			{
+				++digits;
+			}
+
+			if (digits > 0 && digits < token.size() && token[digits] == '.')
+			{
+				token.remove_prefix(digits);
+				while (!token.empty() && token.front() == '.')
+				{
+					token.remove_prefix(1);
+				}
+			}
+
+			if (!token.empty())
+			{
+				result.moves.push_back(token);
+			}
+		}
+	}
+
+	return result;
+}
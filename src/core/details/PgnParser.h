@@ -0,0 +1,63 @@
+#ifndef PGN_PARSER_H_A93C5E07_4F1B_4D28_8B6E_72D0C3A5F914
+#define PGN_PARSER_H_A93C5E07_4F1B_4D28_8B6E_72D0C3A5F914
+
+#include <cpp/simplechess/Pgn.h>
+
+#include <string_view>
+#include <vector>
+
+#include <cstddef>
+
+namespace simplechess
+{
+	namespace details
+	{
+		/**
+		 * \brief The contents of a game in a PGN database, before the moves
+		 * are validated.
+		 *
+		 * The moves and the result point into the parsed text.
+		 */
+		struct ParsedPgnGame
+		{
+			PgnTags tags;
+			std::vector<std::string_view> moves;
+			std::string_view result;
+		};
+
+		/**
+		 * \brief Collection of methods to split and tokenize PGN databases.
+		 */
+		class PgnParser
+		{
+			public:
+				/**
+				 * \brief Returns the offsets of the games which start in
+				 * [\p begin, \p end) of the database \p data of \p size
+				 * bytes.
+				 *
+				 * A game starts at a line beginning with '[' which is not
+				 * preceded by another tag line (ignoring blank lines), so
+				 * each chunk of the database can be scanned independently.
+				 */
+				static std::vector<size_t> findGameStarts(
+						const char* data,
+						size_t size,
+						size_t begin,
+						size_t end);
+
+				/**
+				 * \brief Splits the text of one game into its tags, its
+				 * moves in algebraic notation and its result.
+				 *
+				 * Comments, variations, numeric annotation glyphs, move
+				 * numbers and escaped lines are skipped.
+				 *
+				 * \throws std::invalid_argument if a tag is malformed.
+				 */
+				static ParsedPgnGame parseGame(std::string_view text);
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,137 @@
+#include "PositionValidator.h"
+
+using namespace simplechess;
+using namespace simplechess::details;
+
+namespace
+{
+	constexpr uint8_t A1 = squareIndex(1, 'a');
+	constexpr uint8_t E1 = squareIndex(1, 'e');
+	constexpr uint8_t H1 = squareIndex(1, 'h');
+	constexpr uint8_t A8 = squareIndex(8, 'a');
+	constexpr uint8_t E8 = squareIndex(8, 'e');
+	constexpr uint8_t H8 = squareIndex(8, 'h');
+
+	bool castlingPiecesInPlace(
+			const Position& position,
+			const Color color,
+			const uint8_t kingSquare,
+			const uint8_t rookSquare)
+	{
+		return position.pieceCodeAt(kingSquare) == pieceCode(PieceType::King, color)
+			&& position.pieceCodeAt(rookSquare) == pieceCode(PieceType::Rook, color);
+	}
+
+	/**
+	 * Whether the king of the color not to move in \p position is attacked.
+	 */
+	bool isCheckingOpponent(const Position& position)
+	{
+		const Color activeColor = position.activeColor();
+
+		return position.isAttacked(
+				position.kingSquare(oppositeColor(activeColor)),
+				activeColor);
+	}
+}
+
+const char* PositionValidator::validate(const Position& position)
+{
+	if (popCount(position.pieces(Color::White, PieceType::King)) != 1
+			|| popCount(position.pieces(Color::Black, PieceType::King)) != 1)
+	{
+		return "Invalid number of kings on board";
+	}
+
+	if (::isCheckingOpponent(position))
+	{
+		return "Color to move is already checking";
+	}
+
+	for (uint8_t file = 0; file < 8; ++file)
+	{
+		if (position.pieceCodeAt(static_cast<uint8_t>(56 + file))
+					== pieceCode(PieceType::Pawn, Color::White)
+				|| position.pieceCodeAt(file)
+					== pieceCode(PieceType::Pawn, Color::Black))
+		{
+			return "Pawn found on its promotion rank";
+		}
+	}
+
+	const uint8_t rights = position.castlingRights();
+
+	if ((rights & CastlingRight::WhiteKingSide)
+			&& !::castlingPiecesInPlace(position, Color::White, ::E1, ::H1))
+	{
+		return "Kingside castling right for white is inconsistent with board state";
+	}
+
+	if ((rights & CastlingRight::WhiteQueenSide)
+			&& !::castlingPiecesInPlace(position, Color::White, ::E1, ::A1))
+	{
+		return "Queenside castling right for white is inconsistent with board state";
+	}
+
+	if ((rights & CastlingRight::BlackKingSide)
+			&& !::castlingPiecesInPlace(position, Color::Black, ::E8, ::H8))
+	{
+		return "Kingside castling right for black is inconsistent with board state";
+	}
+
+	if ((rights & CastlingRight::BlackQueenSide)
+			&& !::castlingPiecesInPlace(position, Color::Black, ::E8, ::A8))
+	{
+		return "Queenside castling right for black is inconsistent with board state";
+	}
+
+	const std::optional<uint8_t> epSquare = position.enPassantSquare();
+
+	if (!epSquare)
+	{
+		return nullptr;
+	}
+
+	// The en passant target must be behind a pawn of the opponent which
+	// has just moved two squares from an empty square
+	const Color activeColor = position.activeColor();
+	const int forward = (activeColor == Color::White) ? 8 : -8;
+	const uint8_t expectedRank = (activeColor == Color::White) ? 5 : 2;
+	const uint8_t pawnSquare = static_cast<uint8_t>(*epSquare - forward);
+	const uint8_t originSquare = static_cast<uint8_t>(*epSquare + forward);
+	const uint8_t pawn = pieceCode(PieceType::Pawn, oppositeColor(activeColor));
+
+	if (rankOf(*epSquare) != expectedRank
+			|| position.pieceCodeAt(pawnSquare) != pawn
+			|| position.pieceCodeAt(*epSquare) != NoPiece
+			|| position.pieceCodeAt(originSquare) != NoPiece)
+	{
+		return "En passant target is inconsistent with board state";
+	}
+
+	// The color to move cannot have been in check before the pawn moved
+	uint8_t squares[64];
+
+	for (uint8_t square = 0; square < 64; ++square)
+	{
+		squares[square] = position.pieceCodeAt(square);
+	}
+
+	squares[pawnSquare] = NoPiece;
+	squares[originSquare] = pawn;
+
+	const Position previous = Position::fromMailbox(
+			squares,
+			oppositeColor(activeColor),
+			rights,
+			std::nullopt,
+			0,
+			1);
+
+	if (::isCheckingOpponent(previous))
+	{
+		return "En passant target is inconsistent with board state";
+	}
+
+	return nullptr;
+}
@@ -0,0 +1,33 @@
+#ifndef POSITION_VALIDATOR_H_7A3E91C4_5D2B_4F86_B0E1_9C64D8F2A135
+#define POSITION_VALIDATOR_H_7A3E91C4_5D2B_4F86_B0E1_9C64D8F2A135
+
+#include "bitboard/Position.h"
+
+namespace simplechess
+{
+	namespace details
+	{
+		/**
+		 * \brief Checks whether a parsed position can be the stage of a game.
+		 */
+		class PositionValidator
+		{
+			public:
+				/**
+				 * \brief Returns a description of the first problem found in
+				 * \p position, or nullptr if it is valid.
+				 *
+				 * The position is rejected if:
+				 *  - There is not exactly one king per side.
+				 *  - The color to move is already checking.
+				 *  - There are pawns on the rank where they would promote.
+				 *  - The castling rights are inconsistent with the board.
+				 *  - There is an en passant target, but the position before
+				 *    the double pawn push which created it is not valid.
+				 */
+				static const char* validate(const Position& position);
+		};
+	}
+}
+
+#endif
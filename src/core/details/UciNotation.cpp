@@ -0,0 +1,106 @@
+#include "UciNotation.h"
+
+using namespace simplechess;
+using namespace simplechess::details;
+
+namespace
+{
+	std::optional<uint8_t> parseSquare(const char file, const char rank)
+	{
+		if (file < 'a' || file > 'h' || rank < '1' || rank > '8')
+		{
+			return std::nullopt;
+		}
+
+		return squareIndex(static_cast<uint8_t>(rank - '0'), file);
+	}
+
+	std::optional<PieceType> promotionFromLetter(const char c)
+	{
+		switch (c)
+		{
+			case 'r':
+				return PieceType::Rook;
+			case 'n':
+				return PieceType::Knight;
+			case 'b':
+				return PieceType::Bishop;
+			case 'q':
+				return PieceType::Queen;
+			default:
+				return std::nullopt;
+		}
+	}
+
+	char promotionLetter(const PieceType type)
+	{
+		switch (type)
+		{
+			case PieceType::Rook:
+				return 'r';
+			case PieceType::Knight:
+				return 'n';
+			case PieceType::Bishop:
+				return 'b';
+			default:
+				return 'q';
+		}
+	}
+}
+
+std::optional<Move> UciNotation::parse(
+		const Position& position,
+		const std::string_view uci)
+{
+	if (uci.size() != 4 && uci.size() != 5)
+	{
+		return std::nullopt;
+	}
+
+	const std::optional<uint8_t> src = ::parseSquare(uci[0], uci[1]);
+	const std::optional<uint8_t> dst = ::parseSquare(uci[2], uci[3]);
+
+	if (!src || !dst)
+	{
+		return std::nullopt;
+	}
+
+	PieceType promotion = PieceType::Pawn;
+
+	if (uci.size() == 5)
+	{
+		const std::optional<PieceType> promoted = ::promotionFromLetter(uci[4]);
+
+		if (!promoted)
+		{
+			return std::nullopt;
+		}
+
+		promotion = *promoted;
+	}
+
+	const Move move = {*src, *dst, promotion};
+
+	if (!position.isLegal(move))
+	{
+		return std::nullopt;
+	}
+
+	return move;
+}
+
+std::string UciNotation::toString(const Move& move)
+{
+	std::string result = {
+		static_cast<char>('a' + fileOf(move.src)),
+		static_cast<char>('1' + rankOf(move.src)),
+		static_cast<char>('a' + fileOf(move.dst)),
+		static_cast<char>('1' + rankOf(move.dst)) };
+
+	if (move.promotion != PieceType::Pawn)
+	{
+		result.push_back(::promotionLetter(move.promotion));
+	}
+
+	return result;
+}
@@ -0,0 +1,43 @@
+#ifndef UCI_NOTATION_H_E2B94D17_7C3A_4F85_9D60_A81C5E3F2B74
+#define UCI_NOTATION_H_E2B94D17_7C3A_4F85_9D60_A81C5E3F2B74
+
+#include "bitboard/Position.h"
+
+#include <optional>
+
+#include <string>
+#include <string_view>
+
+namespace simplechess
+{
+	namespace details
+	{
+		/**
+		 * \brief Conversion of moves from and to the long algebraic
+		 * notation used by the Universal Chess Interface ("e2e4",
+		 * "e7e8q", castling as "e1g1").
+		 */
+		class UciNotation
+		{
+			public:
+				/**
+				 * \brief Returns the move described by \p uci if it is a
+				 * legal move in \p position.
+				 *
+				 * \return The described move, or an empty value if \p uci
+				 * is malformed or does not describe a legal move.
+				 */
+				static std::optional<Move> parse(
+						const Position& position,
+						std::string_view uci);
+
+				/**
+				 * \brief Returns the description of \p move in UCI
+				 * notation.
+				 */
+				static std::string toString(const Move& move);
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,290 @@
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace simplechess::details;
+
+namespace
+{
+	/**
+	 * The range of task indices [next, end) still owned by a worker.
+	 */
+	struct alignas(64) WorkerRange
+	{
+		std::mutex mutex;
+		size_t next = 0;
+		size_t end = 0;
+	};
+
+	/**
+	 * Takes the next task of \p range, if any.
+	 */
+	bool takeTask(WorkerRange& range, size_t& task)
+	{
+		const std::lock_guard<std::mutex> lock(range.mutex);
+
+		if (range.next == range.end)
+		{
+			return false;
+		}
+
+		task = range.next++;
+		return true;
+	}
+
+	/**
+	 * Moves the back half of the range of \p victim to \p thief, which
+	 * must be empty.
+	 */
+	bool steal(WorkerRange& victim, WorkerRange& thief)
+	{
+		size_t begin = 0;
+		size_t end = 0;
+
+		{
+			const std::lock_guard<std::mutex> lock(victim.mutex);
+			const size_t remaining = victim.end - victim.next;
+
+			if (remaining == 0)
+			{
+				return false;
+			}
+
+			begin = victim.end - (remaining + 1) / 2;
+			end = victim.end;
+			victim.end = begin;
+		}
+
+		const std::lock_guard<std::mutex> lock(thief.mutex);
+		thief.next = begin;
+		thief.end = end;
+		return true;
+	}
+}
+
+/**
+ * A batch of tasks being run, shared by the workers taking part in it.
+ */
+struct WorkStealingPool::Batch
+{
+	Batch(
+			const size_t count,
+			const size_t workers,
+			const std::function<void(size_t)>& task)
+		: workers(workers),
+		  task(task),
+		  ranges(new WorkerRange[workers]),
+		  aborted(false),
+		  errorMutex(),
+		  error()
+	{
+		for (size_t i = 0; i < workers; ++i)
+		{
+			ranges[i].next = count * i / workers;
+			ranges[i].end = count * (i + 1) / workers;
+		}
+	}
+
+	/**
+	 * Runs tasks as the worker number \p self until none is left or one
+	 * of them throws.
+	 */
+	void work(const size_t self) const
+	{
+		try
+		{
+			size_t index = 0;
+
+			while (!aborted.load(std::memory_order_relaxed))
+			{
+				if (::takeTask(ranges[self], index))
+				{
+					task(index);
+					continue;
+				}
+
+				// Out of work: look for a victim, starting with the
+				// neighbour to spread the thieves
+				bool stolen = false;
+				for (size_t offset = 1; offset < workers && !stolen; ++offset)
+				{
+					stolen = ::steal(ranges[(self + offset) % workers], ranges[self]);
+				}
+
+				if (!stolen)
+				{
+					// Any task left belongs to a worker which is still
+					// running and will complete it
+					return;
+				}
+			}
+		}
+		catch (...)
+		{
+			const std::lock_guard<std::mutex> lock(errorMutex);
+
+			if (!error)
+			{
+				error = std::current_exception();
+			}
+
+			aborted = true;
+		}
+	}
+
+	const size_t workers;
+	const std::function<void(size_t)>& task;
+	const std::unique_ptr<WorkerRange[]> ranges;
+	mutable std::atomic<bool> aborted;
+	mutable std::mutex errorMutex;
+	mutable std::exception_ptr error;
+};
+
+WorkStealingPool::WorkStealingPool(const unsigned threads)
+	: mThreads(threads),
+	  mRunMutex(),
+	  mMutex(),
+	  mBatchReady(),
+	  mBatchDone(),
+	  mBatch(nullptr),
+	  mGeneration(0),
+	  mBusyWorkers(0),
+	  mStopping(false),
+	  mWorkers()
+{
+	if (mThreads == 0)
+	{
+		mThreads = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	try
+	{
+		mWorkers.reserve(mThreads - 1);
+
+		for (size_t i = 1; i < mThreads; ++i)
+		{
+			mWorkers.emplace_back(&WorkStealingPool::serve, this, i);
+		}
+	}
+	catch (...)
+	{
+		// The destructor is not called, and joinable threads must not be
+		// destroyed
+		stop();
+		throw;
+	}
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+	stop();
+}
+
+void WorkStealingPool::stop()
+{
+	{
+		const std::lock_guard<std::mutex> lock(mMutex);
+		mStopping = true;
+	}
+
+	mBatchReady.notify_all();
+
+	for (std::thread& worker : mWorkers)
+	{
+		worker.join();
+	}
+}
+
+void WorkStealingPool::serve(const size_t self) const
+{
+	uint64_t generation = 0;
+
+	while (true)
+	{
+		const Batch* batch = nullptr;
+
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mBatchReady.wait(lock, [&]
+					{
+						return mStopping || mGeneration != generation;
+					});
+
+			if (mStopping)
+			{
+				return;
+			}
+
+			generation = mGeneration;
+			batch = mBatch;
+		}
+
+		// A batch may have fewer workers than the pool, and it may even
+		// be over already if this worker did not take part in it
+		if (!batch || self >= batch->workers)
+		{
+			continue;
+		}
+
+		batch->work(self);
+
+		const std::lock_guard<std::mutex> lock(mMutex);
+
+		if (--mBusyWorkers == 0)
+		{
+			mBatchDone.notify_one();
+		}
+	}
+}
+
+void WorkStealingPool::run(
+		const size_t count,
+		const std::function<void(size_t)>& task) const
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	const size_t workers = std::min<size_t>(mThreads, count);
+
+	if (workers == 1)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			task(i);
+		}
+
+		return;
+	}
+
+	const std::lock_guard<std::mutex> runLock(mRunMutex);
+	const Batch batch(count, workers, task);
+
+	{
+		const std::lock_guard<std::mutex> lock(mMutex);
+		mBatch = &batch;
+		mBusyWorkers = workers - 1;
+		++mGeneration;
+	}
+
+	mBatchReady.notify_all();
+	batch.work(0);
+
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		mBatchDone.wait(lock, [this] { return mBusyWorkers == 0; });
+		mBatch = nullptr;
+	}
+
+	if (batch.error)
+	{
+		std::rethrow_exception(batch.error);
+	}
+}
@@ -0,0 +1,101 @@
+#ifndef WORK_STEALING_POOL_H_7E4B2D81_3A96_4C05_B8F2_D15A6C0E9347
+#define WORK_STEALING_POOL_H_7E4B2D81_3A96_4C05_B8F2_D15A6C0E9347
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace simplechess
+{
+	namespace details
+	{
+		/**
+		 * \brief Runs batches of independent tasks on several threads,
+		 * balancing the load by work stealing.
+		 *
+		 * Each worker starts with a contiguous range of task indices and
+		 * processes it from the front. A worker which runs out of tasks
+		 * steals the back half of the range of another worker, so uneven
+		 * task durations do not leave threads idle while keeping
+		 * synchronisation to one uncontended lock per task.
+		 *
+		 * The worker threads are started once, by the constructor, and
+		 * wait for batches until the pool is destroyed. Batches submitted
+		 * from several threads at the same time are run one after the
+		 * other, so a task must not submit a batch to its own pool.
+		 */
+		class WorkStealingPool
+		{
+			public:
+				/**
+				 * \brief Constructor.
+				 *
+				 * \param threads The number of threads to use, or 0 to use
+				 * one per hardware thread. The calling thread of \ref run()
+				 * is one of them, so one thread less is started.
+				 */
+				explicit WorkStealingPool(unsigned threads = 0);
+
+				/**
+				 * \brief Stops and joins the worker threads.
+				 */
+				~WorkStealingPool();
+
+				WorkStealingPool(const WorkStealingPool&) = delete;
+				WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+				unsigned threads() const
+				{
+					return mThreads;
+				}
+
+				/**
+				 * \brief Calls \p task once for every index in [0, \p
+				 * count), and returns once all of them have been completed.
+				 *
+				 * The calling thread is one of the workers. If a task
+				 * throws, the remaining tasks are abandoned and the first
+				 * exception is rethrown once every worker has stopped.
+				 */
+				void run(size_t count, const std::function<void(size_t)>& task) const;
+
+			private:
+				struct Batch;
+
+				/**
+				 * Body of the worker thread number \p self (from 1), which
+				 * takes part in every batch with more than \p self workers.
+				 */
+				void serve(size_t self) const;
+
+				/**
+				 * Wakes up the worker threads so that they return, and
+				 * joins them.
+				 */
+				void stop();
+
+				unsigned mThreads;
+
+				// Held for the whole duration of a batch
+				mutable std::mutex mRunMutex;
+
+				// Protects the fields below, which tell the workers about
+				// the current batch
+				mutable std::mutex mMutex;
+				mutable std::condition_variable mBatchReady;
+				mutable std::condition_variable mBatchDone;
+				mutable const Batch* mBatch;
+				mutable uint64_t mGeneration;
+				mutable size_t mBusyWorkers;
+				bool mStopping;
+
+				std::vector<std::thread> mWorkers;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,121 @@
+#include "AttackKernels.h"
+#include "KoggeStone.h"
+
+#include "../CpuFeatures.h"
+
+using namespace simplechess::details;
+using namespace simplechess::details::attacks;
+
+namespace
+{
+	struct ScalarLanes
+	{
+		static constexpr size_t Width = 1;
+
+		Bitboard value;
+
+		static ScalarLanes load(const Bitboard* source)
+		{
+			return {*source};
+		}
+
+		static void store(Bitboard* destination, const ScalarLanes& lanes)
+		{
+			*destination = lanes.value;
+		}
+
+		static ScalarLanes broadcast(const Bitboard value)
+		{
+			return {value};
+		}
+	};
+
+	ScalarLanes operator&(const ScalarLanes& lhs, const ScalarLanes& rhs)
+	{
+		return {lhs.value & rhs.value};
+	}
+
+	ScalarLanes operator|(const ScalarLanes& lhs, const ScalarLanes& rhs)
+	{
+		return {lhs.value | rhs.value};
+	}
+
+	ScalarLanes operator~(const ScalarLanes& lanes)
+	{
+		return {~lanes.value};
+	}
+
+	ScalarLanes operator<<(const ScalarLanes& lanes, const int bits)
+	{
+		return {lanes.value << bits};
+	}
+
+	ScalarLanes operator>>(const ScalarLanes& lanes, const int bits)
+	{
+		return {lanes.value >> bits};
+	}
+}
+
+bool attacks::isAvailable(const Kernel kernel)
+{
+	switch (kernel)
+	{
+		case Kernel::Scalar:
+			return true;
+		case Kernel::Avx2:
+#ifdef SIMPLECHESS_AVX2_KERNEL
+			return processorHasAvx2();
+#else
+			return false;
+#endif
+		case Kernel::Avx512:
+#ifdef SIMPLECHESS_AVX512_KERNEL
+			return processorHasAvx512();
+#else
+			return false;
+#endif
+	}
+
+	return false;
+}
+
+Kernel attacks::fastestKernel()
+{
+	// The processor does not change, so it is only queried once
+	static const Kernel fastest = isAvailable(Kernel::Avx512)
+		? Kernel::Avx512
+		: isAvailable(Kernel::Avx2) ? Kernel::Avx2 : Kernel::Scalar;
+
+	return fastest;
+}
+
+void attacks::compute(const Kernel kernel, const BatchView& batch)
+{
+	switch (kernel)
+	{
+		case Kernel::Scalar:
+			computeScalar(batch);
+			return;
+		case Kernel::Avx2:
+#ifdef SIMPLECHESS_AVX2_KERNEL
+			computeAvx2(batch);
+			return;
+#else
+			break;
+#endif
+		case Kernel::Avx512:
+#ifdef SIMPLECHESS_AVX512_KERNEL
+			computeAvx512(batch);
+			return;
+#else
+			break;
+#endif
+	}
+
+	computeScalar(batch);
+}
+
+void attacks::computeScalar(const BatchView& batch)
+{
+	computeAll<ScalarLanes>(batch);
+}
@@ -0,0 +1,81 @@
+#ifndef ATTACK_KERNELS_H_20E00C81_4D91_4D1C_A98D_8D0A47C01C98
+#define ATTACK_KERNELS_H_20E00C81_4D91_4D1C_A98D_8D0A47C01C98
+
+#include "Bitboard.h"
+
+#include <cstddef>
+
+namespace simplechess
+{
+	namespace details
+	{
+		namespace attacks
+		{
+			/**
+			 * \brief The arrays of a batch of positions and of their
+			 * attacks, indexed by color and piece type, each with one
+			 * bitboard per position.
+			 */
+			struct BatchView
+			{
+				const Bitboard* pieces[2][6];
+				Bitboard* pieceAttacks[2][6];
+				Bitboard* colorAttacks[2];
+				size_t size;
+			};
+
+			/**
+			 * \brief The implementations of \ref compute().
+			 */
+			enum class Kernel
+			{
+				/**
+				 * One position at a time, with 64-bit integers.
+				 */
+				Scalar,
+
+				/**
+				 * Four positions at a time, with AVX2.
+				 */
+				Avx2,
+
+				/**
+				 * Eight positions at a time, with AVX-512.
+				 */
+				Avx512
+			};
+
+			/**
+			 * \brief Whether \p kernel was built into the library and the
+			 * processor supports it.
+			 */
+			bool isAvailable(Kernel kernel);
+
+			/**
+			 * \brief The fastest available kernel.
+			 */
+			Kernel fastestKernel();
+
+			/**
+			 * \brief Computes the squares attacked by each kind of piece,
+			 * and by each color, in every position of \p batch.
+			 *
+			 * Attacks stop at the first occupied square, whatever its
+			 * color.
+			 *
+			 * \note \p kernel must be available.
+			 */
+			void compute(Kernel kernel, const BatchView& batch);
+
+			/*
+			 * Entry points of each kernel, each in a translation unit of
+			 * its own compiled for its instruction set.
+			 */
+			void computeScalar(const BatchView& batch);
+			void computeAvx2(const BatchView& batch);
+			void computeAvx512(const BatchView& batch);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,71 @@
+/*
+ * Compiled with AVX2 enabled, so it must only be called after checking that
+ * the processor supports it (see attacks::isAvailable()).
+ */
+
+#ifdef SIMPLECHESS_AVX2_KERNEL
+
+#include "AttackKernels.h"
+#include "KoggeStone.h"
+
+#include <immintrin.h>
+
+using namespace simplechess::details;
+using namespace simplechess::details::attacks;
+
+namespace
+{
+	struct Avx2Lanes
+	{
+		static constexpr size_t Width = 4;
+
+		__m256i value;
+
+		static Avx2Lanes load(const Bitboard* source)
+		{
+			return {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source))};
+		}
+
+		static void store(Bitboard* destination, const Avx2Lanes& lanes)
+		{
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination), lanes.value);
+		}
+
+		static Avx2Lanes broadcast(const Bitboard value)
+		{
+			return {_mm256_set1_epi64x(static_cast<long long>(value))};
+		}
+	};
+
+	Avx2Lanes operator&(const Avx2Lanes& lhs, const Avx2Lanes& rhs)
+	{
+		return {_mm256_and_si256(lhs.value, rhs.value)};
+	}
+
+	Avx2Lanes operator|(const Avx2Lanes& lhs, const Avx2Lanes& rhs)
+	{
+		return {_mm256_or_si256(lhs.value, rhs.value)};
+	}
+
+	Avx2Lanes operator~(const Avx2Lanes& lanes)
+	{
+		return {_mm256_xor_si256(lanes.value, _mm256_set1_epi64x(-1))};
+	}
+
+	Avx2Lanes operator<<(const Avx2Lanes& lanes, const int bits)
+	{
+		return {_mm256_sll_epi64(lanes.value, _mm_cvtsi32_si128(bits))};
+	}
+
+	Avx2Lanes operator>>(const Avx2Lanes& lanes, const int bits)
+	{
+		return {_mm256_srl_epi64(lanes.value, _mm_cvtsi32_si128(bits))};
+	}
+}
+
+void attacks::computeAvx2(const BatchView& batch)
+{
+	computeAll<Avx2Lanes>(batch);
+}
+
+#endif
@@ -0,0 +1,79 @@
+/*
+ * Compiled with AVX-512 enabled, so it must only be called after checking
+ * that the processor supports it (see attacks::isAvailable()).
+ */
+
+#ifdef SIMPLECHESS_AVX512_KERNEL
+
+#include "AttackKernels.h"
+#include "KoggeStone.h"
+
+#include <immintrin.h>
+
+using namespace simplechess::details;
+using namespace simplechess::details::attacks;
+
+namespace
+{
+	struct Avx512Lanes
+	{
+		static constexpr size_t Width = 8;
+
+		__m512i value;
+
+		static Avx512Lanes load(const Bitboard* source)
+		{
+			return {_mm512_loadu_si512(source)};
+		}
+
+		static void store(Bitboard* destination, const Avx512Lanes& lanes)
+		{
+			_mm512_storeu_si512(destination, lanes.value);
+		}
+
+		static Avx512Lanes broadcast(const Bitboard value)
+		{
+			return {_mm512_set1_epi64(static_cast<long long>(value))};
+		}
+	};
+
+	Avx512Lanes operator&(const Avx512Lanes& lhs, const Avx512Lanes& rhs)
+	{
+		return {_mm512_and_si512(lhs.value, rhs.value)};
+	}
+
+	Avx512Lanes operator|(const Avx512Lanes& lhs, const Avx512Lanes& rhs)
+	{
+		return {_mm512_or_si512(lhs.value, rhs.value)};
+	}
+
+	Avx512Lanes operator~(const Avx512Lanes& lanes)
+	{
+		return {_mm512_xor_si512(lanes.value, _mm512_set1_epi64(-1))};
+	}
+
+	/*
+	 * The shifts use the zero-masking forms with every lane enabled: GCC 12
+	 * reports the unmasked ones as reading an uninitialized value once
+	 * inlined, because they pass _mm512_undefined_epi32() as the source of
+	 * the masked-off lanes.
+	 */
+	constexpr __mmask8 AllLanes = 0xFF;
+
+	Avx512Lanes operator<<(const Avx512Lanes& lanes, const int bits)
+	{
+		return {_mm512_maskz_sllv_epi64(AllLanes, lanes.value, _mm512_set1_epi64(bits))};
+	}
+
+	Avx512Lanes operator>>(const Avx512Lanes& lanes, const int bits)
+	{
+		return {_mm512_maskz_srlv_epi64(AllLanes, lanes.value, _mm512_set1_epi64(bits))};
+	}
+}
+
+void attacks::computeAvx512(const BatchView& batch)
+{
+	computeAll<Avx512Lanes>(batch);
+}
+
+#endif
@@ -0,0 +1,240 @@
+#ifndef BITBOARD_H_4F0C2E8A_6B1D_4E73_9A55_1C3D7E2B9F60
+#define BITBOARD_H_4F0C2E8A_6B1D_4E73_9A55_1C3D7E2B9F60
+
+#include <cpp/simplechess/Color.h>
+#include <cpp/simplechess/Square.h>
+
+#include "../../Builders.h"
+
+#include <array>
+#include <cstdint>
+
+/**
+ * Low level helpers to describe sets of squares as 64-bit integers.
+ *
+ * Squares are indexed as in the C interface: a1 is 0, b1 is 1, ..., h8 is 63.
+ * Every table is computed at compile time, so none of these helpers allocate
+ * or throw.
+ */
+
+namespace simplechess
+{
+	namespace details
+	{
+		typedef uint64_t Bitboard;
+
+		constexpr Bitboard FileA = 0x0101010101010101ULL;
+		constexpr Bitboard FileH = FileA << 7;
+		constexpr Bitboard Rank1 = 0xFFULL;
+		constexpr Bitboard Rank8 = Rank1 << 56;
+
+		constexpr Bitboard bit(const uint8_t index)
+		{
+			return Bitboard(1) << index;
+		}
+
+		constexpr uint8_t squareIndex(const uint8_t rank, const char file)
+		{
+			return static_cast<uint8_t>((rank - 1) * 8 + (file - 'a'));
+		}
+
+		inline uint8_t squareIndex(const Square& square)
+		{
+			return squareIndex(square.rank(), square.file());
+		}
+
+		inline Square squareFromIndex(const uint8_t index)
+		{
+			return SquareBuilder::build(
+					static_cast<uint8_t>(index / 8 + 1),
+					static_cast<char>('a' + index % 8));
+		}
+
+		constexpr uint8_t rankOf(const uint8_t index)
+		{
+			return index / 8;
+		}
+
+		constexpr uint8_t fileOf(const uint8_t index)
+		{
+			return index % 8;
+		}
+
+		inline uint8_t lsb(const Bitboard b)
+		{
+			return static_cast<uint8_t>(__builtin_ctzll(b));
+		}
+
+		inline uint8_t msb(const Bitboard b)
+		{
+			return static_cast<uint8_t>(63 - __builtin_clzll(b));
+		}
+
+		inline uint8_t popLsb(Bitboard& b)
+		{
+			const uint8_t index = lsb(b);
+			b &= b - 1;
+			return index;
+		}
+
+		inline int popCount(const Bitboard b)
+		{
+			return __builtin_popcountll(b);
+		}
+
+		namespace tables
+		{
+			/**
+			 * The eight directions a piece can slide in. The first four
+			 * increase the square index, the last four decrease it.
+			 */
+			enum Direction
+			{
+				North,
+				East,
+				NorthEast,
+				NorthWest,
+				South,
+				West,
+				SouthEast,
+				SouthWest
+			};
+
+			constexpr int8_t sRankSteps[8] = { 1, 0, 1, 1, -1, 0, -1, -1 };
+			constexpr int8_t sFileSteps[8] = { 0, 1, 1, -1, 0, -1, 1, -1 };
+
+			constexpr Bitboard stepTarget(
+					const int index, const int rankStep, const int fileStep)
+			{
+				const int rank = index / 8 + rankStep;
+				const int file = index % 8 + fileStep;
+				return (rank >= 0 && rank < 8 && file >= 0 && file < 8)
+					? bit(static_cast<uint8_t>(rank * 8 + file))
+					: 0;
+			}
+
+			constexpr std::array<Bitboard, 64> makeKnightAttacks()
+			{
+				std::array<Bitboard, 64> result = {};
+				for (int sq = 0; sq < 64; ++sq)
+				{
+					result[sq] = stepTarget(sq, 2, 1) | stepTarget(sq, 2, -1)
+						| stepTarget(sq, -2, 1) | stepTarget(sq, -2, -1)
+						| stepTarget(sq, 1, 2) | stepTarget(sq, 1, -2)
+						| stepTarget(sq, -1, 2) | stepTarget(sq, -1, -2);
+				}
+				return result;
+			}
+
+			constexpr std::array<Bitboard, 64> makeKingAttacks()
+			{
+				std::array<Bitboard, 64> result = {};
+				for (int sq = 0; sq < 64; ++sq)
+				{
+					for (int dir = 0; dir < 8; ++dir)
+					{
+						result[sq] |= stepTarget(
+								sq, sRankSteps[dir], sFileSteps[dir]);
+					}
+				}
+				return result;
+			}
+
+			constexpr std::array<std::array<Bitboard, 64>, 2> makePawnAttacks()
+			{
+				std::array<std::array<Bitboard, 64>, 2> result = {};
+				for (int sq = 0; sq < 64; ++sq)
+				{
+					result[0][sq] = stepTarget(sq, 1, -1) | stepTarget(sq, 1, 1);
+					result[1][sq] = stepTarget(sq, -1, -1) | stepTarget(sq, -1, 1);
+				}
+				return result;
+			}
+
+			constexpr std::array<std::array<Bitboard, 64>, 8> makeRays()
+			{
+				std::array<std::array<Bitboard, 64>, 8> result = {};
+				for (int dir = 0; dir < 8; ++dir)
+				{
+					for (int sq = 0; sq < 64; ++sq)
+					{
+						for (int i = 1; i < 8; ++i)
+						{
+							const Bitboard target = stepTarget(
+									sq, i * sRankSteps[dir], i * sFileSteps[dir]);
+							if (!target)
+							{
+								break;
+							}
+							result[dir][sq] |= target;
+						}
+					}
+				}
+				return result;
+			}
+
+			constexpr std::array<Bitboard, 64> sKnightAttacks = makeKnightAttacks();
+			constexpr std::array<Bitboard, 64> sKingAttacks = makeKingAttacks();
+			constexpr std::array<std::array<Bitboard, 64>, 2> sPawnAttacks = makePawnAttacks();
+			constexpr std::array<std::array<Bitboard, 64>, 8> sRays = makeRays();
+
+			inline Bitboard rayAttacks(
+					const Direction dir, const uint8_t square, const Bitboard occupied)
+			{
+				const Bitboard ray = sRays[dir][square];
+				const Bitboard blockers = ray & occupied;
+
+				if (!blockers)
+				{
+					return ray;
+				}
+
+				// Rays in the first four directions grow towards higher
+				// indices, so the closest blocker is the lowest bit
+				const uint8_t first = (dir < South) ? lsb(blockers) : msb(blockers);
+				return ray ^ sRays[dir][first];
+			}
+		}
+
+		inline Bitboard knightAttacks(const uint8_t square)
+		{
+			return tables::sKnightAttacks[square];
+		}
+
+		inline Bitboard kingAttacks(const uint8_t square)
+		{
+			return tables::sKingAttacks[square];
+		}
+
+		/**
+		 * Squares attacked by a pawn of color \p color standing on \p square.
+		 */
+		inline Bitboard pawnAttacks(const Color color, const uint8_t square)
+		{
+			return tables::sPawnAttacks[color == Color::White ? 0 : 1][square];
+		}
+
+		inline Bitboard rookAttacks(const uint8_t square, const Bitboard occupied)
+		{
+			return tables::rayAttacks(tables::North, square, occupied)
+				| tables::rayAttacks(tables::East, square, occupied)
+				| tables::rayAttacks(tables::South, square, occupied)
+				| tables::rayAttacks(tables::West, square, occupied);
+		}
+
+		inline Bitboard bishopAttacks(const uint8_t square, const Bitboard occupied)
+		{
+			return tables::rayAttacks(tables::NorthEast, square, occupied)
+				| tables::rayAttacks(tables::NorthWest, square, occupied)
+				| tables::rayAttacks(tables::SouthEast, square, occupied)
+				| tables::rayAttacks(tables::SouthWest, square, occupied);
+		}
+
+		inline Bitboard queenAttacks(const uint8_t square, const Bitboard occupied)
+		{
+			return rookAttacks(square, occupied) | bishopAttacks(square, occupied);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,251 @@
+#ifndef KOGGE_STONE_H_D068C45D_6D7F_4F29_984A_F2A56E90082C
+#define KOGGE_STONE_H_D068C45D_6D7F_4F29_984A_F2A56E90082C
+
+#include "AttackKernels.h"
+
+#include <cstring>
+
+/**
+ * Attack generation for whole sets of pieces at once, written once for any
+ * vector of bitboards.
+ *
+ * \c Lanes wraps a vector of \c Lanes::Width bitboards, one per position,
+ * and provides:
+ * - \c load(const Bitboard*) and \c store(Bitboard*, Lanes)
+ * - \c broadcast(Bitboard)
+ * - operators \c &, \c |, \c ~, and \c << and \c >> by a number of bits
+ *
+ * Sliding attacks use Kogge-Stone occluded fills, which need a logarithmic
+ * number of shifts and no table lookups, so every lane does the same work.
+ *
+ * Each instantiation must use a \c Lanes type local to its translation
+ * unit, and nothing here may call a non-template inline function: kernels
+ * are compiled with different instruction sets, and the linker could
+ * otherwise keep a copy of shared code which the processor cannot run.
+ */
+
+namespace simplechess
+{
+	namespace details
+	{
+		namespace attacks
+		{
+			constexpr Bitboard NotFileA = ~FileA;
+			constexpr Bitboard NotFileH = ~FileH;
+			constexpr Bitboard NotFilesAB = ~(FileA | (FileA << 1));
+			constexpr Bitboard NotFilesGH = ~(FileH | (FileH >> 1));
+
+			/**
+			 * Squares attacked by \p sliders moving towards higher
+			 * square indices, \p Step squares at a time, with \p mask the
+			 * squares a step can land on without wrapping around.
+			 */
+			template <int Step, typename Lanes>
+			Lanes fillUp(Lanes sliders, const Lanes& empty, const Lanes& mask)
+			{
+				Lanes propagators = empty & mask;
+				sliders = sliders | (propagators & (sliders << Step));
+				propagators = propagators & (propagators << Step);
+				sliders = sliders | (propagators & (sliders << (2 * Step)));
+				propagators = propagators & (propagators << (2 * Step));
+				sliders = sliders | (propagators & (sliders << (4 * Step)));
+				return (sliders << Step) & mask;
+			}
+
+			/**
+			 * Same as \ref fillUp(), towards lower square indices.
+			 */
+			template <int Step, typename Lanes>
+			Lanes fillDown(Lanes sliders, const Lanes& empty, const Lanes& mask)
+			{
+				Lanes propagators = empty & mask;
+				sliders = sliders | (propagators & (sliders >> Step));
+				propagators = propagators & (propagators >> Step);
+				sliders = sliders | (propagators & (sliders >> (2 * Step)));
+				propagators = propagators & (propagators >> (2 * Step));
+				sliders = sliders | (propagators & (sliders >> (4 * Step)));
+				return (sliders >> Step) & mask;
+			}
+
+			template <typename Lanes>
+			Lanes orthogonalAttacks(const Lanes& sliders, const Lanes& empty)
+			{
+				const Lanes all = Lanes::broadcast(~Bitboard(0));
+				const Lanes notFileA = Lanes::broadcast(NotFileA);
+				const Lanes notFileH = Lanes::broadcast(NotFileH);
+
+				return fillUp<8>(sliders, empty, all)
+					| fillDown<8>(sliders, empty, all)
+					| fillUp<1>(sliders, empty, notFileA)
+					| fillDown<1>(sliders, empty, notFileH);
+			}
+
+			template <typename Lanes>
+			Lanes diagonalAttacks(const Lanes& sliders, const Lanes& empty)
+			{
+				const Lanes notFileA = Lanes::broadcast(NotFileA);
+				const Lanes notFileH = Lanes::broadcast(NotFileH);
+
+				return fillUp<9>(sliders, empty, notFileA)
+					| fillUp<7>(sliders, empty, notFileH)
+					| fillDown<7>(sliders, empty, notFileA)
+					| fillDown<9>(sliders, empty, notFileH);
+			}
+
+			template <typename Lanes>
+			Lanes knightAttacks(const Lanes& knights)
+			{
+				const Lanes oneFile
+					= ((knights << 1) & Lanes::broadcast(NotFileA))
+					| ((knights >> 1) & Lanes::broadcast(NotFileH));
+				const Lanes twoFiles
+					= ((knights << 2) & Lanes::broadcast(NotFilesAB))
+					| ((knights >> 2) & Lanes::broadcast(NotFilesGH));
+
+				return (oneFile << 16) | (oneFile >> 16) | (twoFiles << 8) | (twoFiles >> 8);
+			}
+
+			template <typename Lanes>
+			Lanes kingAttacks(const Lanes& kings)
+			{
+				const Lanes sides
+					= ((kings << 1) & Lanes::broadcast(NotFileA))
+					| ((kings >> 1) & Lanes::broadcast(NotFileH));
+				const Lanes row = kings | sides;
+
+				return sides | (row << 8) | (row >> 8);
+			}
+
+			template <typename Lanes>
+			Lanes pawnAttacks(const Lanes& pawns, const bool white)
+			{
+				const Lanes notFileA = Lanes::broadcast(NotFileA);
+				const Lanes notFileH = Lanes::broadcast(NotFileH);
+
+				return white
+					? ((pawns << 9) & notFileA) | ((pawns << 7) & notFileH)
+					: ((pawns >> 7) & notFileA) | ((pawns >> 9) & notFileH);
+			}
+
+			/**
+			 * Computes the attacks of the \c Lanes::Width positions of \p
+			 * batch starting at \p offset.
+			 */
+			template <typename Lanes>
+			void computeBlock(const BatchView& batch, const size_t offset)
+			{
+				Lanes pieces[2][6];
+				Lanes occupied = Lanes::broadcast(0);
+
+				for (int color = 0; color < 2; ++color)
+				{
+					for (int type = 0; type < 6; ++type)
+					{
+						pieces[color][type] = Lanes::load(batch.pieces[color][type] + offset);
+						occupied = occupied | pieces[color][type];
+					}
+				}
+
+				const Lanes empty = ~occupied;
+
+				constexpr int Pawn = static_cast<int>(PieceType::Pawn);
+				constexpr int Rook = static_cast<int>(PieceType::Rook);
+				constexpr int Knight = static_cast<int>(PieceType::Knight);
+				constexpr int Bishop = static_cast<int>(PieceType::Bishop);
+				constexpr int Queen = static_cast<int>(PieceType::Queen);
+				constexpr int King = static_cast<int>(PieceType::King);
+
+				for (int color = 0; color < 2; ++color)
+				{
+					Lanes attacks[6];
+					attacks[Pawn] = pawnAttacks(pieces[color][Pawn], color == 0);
+					attacks[Rook] = orthogonalAttacks(pieces[color][Rook], empty);
+					attacks[Knight] = knightAttacks(pieces[color][Knight]);
+					attacks[Bishop] = diagonalAttacks(pieces[color][Bishop], empty);
+					attacks[Queen] = orthogonalAttacks(pieces[color][Queen], empty)
+						| diagonalAttacks(pieces[color][Queen], empty);
+					attacks[King] = kingAttacks(pieces[color][King]);
+
+					Lanes all = Lanes::broadcast(0);
+
+					for (int type = 0; type < 6; ++type)
+					{
+						Lanes::store(batch.pieceAttacks[color][type] + offset, attacks[type]);
+						all = all | attacks[type];
+					}
+
+					Lanes::store(batch.colorAttacks[color] + offset, all);
+				}
+			}
+
+			/**
+			 * Computes the attacks of every position of \p batch, \c
+			 * Lanes::Width at a time.
+			 */
+			template <typename Lanes>
+			void computeAll(const BatchView& batch)
+			{
+				constexpr size_t Width = Lanes::Width;
+
+				size_t offset = 0;
+
+				for (; offset + Width <= batch.size; offset += Width)
+				{
+					computeBlock<Lanes>(batch, offset);
+				}
+
+				const size_t remaining = batch.size - offset;
+
+				if (remaining == 0)
+				{
+					return;
+				}
+
+				// The last positions are copied to full blocks padded with
+				// empty boards
+				Bitboard pieces[2][6][Width] = {};
+				Bitboard pieceAttacks[2][6][Width] = {};
+				Bitboard colorAttacks[2][Width] = {};
+
+				BatchView tail;
+				tail.size = Width;
+
+				for (int color = 0; color < 2; ++color)
+				{
+					for (int type = 0; type < 6; ++type)
+					{
+						std::memcpy(
+								pieces[color][type],
+								batch.pieces[color][type] + offset,
+								remaining * sizeof(Bitboard));
+
+						tail.pieces[color][type] = pieces[color][type];
+						tail.pieceAttacks[color][type] = pieceAttacks[color][type];
+					}
+
+					tail.colorAttacks[color] = colorAttacks[color];
+				}
+
+				computeBlock<Lanes>(tail, 0);
+
+				for (int color = 0; color < 2; ++color)
+				{
+					for (int type = 0; type < 6; ++type)
+					{
+						std::memcpy(
+								batch.pieceAttacks[color][type] + offset,
+								pieceAttacks[color][type],
+								remaining * sizeof(Bitboard));
+					}
+
+					std::memcpy(
+							batch.colorAttacks[color] + offset,
+							colorAttacks[color],
+							remaining * sizeof(Bitboard));
+				}
+			}
+		}
+	}
+}
+
+#endif
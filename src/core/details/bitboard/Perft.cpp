@@ -0,0 +1,52 @@
+#include "Perft.h"
+
+using namespace simplechess;
+using namespace simplechess::details;
+
+uint64_t Perft::count(const Position& position, const unsigned depth)
+{
+	if (depth == 0)
+	{
+		return 1;
+	}
+
+	MoveList moves;
+	position.legalMoves(moves);
+
+	if (depth == 1)
+	{
+		// Bulk counting: the leaves need not be played
+		return moves.size;
+	}
+
+	uint64_t result = 0;
+
+	for (const Move& move : moves)
+	{
+		Position next = position;
+		next.makeMove(move);
+		result += count(next, depth - 1);
+	}
+
+	return result;
+}
+
+std::vector<std::pair<Move, uint64_t>> Perft::divide(
+		const Position& position,
+		const unsigned depth)
+{
+	MoveList moves;
+	position.legalMoves(moves);
+
+	std::vector<std::pair<Move, uint64_t>> result;
+	result.reserve(moves.size);
+
+	for (const Move& move : moves)
+	{
+		Position next = position;
+		next.makeMove(move);
+		result.push_back({move, count(next, depth - 1)});
+	}
+
+	return result;
+}
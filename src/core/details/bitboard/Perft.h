@@ -0,0 +1,42 @@
+#ifndef PERFT_H_C5A0E7F3_19B4_4D62_8E3A_2B7D0F4C91E6
+#define PERFT_H_C5A0E7F3_19B4_4D62_8E3A_2B7D0F4C91E6
+
+#include "Position.h"
+
+#include <utility>
+#include <vector>
+
+#include <cstdint>
+
+namespace simplechess
+{
+	namespace details
+	{
+		/**
+		 * \brief Collection of methods to count the leaf nodes of the tree
+		 * of legal moves, used to validate move generation.
+		 */
+		class Perft
+		{
+			public:
+				/**
+				 * \brief Returns the number of move sequences of length \p
+				 * depth which can be played from \p position.
+				 */
+				static uint64_t count(const Position& position, unsigned depth);
+
+				/**
+				 * \brief Returns, for each legal move in \p position, the
+				 * number of move sequences of length \p depth which start
+				 * with it.
+				 *
+				 * \note \p depth must be at least 1.
+				 */
+				static std::vector<std::pair<Move, uint64_t>> divide(
+						const Position& position,
+						unsigned depth);
+		};
+	}
+}
+
+#endif
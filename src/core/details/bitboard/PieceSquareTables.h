@@ -0,0 +1,220 @@
+#ifndef PIECE_SQUARE_TABLES_H_71C4E2A9_5D38_4B06_8F1A_E93B6D20C547
+#define PIECE_SQUARE_TABLES_H_71C4E2A9_5D38_4B06_8F1A_E93B6D20C547
+
+#include <cstdint>
+
+/**
+ * Material and piece-square values which a \ref Position keeps up to date
+ * as pieces are put on and removed from the board.
+ *
+ * There is one value for the middlegame and one for the endgame; the
+ * evaluation blends them according to the phase of the game, which is
+ * computed from the pieces left on the board. Values are in centipawns
+ * from the point of view of white, so black pieces count negatively.
+ */
+
+namespace simplechess
+{
+	namespace details
+	{
+		namespace pst
+		{
+			/**
+			 * Phase of the game contributed by each piece type, indexed
+			 * by \ref PieceType. The initial position has \ref MaxPhase.
+			 */
+			constexpr int PhaseWeights[6] = {0, 2, 1, 1, 4, 0};
+			constexpr int MaxPhase = 24;
+
+			constexpr int MiddlegameValues[6] = {100, 480, 320, 330, 900, 0};
+			constexpr int EndgameValues[6] = {120, 520, 300, 320, 940, 0};
+
+			/**
+			 * Bonus of every piece type on every square in the middlegame,
+			 * as seen by white with a8 first (so that the tables read like
+			 * a board), indexed by \ref PieceType.
+			 */
+			constexpr int MiddlegameSquares[6][64] = {
+				// Pawn
+				{
+					  0,   0,   0,   0,   0,   0,   0,   0,
+					 50,  50,  50,  50,  50,  50,  50,  50,
+					 10,  10,  20,  30,  30,  20,  10,  10,
+					  5,   5,  10,  25,  25,  10,   5,   5,
+					  0,   0,   0,  20,  20,   0,   0,   0,
+					  5,  -5, -10,   0,   0, -10,  -5,   5,
+					  5,  10,  10, -20, -20,  10,  10,   5,
+					  0,   0,   0,   0,   0,   0,   0,   0
+				},
+				// Rook
+				{
+					  0,   0,   0,   0,   0,   0,   0,   0,
+					  5,  10,  10,  10,  10,  10,  10,   5,
+					 -5,   0,   0,   0,   0,   0,   0,  -5,
+					 -5,   0,   0,   0,   0,   0,   0,  -5,
+					 -5,   0,   0,   0,   0,   0,   0,  -5,
+					 -5,   0,   0,   0,   0,   0,   0,  -5,
+					 -5,   0,   0,   0,   0,   0,   0,  -5,
+					  0,   0,   0,   5,   5,   0,   0,   0
+				},
+				// Knight
+				{
+					-50, -40, -30, -30, -30, -30, -40, -50,
+					-40, -20,   0,   0,   0,   0, -20, -40,
+					-30,   0,  10,  15,  15,  10,   0, -30,
+					-30,   5,  15,  20,  20,  15,   5, -30,
+					-30,   0,  15,  20,  20,  15,   0, -30,
+					-30,   5,  10,  15,  15,  10,   5, -30,
+					-40, -20,   0,   5,   5,   0, -20, -40,
+					-50, -40, -30, -30, -30, -30, -40, -50
+				},
+				// Bishop
+				{
+					-20, -10, -10, -10, -10, -10, -10, -20,
+					-10,   0,   0,   0,   0,   0,   0, -10,
+					-10,   0,   5,  10,  10,   5,   0, -10,
+					-10,   5,   5,  10,  10,   5,   5, -10,
+					-10,   0,  10,  10,  10,  10,   0, -10,
+					-10,  10,  10,  10,  10,  10,  10, -10,
+					-10,   5,   0,   0,   0,   0,   5, -10,
+					-20, -10, -10, -10, -10, -10, -10, -20
+				},
+				// Queen
+				{
+					-20, -10, -10,  -5,  -5, -10, -10, -20,
+					-10,   0,   0,   0,   0,   0,   0, -10,
+					-10,   0,   5,   5,   5,   5,   0, -10,
+					 -5,   0,   5,   5,   5,   5,   0,  -5,
+					  0,   0,   5,   5,   5,   5,   0,  -5,
+					-10,   5,   5,   5,   5,   5,   0, -10,
+					-10,   0,   5,   0,   0,   0,   0, -10,
+					-20, -10, -10,  -5,  -5, -10, -10, -20
+				},
+				// King
+				{
+					-30, -40, -40, -50, -50, -40, -40, -30,
+					-30, -40, -40, -50, -50, -40, -40, -30,
+					-30, -40, -40, -50, -50, -40, -40, -30,
+					-30, -40, -40, -50, -50, -40, -40, -30,
+					-20, -30, -30, -40, -40, -30, -30, -20,
+					-10, -20, -20, -20, -20, -20, -20, -10,
+					 20,  20,   0,   0,   0,   0,  20,  20,
+					 20,  30,  10,   0,   0,  10,  30,  20
+				}
+			};
+
+			/**
+			 * Same as \ref MiddlegameSquares, for the endgame: pawns are
+			 * worth more the closer they are to promotion, and the king
+			 * belongs in the centre.
+			 */
+			constexpr int EndgameSquares[6][64] = {
+				// Pawn
+				{
+					  0,   0,   0,   0,   0,   0,   0,   0,
+					 80,  80,  80,  80,  80,  80,  80,  80,
+					 50,  50,  50,  50,  50,  50,  50,  50,
+					 30,  30,  30,  30,  30,  30,  30,  30,
+					 15,  15,  15,  15,  15,  15,  15,  15,
+					  5,   5,   5,   5,   5,   5,   5,   5,
+					  0,   0,   0,   0,   0,   0,   0,   0,
+					  0,   0,   0,   0,   0,   0,   0,   0
+				},
+				// Rook
+				{
+					  0,   0,   0,   0,   0,   0,   0,   0,
+					 10,  10,  10,  10,  10,  10,  10,  10,
+					  0,   0,   0,   0,   0,   0,   0,   0,
+					  0,   0,   0,   0,   0,   0,   0,   0,
+					  0,   0,   0,   0,   0,   0,   0,   0,
+					  0,   0,   0,   0,   0,   0,   0,   0,
+					  0,   0,   0,   0,   0,   0,   0,   0,
+					  0,   0,   0,   0,   0,   0,   0,   0
+				},
+				// Knight
+				{
+					-50, -40, -30, -30, -30, -30, -40, -50,
+					-40, -20,   0,   0,   0,   0, -20, -40,
+					-30,   0,  10,  15,  15,  10,   0, -30,
+					-30,   5,  15,  20,  20,  15,   5, -30,
+					-30,   0,  15,  20,  20,  15,   0, -30,
+					-30,   5,  10,  15,  15,  10,   5, -30,
+					-40, -20,   0,   5,   5,   0, -20, -40,
+					-50, -40, -30, -30, -30, -30, -40, -50
+				},
+				// Bishop
+				{
+					-20, -10, -10, -10, -10, -10, -10, -20,
+					-10,   0,   0,   0,   0,   0,   0, -10,
+					-10,   0,   5,  10,  10,   5,   0, -10,
+					-10,   5,  10,  15,  15,  10,   5, -10,
+					-10,   5,  10,  15,  15,  10,   5, -10,
+					-10,   0,   5,  10,  10,   5,   0, -10,
+					-10,   0,   0,   0,   0,   0,   0, -10,
+					-20, -10, -10, -10, -10, -10, -10, -20
+				},
+				// Queen
+				{
+					-20, -10, -10,  -5,  -5, -10, -10, -20,
+					-10,   0,   5,   5,   5,   5,   0, -10,
+					-10,   5,  10,  10,  10,  10,   5, -10,
+					 -5,   5,  10,  15,  15,  10,   5,  -5,
+					 -5,   5,  10,  15,  15,  10,   5,  -5,
+					-10,   5,  10,  10,  10,  10,   5, -10,
+					-10,   0,   5,   5,   5,   5,   0, -10,
+					-20, -10, -10,  -5,  -5, -10, -10, -20
+				},
+				// King
+				{
+					-50, -40, -30, -20, -20, -30, -40, -50,
+					-30, -20, -10,   0,   0, -10, -20, -30,
+					-30, -10,  20,  30,  30,  20, -10, -30,
+					-30, -10,  30,  40,  40,  30, -10, -30,
+					-30, -10,  30,  40,  40,  30, -10, -30,
+					-30, -10,  20,  30,  30,  20, -10, -30,
+					-30, -30,   0,   0,   0,   0, -30, -30,
+					-50, -30, -30, -30, -30, -30, -30, -50
+				}
+			};
+
+			/**
+			 * Material plus square bonus of every piece code (minus one)
+			 * on every square index, from the point of view of white.
+			 */
+			struct Tables
+			{
+				int16_t middlegame[12][64];
+				int16_t endgame[12][64];
+			};
+
+			constexpr Tables generateTables()
+			{
+				Tables tables = {};
+
+				for (int type = 0; type < 6; ++type)
+				{
+					for (int square = 0; square < 64; ++square)
+					{
+						// The tables start at a8, so white squares are
+						// mirrored
+						tables.middlegame[type][square] = static_cast<int16_t>(
+								MiddlegameValues[type] + MiddlegameSquares[type][square ^ 56]);
+						tables.endgame[type][square] = static_cast<int16_t>(
+								EndgameValues[type] + EndgameSquares[type][square ^ 56]);
+
+						tables.middlegame[type + 6][square] = static_cast<int16_t>(
+								-MiddlegameValues[type] - MiddlegameSquares[type][square]);
+						tables.endgame[type + 6][square] = static_cast<int16_t>(
+								-EndgameValues[type] - EndgameSquares[type][square]);
+					}
+				}
+
+				return tables;
+			}
+
+			constexpr Tables sTables = generateTables();
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,852 @@
+#include "Position.h"
+
+#include "Zobrist.h"
+
+#include "../../Builders.h"
+#include "../fen/FenUtils.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+
+using namespace simplechess;
+using namespace simplechess::details;
+
+namespace
+{
+	constexpr uint8_t NoSquare = 64;
+
+	constexpr uint8_t A1 = squareIndex(1, 'a');
+	constexpr uint8_t H1 = squareIndex(1, 'h');
+	constexpr uint8_t A8 = squareIndex(8, 'a');
+	constexpr uint8_t H8 = squareIndex(8, 'h');
+
+	int colorIndex(const Color color)
+	{
+		return color == Color::White ? 0 : 1;
+	}
+
+	/**
+	 * Castling rights which are kept after a move starts or ends on each
+	 * square.
+	 */
+	uint8_t castlingRightsKeptBy(const uint8_t square)
+	{
+		switch (square)
+		{
+			case A1:
+				return ~static_cast<uint8_t>(CastlingRight::WhiteQueenSide);
+			case H1:
+				return ~static_cast<uint8_t>(CastlingRight::WhiteKingSide);
+			case A8:
+				return ~static_cast<uint8_t>(CastlingRight::BlackQueenSide);
+			case H8:
+				return ~static_cast<uint8_t>(CastlingRight::BlackKingSide);
+			default:
+				return 0xFF;
+		}
+	}
+}
+
+Move simplechess::details::moveFromPieceMove(const PieceMove& move)
+{
+	return {
+		squareIndex(move.src()),
+		squareIndex(move.dst()),
+		move.promoted() ? *move.promoted() : PieceType::Pawn };
+}
+
+Position::Position()
+	: mPieces{},
+	  mByColor{},
+	  mOccupied(0),
+	  mSquares{},
+	  mActiveColor(Color::White),
+	  mCastlingRights(0),
+	  mEnPassantSquare(NoSquare),
+	  mHalfmoveClock(0),
+	  mFullmoveCounter(1),
+	  mHash(zobrist::sKeys.castling[0]),
+	  mPawnHash(0),
+	  mMiddlegameScore(0),
+	  mEndgameScore(0),
+	  mPhase(0)
+{
+}
+
+Position Position::fromStage(const GameStage& stage)
+{
+	return fromBoard(
+			stage.board(),
+			stage.activeColor(),
+			stage.castlingRights(),
+			stage.enPassantTarget(),
+			stage.halfMovesSinceLastCaptureOrPawnAdvance(),
+			stage.fullMoveCounter());
+}
+
+Position Position::fromBoard(
+		const Board& board,
+		const Color activeColor,
+		const uint8_t castlingRights,
+		const std::optional<Square>& enPassantTarget,
+		const uint16_t halfmoveClock,
+		const uint16_t fullmoveCounter)
+{
+	uint8_t squares[64] = {};
+
+	for (const auto& [square, piece] : board.occupiedSquares())
+	{
+		squares[squareIndex(square)] = pieceCode(piece);
+	}
+
+	return fromMailbox(
+			squares,
+			activeColor,
+			castlingRights,
+			enPassantTarget
+				? std::optional<uint8_t>(squareIndex(*enPassantTarget))
+				: std::nullopt,
+			halfmoveClock,
+			fullmoveCounter);
+}
+
+Position Position::fromMailbox(
+		const uint8_t (&squares)[64],
+		const Color activeColor,
+		const uint8_t castlingRights,
+		const std::optional<uint8_t>& enPassantSquare,
+		const uint16_t halfmoveClock,
+		const uint16_t fullmoveCounter)
+{
+	Position result;
+
+	for (uint8_t square = 0; square < 64; ++square)
+	{
+		if (squares[square] != NoPiece)
+		{
+			result.putPiece(square, squares[square]);
+		}
+	}
+
+	if (activeColor == Color::Black)
+	{
+		result.mActiveColor = Color::Black;
+		result.mHash ^= zobrist::sKeys.blackToMove;
+	}
+
+	result.setCastlingRights(castlingRights);
+
+	if (enPassantSquare)
+	{
+		result.setEnPassantSquare(*enPassantSquare);
+	}
+
+	result.mHalfmoveClock = halfmoveClock;
+	result.mFullmoveCounter = fullmoveCounter;
+
+	return result;
+}
+
+void Position::pack(uint8_t* output) const
+{
+	if (popCount(mOccupied) > 32)
+	{
+		throw std::invalid_argument("Too many pieces to pack the position");
+	}
+
+	for (int i = 0; i < 8; ++i)
+	{
+		output[i] = static_cast<uint8_t>(mOccupied >> (8 * i));
+	}
+
+	uint8_t* codes = output + 8;
+	std::fill(codes, codes + 16, uint8_t(0));
+
+	Bitboard occupied = mOccupied;
+
+	for (unsigned n = 0; occupied; ++n)
+	{
+		codes[n >> 1] |= static_cast<uint8_t>(
+				mSquares[popLsb(occupied)] << ((n & 1) * 4));
+	}
+
+	output[24] = static_cast<uint8_t>(
+			(mActiveColor == Color::Black ? 1 : 0)
+			| ((mCastlingRights & 0x0F) << 1));
+	output[25] = (mEnPassantSquare == NoSquare)
+		? 0
+		: static_cast<uint8_t>(fileOf(mEnPassantSquare) + 1);
+	output[26] = static_cast<uint8_t>(mHalfmoveClock);
+	output[27] = static_cast<uint8_t>(mHalfmoveClock >> 8);
+	output[28] = static_cast<uint8_t>(mFullmoveCounter);
+	output[29] = static_cast<uint8_t>(mFullmoveCounter >> 8);
+	output[30] = 0;
+	output[31] = 0;
+}
+
+std::optional<Position> Position::unpack(const uint8_t* data)
+{
+	Bitboard occupied = 0;
+
+	for (int i = 0; i < 8; ++i)
+	{
+		occupied |= static_cast<Bitboard>(data[i]) << (8 * i);
+	}
+
+	const int count = popCount(occupied);
+
+	if (count > 32
+			|| (data[24] & 0xE0) != 0
+			|| data[25] > 8
+			|| data[30] != 0
+			|| data[31] != 0)
+	{
+		return std::nullopt;
+	}
+
+	const uint8_t* codes = data + 8;
+	uint8_t squares[64] = {};
+	uint8_t invalid = 0;
+
+	for (int n = 0; n < 32; ++n)
+	{
+		const uint8_t code = (codes[n >> 1] >> ((n & 1) * 4)) & 0x0F;
+
+		if (n < count)
+		{
+			squares[popLsb(occupied)] = code;
+			invalid |= (code == NoPiece || code > 12);
+		}
+		else
+		{
+			invalid |= (code != NoPiece);
+		}
+	}
+
+	const uint16_t fullmoveCounter
+		= static_cast<uint16_t>(data[28] | (data[29] << 8));
+
+	if (invalid || fullmoveCounter == 0)
+	{
+		return std::nullopt;
+	}
+
+	const Color activeColor = (data[24] & 1) ? Color::Black : Color::White;
+
+	// The en passant target is behind a pawn of the side not to move
+	const std::optional<uint8_t> enPassantSquare = (data[25] == 0)
+		? std::nullopt
+		: std::optional<uint8_t>(squareIndex(
+					activeColor == Color::White ? 6 : 3,
+					static_cast<char>('a' + data[25] - 1)));
+
+	return fromMailbox(
+			squares,
+			activeColor,
+			static_cast<uint8_t>(data[24] >> 1),
+			enPassantSquare,
+			static_cast<uint16_t>(data[26] | (data[27] << 8)),
+			fullmoveCounter);
+}
+
+std::optional<Piece> Position::pieceAt(const uint8_t square) const
+{
+	const uint8_t code = mSquares[square];
+
+	if (code == NoPiece)
+	{
+		return std::nullopt;
+	}
+
+	return Piece(pieceTypeOf(code), colorOf(code));
+}
+
+std::optional<uint8_t> Position::enPassantSquare() const
+{
+	if (mEnPassantSquare == NoSquare)
+	{
+		return std::nullopt;
+	}
+
+	return mEnPassantSquare;
+}
+
+bool Position::isRepetitionOf(const Position& other) const
+{
+	return mHash == other.mHash
+		&& mActiveColor == other.mActiveColor
+		&& mCastlingRights == other.mCastlingRights
+		&& mEnPassantSquare == other.mEnPassantSquare
+		&& std::memcmp(mSquares, other.mSquares, sizeof(mSquares)) == 0;
+}
+
+Bitboard Position::attackersTo(
+		const uint8_t square,
+		const Color color,
+		const Bitboard occupied) const
+{
+	const Bitboard queens = pieces(color, PieceType::Queen);
+
+	return (pawnAttacks(oppositeColor(color), square) & pieces(color, PieceType::Pawn))
+		| (knightAttacks(square) & pieces(color, PieceType::Knight))
+		| (kingAttacks(square) & pieces(color, PieceType::King))
+		| (bishopAttacks(square, occupied) & (pieces(color, PieceType::Bishop) | queens))
+		| (rookAttacks(square, occupied) & (pieces(color, PieceType::Rook) | queens));
+}
+
+void Position::putPiece(const uint8_t square, const uint8_t code)
+{
+	const Bitboard mask = bit(square);
+	mPieces[code - 1] |= mask;
+	mByColor[colorIndex(colorOf(code))] |= mask;
+	mOccupied |= mask;
+	mSquares[square] = code;
+	mHash ^= zobrist::sKeys.pieceSquare[code - 1][square];
+	updateScores(square, code, 1);
+}
+
+void Position::removePiece(const uint8_t square)
+{
+	const uint8_t code = mSquares[square];
+
+	if (code == NoPiece)
+	{
+		return;
+	}
+
+	const Bitboard mask = ~bit(square);
+	mPieces[code - 1] &= mask;
+	mByColor[colorIndex(colorOf(code))] &= mask;
+	mOccupied &= mask;
+	mSquares[square] = NoPiece;
+	mHash ^= zobrist::sKeys.pieceSquare[code - 1][square];
+	updateScores(square, code, -1);
+}
+
+void Position::updateScores(const uint8_t square, const uint8_t code, const int sign)
+{
+	const PieceType type = pieceTypeOf(code);
+
+	if (type == PieceType::Pawn)
+	{
+		mPawnHash ^= zobrist::sKeys.pieceSquare[code - 1][square];
+	}
+
+	mMiddlegameScore += sign * pst::sTables.middlegame[code - 1][square];
+	mEndgameScore += sign * pst::sTables.endgame[code - 1][square];
+	mPhase += sign * pst::PhaseWeights[static_cast<int>(type)];
+}
+
+void Position::setCastlingRights(const uint8_t rights)
+{
+	mHash ^= zobrist::sKeys.castling[mCastlingRights & 0x0F];
+	mCastlingRights = rights;
+	mHash ^= zobrist::sKeys.castling[mCastlingRights & 0x0F];
+}
+
+void Position::setEnPassantSquare(const uint8_t square)
+{
+	if (mEnPassantSquare != NoSquare)
+	{
+		mHash ^= zobrist::sKeys.enPassantFile[fileOf(mEnPassantSquare)];
+	}
+
+	mEnPassantSquare = square;
+
+	if (mEnPassantSquare != NoSquare)
+	{
+		mHash ^= zobrist::sKeys.enPassantFile[fileOf(mEnPassantSquare)];
+	}
+}
+
+void Position::movePieces(const Move& move)
+{
+	const uint8_t code = mSquares[move.src];
+	const PieceType type = pieceTypeOf(code);
+
+	if (type == PieceType::Pawn
+			&& fileOf(move.src) != fileOf(move.dst)
+			&& mSquares[move.dst] == NoPiece)
+	{
+		// En passant: the captured pawn is behind the landing square
+		removePiece(static_cast<uint8_t>(
+					rankOf(move.src) * 8 + fileOf(move.dst)));
+	}
+	else if (type == PieceType::King
+			&& (move.dst == move.src + 2 || move.src == move.dst + 2))
+	{
+		// Castling: move the rook as well
+		const bool kingSide = move.dst > move.src;
+		const uint8_t rookSrc = kingSide ? move.src + 3 : move.src - 4;
+		const uint8_t rookDst = kingSide ? move.src + 1 : move.src - 1;
+		const uint8_t rook = mSquares[rookSrc];
+		removePiece(rookSrc);
+		putPiece(rookDst, rook);
+	}
+
+	removePiece(move.dst);
+	removePiece(move.src);
+	putPiece(
+			move.dst,
+			(move.promotion != PieceType::Pawn)
+				? pieceCode(move.promotion, colorOf(code))
+				: code);
+}
+
+bool Position::isPseudoLegalPawnMove(const Move& move) const
+{
+	const bool white = mActiveColor == Color::White;
+	const int forward = white ? 8 : -8;
+
+	if (fileOf(move.src) == fileOf(move.dst))
+	{
+		if (mOccupied & bit(move.dst))
+		{
+			return false;
+		}
+
+		if (move.dst == move.src + forward)
+		{
+			return true;
+		}
+
+		const uint8_t startRank = white ? 1 : 6;
+		return rankOf(move.src) == startRank
+			&& move.dst == move.src + 2 * forward
+			&& !(mOccupied & bit(static_cast<uint8_t>(move.src + forward)));
+	}
+
+	if (!(pawnAttacks(mActiveColor, move.src) & bit(move.dst)))
+	{
+		return false;
+	}
+
+	return (pieces(oppositeColor(mActiveColor)) & bit(move.dst))
+		|| move.dst == mEnPassantSquare;
+}
+
+bool Position::isPseudoLegalCastling(const Move& move) const
+{
+	const bool white = mActiveColor == Color::White;
+	const bool kingSide = move.dst > move.src;
+
+	const uint8_t right = white
+		? (kingSide ? CastlingRight::WhiteKingSide : CastlingRight::WhiteQueenSide)
+		: (kingSide ? CastlingRight::BlackKingSide : CastlingRight::BlackQueenSide);
+
+	if (!(mCastlingRights & right)
+			|| move.src != squareIndex(white ? 1 : 8, 'e'))
+	{
+		return false;
+	}
+
+	const Color them = oppositeColor(mActiveColor);
+
+	if (isAttacked(move.src, them))
+	{
+		// Castling is not available in check
+		return false;
+	}
+
+	// The squares the king passes through must be empty and not under
+	// attack
+	const uint8_t passing[2] = {
+		static_cast<uint8_t>(kingSide ? move.src + 1 : move.src - 1),
+		static_cast<uint8_t>(kingSide ? move.src + 2 : move.src - 2) };
+
+	for (const uint8_t square : passing)
+	{
+		if ((mOccupied & bit(square)) || isAttacked(square, them))
+		{
+			return false;
+		}
+	}
+
+	// When castling queenside the rook also passes through the b-file,
+	// which only has to be empty
+	return kingSide || !(mOccupied & bit(static_cast<uint8_t>(move.src - 3)));
+}
+
+bool Position::leavesKingSafe(const Move& move) const
+{
+	Position afterMove = *this;
+	afterMove.movePieces(move);
+	return !afterMove.isAttacked(
+			afterMove.kingSquare(mActiveColor),
+			oppositeColor(mActiveColor));
+}
+
+Bitboard Position::pinnedPieces() const
+{
+	const Color them = oppositeColor(mActiveColor);
+	const uint8_t king = kingSquare(mActiveColor);
+	const Bitboard queens = pieces(them, PieceType::Queen);
+
+	Bitboard pinned = 0;
+
+	// Enemy sliders which would attack the king on an empty board, and the
+	// squares in between (excluding both ends) along that same line
+	Bitboard snipers = rookAttacks(king, 0) & (pieces(them, PieceType::Rook) | queens);
+	while (snipers)
+	{
+		const uint8_t sniper = popLsb(snipers);
+		const Bitboard between
+			= rookAttacks(king, bit(sniper)) & rookAttacks(sniper, bit(king)) & mOccupied;
+
+		if (popCount(between) == 1)
+		{
+			pinned |= between & pieces(mActiveColor);
+		}
+	}
+
+	snipers = bishopAttacks(king, 0) & (pieces(them, PieceType::Bishop) | queens);
+	while (snipers)
+	{
+		const uint8_t sniper = popLsb(snipers);
+		const Bitboard between
+			= bishopAttacks(king, bit(sniper)) & bishopAttacks(sniper, bit(king)) & mOccupied;
+
+		if (popCount(between) == 1)
+		{
+			pinned |= between & pieces(mActiveColor);
+		}
+	}
+
+	return pinned;
+}
+
+bool Position::isLegal(const Move& move) const
+{
+	if (move.src >= 64 || move.dst >= 64 || move.src == move.dst)
+	{
+		return false;
+	}
+
+	const uint8_t code = mSquares[move.src];
+
+	if (code == NoPiece
+			|| colorOf(code) != mActiveColor
+			|| (pieces(mActiveColor) & bit(move.dst)))
+	{
+		return false;
+	}
+
+	const PieceType type = pieceTypeOf(code);
+
+	const bool reachesLastRank = type == PieceType::Pawn
+		&& (rankOf(move.dst) == 0 || rankOf(move.dst) == 7);
+
+	if (reachesLastRank != (move.promotion != PieceType::Pawn)
+			|| move.promotion == PieceType::King)
+	{
+		return false;
+	}
+
+	bool pseudoLegal = false;
+
+	switch (type)
+	{
+		case PieceType::Pawn:
+			pseudoLegal = isPseudoLegalPawnMove(move);
+			break;
+		case PieceType::Knight:
+			pseudoLegal = (knightAttacks(move.src) & bit(move.dst)) != 0;
+			break;
+		case PieceType::Bishop:
+			pseudoLegal = (bishopAttacks(move.src, mOccupied) & bit(move.dst)) != 0;
+			break;
+		case PieceType::Rook:
+			pseudoLegal = (rookAttacks(move.src, mOccupied) & bit(move.dst)) != 0;
+			break;
+		case PieceType::Queen:
+			pseudoLegal = (queenAttacks(move.src, mOccupied) & bit(move.dst)) != 0;
+			break;
+		case PieceType::King:
+			pseudoLegal = (kingAttacks(move.src) & bit(move.dst))
+				|| ((move.dst == move.src + 2 || move.src == move.dst + 2)
+						&& isPseudoLegalCastling(move));
+			break;
+	}
+
+	if (!pseudoLegal)
+	{
+		return false;
+	}
+
+	// Filter out moves which would expose the own king
+	return leavesKingSafe(move);
+}
+
+void Position::legalMoves(MoveList& moves) const
+{
+	const Color us = mActiveColor;
+	const Color them = oppositeColor(us);
+	const Bitboard targets = ~pieces(us);
+	const Bitboard enemies = pieces(them);
+	const uint8_t king = kingSquare(us);
+
+	// When not in check, only the moves of pinned pieces and en passant
+	// captures can expose the king, so every other move is added without
+	// playing it
+	const bool inCheck = attackersTo(king, them, mOccupied) != 0;
+	const Bitboard pinned = pinnedPieces();
+
+	const auto addIfLegal = [&](const Move& move, const bool mustVerify)
+	{
+		if (!(mustVerify || inCheck || (pinned & bit(move.src)))
+				|| leavesKingSafe(move))
+		{
+			moves.push(move);
+		}
+	};
+
+	// Pawns
+	const bool white = us == Color::White;
+	const int forward = white ? 8 : -8;
+	const uint8_t startRank = white ? 1 : 6;
+	const uint8_t lastRank = white ? 7 : 0;
+
+	const auto addPawnMove = [&](const uint8_t src, const uint8_t dst, const bool mustVerify)
+	{
+		if (rankOf(dst) == lastRank)
+		{
+			for (const PieceType promotion : {PieceType::Rook, PieceType::Knight,
+					PieceType::Bishop, PieceType::Queen})
+			{
+				addIfLegal({src, dst, promotion}, mustVerify);
+			}
+		}
+		else
+		{
+			addIfLegal({src, dst, PieceType::Pawn}, mustVerify);
+		}
+	};
+
+	Bitboard pawns = pieces(us, PieceType::Pawn);
+	while (pawns)
+	{
+		const uint8_t src = popLsb(pawns);
+		const uint8_t oneStep = static_cast<uint8_t>(src + forward);
+
+		if (!(mOccupied & bit(oneStep)))
+		{
+			addPawnMove(src, oneStep, false);
+
+			const uint8_t twoSteps = static_cast<uint8_t>(oneStep + forward);
+			if (rankOf(src) == startRank && !(mOccupied & bit(twoSteps)))
+			{
+				addPawnMove(src, twoSteps, false);
+			}
+		}
+
+		Bitboard captures = pawnAttacks(us, src) & enemies;
+		while (captures)
+		{
+			addPawnMove(src, popLsb(captures), false);
+		}
+
+		if (mEnPassantSquare != NoSquare
+				&& (pawnAttacks(us, src) & bit(mEnPassantSquare)))
+		{
+			// Removing two pawns from the same rank might expose the king
+			addPawnMove(src, mEnPassantSquare, true);
+		}
+	}
+
+	// Knights and sliders
+	for (const PieceType type : {PieceType::Knight, PieceType::Bishop,
+			PieceType::Rook, PieceType::Queen})
+	{
+		Bitboard pieceSet = pieces(us, type);
+		while (pieceSet)
+		{
+			const uint8_t src = popLsb(pieceSet);
+
+			Bitboard attacks = 0;
+			switch (type)
+			{
+				case PieceType::Knight:
+					attacks = knightAttacks(src);
+					break;
+				case PieceType::Bishop:
+					attacks = bishopAttacks(src, mOccupied);
+					break;
+				case PieceType::Rook:
+					attacks = rookAttacks(src, mOccupied);
+					break;
+				default:
+					attacks = queenAttacks(src, mOccupied);
+					break;
+			}
+
+			attacks &= targets;
+			while (attacks)
+			{
+				addIfLegal({src, popLsb(attacks), PieceType::Pawn}, false);
+			}
+		}
+	}
+
+	// King: the destination must not be attacked once the king has left
+	// its square (which might have been blocking a slider)
+	Bitboard kingTargets = kingAttacks(king) & targets;
+	while (kingTargets)
+	{
+		const uint8_t dst = popLsb(kingTargets);
+		if (!attackersTo(dst, them, mOccupied ^ bit(king)))
+		{
+			moves.push({king, dst, PieceType::Pawn});
+		}
+	}
+
+	if (!inCheck && mCastlingRights)
+	{
+		for (const Move castling : {
+				Move{king, static_cast<uint8_t>(king + 2), PieceType::Pawn},
+				Move{king, static_cast<uint8_t>(king - 2), PieceType::Pawn}})
+		{
+			if (fileOf(king) == 4 && isPseudoLegalCastling(castling))
+			{
+				moves.push(castling);
+			}
+		}
+	}
+}
+
+void Position::makeMove(const Move& move)
+{
+	const uint8_t code = mSquares[move.src];
+	const PieceType type = pieceTypeOf(code);
+	const Color us = mActiveColor;
+	const Color them = oppositeColor(us);
+
+	const bool isCapture = mSquares[move.dst] != NoPiece
+		|| (type == PieceType::Pawn && fileOf(move.src) != fileOf(move.dst));
+
+	movePieces(move);
+
+	uint8_t castlingRights = mCastlingRights;
+
+	if (type == PieceType::King)
+	{
+		// Once the king moves, castling is no longer allowed
+		castlingRights &= (us == Color::White)
+			? ~(CastlingRight::WhiteKingSide | CastlingRight::WhiteQueenSide)
+			: ~(CastlingRight::BlackKingSide | CastlingRight::BlackQueenSide);
+	}
+
+	castlingRights &= castlingRightsKeptBy(move.src);
+	castlingRights &= castlingRightsKeptBy(move.dst);
+
+	if (castlingRights != mCastlingRights)
+	{
+		setCastlingRights(castlingRights);
+	}
+
+	mHalfmoveClock = (type == PieceType::Pawn || isCapture)
+		? 0
+		: static_cast<uint16_t>(mHalfmoveClock + 1);
+
+	if (us == Color::Black)
+	{
+		++mFullmoveCounter;
+	}
+
+	mActiveColor = them;
+	mHash ^= zobrist::sKeys.blackToMove;
+	setEnPassantSquare(NoSquare);
+
+	if (type == PieceType::Pawn
+			&& (move.dst == move.src + 16 || move.src == move.dst + 16))
+	{
+		// Only report the en passant target if an enemy pawn can legally
+		// capture en passant (i.e. adjacent and not pinned)
+		const uint8_t candidate = static_cast<uint8_t>((move.src + move.dst) / 2);
+		Bitboard capturers = pawnAttacks(us, candidate) & pieces(them, PieceType::Pawn);
+
+		setEnPassantSquare(candidate);
+
+		bool anyLegal = false;
+		while (capturers && !anyLegal)
+		{
+			anyLegal = isLegal({popLsb(capturers), candidate, PieceType::Pawn});
+		}
+
+		if (!anyLegal)
+		{
+			setEnPassantSquare(NoSquare);
+		}
+	}
+}
+
+PieceMove Position::toPieceMove(const Move& move) const
+{
+	const uint8_t code = mSquares[move.src];
+	const Piece piece(pieceTypeOf(code), colorOf(code));
+
+	if (move.promotion != PieceType::Pawn)
+	{
+		return PieceMove::pawnPromotion(
+				piece,
+				squareFromIndex(move.src),
+				squareFromIndex(move.dst),
+				move.promotion);
+	}
+
+	return PieceMove::regularMove(
+			piece,
+			squareFromIndex(move.src),
+			squareFromIndex(move.dst));
+}
+
+Board Position::toBoard(const Board::allocator_type& allocator) const
+{
+	std::pmr::map<Square, Piece> positions(allocator);
+
+	Bitboard occupied = mOccupied;
+	while (occupied)
+	{
+		const uint8_t square = popLsb(occupied);
+		positions.insert({squareFromIndex(square), *pieceAt(square)});
+	}
+
+	return BoardBuilder::build(std::move(positions));
+}
+
+CheckType Position::checkStatus() const
+{
+	if (!inCheck())
+	{
+		return CheckType::NoCheck;
+	}
+
+	MoveList responses;
+	legalMoves(responses);
+
+	return (responses.size == 0)
+		? CheckType::CheckMate
+		: CheckType::Check;
+}
+
+GameStage Position::toStage(const GameStage::allocator_type& allocator) const
+{
+	const std::optional<uint8_t> epSquare = enPassantSquare();
+
+	char fen[FenUtils::MaxFenLength + 1];
+	const size_t fenLength = FenUtils::generateFen(*this, fen);
+
+	return GameStageBuilder::build(
+			toBoard(allocator),
+			mActiveColor,
+			mCastlingRights,
+			mHalfmoveClock,
+			mFullmoveCounter,
+			epSquare
+				? std::optional<Square>(squareFromIndex(*epSquare))
+				: std::nullopt,
+			checkStatus(),
+			std::string_view(fen, fenLength),
+			allocator);
+}
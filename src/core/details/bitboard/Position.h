@@ -0,0 +1,438 @@
+#ifndef POSITION_H_2B7E4C91_0D3A_4F58_8E6B_7A1F9C3D5E24
+#define POSITION_H_2B7E4C91_0D3A_4F58_8E6B_7A1F9C3D5E24
+
+#include "Bitboard.h"
+#include "PieceSquareTables.h"
+
+#include <cpp/simplechess/Board.h>
+#include <cpp/simplechess/Color.h>
+#include <cpp/simplechess/GameStage.h>
+#include <cpp/simplechess/Piece.h>
+#include <cpp/simplechess/PieceMove.h>
+
+#include <optional>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace simplechess
+{
+	namespace details
+	{
+		/**
+		 * \brief Compact description of a move between two square indices.
+		 *
+		 * Unlike \ref PieceMove, it does not carry the moving piece, which
+		 * is implied by the \ref Position the move is played on.
+		 */
+		struct Move
+		{
+			uint8_t src;
+			uint8_t dst;
+
+			/**
+			 * \brief The type the pawn is promoted to, or \ref
+			 * PieceType::Pawn if the move is not a promotion.
+			 */
+			PieceType promotion;
+
+			bool operator==(const Move& rhs) const
+			{
+				return src == rhs.src
+					&& dst == rhs.dst
+					&& promotion == rhs.promotion;
+			}
+
+			bool operator!=(const Move& rhs) const
+			{
+				return !(*this == rhs);
+			}
+		};
+
+		/**
+		 * \brief Returns the \ref Move describing the same piece movement
+		 * as \p move.
+		 */
+		Move moveFromPieceMove(const PieceMove& move);
+
+		/**
+		 * \brief Fixed-capacity list of moves, large enough for every legal
+		 * chess position, which can live on the stack.
+		 */
+		struct MoveList
+		{
+			Move moves[256];
+			size_t size = 0;
+
+			void push(const Move& move)
+			{
+				moves[size++] = move;
+			}
+
+			const Move* begin() const
+			{
+				return moves;
+			}
+
+			const Move* end() const
+			{
+				return moves + size;
+			}
+		};
+
+		/**
+		 * \brief Piece codes used by \ref Position to describe the contents
+		 * of a square in four bits: 0 for an empty square, 1 to 6 for the
+		 * white pieces and 7 to 12 for the black pieces, in the order of
+		 * \ref PieceType.
+		 */
+		constexpr uint8_t NoPiece = 0;
+
+		constexpr uint8_t pieceCode(const PieceType type, const Color color)
+		{
+			return static_cast<uint8_t>(
+					1 + static_cast<int>(type) + (color == Color::White ? 0 : 6));
+		}
+
+		inline uint8_t pieceCode(const Piece& piece)
+		{
+			return pieceCode(piece.type(), piece.color());
+		}
+
+		constexpr PieceType pieceTypeOf(const uint8_t code)
+		{
+			return static_cast<PieceType>((code - 1) % 6);
+		}
+
+		constexpr Color colorOf(const uint8_t code)
+		{
+			return (code <= 6) ? Color::White : Color::Black;
+		}
+
+		/**
+		 * \brief A bitboard-based description of a stage of the game, meant
+		 * for the internal hot paths of the library.
+		 *
+		 * It holds the same information as a \ref GameStage (minus the
+		 * derived FEN string and check status), laid out as one bitboard
+		 * per piece plus a square-indexed mailbox, so that it can be copied
+		 * cheaply and updated in place without allocating.
+		 *
+		 * The rules it implements are the same as those of \ref
+		 * MoveValidator and \ref GameStageUpdater, including the criterion
+		 * used to decide whether an en passant target is recorded.
+		 */
+		class Position
+		{
+			public:
+				/**
+				 * \brief Builds the \c Position equivalent to \p stage.
+				 */
+				static Position fromStage(const GameStage& stage);
+
+				/**
+				 * \brief Builds a \c Position from its components.
+				 */
+				static Position fromBoard(
+						const Board& board,
+						Color activeColor,
+						uint8_t castlingRights,
+						const std::optional<Square>& enPassantTarget,
+						uint16_t halfmoveClock,
+						uint16_t fullmoveCounter);
+
+				/**
+				 * \brief Builds a \c Position from the piece code of every
+				 * square (\ref NoPiece for empty squares) and the rest of
+				 * its components.
+				 */
+				static Position fromMailbox(
+						const uint8_t (&squares)[64],
+						Color activeColor,
+						uint8_t castlingRights,
+						const std::optional<uint8_t>& enPassantSquare,
+						uint16_t halfmoveClock,
+						uint16_t fullmoveCounter);
+
+				/**
+				 * \brief Size in bytes of a packed position.
+				 */
+				static constexpr size_t PackedSize = 32;
+
+				/**
+				 * \brief Writes the packed representation of the position
+				 * to the \ref PackedSize bytes at \p output.
+				 *
+				 * The layout is:
+				 * - Bytes 0-7: the occupied squares, as a little-endian
+				 *   bitboard (a1 is bit 0).
+				 * - Bytes 8-23: the piece code of every occupied square, in
+				 *   increasing square order, 4 bits each (low nibble
+				 *   first). Unused nibbles are 0.
+				 * - Byte 24: 1 if black is to move, plus the castling
+				 *   rights shifted 1 bit to the left.
+				 * - Byte 25: the file of the en passant target plus one, or
+				 *   0 if there is none.
+				 * - Bytes 26-27 and 28-29: the halfmove clock and the
+				 *   fullmove counter, little-endian.
+				 * - Bytes 30-31: 0.
+				 *
+				 * \throws std::invalid_argument if there are more than 32
+				 * pieces on the board.
+				 */
+				void pack(uint8_t* output) const;
+
+				/**
+				 * \brief Returns the position packed in the \ref PackedSize
+				 * bytes at \p data, or an empty value if they do not follow
+				 * the layout of \ref pack().
+				 *
+				 * \note Only the layout is validated, not whether the
+				 * position could arise in a game.
+				 */
+				static std::optional<Position> unpack(const uint8_t* data);
+
+				/**
+				 * \brief Returns the piece code of the piece on \p square.
+				 */
+				uint8_t pieceCodeAt(uint8_t square) const
+				{
+					return mSquares[square];
+				}
+
+				std::optional<Piece> pieceAt(uint8_t square) const;
+
+				Bitboard pieces(Color color, PieceType type) const
+				{
+					return mPieces[pieceCode(type, color) - 1];
+				}
+
+				Bitboard pieces(Color color) const
+				{
+					return mByColor[color == Color::White ? 0 : 1];
+				}
+
+				Bitboard occupied() const
+				{
+					return mOccupied;
+				}
+
+				Color activeColor() const
+				{
+					return mActiveColor;
+				}
+
+				uint8_t castlingRights() const
+				{
+					return mCastlingRights;
+				}
+
+				/**
+				 * \brief Returns the index of the en passant target square,
+				 * or an empty value if there is none.
+				 */
+				std::optional<uint8_t> enPassantSquare() const;
+
+				uint16_t halfmoveClock() const
+				{
+					return mHalfmoveClock;
+				}
+
+				uint16_t fullmoveCounter() const
+				{
+					return mFullmoveCounter;
+				}
+
+				/**
+				 * \brief Returns the Zobrist hash of the position.
+				 *
+				 * Positions which are the same for the purpose of the n-fold
+				 * repetition rule have the same hash.
+				 */
+				uint64_t hash() const
+				{
+					return mHash;
+				}
+
+				/**
+				 * \brief Returns the Zobrist hash of the pawns alone, to
+				 * cache evaluation terms which only depend on them.
+				 */
+				uint64_t pawnHash() const
+				{
+					return mPawnHash;
+				}
+
+				/**
+				 * \brief Material and piece-square value of the pieces on
+				 * the board in the middlegame, from the point of view of
+				 * white.
+				 */
+				int middlegameScore() const
+				{
+					return mMiddlegameScore;
+				}
+
+				/**
+				 * \brief Same as \ref middlegameScore(), for the endgame.
+				 */
+				int endgameScore() const
+				{
+					return mEndgameScore;
+				}
+
+				/**
+				 * \brief Phase of the game according to the pieces on the
+				 * board, from \ref pst::MaxPhase for the initial material
+				 * down to 0 for bare kings and pawns (it can go above \ref
+				 * pst::MaxPhase after promotions).
+				 */
+				int phase() const
+				{
+					return mPhase;
+				}
+
+				/**
+				 * \brief Whether both positions are the same for the
+				 * purpose of the n-fold repetition rule (the move counters
+				 * are ignored).
+				 */
+				bool isRepetitionOf(const Position& other) const;
+
+				uint8_t kingSquare(Color color) const
+				{
+					return lsb(pieces(color, PieceType::King));
+				}
+
+				/**
+				 * \brief Returns all the pieces of color \p color which
+				 * attack \p square, with \p occupied as the set of blocking
+				 * squares for sliding pieces.
+				 */
+				Bitboard attackersTo(
+						uint8_t square,
+						Color color,
+						Bitboard occupied) const;
+
+				bool isAttacked(uint8_t square, Color color) const
+				{
+					return attackersTo(square, color, mOccupied) != 0;
+				}
+
+				/**
+				 * \brief Whether the active color is in check.
+				 */
+				bool inCheck() const
+				{
+					return isAttacked(
+							kingSquare(mActiveColor),
+							oppositeColor(mActiveColor));
+				}
+
+				/**
+				 * \brief Whether \p move is a legal move for the active
+				 * color.
+				 *
+				 * The move is fully validated (ownership of the moving
+				 * piece, movement pattern, castling conditions, promotion
+				 * type and king safety), so any \ref Move can be passed.
+				 */
+				bool isLegal(const Move& move) const;
+
+				/**
+				 * \brief Fills \p moves with all the legal moves for the
+				 * active color.
+				 */
+				void legalMoves(MoveList& moves) const;
+
+				/**
+				 * \brief Plays \p move, updating every field of the
+				 * position (castling rights, en passant target, clocks and
+				 * active color).
+				 *
+				 * \note The move is not validated, see \ref isLegal().
+				 */
+				void makeMove(const Move& move);
+
+				/**
+				 * \brief Returns the \ref PieceMove describing \p move in
+				 * this position.
+				 */
+				PieceMove toPieceMove(const Move& move) const;
+
+				/**
+				 * \brief Returns the \ref Board with the pieces of this
+				 * position, allocated from \p allocator.
+				 */
+				Board toBoard(const Board::allocator_type& allocator = {}) const;
+
+				/**
+				 * \brief Whether the active color is in check or
+				 * checkmated.
+				 */
+				CheckType checkStatus() const;
+
+				/**
+				 * \brief Returns the \ref GameStage equivalent to this
+				 * position, allocating nothing but its board and FEN string
+				 * from \p allocator.
+				 */
+				GameStage toStage(const GameStage::allocator_type& allocator = {}) const;
+
+			private:
+				Position();
+
+				void putPiece(uint8_t square, uint8_t code);
+				void removePiece(uint8_t square);
+
+				/**
+				 * Adds (\p sign 1) or removes (\p sign -1) the
+				 * contribution of piece \p code on \p square to the
+				 * incrementally updated evaluation terms.
+				 */
+				void updateScores(uint8_t square, uint8_t code, int sign);
+
+				/**
+				 * Moves the pieces involved in \p move (including the rook
+				 * when castling and the pawn captured en passant), without
+				 * updating any other field.
+				 */
+				void movePieces(const Move& move);
+
+				bool isPseudoLegalPawnMove(const Move& move) const;
+				bool isPseudoLegalCastling(const Move& move) const;
+
+				/**
+				 * Whether the active king is safe after playing \p move,
+				 * which must be pseudo-legal.
+				 */
+				bool leavesKingSafe(const Move& move) const;
+
+				/**
+				 * Pieces of the active color which are pinned against their
+				 * own king.
+				 */
+				Bitboard pinnedPieces() const;
+
+				void setCastlingRights(uint8_t rights);
+				void setEnPassantSquare(uint8_t square);
+
+				Bitboard mPieces[12];
+				Bitboard mByColor[2];
+				Bitboard mOccupied;
+				uint8_t mSquares[64];
+				Color mActiveColor;
+				uint8_t mCastlingRights;
+				uint8_t mEnPassantSquare;
+				uint16_t mHalfmoveClock;
+				uint16_t mFullmoveCounter;
+				uint64_t mHash;
+				uint64_t mPawnHash;
+				int32_t mMiddlegameScore;
+				int32_t mEndgameScore;
+				int32_t mPhase;
+		};
+	}
+}
+
+#endif
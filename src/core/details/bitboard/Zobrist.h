@@ -0,0 +1,73 @@
+#ifndef ZOBRIST_H_8D3F1B62_A4C7_4E09_B2D5_6F1E9A3C7B48
+#define ZOBRIST_H_8D3F1B62_A4C7_4E09_B2D5_6F1E9A3C7B48
+
+#include <cstdint>
+
+/**
+ * Zobrist keys used to hash a \ref Position.
+ *
+ * Two positions which are the same according to the n-fold repetition rule
+ * (same pieces on the same squares, same active color, same castling rights
+ * and same en passant target) always have the same hash.
+ *
+ * The keys are generated at compile time from a fixed seed, so hashes are
+ * stable across runs and platforms.
+ */
+
+namespace simplechess
+{
+	namespace details
+	{
+		namespace zobrist
+		{
+			constexpr uint64_t splitMix64(uint64_t& state)
+			{
+				state += 0x9E3779B97F4A7C15ULL;
+				uint64_t z = state;
+				z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+				z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+				return z ^ (z >> 31);
+			}
+
+			struct Keys
+			{
+				uint64_t pieceSquare[12][64];
+				uint64_t castling[16];
+				uint64_t enPassantFile[8];
+				uint64_t blackToMove;
+			};
+
+			constexpr Keys generateKeys()
+			{
+				Keys keys = {};
+				uint64_t state = 0x5EED5EED5EED5EEDULL;
+
+				for (int piece = 0; piece < 12; ++piece)
+				{
+					for (int square = 0; square < 64; ++square)
+					{
+						keys.pieceSquare[piece][square] = splitMix64(state);
+					}
+				}
+
+				for (int rights = 0; rights < 16; ++rights)
+				{
+					keys.castling[rights] = splitMix64(state);
+				}
+
+				for (int file = 0; file < 8; ++file)
+				{
+					keys.enPassantFile[file] = splitMix64(state);
+				}
+
+				keys.blackToMove = splitMix64(state);
+
+				return keys;
+			}
+
+			constexpr Keys sKeys = generateKeys();
+		}
+	}
+}
+
+#endif
@@ -1,12 +1,15 @@
 #include "FenParser.h"
-#include "FenUtils.h"
+#include "PlacementScanner.h"
 
 #include "../../Builders.h"
 
 #include <boost/algorithm/string.hpp>
 
 #include <cctype>
+#include <cerrno>
 #include <cstdint>
+#include <cstdlib>
+#include <utility>
 #include <vector>
 
 using namespace simplechess;
@@ -14,93 +17,53 @@ using namespace simplechess::details;
 
 namespace internal
 {
+	const std::string InvalidPiecePlacement
+		= " is not a valid \"piece placement\" field in a FEN string";
+
+	/**
+	 * Fills \p squares with the piece code of every square described by
+	 * the "piece placement" field of a FEN string (\ref NoPiece for empty
+	 * squares). Returns false if the field is malformed.
+	 */
+	bool scanPiecePlacement(
+			const std::string& piecePlacementFen,
+			uint8_t (&squares)[64])
+	{
+		return placement::scan(
+				piecePlacementFen.data(),
+				piecePlacementFen.size(),
+				squares);
+	}
+
 	Board parsePiecePlacement(
 			const std::string& piecePlacementFen)
 	{
-		std::vector<std::string> rows;
-		boost::split(rows, piecePlacementFen, [](char c) { return c == '/';});
+		uint8_t squares[64];
 
-		if (rows.size() != 8)
+		if (!scanPiecePlacement(piecePlacementFen, squares))
 		{
-			throw std::invalid_argument(piecePlacementFen
-					+ " is not a valid \"piece placement\" "
-					+ "field in a FEN string");
+			throw std::invalid_argument(
+					piecePlacementFen + InvalidPiecePlacement);
 		}
 
-		std::map<Square, Piece> pieceLocations;
-
-		// In FEN, numbers indicate a run of consecutive empty squares in the
-		// row. Numbers must be in [1,8], and cannot be consecutive ('12' is
-		// not allowed, as 12 is too large and if it is supposed to represent
-		// "1 empty square followed by 2 empty squares" it should simply be
-		// '3').
-		bool isLastCharNumber = false;
+		std::pmr::map<Square, Piece> pieceLocations;
 
-		for (int row = 8; row >= 1; --row)
+		for (uint8_t square = 0; square < 64; ++square)
 		{
-			isLastCharNumber = false;
-			char col = 'a';
-			const std::string str = rows[8 - row];
-
-			for (const auto c : str)
+			if (squares[square] != NoPiece)
 			{
-				if (std::isdigit(c))
-				{
-					if (isLastCharNumber)
-					{
-						// Two digits in a row, error
-						throw std::invalid_argument(
-								piecePlacementFen
-								+ " is not a valid \"piece placement\" "
-								+ "field in a FEN string");
-					}
-
-					isLastCharNumber = true;
-
-					const uint8_t offset = c - '0';
-
-					if (offset <= 0 || offset > 8)
-					{
-						throw std::invalid_argument(
-								piecePlacementFen
-								+ " is not a valid \"piece placement\" "
-								+ "field in a FEN string");
-					}
-
-					col += offset;
-
-					if (col > ('h' + 1))
-					{
-						throw std::invalid_argument(
-								piecePlacementFen
-								+ " is not a valid \"piece placement\" "
-								+ "field in a FEN string");
-					}
-
-					continue;
-				}
-
-				isLastCharNumber = false;
-
-				if (col < 'a' || col > 'h')
-				{
-					throw std::invalid_argument(
-								piecePlacementFen
-								+ " is not a valid \"piece placement\" "
-								+ "field in a FEN string");
-				}
 				pieceLocations.insert({
-						Square::fromRankAndFile(row, col),
-						FenUtils::stringToPiece(c)});
-
-				col++;
+						squareFromIndex(square),
+						Piece(
+							pieceTypeOf(squares[square]),
+							colorOf(squares[square]))});
 			}
 		}
 
-		return BoardBuilder::build(pieceLocations);
+		return BoardBuilder::build(std::move(pieceLocations));
 	}
 
-	Color parseColor(const std::string& str)
+	std::optional<Color> tryParseColor(const std::string& str)
 	{
 		if (str == "w")
 		{
@@ -111,11 +74,23 @@ namespace internal
 			return Color::Black;
 		}
 
-		throw std::invalid_argument(
-				str + " is not a valid \"active color\" field in a FEN string");
+		return std::nullopt;
 	}
 
-	uint8_t parseCastlingRights(const std::string& str)
+	Color parseColor(const std::string& str)
+	{
+		const std::optional<Color> color = tryParseColor(str);
+
+		if (!color)
+		{
+			throw std::invalid_argument(
+					str + " is not a valid \"active color\" field in a FEN string");
+		}
+
+		return *color;
+	}
+
+	std::optional<uint8_t> tryParseCastlingRights(const std::string& str)
 	{
 		if (str == "-")
 		{
@@ -124,10 +99,7 @@ namespace internal
 
 		if (str.size() == 0 || str.size() > 4)
 		{
-			throw std::invalid_argument(
-					str
-					+ " is not a valid \"castling availability\" "
-					+ "field in a FEN string");
+			return std::nullopt;
 		}
 
 		uint8_t mask = 0;
@@ -155,16 +127,54 @@ namespace internal
 			if (oldMask == mask)
 			{
 				// This was an invalid or a repeated character
-				throw std::invalid_argument(
-						str
-						+ " is not a valid \"castling availability\" "
-						+ "field in a FEN string");
+				return std::nullopt;
 			}
 		}
 
 		return mask;
 	}
 
+	uint8_t parseCastlingRights(const std::string& str)
+	{
+		const std::optional<uint8_t> mask = tryParseCastlingRights(str);
+
+		if (!mask)
+		{
+			throw std::invalid_argument(
+					str
+					+ " is not a valid \"castling availability\" "
+					+ "field in a FEN string");
+		}
+
+		return *mask;
+	}
+
+	/**
+	 * Parses the "en passant target" field, accepting the same strings as
+	 * \ref Square::fromString(). The outer optional is empty if the field
+	 * is malformed.
+	 */
+	std::optional<std::optional<Square>> tryParseEnPassantTarget(
+			const std::string& str)
+	{
+		if (str == "-")
+		{
+			return std::optional<Square>();
+		}
+
+		if (str.size() != 2
+				|| !std::isalpha(str[0])
+				|| !std::isdigit(str[1])
+				|| !Square::isInsideBoundaries(str[1] - '0', str[0]))
+		{
+			return std::nullopt;
+		}
+
+		return std::optional<Square>(SquareBuilder::build(
+					static_cast<uint8_t>(str[1] - '0'),
+					static_cast<char>(std::tolower(str[0]))));
+	}
+
 	std::optional<Square> parseEnPassantTarget(const std::string& str)
 	{
 		if (str == "-")
@@ -175,6 +185,25 @@ namespace internal
 		return Square::fromString(str);
 	}
 
+	/**
+	 * Parses a move clock, accepting the same strings as std::stoi().
+	 */
+	std::optional<uint16_t> tryParseMoveClock(const std::string& str)
+	{
+		const char* begin = str.c_str();
+		char* end = nullptr;
+
+		errno = 0;
+		const long number = std::strtol(begin, &end, 10);
+
+		if (end == begin || errno == ERANGE || number < 0 || number > UINT16_MAX)
+		{
+			return std::nullopt;
+		}
+
+		return static_cast<uint16_t>(number);
+	}
+
 	uint16_t parseMoveClock(const std::string& str)
 	{
 		const int number = std::stoi(str);
@@ -187,6 +216,21 @@ namespace internal
 
 		return static_cast<uint16_t>(number);
 	}
+
+	/**
+	 * Whether the en passant target is in front of a pawn of the right
+	 * color (only checked for targets on the third and sixth ranks).
+	 */
+	bool isEnPassantTargetConsistent(
+			const uint8_t (&squares)[64],
+			const std::optional<Square>& epTarget)
+	{
+		return !epTarget
+			|| !((epTarget->rank() == 3
+					&& squares[squareIndex(4, epTarget->file())] != pieceCode(PieceType::Pawn, Color::White))
+				|| (epTarget->rank() == 6
+					&& squares[squareIndex(5, epTarget->file())] != pieceCode(PieceType::Pawn, Color::Black)));
+	}
 }
 
 FenParser::FenParser(
@@ -224,9 +268,9 @@ FenParser FenParser::parse(const std::string& fen)
 
 	if (epTarget
 			&& ((epTarget->rank() == 3
-					&& board.pieceAt(Square::fromRankAndFile(4, epTarget->file())) != std::optional<Piece>({PieceType::Pawn, Color::White}))
+					&& board.pieceAt(SquareBuilder::build(4, epTarget->file())) != std::optional<Piece>({PieceType::Pawn, Color::White}))
 				|| (epTarget->rank() == 6
-					&& board.pieceAt(Square::fromRankAndFile(5, epTarget->file())) != std::optional<Piece>({PieceType::Pawn, Color::Black}))))
+					&& board.pieceAt(SquareBuilder::build(5, epTarget->file())) != std::optional<Piece>({PieceType::Pawn, Color::Black}))))
 	{
 		throw std::invalid_argument(
 				"Found inconsistency between piece placement and "
@@ -243,6 +287,78 @@ FenParser FenParser::parse(const std::string& fen)
 		fullmoveClock };
 }
 
+std::optional<Position> FenParser::tryParsePosition(const std::string& fen)
+{
+	// Split the six fields
+	std::string tokens[6];
+	size_t numberOfTokens = 0;
+	size_t start = 0;
+
+	for (size_t i = 0; i <= fen.size(); ++i)
+	{
+		if (i == fen.size() || fen[i] == ' ')
+		{
+			if (numberOfTokens == 6)
+			{
+				return std::nullopt;
+			}
+
+			tokens[numberOfTokens++].assign(fen, start, i - start);
+			start = i + 1;
+		}
+	}
+
+	if (numberOfTokens != 6)
+	{
+		return std::nullopt;
+	}
+
+	uint8_t squares[64];
+
+	if (!internal::scanPiecePlacement(tokens[0], squares))
+	{
+		return std::nullopt;
+	}
+
+	const std::optional<Color> activeColor = internal::tryParseColor(tokens[1]);
+	const std::optional<uint8_t> castlingRights = internal::tryParseCastlingRights(tokens[2]);
+	const std::optional<std::optional<Square>> epTarget = internal::tryParseEnPassantTarget(tokens[3]);
+	const std::optional<uint16_t> halfmoveClock = internal::tryParseMoveClock(tokens[4]);
+	const std::optional<uint16_t> fullmoveClock = internal::tryParseMoveClock(tokens[5]);
+
+	if (!activeColor
+			|| !castlingRights
+			|| !epTarget
+			|| !halfmoveClock
+			|| !fullmoveClock
+			|| !internal::isEnPassantTargetConsistent(squares, *epTarget))
+	{
+		return std::nullopt;
+	}
+
+	return Position::fromMailbox(
+			squares,
+			*activeColor,
+			*castlingRights,
+			*epTarget
+				? std::optional<uint8_t>(squareIndex(**epTarget))
+				: std::nullopt,
+			*halfmoveClock,
+			*fullmoveClock);
+}
+
+Position FenParser::parsePosition(const std::string& fen)
+{
+	const std::optional<Position> position = tryParsePosition(fen);
+
+	if (!position)
+	{
+		throw std::invalid_argument(fen + " is not a valid FEN string");
+	}
+
+	return *position;
+}
+
 const Board& FenParser::board() const
 {
 	return mBoard;
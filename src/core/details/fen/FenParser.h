@@ -1,6 +1,8 @@
 #ifndef FEN_PARSER_H_7EC60DCF_6D80_4E54_BEEF_61971B784511
 #define FEN_PARSER_H_7EC60DCF_6D80_4E54_BEEF_61971B784511
 
+#include "../bitboard/Position.h"
+
 #include <cpp/simplechess/Board.h>
 #include <cpp/simplechess/Color.h>
 #include <cpp/simplechess/GameStage.h>
@@ -38,6 +40,24 @@ namespace simplechess
 				 */
 				static FenParser parse(const std::string& fen);
 
+				/**
+				 * \brief Parse a FEN string straight into a \ref Position.
+				 *
+				 * The string is validated in the same way as by \ref
+				 * parse(), but no \ref Board is built.
+				 *
+				 * \throws std::invalid_argument in the same circumstances
+				 * as \ref parse().
+				 */
+				static Position parsePosition(const std::string& fen);
+
+				/**
+				 * \brief Same as \ref parsePosition(), but returns an empty
+				 * value instead of throwing if \p fen is not valid.
+				 */
+				static std::optional<Position> tryParsePosition(
+						const std::string& fen);
+
 				/**
 				 * \brief Returns the state of the board described by the FEN
 				 * string.
@@ -5,9 +5,9 @@
 
 #include <cpp/simplechess/GameStage.h>
 
-#include <boost/algorithm/string.hpp>
 
 #include <sstream>
+#include <utility>
 #include <stdexcept>
 
 using namespace simplechess;
@@ -68,13 +68,24 @@ Piece FenUtils::stringToPiece(const char c)
 	return it->second;
 }
 
-std::string FenUtils::fenForRepetitions(const std::string& fen)
+std::string_view FenUtils::fenForRepetitions(const std::string_view fen)
 {
-		std::vector<std::string> fenTokens;
-		boost::split(fenTokens, fen,  [](char c) { return c == ' ';});
-		fenTokens.pop_back();
-		fenTokens.pop_back();
-		return boost::algorithm::join(fenTokens, " ");
+	// Everything but the two move clocks, which are the last two fields
+	const size_t lastSeparator = fen.rfind(' ');
+
+	if (lastSeparator == std::string_view::npos || lastSeparator == 0)
+	{
+		return {};
+	}
+
+	const size_t separator = fen.rfind(' ', lastSeparator - 1);
+
+	if (separator == std::string_view::npos)
+	{
+		return {};
+	}
+
+	return fen.substr(0, separator);
 }
 
 std::string FenUtils::generateFen(
@@ -108,7 +119,7 @@ std::string FenUtils::generateFen(
 	{
 		for (char file = 'a'; file <= 'h'; ++file)
 		{
-			const Square square = Square::fromRankAndFile(rank, file);
+			const Square square = SquareBuilder::build(rank, file);
 
 			const std::optional<Piece> piece = board.pieceAt(square);
 
@@ -205,6 +216,117 @@ std::string FenUtils::generateFen(
 	return ss.str();
 }
 
+size_t FenUtils::generateFen(
+		const Position& position,
+		char (&output)[MaxFenLength + 1])
+{
+	// The same fields as in the other overload, in the same order
+	static constexpr char PieceCharacters[] = " PRNBQKprnbqk";
+
+	size_t length = 0;
+
+	const auto appendNumber = [&output, &length](const uint16_t number)
+	{
+		char digits[5];
+		size_t count = 0;
+		uint16_t remaining = number;
+
+		do
+		{
+			digits[count++] = static_cast<char>('0' + remaining % 10);
+			remaining /= 10;
+		} while (remaining != 0);
+
+		while (count > 0)
+		{
+			output[length++] = digits[--count];
+		}
+	};
+
+	for (int rank = 7; rank >= 0; --rank)
+	{
+		uint8_t emptySquaresRun = 0;
+
+		for (int file = 0; file < 8; ++file)
+		{
+			const uint8_t code = position.pieceCodeAt(
+					static_cast<uint8_t>(rank * 8 + file));
+
+			if (code == NoPiece)
+			{
+				++emptySquaresRun;
+				continue;
+			}
+
+			if (emptySquaresRun != 0)
+			{
+				output[length++] = static_cast<char>('0' + emptySquaresRun);
+				emptySquaresRun = 0;
+			}
+
+			output[length++] = PieceCharacters[code];
+		}
+
+		if (emptySquaresRun != 0)
+		{
+			output[length++] = static_cast<char>('0' + emptySquaresRun);
+		}
+
+		if (rank != 0)
+		{
+			output[length++] = '/';
+		}
+	}
+
+	output[length++] = ' ';
+	output[length++] = (position.activeColor() == Color::White) ? 'w' : 'b';
+
+	output[length++] = ' ';
+	const uint8_t castlingRights = position.castlingRights();
+
+	if (castlingRights == 0)
+	{
+		output[length++] = '-';
+	}
+	else
+	{
+		const std::pair<CastlingRight, char> rights[] = {
+			{CastlingRight::WhiteKingSide, 'K'},
+			{CastlingRight::WhiteQueenSide, 'Q'},
+			{CastlingRight::BlackKingSide, 'k'},
+			{CastlingRight::BlackQueenSide, 'q'}};
+
+		for (const auto& [right, character] : rights)
+		{
+			if ((castlingRights & right) != 0)
+			{
+				output[length++] = character;
+			}
+		}
+	}
+
+	output[length++] = ' ';
+	const std::optional<uint8_t> epSquare = position.enPassantSquare();
+
+	if (epSquare)
+	{
+		output[length++] = static_cast<char>('a' + fileOf(*epSquare));
+		output[length++] = static_cast<char>('1' + rankOf(*epSquare));
+	}
+	else
+	{
+		output[length++] = '-';
+	}
+
+	output[length++] = ' ';
+	appendNumber(position.halfmoveClock());
+	output[length++] = ' ';
+	appendNumber(position.fullmoveCounter());
+	output[length] = '\0';
+
+	return length;
+}
+
 GameStage FenUtils::fromFenString(const std::string& fen)
 {
 	const FenParser parsedFen = FenParser::parse(fen);
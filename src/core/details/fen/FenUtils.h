@@ -1,11 +1,15 @@
 #ifndef FEN_UTILS_H_74319100_580E_47C2_8610_E38B9948AA96
 #define FEN_UTILS_H_74319100_580E_47C2_8610_E38B9948AA96
 
+#include "../bitboard/Position.h"
+
 #include <cpp/simplechess/GameStage.h>
 
 #include <boost/bimap.hpp>
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 
 namespace simplechess
 {
@@ -46,9 +50,10 @@ namespace simplechess
 				 * \param The full FEN string.
 				 * \return A shorter version of the FEN string suitable to be
 				 * directly compared with others to determine whether the
-				 * positions are the same.
+				 * positions are the same. It is a prefix of \p fen, so it
+				 * is only valid as long as \p fen is.
 				 */
-				static std::string fenForRepetitions(const std::string& fen);
+				static std::string_view fenForRepetitions(std::string_view fen);
 
 				/**
 				 * \brief Generate a FEN string from chess position components.
@@ -69,6 +74,24 @@ namespace simplechess
 						const uint16_t halfmoveClock,
 						const uint16_t fullmoveClock);
 
+				/**
+				 * \brief The length of the longest FEN string of a position,
+				 * with a full board and the largest move clocks.
+				 */
+				static constexpr size_t MaxFenLength = 93;
+
+				/**
+				 * \brief Writes the FEN string of \p position, as \ref
+				 * generateFen() would generate it from the same components,
+				 * followed by a null character into \p output, without
+				 * allocating memory.
+				 *
+				 * \return The length of the FEN string.
+				 */
+				static size_t generateFen(
+						const Position& position,
+						char (&output)[MaxFenLength + 1]);
+
 				/**
 				 * \brief Create a GameStage from a FEN string.
 				 *
@@ -0,0 +1,200 @@
+#include "PlacementScanner.h"
+
+#include "../CpuFeatures.h"
+#include "../bitboard/Position.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+
+using namespace simplechess;
+using namespace simplechess::details;
+
+namespace
+{
+	/**
+	 * Returns the piece code described by \p c in a FEN string, or \ref
+	 * NoPiece if it does not describe a piece.
+	 */
+	uint8_t pieceCodeOf(const char c)
+	{
+		const Color color = std::isupper(c) ? Color::White : Color::Black;
+
+		switch (std::tolower(c))
+		{
+			case 'p':
+				return pieceCode(PieceType::Pawn, color);
+			case 'r':
+				return pieceCode(PieceType::Rook, color);
+			case 'n':
+				return pieceCode(PieceType::Knight, color);
+			case 'b':
+				return pieceCode(PieceType::Bishop, color);
+			case 'q':
+				return pieceCode(PieceType::Queen, color);
+			case 'k':
+				return pieceCode(PieceType::King, color);
+			default:
+				return NoPiece;
+		}
+	}
+}
+
+bool placement::isAvailable(const Kernel kernel)
+{
+	switch (kernel)
+	{
+		case Kernel::Scalar:
+			return true;
+		case Kernel::Avx2:
+#ifdef SIMPLECHESS_AVX2_KERNEL
+			return processorHasAvx2();
+#else
+			return false;
+#endif
+	}
+
+	return false;
+}
+
+placement::Kernel placement::fastestKernel()
+{
+	// The processor does not change, so it is only queried once
+	static const Kernel fastest = isAvailable(Kernel::Avx2)
+		? Kernel::Avx2
+		: Kernel::Scalar;
+
+	return fastest;
+}
+
+bool placement::scan(
+		const Kernel kernel,
+		const char* data,
+		const size_t size,
+		uint8_t (&squares)[64])
+{
+#ifdef SIMPLECHESS_AVX2_KERNEL
+	if (kernel == Kernel::Avx2)
+	{
+		return scanAvx2(data, size, squares);
+	}
+#else
+	(void) kernel;
+#endif
+
+	return scanScalar(data, size, squares);
+}
+
+bool placement::scan(
+		const char* data,
+		const size_t size,
+		uint8_t (&squares)[64])
+{
+	return scan(fastestKernel(), data, size, squares);
+}
+
+bool placement::scanScalar(
+		const char* data,
+		const size_t size,
+		uint8_t (&squares)[64])
+{
+	if (std::count(data, data + size, '/') != 7)
+	{
+		return false;
+	}
+
+	std::fill(std::begin(squares), std::end(squares), NoPiece);
+
+	// In FEN, numbers indicate a run of consecutive empty squares in the
+	// row. Numbers must be in [1,8], and cannot be consecutive ('12' is
+	// not allowed, as 12 is too large and if it is supposed to represent
+	// "1 empty square followed by 2 empty squares" it should simply be
+	// '3').
+	int row = 8;
+	char col = 'a';
+	bool isLastCharNumber = false;
+
+	for (const char* it = data; it != data + size; ++it)
+	{
+		const char c = *it;
+
+		if (c == '/')
+		{
+			--row;
+			col = 'a';
+			isLastCharNumber = false;
+			continue;
+		}
+
+		if (std::isdigit(c))
+		{
+			const uint8_t offset = c - '0';
+
+			// Two digits in a row are not allowed
+			if (isLastCharNumber || offset <= 0 || offset > 8)
+			{
+				return false;
+			}
+
+			isLastCharNumber = true;
+			col += offset;
+
+			if (col > ('h' + 1))
+			{
+				return false;
+			}
+
+			continue;
+		}
+
+		isLastCharNumber = false;
+
+		const uint8_t code = ::pieceCodeOf(c);
+
+		if (col < 'a' || col > 'h' || code == NoPiece)
+		{
+			return false;
+		}
+
+		squares[squareIndex(row, col)] = code;
+		col++;
+	}
+
+	return true;
+}
+
+bool placement::placeClassified(
+		const uint8_t* codes,
+		const uint8_t* widths,
+		const size_t size,
+		uint8_t (&squares)[64])
+{
+	std::fill(std::begin(squares), std::end(squares), NoPiece);
+
+	// Index of the first square of the current rank, from the eighth one
+	int rankStart = 56;
+	int file = 0;
+
+	for (size_t i = 0; i < size; ++i)
+	{
+		if (widths[i] == 0)
+		{
+			rankStart -= 8;
+			file = 0;
+			continue;
+		}
+
+		// A digit may reach the end of the rank, a piece may not go past it
+		file += widths[i];
+
+		if (file > 8)
+		{
+			return false;
+		}
+
+		// Digits write an empty square, which is always within the rank
+		squares[rankStart + file - 1] = codes[i];
+	}
+
+	return true;
+}
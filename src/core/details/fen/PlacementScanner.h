@@ -0,0 +1,98 @@
+#ifndef PLACEMENT_SCANNER_H_22512552_8CB6_4276_851C_1E7A04AC1BE6
+#define PLACEMENT_SCANNER_H_22512552_8CB6_4276_851C_1E7A04AC1BE6
+
+#include <cstddef>
+#include <cstdint>
+
+namespace simplechess
+{
+	namespace details
+	{
+		namespace placement
+		{
+			/**
+			 * \brief Length of the longest valid "piece placement" field
+			 * (eight ranks of eight characters and seven separators).
+			 */
+			constexpr size_t MaxLength = 71;
+
+			/**
+			 * \brief The implementations of \ref scan().
+			 */
+			enum class Kernel
+			{
+				/**
+				 * One character at a time.
+				 */
+				Scalar,
+
+				/**
+				 * Every character classified at once with AVX2.
+				 */
+				Avx2
+			};
+
+			/**
+			 * \brief Whether \p kernel was built into the library and the
+			 * processor supports it.
+			 */
+			bool isAvailable(Kernel kernel);
+
+			/**
+			 * \brief The fastest available kernel.
+			 */
+			Kernel fastestKernel();
+
+			/**
+			 * \brief Fills \p squares with the piece code of every square
+			 * described by the "piece placement" field of a FEN string in
+			 * \p data (\ref NoPiece for empty squares).
+			 *
+			 * The field must have exactly eight ranks separated by '/',
+			 * made of piece letters and digits from 1 to 8, with no two
+			 * digits in a row and no more than eight squares per rank.
+			 * Ranks with fewer squares are padded with empty squares.
+			 *
+			 * \note \p kernel must be available.
+			 *
+			 * \return Whether the field is valid. \p squares is
+			 * unspecified if it is not.
+			 */
+			bool scan(
+					Kernel kernel,
+					const char* data,
+					size_t size,
+					uint8_t (&squares)[64]);
+
+			/**
+			 * \brief Same as above, with the fastest available kernel.
+			 */
+			bool scan(const char* data, size_t size, uint8_t (&squares)[64]);
+
+			/*
+			 * Entry points of each kernel, each in a translation unit of
+			 * its own compiled for its instruction set.
+			 */
+			bool scanScalar(const char* data, size_t size, uint8_t (&squares)[64]);
+			bool scanAvx2(const char* data, size_t size, uint8_t (&squares)[64]);
+
+			/**
+			 * \brief Places the pieces of an already classified field.
+			 *
+			 * For every character of the field, \p codes holds its piece
+			 * code (\ref NoPiece for digits and separators) and \p widths
+			 * the number of squares it covers (0 for separators). The
+			 * field must have exactly seven separators.
+			 *
+			 * \return Whether no rank covers more than eight squares.
+			 */
+			bool placeClassified(
+					const uint8_t* codes,
+					const uint8_t* widths,
+					size_t size,
+					uint8_t (&squares)[64]);
+		}
+	}
+}
+
+#endif
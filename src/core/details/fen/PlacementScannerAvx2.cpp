@@ -0,0 +1,160 @@
+/*
+ * Compiled with AVX2 enabled, so it must only be called after checking that
+ * the processor supports it (see placement::isAvailable()). For the same
+ * reason, it must not instantiate templates or call inline functions shared
+ * with other translation units.
+ */
+
+#ifdef SIMPLECHESS_AVX2_KERNEL
+
+#include "PlacementScanner.h"
+
+#include "../bitboard/Position.h"
+
+#include <cstring>
+#include <immintrin.h>
+
+using namespace simplechess;
+using namespace simplechess::details;
+
+namespace
+{
+	constexpr size_t ChunkSize = 32;
+	constexpr size_t Chunks = (placement::MaxLength + ChunkSize - 1) / ChunkSize;
+
+	constexpr char Pawn = pieceCode(PieceType::Pawn, Color::White);
+	constexpr char Rook = pieceCode(PieceType::Rook, Color::White);
+	constexpr char Knight = pieceCode(PieceType::Knight, Color::White);
+	constexpr char Bishop = pieceCode(PieceType::Bishop, Color::White);
+	constexpr char Queen = pieceCode(PieceType::Queen, Color::White);
+	constexpr char King = pieceCode(PieceType::King, Color::White);
+	constexpr char BlackOffset
+		= pieceCode(PieceType::Pawn, Color::Black) - pieceCode(PieceType::Pawn, Color::White);
+
+	struct ChunkMasks
+	{
+		uint32_t separators;
+		uint32_t digits;
+		uint32_t valid;
+	};
+
+	/**
+	 * Classifies the 32 characters at \p input, storing the piece code and
+	 * the width of each of them in \p codes and \p widths.
+	 */
+	ChunkMasks classify(const char* input, uint8_t* codes, uint8_t* widths)
+	{
+		const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input));
+
+		const __m256i separators = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('/'));
+		const __m256i digits = _mm256_and_si256(
+				_mm256_cmpgt_epi8(c, _mm256_set1_epi8('0')),
+				_mm256_cmpgt_epi8(_mm256_set1_epi8('9'), c));
+
+		// Piece letters are told apart by their low nibble among those
+		// sharing their high nibble once folded to upper case: B, K and N
+		// are 0x4?, and P, Q and R are 0x5?
+		const __m256i lowNibbles = _mm256_and_si256(c, _mm256_set1_epi8(0x0F));
+		const __m256i foldedHighNibbles
+			= _mm256_and_si256(c, _mm256_set1_epi8(static_cast<char>(0xD0)));
+
+		const __m256i lettersFrom40 = _mm256_setr_epi8(
+				0, 0, Bishop, 0, 0, 0, 0, 0, 0, 0, 0, King, 0, 0, Knight, 0,
+				0, 0, Bishop, 0, 0, 0, 0, 0, 0, 0, 0, King, 0, 0, Knight, 0);
+		const __m256i lettersFrom50 = _mm256_setr_epi8(
+				Pawn, Queen, Rook, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+				Pawn, Queen, Rook, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+
+		const __m256i whiteCodes = _mm256_or_si256(
+				_mm256_and_si256(
+					_mm256_cmpeq_epi8(foldedHighNibbles, _mm256_set1_epi8(0x40)),
+					_mm256_shuffle_epi8(lettersFrom40, lowNibbles)),
+				_mm256_and_si256(
+					_mm256_cmpeq_epi8(foldedHighNibbles, _mm256_set1_epi8(0x50)),
+					_mm256_shuffle_epi8(lettersFrom50, lowNibbles)));
+
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i pieces = _mm256_xor_si256(
+				_mm256_cmpeq_epi8(whiteCodes, zero),
+				_mm256_set1_epi8(-1));
+		const __m256i lowerCase = _mm256_cmpeq_epi8(
+				_mm256_and_si256(c, _mm256_set1_epi8(0x20)),
+				_mm256_set1_epi8(0x20));
+
+		const __m256i pieceCodes = _mm256_add_epi8(
+				whiteCodes,
+				_mm256_and_si256(
+					_mm256_and_si256(pieces, lowerCase),
+					_mm256_set1_epi8(BlackOffset)));
+		const __m256i pieceWidths = _mm256_or_si256(
+				_mm256_and_si256(pieces, _mm256_set1_epi8(1)),
+				_mm256_and_si256(digits, _mm256_sub_epi8(c, _mm256_set1_epi8('0'))));
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(codes), pieceCodes);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(widths), pieceWidths);
+
+		return {
+			static_cast<uint32_t>(_mm256_movemask_epi8(separators)),
+			static_cast<uint32_t>(_mm256_movemask_epi8(digits)),
+			static_cast<uint32_t>(_mm256_movemask_epi8(
+					_mm256_or_si256(separators, _mm256_or_si256(digits, pieces))))};
+	}
+}
+
+bool placement::scanAvx2(
+		const char* data,
+		const size_t size,
+		uint8_t (&squares)[64])
+{
+	// Longer fields must have a rank with more than eight squares
+	if (size > MaxLength)
+	{
+		return false;
+	}
+
+	// Padded with zeros, which are neither separators nor digits
+	char input[Chunks * ChunkSize];
+	std::memset(input, 0, sizeof(input));
+	std::memcpy(input, data, size);
+
+	uint8_t codes[Chunks * ChunkSize];
+	uint8_t widths[Chunks * ChunkSize];
+
+	// One bit per character, in two words
+	uint64_t separators[2] = {0, 0};
+	uint64_t digits[2] = {0, 0};
+	uint64_t valid[2] = {0, 0};
+
+	for (size_t chunk = 0; chunk < Chunks; ++chunk)
+	{
+		const size_t offset = chunk * ChunkSize;
+		const ChunkMasks masks = ::classify(input + offset, codes + offset, widths + offset);
+
+		separators[offset / 64] |= uint64_t(masks.separators) << (offset % 64);
+		digits[offset / 64] |= uint64_t(masks.digits) << (offset % 64);
+		valid[offset / 64] |= uint64_t(masks.valid) << (offset % 64);
+	}
+
+	const uint64_t inField[2] = {
+		size >= 64 ? ~uint64_t(0) : (uint64_t(1) << size) - 1,
+		size > 64 ? (uint64_t(1) << (size - 64)) - 1 : 0
+	};
+
+	if ((inField[0] & ~valid[0]) != 0
+			|| (inField[1] & ~valid[1]) != 0
+			|| __builtin_popcountll(separators[0]) + __builtin_popcountll(separators[1]) != 7)
+	{
+		return false;
+	}
+
+	// Two digits in a row are not allowed
+	if ((digits[0] & (digits[0] << 1)) != 0
+			|| (digits[1] & ((digits[1] << 1) | (digits[0] >> 63))) != 0)
+	{
+		return false;
+	}
+
+	return placeClassified(codes, widths, size, squares);
+}
+
+#endif
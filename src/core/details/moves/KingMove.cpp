@@ -2,6 +2,7 @@
 
 #include <cpp/simplechess/GameStage.h>
 #include "../BoardAnalyzer.h"
+#include "../../Builders.h"
 
 using namespace simplechess;
 using namespace simplechess::details;
@@ -25,7 +26,7 @@ std::set<PieceMove> simplechess::details::kingMovesExceptCastling(
 						square.rank() + rankStep,
 						square.file() + fileStep))
 			{
-				const Square dst = Square::fromRankAndFile(
+				const Square dst = SquareBuilder::build(
 						square.rank() + rankStep,
 						square.file() + fileStep);
 
@@ -68,8 +69,8 @@ std::set<PieceMove> simplechess::details::kingMovesUnfiltered(
 	{
 		// Only available if the passing squares are empty and not under attack
 		const std::set<Square> mustBeFreeSquares = {
-			Square::fromRankAndFile(square.rank(), 'f'),
-			Square::fromRankAndFile(square.rank(), 'g')
+			SquareBuilder::build(square.rank(), 'f'),
+			SquareBuilder::build(square.rank(), 'g')
 		};
 
 		bool allClear = true;
@@ -91,7 +92,7 @@ std::set<PieceMove> simplechess::details::kingMovesUnfiltered(
 			result.insert(PieceMove::regularMove(
 						king,
 						square,
-						Square::fromRankAndFile(
+						SquareBuilder::build(
 							square.rank(),
 							'g')));
 		}
@@ -104,8 +105,8 @@ std::set<PieceMove> simplechess::details::kingMovesUnfiltered(
 	{
 		// Only available if the passing squares are empty and not under attack
 		const std::set<Square> mustBeFreeSquares = {
-			Square::fromRankAndFile(square.rank(), 'd'),
-			Square::fromRankAndFile(square.rank(), 'c')
+			SquareBuilder::build(square.rank(), 'd'),
+			SquareBuilder::build(square.rank(), 'c')
 		};
 
 		bool allClear = true;
@@ -122,12 +123,20 @@ std::set<PieceMove> simplechess::details::kingMovesUnfiltered(
 			}
 		}
 
+		// The rook also passes through the b-file, which only has to be empty
+		if (!BoardAnalyzer::isEmpty(
+					board,
+					SquareBuilder::build(square.rank(), 'b')))
+		{
+			allClear = false;
+		}
+
 		if (allClear)
 		{
 			result.insert(PieceMove::regularMove(
 						king,
 						square,
-						Square::fromRankAndFile(
+						SquareBuilder::build(
 							square.rank(),
 							'c')));
 		}
@@ -1,6 +1,7 @@
 #include "KnightMove.h"
 
 #include "../BoardAnalyzer.h"
+#include "../../Builders.h"
 
 using namespace simplechess;
 using namespace simplechess::details;
@@ -25,7 +26,7 @@ std::set<PieceMove> simplechess::details::knightMovesUnfiltered(
 						square.rank() + longStep,
 						square.file() + shortStep))
 			{
-				const Square dst = Square::fromRankAndFile(
+				const Square dst = SquareBuilder::build(
 						square.rank() + longStep,
 						square.file() + shortStep);
 
@@ -39,7 +40,7 @@ std::set<PieceMove> simplechess::details::knightMovesUnfiltered(
 						square.rank() + shortStep,
 						square.file() + longStep))
 			{
-				const Square dst = Square::fromRankAndFile(
+				const Square dst = SquareBuilder::build(
 						square.rank() + shortStep,
 						square.file() + longStep);
 
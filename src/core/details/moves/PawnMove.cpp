@@ -1,6 +1,7 @@
 #include "PawnMove.h"
 
 #include "../BoardAnalyzer.h"
+#include "../../Builders.h"
 
 using namespace simplechess;
 using namespace simplechess::details;
@@ -29,7 +30,7 @@ std::set<PieceMove> simplechess::details::pawnMovesUnfiltered(
 		? 1
 		: -1;
 
-	const Square oneAhead = Square::fromRankAndFile(
+	const Square oneAhead = SquareBuilder::build(
 			square.rank() + step,
 			square.file());
 
@@ -42,7 +43,7 @@ std::set<PieceMove> simplechess::details::pawnMovesUnfiltered(
 			|| (pawn.color() == Color::Black && square.rank() == 7))
 	{
 		// The pawn has never moved, might be able to move twice ahead
-		const Square twoAhead = Square::fromRankAndFile(
+		const Square twoAhead = SquareBuilder::build(
 				square.rank() + 2*step,
 				square.file());
 
@@ -56,7 +57,7 @@ std::set<PieceMove> simplechess::details::pawnMovesUnfiltered(
 	if (square.file() != 'a')
 	{
 		// Can potentially capture towards the queen side
-		const Square aheadQueenSide = Square::fromRankAndFile(
+		const Square aheadQueenSide = SquareBuilder::build(
 				square.rank() + step,
 				square.file() - 1);
 
@@ -73,7 +74,7 @@ std::set<PieceMove> simplechess::details::pawnMovesUnfiltered(
 	if (square.file() != 'h')
 	{
 		// Can potentially capture towards the king side
-		const Square aheadKingSide = Square::fromRankAndFile(
+		const Square aheadKingSide = SquareBuilder::build(
 				square.rank() + step,
 				square.file() + 1);
 
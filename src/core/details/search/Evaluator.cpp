@@ -0,0 +1,222 @@
+#include "Evaluator.h"
+
+#include <algorithm>
+
+using namespace simplechess;
+using namespace simplechess::details;
+
+constexpr int Evaluator::PieceValues[6];
+constexpr size_t Evaluator::DefaultPawnTableSize;
+
+namespace
+{
+	/**
+	 * Mobility bonus per reachable square, and the number of squares a
+	 * piece is expected to reach, indexed by \ref PieceType.
+	 */
+	constexpr int MiddlegameMobility[6] = {0, 2, 4, 5, 1, 0};
+	constexpr int EndgameMobility[6] = {0, 4, 4, 5, 2, 0};
+	constexpr int AverageMobility[6] = {0, 7, 4, 6, 13, 0};
+
+	constexpr int DoubledPawn[2] = {-10, -20};
+	constexpr int IsolatedPawn[2] = {-10, -15};
+
+	/**
+	 * Bonus of a passed pawn on top of its piece-square value, indexed by
+	 * the rank relative to its color.
+	 */
+	constexpr int MiddlegamePassedPawn[8] = {0, 5, 10, 15, 25, 40, 60, 0};
+	constexpr int EndgamePassedPawn[8] = {0, 10, 20, 35, 60, 90, 130, 0};
+
+	/**
+	 * Squares strictly in front of \p square from the point of view of
+	 * \p color, on its file and the adjacent ones.
+	 */
+	Bitboard passedPawnSpan(const Color color, const uint8_t square)
+	{
+		const uint8_t file = fileOf(square);
+		Bitboard files = FileA << file;
+
+		if (file > 0)
+		{
+			files |= FileA << (file - 1);
+		}
+
+		if (file < 7)
+		{
+			files |= FileA << (file + 1);
+		}
+
+		const uint8_t rank = rankOf(square);
+		const Bitboard ahead = (color == Color::White)
+			? ((rank == 7) ? 0 : ~Bitboard(0) << (8 * (rank + 1)))
+			: (bit(static_cast<uint8_t>(8 * rank)) - 1);
+
+		return files & ahead;
+	}
+
+	/**
+	 * Adds the mobility terms of \p color to \p middlegame and \p endgame.
+	 */
+	void addMobility(
+			const Position& position,
+			const Color color,
+			const int sign,
+			int& middlegame,
+			int& endgame)
+	{
+		const Color them = oppositeColor(color);
+		const Bitboard occupied = position.occupied();
+
+		// Squares defended by enemy pawns are not worth counting
+		Bitboard unsafe = position.pieces(color);
+
+		for (Bitboard pawns = position.pieces(them, PieceType::Pawn); pawns != 0;)
+		{
+			unsafe |= pawnAttacks(them, popLsb(pawns));
+		}
+
+		for (const PieceType type : {PieceType::Rook, PieceType::Knight, PieceType::Bishop, PieceType::Queen})
+		{
+			const int index = static_cast<int>(type);
+
+			for (Bitboard pieces = position.pieces(color, type); pieces != 0;)
+			{
+				const uint8_t square = popLsb(pieces);
+				Bitboard attacks = 0;
+
+				switch (type)
+				{
+					case PieceType::Rook:
+						attacks = rookAttacks(square, occupied);
+						break;
+					case PieceType::Knight:
+						attacks = knightAttacks(square);
+						break;
+					case PieceType::Bishop:
+						attacks = bishopAttacks(square, occupied);
+						break;
+					default:
+						attacks = queenAttacks(square, occupied);
+						break;
+				}
+
+				const int mobility = popCount(attacks & ~unsafe) - ::AverageMobility[index];
+				middlegame += sign * mobility * ::MiddlegameMobility[index];
+				endgame += sign * mobility * ::EndgameMobility[index];
+			}
+		}
+	}
+}
+
+Evaluator::Evaluator(const size_t pawnTableSize)
+	: mPawnTable()
+{
+	if (pawnTableSize != 0)
+	{
+		size_t size = 1;
+
+		while (size * 2 <= pawnTableSize)
+		{
+			size *= 2;
+		}
+
+		// A zero pawn hash (no pawns) is never looked up in the table, so
+		// zero keys mark empty entries
+		mPawnTable.assign(size, PawnEntry{0, 0, 0});
+	}
+}
+
+int Evaluator::evaluate(const Position& position)
+{
+	const int score = evaluateForWhite(position);
+	return (position.activeColor() == Color::White) ? score : -score;
+}
+
+int Evaluator::evaluateForWhite(const Position& position)
+{
+	const PawnEntry pawns = pawnStructure(position);
+
+	int middlegame = position.middlegameScore() + pawns.middlegame;
+	int endgame = position.endgameScore() + pawns.endgame;
+
+	::addMobility(position, Color::White, 1, middlegame, endgame);
+	::addMobility(position, Color::Black, -1, middlegame, endgame);
+
+	const int phase = std::min(position.phase(), pst::MaxPhase);
+
+	return (middlegame * phase + endgame * (pst::MaxPhase - phase)) / pst::MaxPhase;
+}
+
+Evaluator::PawnEntry Evaluator::pawnStructure(const Position& position)
+{
+	const uint64_t key = position.pawnHash();
+
+	if (key == 0)
+	{
+		return {0, 0, 0};
+	}
+
+	PawnEntry* entry = mPawnTable.empty()
+		? nullptr
+		: &mPawnTable[key & (mPawnTable.size() - 1)];
+
+	if (entry && entry->key == key)
+	{
+		return *entry;
+	}
+
+	PawnEntry result = {key, 0, 0};
+
+	for (const Color color : {Color::White, Color::Black})
+	{
+		const int sign = (color == Color::White) ? 1 : -1;
+		const Bitboard ours = position.pieces(color, PieceType::Pawn);
+		const Bitboard theirs = position.pieces(oppositeColor(color), PieceType::Pawn);
+
+		for (uint8_t file = 0; file < 8; ++file)
+		{
+			const int onFile = popCount(ours & (FileA << file));
+
+			if (onFile == 0)
+			{
+				continue;
+			}
+
+			result.middlegame += sign * (onFile - 1) * ::DoubledPawn[0];
+			result.endgame += sign * (onFile - 1) * ::DoubledPawn[1];
+
+			const Bitboard adjacent
+				= ((file > 0) ? FileA << (file - 1) : 0)
+				| ((file < 7) ? FileA << (file + 1) : 0);
+
+			if ((ours & adjacent) == 0)
+			{
+				result.middlegame += sign * onFile * ::IsolatedPawn[0];
+				result.endgame += sign * onFile * ::IsolatedPawn[1];
+			}
+		}
+
+		for (Bitboard pawns = ours; pawns != 0;)
+		{
+			const uint8_t square = popLsb(pawns);
+
+			if ((theirs & ::passedPawnSpan(color, square)) == 0)
+			{
+				const uint8_t rank = (color == Color::White)
+					? rankOf(square)
+					: static_cast<uint8_t>(7 - rankOf(square));
+
+				result.middlegame += sign * ::MiddlegamePassedPawn[rank];
+				result.endgame += sign * ::EndgamePassedPawn[rank];
+			}
+		}
+	}
+
+	if (entry)
+	{
+		*entry = result;
+	}
+
+	return result;
+}
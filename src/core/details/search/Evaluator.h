@@ -0,0 +1,81 @@
+#ifndef EVALUATOR_H_3E5A7C92_1B4D_4F08_9A6E_C82D0F51B7A4
+#define EVALUATOR_H_3E5A7C92_1B4D_4F08_9A6E_C82D0F51B7A4
+
+#include "../bitboard/Position.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace simplechess
+{
+	namespace details
+	{
+		/**
+		 * \brief Static evaluation of positions.
+		 *
+		 * Material and piece-square values are kept up to date by \ref
+		 * Position itself, and blended between their middlegame and
+		 * endgame values according to the phase of the game. On top of
+		 * that come the mobility of the pieces, computed from their
+		 * attacks, and the pawn structure, which is cached by the hash of
+		 * the pawns since it changes much less often than the rest of the
+		 * position.
+		 *
+		 * An evaluator is not thread-safe; each thread needs its own.
+		 */
+		class Evaluator
+		{
+			public:
+				/**
+				 * \brief Value of each piece type in centipawns, indexed
+				 * by \ref PieceType, to compare captures.
+				 */
+				static constexpr int PieceValues[6] = {100, 500, 320, 330, 900, 0};
+
+				/**
+				 * \brief Default number of entries of the pawn structure
+				 * cache.
+				 */
+				static constexpr size_t DefaultPawnTableSize = 1 << 14;
+
+				/**
+				 * \brief Constructor.
+				 *
+				 * \param pawnTableSize Number of entries of the pawn
+				 * structure cache (rounded down to a power of two), or 0
+				 * to not cache it.
+				 */
+				explicit Evaluator(size_t pawnTableSize = DefaultPawnTableSize);
+
+				/**
+				 * \brief Returns the score of \p position in centipawns,
+				 * from the point of view of the color to move.
+				 */
+				int evaluate(const Position& position);
+
+				/**
+				 * \brief Returns the score of \p position in centipawns,
+				 * from the point of view of white.
+				 */
+				int evaluateForWhite(const Position& position);
+
+			private:
+				struct PawnEntry
+				{
+					uint64_t key;
+					int32_t middlegame;
+					int32_t endgame;
+				};
+
+				/**
+				 * Returns the pawn structure terms of \p position, from
+				 * the cache if possible.
+				 */
+				PawnEntry pawnStructure(const Position& position);
+
+				std::vector<PawnEntry> mPawnTable;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,352 @@
+#include "MateSolver.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <optional>
+
+using namespace simplechess;
+using namespace simplechess::details;
+
+namespace
+{
+	/**
+	 * Squares from which each piece type of the attacker checks the
+	 * defending king, and the attacking pieces which may uncover a check
+	 * by moving.
+	 */
+	struct CheckSquares
+	{
+		Bitboard byType[6];
+		Bitboard discoverers;
+	};
+
+	CheckSquares checkSquares(const Position& position)
+	{
+		const Color us = position.activeColor();
+		const Color them = oppositeColor(us);
+		const uint8_t king = position.kingSquare(them);
+		const Bitboard occupied = position.occupied();
+
+		CheckSquares result = {};
+		result.byType[static_cast<int>(PieceType::Pawn)] = pawnAttacks(them, king);
+		result.byType[static_cast<int>(PieceType::Rook)] = rookAttacks(king, occupied);
+		result.byType[static_cast<int>(PieceType::Knight)] = knightAttacks(king);
+		result.byType[static_cast<int>(PieceType::Bishop)] = bishopAttacks(king, occupied);
+		result.byType[static_cast<int>(PieceType::Queen)]
+			= result.byType[static_cast<int>(PieceType::Rook)]
+			| result.byType[static_cast<int>(PieceType::Bishop)];
+
+		// Only a piece in direct sight of the king can uncover a line to it
+		result.discoverers = queenAttacks(king, occupied) & position.pieces(us);
+
+		return result;
+	}
+
+	bool givesCheck(const Position& position, const Move& move, const CheckSquares& squares)
+	{
+		const PieceType type = pieceTypeOf(position.pieceCodeAt(move.src));
+
+		const bool special = move.promotion != PieceType::Pawn
+			|| (type == PieceType::King
+				&& std::abs(fileOf(move.src) - fileOf(move.dst)) == 2)
+			|| (type == PieceType::Pawn
+				&& fileOf(move.src) != fileOf(move.dst)
+				&& position.pieceCodeAt(move.dst) == NoPiece);
+
+		if (special || (squares.discoverers & bit(move.src)) != 0)
+		{
+			// Promotions, castling, en passant and possible discovered
+			// checks are rare enough to just play them
+			Position next = position;
+			next.makeMove(move);
+			return next.inCheck();
+		}
+
+		return (squares.byType[static_cast<int>(type)] & bit(move.dst)) != 0;
+	}
+
+	void checkingMoves(const Position& position, const CheckSquares& squares, MoveList& checks)
+	{
+		const Color us = position.activeColor();
+		const Bitboard targets = ~position.pieces(us);
+		const Bitboard occupied = position.occupied();
+		const std::optional<uint8_t> enPassant = position.enPassantSquare();
+
+		// Moves landing on a check square give check, as the moving piece
+		// cannot have been blocking its own line to the king. The others
+		// which might (promotions, castling, en passant and moves of a
+		// possible discoverer) are played to find out.
+		const auto add = [&position, &checks](const Move& move, const bool verify)
+		{
+			if (!position.isLegal(move))
+			{
+				return;
+			}
+
+			if (verify)
+			{
+				Position next = position;
+				next.makeMove(move);
+
+				if (!next.inCheck())
+				{
+					return;
+				}
+			}
+
+			checks.push(move);
+		};
+
+		// Pawns
+		const bool white = us == Color::White;
+		const int forward = white ? 8 : -8;
+		const uint8_t lastRank = white ? 7 : 0;
+
+		Bitboard pawns = position.pieces(us, PieceType::Pawn);
+		while (pawns)
+		{
+			const uint8_t src = popLsb(pawns);
+			const bool discoverer = (squares.discoverers & bit(src)) != 0;
+
+			Bitboard destinations = pawnAttacks(us, src) & position.pieces(oppositeColor(us));
+			if (enPassant)
+			{
+				destinations |= pawnAttacks(us, src) & bit(*enPassant);
+			}
+
+			const uint8_t oneStep = static_cast<uint8_t>(src + forward);
+			if (!(occupied & bit(oneStep)))
+			{
+				destinations |= bit(oneStep);
+
+				const uint8_t twoSteps = static_cast<uint8_t>(oneStep + forward);
+				if (rankOf(src) == (white ? 1 : 6) && !(occupied & bit(twoSteps)))
+				{
+					destinations |= bit(twoSteps);
+				}
+			}
+
+			while (destinations)
+			{
+				const uint8_t dst = popLsb(destinations);
+
+				if (rankOf(dst) == lastRank)
+				{
+					for (const PieceType promotion : {PieceType::Rook, PieceType::Knight,
+							PieceType::Bishop, PieceType::Queen})
+					{
+						add({src, dst, promotion}, true);
+					}
+				}
+				else if (discoverer || (enPassant && dst == *enPassant))
+				{
+					add({src, dst, PieceType::Pawn}, true);
+				}
+				else if (squares.byType[static_cast<int>(PieceType::Pawn)] & bit(dst))
+				{
+					add({src, dst, PieceType::Pawn}, false);
+				}
+			}
+		}
+
+		// Knights and sliders
+		for (const PieceType type : {PieceType::Knight, PieceType::Bishop,
+				PieceType::Rook, PieceType::Queen})
+		{
+			Bitboard pieceSet = position.pieces(us, type);
+			while (pieceSet)
+			{
+				const uint8_t src = popLsb(pieceSet);
+
+				Bitboard attacks = 0;
+				switch (type)
+				{
+					case PieceType::Knight:
+						attacks = knightAttacks(src);
+						break;
+					case PieceType::Bishop:
+						attacks = bishopAttacks(src, occupied);
+						break;
+					case PieceType::Rook:
+						attacks = rookAttacks(src, occupied);
+						break;
+					default:
+						attacks = queenAttacks(src, occupied);
+						break;
+				}
+
+				const bool discoverer = (squares.discoverers & bit(src)) != 0;
+				attacks &= targets;
+
+				if (!discoverer)
+				{
+					attacks &= squares.byType[static_cast<int>(type)];
+				}
+
+				while (attacks)
+				{
+					add({src, popLsb(attacks), PieceType::Pawn}, discoverer);
+				}
+			}
+		}
+
+		// The king only checks by uncovering a line or by castling
+		const uint8_t king = position.kingSquare(us);
+
+		if (squares.discoverers & bit(king))
+		{
+			Bitboard kingTargets = kingAttacks(king) & targets;
+			while (kingTargets)
+			{
+				add({king, popLsb(kingTargets), PieceType::Pawn}, true);
+			}
+		}
+
+		if (position.castlingRights() && fileOf(king) == 4)
+		{
+			add({king, static_cast<uint8_t>(king + 2), PieceType::Pawn}, true);
+			add({king, static_cast<uint8_t>(king - 2), PieceType::Pawn}, true);
+		}
+	}
+}
+
+MateSolver::MateSolver(const bool checksOnly)
+	: mChecksOnly(checksOnly),
+	  mTable(),
+	  mRefutations()
+{
+}
+
+bool MateSolver::givesCheck(const Position& position, const Move& move)
+{
+	return ::givesCheck(position, move, ::checkSquares(position));
+}
+
+void MateSolver::checkingMoves(const Position& position, MoveList& checks)
+{
+	::checkingMoves(position, ::checkSquares(position), checks);
+}
+
+bool MateSolver::isMatingMove(const Position& position, const Move& move, const unsigned moves)
+{
+	if (moves == 0 || ((mChecksOnly || moves == 1) && !givesCheck(position, move)))
+	{
+		return false;
+	}
+
+	Position next = position;
+	next.makeMove(move);
+	return defend(next, moves);
+}
+
+bool MateSolver::attack(const Position& position, const unsigned moves)
+{
+	if (moves == 0)
+	{
+		return false;
+	}
+
+	const auto it = mTable.find(position.hash());
+
+	if (it != mTable.end())
+	{
+		if (it->second.proven != 0 && it->second.proven <= moves)
+		{
+			return true;
+		}
+
+		if (it->second.disproven >= moves)
+		{
+			return false;
+		}
+	}
+
+	// Checks first, since they leave the defender the fewest replies
+	MoveList candidates;
+	::checkingMoves(position, ::checkSquares(position), candidates);
+	const size_t checks = candidates.size;
+
+	if (!mChecksOnly && moves > 1)
+	{
+		MoveList legal;
+		position.legalMoves(legal);
+
+		for (const Move& move : legal)
+		{
+			if (std::find(candidates.moves, candidates.moves + checks, move)
+					== candidates.moves + checks)
+			{
+				candidates.push(move);
+			}
+		}
+	}
+
+	bool mates = false;
+
+	for (const Move& move : candidates)
+	{
+		Position next = position;
+		next.makeMove(move);
+
+		if (defend(next, moves))
+		{
+			mates = true;
+			break;
+		}
+	}
+
+	Entry& entry = mTable[position.hash()];
+
+	if (mates)
+	{
+		entry.proven = (entry.proven == 0)
+			? static_cast<uint16_t>(moves)
+			: std::min(entry.proven, static_cast<uint16_t>(moves));
+	}
+	else
+	{
+		entry.disproven = std::max(entry.disproven, static_cast<uint16_t>(moves));
+	}
+
+	return mates;
+}
+
+bool MateSolver::defend(const Position& position, const unsigned moves)
+{
+	MoveList replies;
+	position.legalMoves(replies);
+
+	if (replies.size == 0)
+	{
+		// Checkmate, or stalemate
+		return position.inCheck();
+	}
+
+	if (moves <= 1)
+	{
+		return false;
+	}
+
+	// Try first the reply which refuted the last attempt at this depth
+	Move& refutation = mRefutations[std::min<unsigned>(moves, 255)];
+	const auto known = std::find(replies.moves, replies.moves + replies.size, refutation);
+
+	if (known != replies.moves + replies.size)
+	{
+		std::swap(*known, replies.moves[0]);
+	}
+
+	for (const Move& reply : replies)
+	{
+		Position next = position;
+		next.makeMove(reply);
+
+		if (!attack(next, moves - 1))
+		{
+			refutation = reply;
+			return false;
+		}
+	}
+
+	return true;
+}
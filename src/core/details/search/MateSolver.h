@@ -0,0 +1,96 @@
+#ifndef MATE_SOLVER_H_92B6D1E4_0C7A_4F53_A8E2_6D3F15C79B08
+#define MATE_SOLVER_H_92B6D1E4_0C7A_4F53_A8E2_6D3F15C79B08
+
+#include "../bitboard/Position.h"
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace simplechess
+{
+	namespace details
+	{
+		/**
+		 * \brief Depth-limited AND/OR search for forced mates.
+		 *
+		 * The attacker needs one move which mates against every
+		 * defence; the defender needs one reply which escapes. Results
+		 * of the attacker's positions are remembered, so transpositions
+		 * and the iterations of a deepening search are only solved once.
+		 *
+		 * Draw rules other than stalemate are ignored.
+		 */
+		class MateSolver
+		{
+			public:
+				/**
+				 * \brief Constructor.
+				 *
+				 * \param checksOnly Whether the attacker only plays
+				 * checking moves, which is much faster but misses mates
+				 * with a quiet move. The last move of a mate is always a
+				 * check, so it is only generated among checking moves
+				 * either way.
+				 */
+				explicit MateSolver(bool checksOnly);
+
+				/**
+				 * \brief Whether playing \p move on \p position (with
+				 * the attacker to move) forces mate in at most \p moves
+				 * moves, counting \p move.
+				 */
+				bool isMatingMove(const Position& position, const Move& move, unsigned moves);
+
+				/**
+				 * \brief Whether \p move gives check on \p position.
+				 */
+				static bool givesCheck(const Position& position, const Move& move);
+
+				/**
+				 * \brief Fills \p checks with the legal moves which give
+				 * check on \p position, generated from the squares they
+				 * check from rather than by filtering every legal move.
+				 */
+				static void checkingMoves(const Position& position, MoveList& checks);
+
+			private:
+				/**
+				 * Whether the attacker, to move on \p position, forces
+				 * mate in at most \p moves moves.
+				 */
+				bool attack(const Position& position, unsigned moves);
+
+				/**
+				 * Whether every reply of the defender, to move on \p
+				 * position, loses to a mate in at most \p moves moves
+				 * counting the attacker's move which has just been
+				 * played.
+				 */
+				bool defend(const Position& position, unsigned moves);
+
+				struct Entry
+				{
+					/**
+					 * Number of moves of a proven mate, or 0.
+					 */
+					uint16_t proven;
+
+					/**
+					 * Largest number of moves with no mate.
+					 */
+					uint16_t disproven;
+				};
+
+				bool mChecksOnly;
+				std::unordered_map<uint64_t, Entry> mTable;
+
+				/**
+				 * The last reply of the defender which refuted a mate,
+				 * indexed by the number of moves left.
+				 */
+				Move mRefutations[256];
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,539 @@
+#include "Searcher.h"
+
+#include "../DrawEvaluator.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace simplechess;
+using namespace simplechess::details;
+
+namespace
+{
+	constexpr Move NoMove = {0, 0, PieceType::Pawn};
+
+	/**
+	 * Nodes counted by a thread before they are added to the shared count
+	 * and the limits are checked.
+	 */
+	constexpr uint64_t NodeBatch = 1024;
+
+	bool isCapture(const Position& position, const Move& move)
+	{
+		return position.pieceCodeAt(move.dst) != NoPiece
+			|| (pieceTypeOf(position.pieceCodeAt(move.src)) == PieceType::Pawn
+				&& fileOf(move.src) != fileOf(move.dst));
+	}
+
+	int scoreToTable(const int value, const int ply)
+	{
+		if (value > score::MateBound)
+		{
+			return value + ply;
+		}
+
+		if (value < -score::MateBound)
+		{
+			return value - ply;
+		}
+
+		return value;
+	}
+
+	int scoreFromTable(const int value, const int ply)
+	{
+		if (value > score::MateBound)
+		{
+			return value - ply;
+		}
+
+		if (value < -score::MateBound)
+		{
+			return value + ply;
+		}
+
+		return value;
+	}
+
+	/**
+	 * Moves the best scored move of [\p index, \p size) to \p index.
+	 */
+	void pickMove(MoveList& moves, int* scores, const size_t index)
+	{
+		size_t best = index;
+
+		for (size_t i = index + 1; i < moves.size; ++i)
+		{
+			if (scores[i] > scores[best])
+			{
+				best = i;
+			}
+		}
+
+		std::swap(moves.moves[index], moves.moves[best]);
+		std::swap(scores[index], scores[best]);
+	}
+}
+
+Searcher::Searcher(SharedSearch& shared, const unsigned id)
+	: mShared(shared),
+	  mId(id),
+	  mPendingNodes(0),
+	  mAborted(false),
+	  mScore(0),
+	  mCompletedDepth(0),
+	  mPrincipalVariation(),
+	  mHashes(shared.previousHashes),
+	  mRootIndex(shared.previousHashes.size()),
+	  mKillers(),
+	  mHistory(),
+	  mPv(),
+	  mPvLength(),
+	  mEvaluator()
+{
+}
+
+void Searcher::run()
+{
+	// Helper threads search one ply deeper every other thread, so that
+	// they fill the table with results the main thread will need next
+	const int offset = static_cast<int>(mId % 2);
+
+	for (int depth = 1; depth <= mShared.maxDepth; ++depth)
+	{
+		const int value = search(
+				mShared.root,
+				-score::Infinite,
+				score::Infinite,
+				std::min(depth + offset, score::MaxPly - 1),
+				0);
+
+		if (mAborted)
+		{
+			break;
+		}
+
+		mScore = value;
+		mCompletedDepth = depth;
+		mPrincipalVariation.assign(mPv[0], mPv[0] + mPvLength[0]);
+
+		if (mId != 0)
+		{
+			continue;
+		}
+
+		// A mate within the depth searched cannot be improved upon
+		if (std::abs(value) > score::MateBound
+				&& score::Mate - std::abs(value) <= depth)
+		{
+			break;
+		}
+
+		// An iteration takes longer than all the previous ones together,
+		// so do not start one which is unlikely to finish
+		if (mShared.deadline
+				&& std::chrono::steady_clock::now()
+					> *mShared.deadline - (*mShared.deadline - mShared.start) / 2)
+		{
+			break;
+		}
+	}
+
+	if (mId == 0)
+	{
+		mShared.stop = true;
+	}
+
+	mShared.nodes += mPendingNodes;
+	mPendingNodes = 0;
+}
+
+bool Searcher::visitNode()
+{
+	if (++mPendingNodes >= ::NodeBatch)
+	{
+		const uint64_t total = mShared.nodes += mPendingNodes;
+		mPendingNodes = 0;
+
+		if ((mShared.nodeLimit != 0 && total >= mShared.nodeLimit)
+				|| (mShared.deadline
+					&& std::chrono::steady_clock::now() >= *mShared.deadline))
+		{
+			mShared.stop = true;
+		}
+	}
+
+	// The main thread always completes the first depth, so that there is
+	// a move to report
+	mAborted = mShared.stop.load(std::memory_order_relaxed)
+		&& !(mId == 0 && mCompletedDepth == 0);
+
+	return mAborted;
+}
+
+bool Searcher::isRepetition(const Position& position) const
+{
+	// The current position is the last one in mHashes, and only positions
+	// with the same color to move since the last irreversible move can be
+	// the same
+	const size_t current = mHashes.size() - 1;
+	const size_t reversible = std::min<size_t>(position.halfmoveClock(), current);
+	int timesReached = 0;
+
+	for (size_t distance = 2; distance <= reversible; distance += 2)
+	{
+		const size_t index = current - distance;
+
+		if (mHashes[index] == position.hash())
+		{
+			// A repetition within the search is scored as a draw, since
+			// either side could repeat again; positions of the game
+			// need to be on the board for the third time
+			if (index >= mRootIndex || ++timesReached >= 2)
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+int Searcher::orderingScore(
+		const Position& position,
+		const Move& move,
+		const Move& tableMove,
+		const int ply) const
+{
+	if (move == tableMove)
+	{
+		return 1000000;
+	}
+
+	if (::isCapture(position, move))
+	{
+		// Most valuable victim, least valuable attacker
+		const uint8_t victim = position.pieceCodeAt(move.dst);
+		const int victimValue = (victim == NoPiece)
+			? Evaluator::PieceValues[static_cast<int>(PieceType::Pawn)]
+			: Evaluator::PieceValues[static_cast<int>(pieceTypeOf(victim))];
+		const int attackerValue = Evaluator::PieceValues[
+			static_cast<int>(pieceTypeOf(position.pieceCodeAt(move.src)))];
+
+		return 100000 + 10 * victimValue - attackerValue / 10;
+	}
+
+	if (move.promotion == PieceType::Queen)
+	{
+		return 90000;
+	}
+
+	if (move == mKillers[ply][0])
+	{
+		return 80000;
+	}
+
+	if (move == mKillers[ply][1])
+	{
+		return 79000;
+	}
+
+	return mHistory[position.activeColor() == Color::White ? 0 : 1][move.src][move.dst];
+}
+
+void Searcher::updateHeuristics(
+		const Position& position,
+		const Move& move,
+		const int depth,
+		const int ply)
+{
+	if (::isCapture(position, move))
+	{
+		return;
+	}
+
+	if (move != mKillers[ply][0])
+	{
+		mKillers[ply][1] = mKillers[ply][0];
+		mKillers[ply][0] = move;
+	}
+
+	int& history = mHistory[position.activeColor() == Color::White ? 0 : 1][move.src][move.dst];
+	history = std::min(history + depth * depth, 70000);
+}
+
+int Searcher::search(
+		const Position& position,
+		int alpha,
+		int beta,
+		int depth,
+		const int ply)
+{
+	mPvLength[ply] = 0;
+
+	if (visitNode())
+	{
+		return 0;
+	}
+
+	const bool inCheck = position.inCheck();
+
+	if (ply > 0)
+	{
+		if (isRepetition(position) || DrawEvaluator::isInsufficientMaterial(position))
+		{
+			return 0;
+		}
+
+		// Either side could claim the fifty-move rule, unless the last
+		// move was mate
+		if (position.halfmoveClock() >= 100 && !inCheck)
+		{
+			return 0;
+		}
+
+		if (ply >= score::MaxPly)
+		{
+			return mEvaluator.evaluate(position);
+		}
+
+		if (inCheck)
+		{
+			++depth;
+		}
+
+		if (depth <= 0)
+		{
+			return quiescence(position, alpha, beta, ply);
+		}
+	}
+
+	const bool pvNode = beta - alpha > 1;
+
+	TableEntry entry;
+	Move tableMove = ::NoMove;
+
+	if (mShared.table.probe(position.hash(), entry))
+	{
+		tableMove = entry.move;
+		const int value = ::scoreFromTable(entry.score, ply);
+
+		if (!pvNode
+				&& ply > 0
+				&& entry.depth >= depth
+				&& (entry.bound == Bound::Exact
+					|| (entry.bound == Bound::Lower && value >= beta)
+					|| (entry.bound == Bound::Upper && value <= alpha)))
+		{
+			return value;
+		}
+	}
+
+	MoveList moves;
+	position.legalMoves(moves);
+
+	if (moves.size == 0)
+	{
+		return inCheck ? -(score::Mate - ply) : 0;
+	}
+
+	int bestScore = -score::Infinite;
+
+	if (ply > 0)
+	{
+		if (position.halfmoveClock() >= 100)
+		{
+			return 0;
+		}
+
+		// The player to move may claim a draw instead of moving
+		const Color them = oppositeColor(position.activeColor());
+
+		if (position.halfmoveClock() >= 99
+				|| position.pieces(them) == position.pieces(them, PieceType::King))
+		{
+			bestScore = 0;
+			alpha = std::max(alpha, 0);
+
+			if (alpha >= beta)
+			{
+				return alpha;
+			}
+		}
+	}
+
+	int scores[256];
+
+	for (size_t i = 0; i < moves.size; ++i)
+	{
+		scores[i] = orderingScore(position, moves.moves[i], tableMove, ply);
+	}
+
+	const int originalAlpha = alpha;
+	Move bestMove = ::NoMove;
+
+	mHashes.push_back(position.hash());
+
+	for (size_t i = 0; i < moves.size; ++i)
+	{
+		::pickMove(moves, scores, i);
+		const Move& move = moves.moves[i];
+
+		Position next = position;
+		next.makeMove(move);
+
+		int value;
+
+		if (i == 0)
+		{
+			value = -search(next, -beta, -alpha, depth - 1, ply + 1);
+		}
+		else
+		{
+			// Prove the move is worse with a null window, and search it
+			// again with the full window if it is not
+			value = -search(next, -alpha - 1, -alpha, depth - 1, ply + 1);
+
+			if (value > alpha && value < beta)
+			{
+				value = -search(next, -beta, -alpha, depth - 1, ply + 1);
+			}
+		}
+
+		if (mAborted)
+		{
+			mHashes.pop_back();
+			return 0;
+		}
+
+		if (value > bestScore)
+		{
+			bestScore = value;
+			bestMove = move;
+
+			if (value > alpha)
+			{
+				alpha = value;
+
+				mPv[ply][0] = move;
+				std::copy(mPv[ply + 1], mPv[ply + 1] + mPvLength[ply + 1], mPv[ply] + 1);
+				mPvLength[ply] = mPvLength[ply + 1] + 1;
+
+				if (alpha >= beta)
+				{
+					updateHeuristics(position, move, depth, ply);
+					break;
+				}
+			}
+		}
+	}
+
+	mHashes.pop_back();
+
+	const Bound bound = (bestScore >= beta)
+		? Bound::Lower
+		: (bestScore > originalAlpha) ? Bound::Exact : Bound::Upper;
+
+	mShared.table.store(
+			position.hash(),
+			{bestMove,
+			static_cast<int16_t>(::scoreToTable(bestScore, ply)),
+			static_cast<uint8_t>(depth),
+			bound});
+
+	return bestScore;
+}
+
+int Searcher::quiescence(const Position& position, int alpha, const int beta, const int ply)
+{
+	mPvLength[ply] = 0;
+
+	if (visitNode())
+	{
+		return 0;
+	}
+
+	if (DrawEvaluator::isInsufficientMaterial(position))
+	{
+		return 0;
+	}
+
+	if (ply >= score::MaxPly)
+	{
+		return mEvaluator.evaluate(position);
+	}
+
+	const bool inCheck = position.inCheck();
+	int bestScore = -score::Infinite;
+
+	if (!inCheck)
+	{
+		// The player to move may stop capturing
+		bestScore = mEvaluator.evaluate(position);
+
+		if (bestScore >= beta)
+		{
+			return bestScore;
+		}
+
+		alpha = std::max(alpha, bestScore);
+	}
+
+	MoveList moves;
+	position.legalMoves(moves);
+
+	if (moves.size == 0)
+	{
+		return inCheck ? -(score::Mate - ply) : 0;
+	}
+
+	// Out of check, only captures and promotions are searched
+	MoveList candidates;
+
+	for (const Move& move : moves)
+	{
+		if (inCheck || move.promotion == PieceType::Queen || ::isCapture(position, move))
+		{
+			candidates.push(move);
+		}
+	}
+
+	int scores[256];
+
+	for (size_t i = 0; i < candidates.size; ++i)
+	{
+		scores[i] = orderingScore(position, candidates.moves[i], ::NoMove, ply);
+	}
+
+	for (size_t i = 0; i < candidates.size; ++i)
+	{
+		::pickMove(candidates, scores, i);
+
+		Position next = position;
+		next.makeMove(candidates.moves[i]);
+
+		const int value = -quiescence(next, -beta, -alpha, ply + 1);
+
+		if (mAborted)
+		{
+			return 0;
+		}
+
+		if (value > bestScore)
+		{
+			bestScore = value;
+
+			if (value > alpha)
+			{
+				alpha = value;
+
+				if (alpha >= beta)
+				{
+					break;
+				}
+			}
+		}
+	}
+
+	return bestScore;
+}
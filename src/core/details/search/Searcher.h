@@ -0,0 +1,172 @@
+#ifndef SEARCHER_H_5B09E3D7_2A6C_4F81_9D4E_B16F7C38A052
+#define SEARCHER_H_5B09E3D7_2A6C_4F81_9D4E_B16F7C38A052
+
+#include "Evaluator.h"
+#include "TranspositionTable.h"
+
+#include "../bitboard/Position.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace simplechess
+{
+	namespace details
+	{
+		/**
+		 * \brief Scores of the search, in centipawns from the point of
+		 * view of the color to move.
+		 */
+		namespace score
+		{
+			constexpr int Infinite = 32001;
+			constexpr int Mate = 32000;
+
+			/**
+			 * \brief Maximum number of plies from the root.
+			 */
+			constexpr int MaxPly = 128;
+
+			/**
+			 * \brief Scores beyond this are mates.
+			 */
+			constexpr int MateBound = Mate - MaxPly;
+		}
+
+		/**
+		 * \brief State shared by all the threads of a search.
+		 */
+		struct SharedSearch
+		{
+			SharedSearch(
+					const Position& root,
+					const std::vector<uint64_t>& previousHashes,
+					size_t hashSize)
+				: root(root),
+				  previousHashes(previousHashes),
+				  table(hashSize),
+				  maxDepth(1),
+				  nodeLimit(0),
+				  start(std::chrono::steady_clock::now()),
+				  deadline(),
+				  stop(false),
+				  nodes(0)
+			{
+			}
+
+			/**
+			 * \brief The position to search.
+			 */
+			const Position root;
+
+			/**
+			 * \brief Hashes of the positions of the game before the
+			 * root which can still be repeated, oldest first.
+			 */
+			const std::vector<uint64_t> previousHashes;
+
+			TranspositionTable table;
+
+			int maxDepth;
+			uint64_t nodeLimit;
+			std::chrono::steady_clock::time_point start;
+			std::optional<std::chrono::steady_clock::time_point> deadline;
+
+			std::atomic<bool> stop;
+			std::atomic<uint64_t> nodes;
+		};
+
+		/**
+		 * \brief One thread of a search: iterative deepening of a
+		 * principal variation search, with its own move ordering
+		 * heuristics.
+		 */
+		class Searcher
+		{
+			public:
+				/**
+				 * \brief Constructor.
+				 *
+				 * \param shared The state shared with the other threads.
+				 * \param id The index of the thread. Thread 0 reports the
+				 * result, and stops the others when it finishes.
+				 */
+				Searcher(SharedSearch& shared, unsigned id);
+
+				/**
+				 * \brief Searches deeper and deeper until a limit is
+				 * reached.
+				 */
+				void run();
+
+				/**
+				 * \brief Score of the last depth searched completely.
+				 */
+				int score() const
+				{
+					return mScore;
+				}
+
+				/**
+				 * \brief The last depth searched completely.
+				 */
+				int completedDepth() const
+				{
+					return mCompletedDepth;
+				}
+
+				/**
+				 * \brief Principal variation of the last depth searched
+				 * completely.
+				 */
+				const std::vector<Move>& principalVariation() const
+				{
+					return mPrincipalVariation;
+				}
+
+			private:
+				int search(const Position& position, int alpha, int beta, int depth, int ply);
+				int quiescence(const Position& position, int alpha, int beta, int ply);
+
+				bool isRepetition(const Position& position) const;
+				int orderingScore(const Position& position, const Move& move, const Move& tableMove, int ply) const;
+				void updateHeuristics(const Position& position, const Move& move, int depth, int ply);
+
+				/**
+				 * Counts a visited node, and returns whether the search
+				 * has to stop.
+				 */
+				bool visitNode();
+
+				SharedSearch& mShared;
+				unsigned mId;
+
+				uint64_t mPendingNodes;
+				bool mAborted;
+
+				int mScore;
+				int mCompletedDepth;
+				std::vector<Move> mPrincipalVariation;
+
+				/**
+				 * Hashes of the previous positions followed by the
+				 * positions on the current path.
+				 */
+				std::vector<uint64_t> mHashes;
+				size_t mRootIndex;
+
+				Move mKillers[score::MaxPly + 1][2];
+				int mHistory[2][64][64];
+
+				Move mPv[score::MaxPly + 1][score::MaxPly + 1];
+				int mPvLength[score::MaxPly + 1];
+
+				Evaluator mEvaluator;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,80 @@
+#include "TranspositionTable.h"
+
+using namespace simplechess;
+using namespace simplechess::details;
+
+TranspositionTable::TranspositionTable(const size_t bytes)
+	: mSlots(),
+	  mMask(0)
+{
+	size_t slots = 1;
+
+	while (slots * 2 * sizeof(Slot) <= bytes)
+	{
+		slots *= 2;
+	}
+
+	mSlots.reset(new Slot[slots]);
+	mMask = slots - 1;
+
+	for (size_t i = 0; i < slots; ++i)
+	{
+		mSlots[i].check.store(0, std::memory_order_relaxed);
+		mSlots[i].data.store(0, std::memory_order_relaxed);
+	}
+}
+
+bool TranspositionTable::probe(const uint64_t key, TableEntry& entry) const
+{
+	const Slot& slot = mSlots[key & mMask];
+	const uint64_t data = slot.data.load(std::memory_order_relaxed);
+
+	if ((slot.check.load(std::memory_order_relaxed) ^ data) != key || data == 0)
+	{
+		return false;
+	}
+
+	entry = unpack(data);
+	return true;
+}
+
+void TranspositionTable::store(const uint64_t key, const TableEntry& entry)
+{
+	Slot& slot = mSlots[key & mMask];
+	const uint64_t previous = slot.data.load(std::memory_order_relaxed);
+
+	if ((slot.check.load(std::memory_order_relaxed) ^ previous) == key
+			&& previous != 0
+			&& unpack(previous).depth > entry.depth
+			&& entry.bound != Bound::Exact)
+	{
+		return;
+	}
+
+	const uint64_t data = pack(entry);
+	slot.check.store(key ^ data, std::memory_order_relaxed);
+	slot.data.store(data, std::memory_order_relaxed);
+}
+
+uint64_t TranspositionTable::pack(const TableEntry& entry)
+{
+	// The bound is stored plus one, so that no packed entry is zero
+	return static_cast<uint64_t>(entry.move.src)
+		| (static_cast<uint64_t>(entry.move.dst) << 6)
+		| (static_cast<uint64_t>(entry.move.promotion) << 12)
+		| (static_cast<uint64_t>(static_cast<uint16_t>(entry.score)) << 16)
+		| (static_cast<uint64_t>(entry.depth) << 32)
+		| (static_cast<uint64_t>(static_cast<uint8_t>(entry.bound) + 1) << 40);
+}
+
+TableEntry TranspositionTable::unpack(const uint64_t data)
+{
+	TableEntry entry;
+	entry.move.src = static_cast<uint8_t>(data & 0x3F);
+	entry.move.dst = static_cast<uint8_t>((data >> 6) & 0x3F);
+	entry.move.promotion = static_cast<PieceType>((data >> 12) & 0x0F);
+	entry.score = static_cast<int16_t>(static_cast<uint16_t>(data >> 16));
+	entry.depth = static_cast<uint8_t>(data >> 32);
+	entry.bound = static_cast<Bound>(((data >> 40) & 0xFF) - 1);
+	return entry;
+}
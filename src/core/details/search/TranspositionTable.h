@@ -0,0 +1,85 @@
+#ifndef TRANSPOSITION_TABLE_H_C41E8B27_6F3A_4D95_8B0C_7A2E5D19F643
+#define TRANSPOSITION_TABLE_H_C41E8B27_6F3A_4D95_8B0C_7A2E5D19F643
+
+#include "../bitboard/Position.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace simplechess
+{
+	namespace details
+	{
+		/**
+		 * \brief How the score of a \ref TranspositionTable entry relates
+		 * to the true score of the position.
+		 */
+		enum class Bound : uint8_t
+		{
+			Exact,
+			Lower,
+			Upper
+		};
+
+		/**
+		 * \brief What the search learnt about a position.
+		 */
+		struct TableEntry
+		{
+			Move move;
+			int16_t score;
+			uint8_t depth;
+			Bound bound;
+		};
+
+		/**
+		 * \brief Fixed-size hash table of search results, shared by all
+		 * the threads of a search.
+		 *
+		 * Every slot holds the entry packed in 64 bits and the key XORed
+		 * with it, both stored with relaxed atomics. A slot torn by two
+		 * threads writing at once no longer matches any key, so readers
+		 * never see a mix of two entries and no lock is needed.
+		 */
+		class TranspositionTable
+		{
+			public:
+				/**
+				 * \brief Constructor.
+				 *
+				 * \param bytes Approximate size of the table. The number of
+				 * slots is rounded down to a power of two.
+				 */
+				explicit TranspositionTable(size_t bytes);
+
+				/**
+				 * \brief Looks \p key up, returning whether it was found.
+				 */
+				bool probe(uint64_t key, TableEntry& entry) const;
+
+				/**
+				 * \brief Stores \p entry for \p key, replacing whatever was
+				 * in its slot unless it was a deeper result for the same
+				 * position.
+				 */
+				void store(uint64_t key, const TableEntry& entry);
+
+			private:
+				struct Slot
+				{
+					std::atomic<uint64_t> check;
+					std::atomic<uint64_t> data;
+				};
+
+				static uint64_t pack(const TableEntry& entry);
+				static TableEntry unpack(uint64_t data);
+
+				std::unique_ptr<Slot[]> mSlots;
+				uint64_t mMask;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,378 @@
+#include "EndgameTable.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+using namespace simplechess;
+using namespace simplechess::details;
+
+constexpr size_t EndgameTable::MaxPieces;
+
+namespace
+{
+	/**
+	 * Order of the pieces of each side in the name of an ending.
+	 */
+	const std::string PieceLetters = "QRBNP";
+
+	constexpr PieceType PieceTypes[5] = {
+		PieceType::Queen,
+		PieceType::Rook,
+		PieceType::Bishop,
+		PieceType::Knight,
+		PieceType::Pawn
+	};
+
+	constexpr uint8_t NoKingIndex = 0xFF;
+
+	/**
+	 * Index of every square of the a1-d1-d4 triangle, where the white
+	 * king stands in endings without pawns.
+	 */
+	constexpr std::array<uint8_t, 64> makeTriangleIndices()
+	{
+		std::array<uint8_t, 64> result = {};
+		uint8_t next = 0;
+
+		for (uint8_t square = 0; square < 64; ++square)
+		{
+			result[square] = (fileOf(square) <= 3 && rankOf(square) <= fileOf(square))
+				? next++
+				: NoKingIndex;
+		}
+
+		return result;
+	}
+
+	constexpr std::array<uint8_t, 64> TriangleIndices = makeTriangleIndices();
+
+	uint8_t flipFile(const uint8_t square)
+	{
+		return square ^ 7;
+	}
+
+	uint8_t flipRank(const uint8_t square)
+	{
+		return square ^ 56;
+	}
+
+	uint8_t flipDiagonal(const uint8_t square)
+	{
+		return static_cast<uint8_t>((fileOf(square) << 3) | rankOf(square));
+	}
+
+	template <typename Transform>
+	void transform(uint8_t (&squares)[EndgameTable::MaxPieces], const size_t count, Transform function)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			squares[i] = function(squares[i]);
+		}
+	}
+
+	/**
+	 * Builds the name of an ending from the letters of each side.
+	 */
+	std::string endingName(std::string white, std::string black)
+	{
+		const auto byOrder = [](const char lhs, const char rhs)
+		{
+			return ::PieceLetters.find(lhs) < ::PieceLetters.find(rhs);
+		};
+
+		std::sort(white.begin(), white.end(), byOrder);
+		std::sort(black.begin(), black.end(), byOrder);
+
+		return "K" + white + "K" + black;
+	}
+}
+
+EndgameTable::EndgameTable(const std::string& name)
+	: mName(),
+	  mPieces(),
+	  mHasPawns(false),
+	  mSize(0)
+{
+	const size_t blackKing = name.find('K', 1);
+
+	if (name.empty()
+			|| name[0] != 'K'
+			|| blackKing == std::string::npos
+			|| name.size() > MaxPieces
+			|| name.find_first_not_of(::PieceLetters, 1) != blackKing
+			|| name.find_first_not_of(::PieceLetters, blackKing + 1) != std::string::npos)
+	{
+		throw std::invalid_argument("Invalid or unsupported ending: " + name);
+	}
+
+	const std::string white = name.substr(1, blackKing - 1);
+	const std::string black = name.substr(blackKing + 1);
+
+	if (white.find('P') != std::string::npos && black.find('P') != std::string::npos)
+	{
+		throw std::invalid_argument(
+				"Endings with pawns of both colors are not supported: " + name);
+	}
+
+	mName = ::endingName(white, black);
+
+	for (size_t i = 1; i < mName.size(); ++i)
+	{
+		if (i == white.size() + 1)
+		{
+			// The black king
+			continue;
+		}
+
+		const Color color = (i <= white.size()) ? Color::White : Color::Black;
+		const PieceType type = ::PieceTypes[::PieceLetters.find(mName[i])];
+
+		mPieces.push_back(pieceCode(type, color));
+		mHasPawns = mHasPawns || type == PieceType::Pawn;
+	}
+
+	mSize = 2 * (mHasPawns ? 32 : 10) * 64;
+
+	for (size_t i = 0; i < mPieces.size(); ++i)
+	{
+		mSize *= 64;
+	}
+}
+
+std::string EndgameTable::nameOf(const Position& position, const bool swapColors)
+{
+	std::string sides[2];
+
+	for (const Color color : {Color::White, Color::Black})
+	{
+		std::string& side = sides[(color == Color::White) != swapColors ? 0 : 1];
+
+		for (size_t i = 0; i < ::PieceLetters.size(); ++i)
+		{
+			side.append(
+					static_cast<size_t>(popCount(position.pieces(color, ::PieceTypes[i]))),
+					::PieceLetters[i]);
+		}
+	}
+
+	return "K" + sides[0] + "K" + sides[1];
+}
+
+std::vector<std::string> EndgameTable::successors() const
+{
+	const size_t blackKing = mName.find('K', 1);
+	const std::string white = mName.substr(1, blackKing - 1);
+	const std::string black = mName.substr(blackKing + 1);
+
+	std::vector<std::string> result;
+
+	const auto add = [&result](const std::string& whitePieces, const std::string& blackPieces)
+	{
+		if (whitePieces.empty() && blackPieces.empty())
+		{
+			return;
+		}
+
+		const std::string name = ::endingName(whitePieces, blackPieces);
+
+		if (std::find(result.begin(), result.end(), name) == result.end())
+		{
+			result.push_back(name);
+		}
+	};
+
+	for (const bool isWhite : {true, false})
+	{
+		const std::string& side = isWhite ? white : black;
+
+		for (size_t i = 0; i < side.size(); ++i)
+		{
+			std::string changed = side;
+			changed.erase(i, 1);
+
+			// Captures
+			if (isWhite)
+			{
+				add(changed, black);
+			}
+			else
+			{
+				add(white, changed);
+			}
+
+			if (side[i] != 'P')
+			{
+				continue;
+			}
+
+			// Promotions
+			for (const char promotion : {'Q', 'R', 'B', 'N'})
+			{
+				if (isWhite)
+				{
+					add(changed + promotion, black);
+				}
+				else
+				{
+					add(white, changed + promotion);
+				}
+			}
+		}
+	}
+
+	return result;
+}
+
+void EndgameTable::squaresOf(const Position& position, uint8_t (&squares)[MaxPieces]) const
+{
+	squares[0] = position.kingSquare(Color::White);
+	squares[1] = position.kingSquare(Color::Black);
+
+	for (size_t i = 0; i < mPieces.size(); ++i)
+	{
+		Bitboard pieces = position.pieces(colorOf(mPieces[i]), pieceTypeOf(mPieces[i]));
+
+		// Identical pieces take their squares in increasing order
+		for (size_t j = 0; j < i; ++j)
+		{
+			if (mPieces[j] == mPieces[i])
+			{
+				popLsb(pieces);
+			}
+		}
+
+		squares[i + 2] = lsb(pieces);
+	}
+}
+
+size_t EndgameTable::rawIndex(const uint8_t (&squares)[MaxPieces], const Color activeColor) const
+{
+	size_t result = (activeColor == Color::White) ? 0 : 1;
+
+	result = mHasPawns
+		? result * 32 + rankOf(squares[0]) * 4 + fileOf(squares[0])
+		: result * 10 + ::TriangleIndices[squares[0]];
+
+	for (size_t i = 1; i < mPieces.size() + 2; ++i)
+	{
+		result = result * 64 + squares[i];
+	}
+
+	return result;
+}
+
+size_t EndgameTable::index(const Position& position) const
+{
+	size_t result[4];
+	indices(position, result);
+	return result[0];
+}
+
+size_t EndgameTable::indices(const Position& position, size_t (&result)[4]) const
+{
+	const size_t count = mPieces.size() + 2;
+	uint8_t squares[MaxPieces];
+	squaresOf(position, squares);
+
+	if (fileOf(squares[0]) > 3)
+	{
+		::transform(squares, count, ::flipFile);
+	}
+
+	if (!mHasPawns && rankOf(squares[0]) > 3)
+	{
+		::transform(squares, count, ::flipRank);
+	}
+
+	if (!mHasPawns && rankOf(squares[0]) > fileOf(squares[0]))
+	{
+		::transform(squares, count, ::flipDiagonal);
+	}
+
+	size_t found = 0;
+	result[found++] = rawIndex(squares, position.activeColor());
+
+	const bool identicalPieces = mPieces.size() == 2 && mPieces[0] == mPieces[1];
+
+	if (identicalPieces)
+	{
+		std::swap(squares[2], squares[3]);
+		result[found++] = rawIndex(squares, position.activeColor());
+		std::swap(squares[2], squares[3]);
+	}
+
+	if (!mHasPawns && rankOf(squares[0]) == fileOf(squares[0]))
+	{
+		::transform(squares, count, ::flipDiagonal);
+		result[found++] = rawIndex(squares, position.activeColor());
+
+		if (identicalPieces)
+		{
+			std::swap(squares[2], squares[3]);
+			result[found++] = rawIndex(squares, position.activeColor());
+		}
+	}
+
+	return found;
+}
+
+bool EndgameTable::decode(size_t index, uint8_t (&squares)[64], Color& activeColor) const
+{
+	uint8_t pieceSquares[MaxPieces];
+	const size_t count = mPieces.size() + 2;
+
+	for (size_t i = count - 1; i > 0; --i)
+	{
+		pieceSquares[i] = static_cast<uint8_t>(index % 64);
+		index /= 64;
+	}
+
+	const size_t kings = mHasPawns ? 32 : 10;
+	const uint8_t king = static_cast<uint8_t>(index % kings);
+	index /= kings;
+
+	if (mHasPawns)
+	{
+		pieceSquares[0] = static_cast<uint8_t>((king / 4) * 8 + king % 4);
+	}
+	else
+	{
+		pieceSquares[0] = static_cast<uint8_t>(
+				std::find(::TriangleIndices.begin(), ::TriangleIndices.end(), king)
+					- ::TriangleIndices.begin());
+	}
+
+	activeColor = (index == 0) ? Color::White : Color::Black;
+
+	Bitboard occupied = 0;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (occupied & bit(pieceSquares[i]))
+		{
+			return false;
+		}
+
+		occupied |= bit(pieceSquares[i]);
+	}
+
+	for (size_t i = 0; i < mPieces.size(); ++i)
+	{
+		if (pieceTypeOf(mPieces[i]) == PieceType::Pawn
+				&& (rankOf(pieceSquares[i + 2]) == 0 || rankOf(pieceSquares[i + 2]) == 7))
+		{
+			return false;
+		}
+	}
+
+	squares[pieceSquares[0]] = pieceCode(PieceType::King, Color::White);
+	squares[pieceSquares[1]] = pieceCode(PieceType::King, Color::Black);
+
+	for (size_t i = 0; i < mPieces.size(); ++i)
+	{
+		squares[pieceSquares[i + 2]] = mPieces[i];
+	}
+
+	return true;
+}
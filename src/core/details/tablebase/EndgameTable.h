@@ -0,0 +1,125 @@
+#ifndef ENDGAME_TABLE_H_6A0E3F95_B24C_4D71_8E3A_F51C7D09B26E
+#define ENDGAME_TABLE_H_6A0E3F95_B24C_4D71_8E3A_F51C7D09B26E
+
+#include "../bitboard/Position.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace simplechess
+{
+	namespace details
+	{
+		/**
+		 * \brief The positions of an ending with a given material, and
+		 * how they are laid out in a table.
+		 *
+		 * An ending is named after the pieces of white and then black,
+		 * each starting with its king, e.g. \c KRK or \c KQKP. Each
+		 * position has an index made of the color to move, the white
+		 * king, the black king and every other piece in the order of the
+		 * name. Symmetric positions share an index: the white king is
+		 * always on files a to d and, without pawns, on the a1-d1-d4
+		 * triangle.
+		 *
+		 * A position may still have several indices (when the white king
+		 * stands on the long diagonal, or when a side has two identical
+		 * pieces); \ref indices() lists them all.
+		 */
+		class EndgameTable
+		{
+			public:
+				/**
+				 * \brief Maximum number of pieces, kings included.
+				 */
+				static constexpr size_t MaxPieces = 4;
+
+				/**
+				 * \brief Constructor.
+				 *
+				 * \throws std::invalid_argument if \p name is not a valid
+				 * ending, has more than \ref MaxPieces pieces or has pawns
+				 * of both colors (en passant is not supported).
+				 */
+				explicit EndgameTable(const std::string& name);
+
+				/**
+				 * \brief Returns the name of the ending of \p position,
+				 * with the colors swapped if \p swapColors.
+				 */
+				static std::string nameOf(const Position& position, bool swapColors);
+
+				/**
+				 * \brief The normalized name of the ending.
+				 */
+				const std::string& name() const
+				{
+					return mName;
+				}
+
+				/**
+				 * \brief Number of indices of the table.
+				 */
+				size_t size() const
+				{
+					return mSize;
+				}
+
+				/**
+				 * \brief Endings which can be reached from this one by a
+				 * capture or a promotion, other than bare kings.
+				 */
+				std::vector<std::string> successors() const;
+
+				/**
+				 * \brief Returns the index of \p position, which must
+				 * have exactly the material of the ending.
+				 */
+				size_t index(const Position& position) const;
+
+				/**
+				 * \brief Stores every index of \p position (which must
+				 * have exactly the material of the ending) in \p result,
+				 * and returns how many there are.
+				 */
+				size_t indices(const Position& position, size_t (&result)[4]) const;
+
+				/**
+				 * \brief Places the pieces of the position with index \p
+				 * index on \p squares, which must be empty.
+				 *
+				 * \return Whether \p index describes a position with no
+				 * two pieces on the same square and no pawn on the first
+				 * or last rank. It may still be illegal.
+				 */
+				bool decode(size_t index, uint8_t (&squares)[64], Color& activeColor) const;
+
+			private:
+				/**
+				 * Squares of the white king, the black king and the rest
+				 * of the pieces of \p position, in the order of the index.
+				 */
+				void squaresOf(const Position& position, uint8_t (&squares)[MaxPieces]) const;
+
+				/**
+				 * Index of the pieces on \p squares, which must already
+				 * be in their symmetric form.
+				 */
+				size_t rawIndex(const uint8_t (&squares)[MaxPieces], Color activeColor) const;
+
+				std::string mName;
+
+				/**
+				 * Piece codes of the pieces other than the kings.
+				 */
+				std::vector<uint8_t> mPieces;
+
+				bool mHasPawns;
+				size_t mSize;
+		};
+	}
+}
+
+#endif
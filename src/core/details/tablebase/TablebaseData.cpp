@@ -0,0 +1,233 @@
+#include "TablebaseData.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+using namespace simplechess;
+using namespace simplechess::details;
+
+namespace
+{
+	/**
+	 * A tablebase file starts with a header (magic, version and number of
+	 * tables), followed by one directory entry per table (name, offset
+	 * and size) and the values of the tables. Numbers are little-endian.
+	 */
+	const char Magic[4] = {'S', 'C', 'T', 'B'};
+	constexpr uint32_t Version = 1;
+	constexpr size_t HeaderSize = 16;
+	constexpr size_t NameSize = 8;
+	constexpr size_t EntrySize = NameSize + 16;
+
+	/**
+	 * Tables start at multiples of this, so that they are aligned to cache
+	 * lines when mapped.
+	 */
+	constexpr size_t Alignment = 64;
+
+	void writeNumber(std::vector<char>& output, const uint64_t value, const size_t bytes)
+	{
+		for (size_t i = 0; i < bytes; ++i)
+		{
+			output.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+		}
+	}
+
+	uint64_t readNumber(const char* data, const size_t bytes)
+	{
+		uint64_t value = 0;
+
+		for (size_t i = 0; i < bytes; ++i)
+		{
+			value |= static_cast<uint64_t>(static_cast<uint8_t>(data[i])) << (8 * i);
+		}
+
+		return value;
+	}
+
+	void throwMalformed()
+	{
+		throw std::invalid_argument("Malformed tablebase file");
+	}
+}
+
+TablebaseData::TablebaseData()
+	: mTables(),
+	  mGenerated(),
+	  mFile()
+{
+}
+
+TablebaseData::TablebaseData(const std::string& path)
+	: mTables(),
+	  mGenerated(),
+	  mFile(std::make_unique<MappedFile>(path))
+{
+	const char* data = mFile->data();
+	const size_t size = mFile->size();
+
+	if (size < ::HeaderSize
+			|| std::memcmp(data, ::Magic, sizeof(::Magic)) != 0
+			|| ::readNumber(data + 4, 4) != ::Version)
+	{
+		::throwMalformed();
+	}
+
+	const uint64_t count = ::readNumber(data + 8, 4);
+
+	if (count > (size - ::HeaderSize) / ::EntrySize)
+	{
+		::throwMalformed();
+	}
+
+	for (uint64_t i = 0; i < count; ++i)
+	{
+		const char* entry = data + ::HeaderSize + i * ::EntrySize;
+		const std::string name(entry, std::find(entry, entry + ::NameSize, '\0'));
+		const uint64_t offset = ::readNumber(entry + ::NameSize, 8);
+		const uint64_t length = ::readNumber(entry + ::NameSize + 8, 8);
+
+		const EndgameTable ending(name);
+
+		if (ending.name() != name
+				|| length != ending.size()
+				|| offset > size
+				|| length > size - offset
+				|| mTables.count(name) != 0)
+		{
+			::throwMalformed();
+		}
+
+		mTables.emplace(
+				name,
+				Table{ending, reinterpret_cast<const uint8_t*>(data + offset)});
+	}
+}
+
+void TablebaseData::add(const EndgameTable& ending, std::vector<uint8_t> values)
+{
+	mGenerated.push_back(std::move(values));
+	mTables.erase(ending.name());
+	mTables.emplace(ending.name(), Table{ending, mGenerated.back().data()});
+}
+
+bool TablebaseData::contains(const std::string& name) const
+{
+	return mTables.count(name) != 0;
+}
+
+std::vector<std::string> TablebaseData::endings() const
+{
+	std::vector<std::string> result;
+
+	for (const auto& entry : mTables)
+	{
+		result.push_back(entry.first);
+	}
+
+	return result;
+}
+
+std::optional<uint8_t> TablebaseData::probe(const Position& position) const
+{
+	if (position.castlingRights() != 0
+			|| static_cast<size_t>(popCount(position.occupied())) > EndgameTable::MaxPieces)
+	{
+		return std::nullopt;
+	}
+
+	if (popCount(position.occupied()) == 2)
+	{
+		return tablebase::Draw;
+	}
+
+	auto it = mTables.find(EndgameTable::nameOf(position, false));
+
+	if (it != mTables.end())
+	{
+		return it->second.values[it->second.ending.index(position)];
+	}
+
+	it = mTables.find(EndgameTable::nameOf(position, true));
+
+	if (it == mTables.end())
+	{
+		return std::nullopt;
+	}
+
+	// The same position with the colors swapped
+	uint8_t squares[64] = {};
+
+	for (Bitboard occupied = position.occupied(); occupied != 0;)
+	{
+		const uint8_t square = popLsb(occupied);
+		const uint8_t code = position.pieceCodeAt(square);
+
+		squares[square ^ 56] = pieceCode(pieceTypeOf(code), oppositeColor(colorOf(code)));
+	}
+
+	const Position swapped = Position::fromMailbox(
+			squares,
+			oppositeColor(position.activeColor()),
+			0,
+			std::nullopt,
+			position.halfmoveClock(),
+			position.fullmoveCounter());
+
+	return it->second.values[it->second.ending.index(swapped)];
+}
+
+void TablebaseData::save(const std::string& path) const
+{
+	std::vector<char> header(::Magic, ::Magic + sizeof(::Magic));
+	::writeNumber(header, ::Version, 4);
+	::writeNumber(header, mTables.size(), 4);
+	::writeNumber(header, 0, 4);
+
+	size_t offset = ::HeaderSize + mTables.size() * ::EntrySize;
+
+	for (const auto& entry : mTables)
+	{
+		offset = (offset + ::Alignment - 1) / ::Alignment * ::Alignment;
+
+		std::string name = entry.first;
+		name.resize(::NameSize, '\0');
+		header.insert(header.end(), name.begin(), name.end());
+		::writeNumber(header, offset, 8);
+		::writeNumber(header, entry.second.ending.size(), 8);
+
+		offset += entry.second.ending.size();
+	}
+
+	std::ofstream output(path, std::ios::binary | std::ios::trunc);
+	output.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+	size_t written = header.size();
+
+	for (const auto& entry : mTables)
+	{
+		const size_t padding = (::Alignment - written % ::Alignment) % ::Alignment;
+		const char zeros[::Alignment] = {};
+		output.write(zeros, static_cast<std::streamsize>(padding));
+
+		output.write(
+				reinterpret_cast<const char*>(entry.second.values),
+				static_cast<std::streamsize>(entry.second.ending.size()));
+
+		written += padding + entry.second.ending.size();
+	}
+
+	output.flush();
+
+	if (!output)
+	{
+		throw std::system_error(
+				errno != 0 ? errno : EIO,
+				std::generic_category(),
+				"Cannot write tablebase file " + path);
+	}
+}
@@ -0,0 +1,119 @@
+#ifndef TABLEBASE_DATA_H_0D7B4E62_93A1_4C5F_B6E8_2F19C4A7D530
+#define TABLEBASE_DATA_H_0D7B4E62_93A1_4C5F_B6E8_2F19C4A7D530
+
+#include "EndgameTable.h"
+
+#include "../MappedFile.h"
+#include "../bitboard/Position.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace simplechess
+{
+	namespace details
+	{
+		/**
+		 * \brief Values stored in an endgame table, from the point of
+		 * view of the color to move.
+		 *
+		 * 0 is a draw; any other value is the number of plies to mate
+		 * plus one, so odd values are losses (1 means checkmated) and
+		 * even values are wins.
+		 */
+		namespace tablebase
+		{
+			constexpr uint8_t Draw = 0;
+
+			constexpr bool isWin(const uint8_t value)
+			{
+				return value != 0 && value % 2 == 0;
+			}
+
+			constexpr bool isLoss(const uint8_t value)
+			{
+				return value % 2 == 1;
+			}
+		}
+
+		/**
+		 * \brief A set of endgame tables, either generated in memory or
+		 * mapped from a file.
+		 */
+		class TablebaseData
+		{
+			public:
+				TablebaseData();
+
+				/**
+				 * \brief Maps the tables saved in the file at \p path.
+				 *
+				 * \throws std::system_error if the file cannot be mapped.
+				 * \throws std::invalid_argument if it is not a tablebase
+				 * file.
+				 */
+				explicit TablebaseData(const std::string& path);
+
+				TablebaseData(const TablebaseData&) = delete;
+				TablebaseData& operator=(const TablebaseData&) = delete;
+
+				/**
+				 * \brief Adds the table of \p ending.
+				 */
+				void add(const EndgameTable& ending, std::vector<uint8_t> values);
+
+				/**
+				 * \brief Whether there is a table for \p name.
+				 */
+				bool contains(const std::string& name) const;
+
+				/**
+				 * \brief Names of the endings of every table.
+				 */
+				std::vector<std::string> endings() const;
+
+				/**
+				 * \brief Returns the value of \p position (see \ref
+				 * tablebase), or nothing if no table covers it.
+				 *
+				 * Bare kings are always a draw. Positions with castling
+				 * rights are not covered.
+				 */
+				std::optional<uint8_t> probe(const Position& position) const;
+
+				/**
+				 * \brief Writes every table to the file at \p path, in
+				 * the format read by \ref TablebaseData(const
+				 * std::string&).
+				 *
+				 * \throws std::system_error if the file cannot be written.
+				 */
+				void save(const std::string& path) const;
+
+			private:
+				struct Table
+				{
+					EndgameTable ending;
+					const uint8_t* values;
+				};
+
+				std::map<std::string, Table> mTables;
+
+				/**
+				 * Storage of the tables generated in memory.
+				 */
+				std::vector<std::vector<uint8_t>> mGenerated;
+
+				/**
+				 * Storage of the tables mapped from a file.
+				 */
+				std::unique_ptr<MappedFile> mFile;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,458 @@
+#include "TablebaseGenerator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+
+using namespace simplechess;
+using namespace simplechess::details;
+
+namespace
+{
+	/**
+	 * Number of indices or positions handled by each task.
+	 */
+	constexpr size_t ChunkSize = 1 << 12;
+
+	constexpr unsigned MaxValue = 255;
+
+	bool leavesEnding(const Position& position, const Move& move)
+	{
+		return move.promotion != PieceType::Pawn
+			|| position.pieceCodeAt(move.dst) != NoPiece
+			|| (pieceTypeOf(position.pieceCodeAt(move.src)) == PieceType::Pawn
+				&& fileOf(move.src) != fileOf(move.dst));
+	}
+
+	/**
+	 * Squares from which a piece of code \p code may have moved to \p
+	 * square without capturing.
+	 */
+	Bitboard origins(const uint8_t code, const uint8_t square, const Bitboard occupied)
+	{
+		switch (pieceTypeOf(code))
+		{
+			case PieceType::King:
+				return kingAttacks(square) & ~occupied;
+			case PieceType::Knight:
+				return knightAttacks(square) & ~occupied;
+			case PieceType::Bishop:
+				return bishopAttacks(square, occupied) & ~occupied;
+			case PieceType::Rook:
+				return rookAttacks(square, occupied) & ~occupied;
+			case PieceType::Queen:
+				return queenAttacks(square, occupied) & ~occupied;
+			case PieceType::Pawn:
+				break;
+		}
+
+		const bool white = colorOf(code) == Color::White;
+		const uint8_t rank = rankOf(square);
+		const int step = white ? -8 : 8;
+
+		// A pawn never stands on its first rank
+		if ((white && rank < 2) || (!white && rank > 5))
+		{
+			return 0;
+		}
+
+		const uint8_t single = static_cast<uint8_t>(square + step);
+
+		if (occupied & bit(single))
+		{
+			return 0;
+		}
+
+		Bitboard result = bit(single);
+		const uint8_t doubleRank = white ? 3 : 4;
+		const uint8_t twice = static_cast<uint8_t>(square + 2 * step);
+
+		if (rank == doubleRank && !(occupied & bit(twice)))
+		{
+			result |= bit(twice);
+		}
+
+		return result;
+	}
+
+	class Generation
+	{
+		public:
+			Generation(
+					const EndgameTable& ending,
+					const TablebaseData& successors,
+					const WorkStealingPool& pool)
+				: mEnding(ending),
+				  mSuccessors(successors),
+				  mPool(pool),
+				  mValues(new std::atomic<uint8_t>[ending.size()]),
+				  mBuckets(MaxValue + 1),
+				  mBucketsMutex()
+			{
+				for (size_t i = 0; i < ending.size(); ++i)
+				{
+					mValues[i].store(tablebase::Draw, std::memory_order_relaxed);
+				}
+			}
+
+			std::vector<uint8_t> run()
+			{
+				forEachChunk(
+						mEnding.size(),
+						[this](const size_t index, std::vector<size_t>&)
+						{
+							initialize(index);
+						});
+
+				std::vector<size_t> frontier;
+
+				for (unsigned value = 1; value <= MaxValue; ++value)
+				{
+					for (const size_t index : mBuckets[value])
+					{
+						if (finalize(*decode(index), static_cast<uint8_t>(value)))
+						{
+							frontier.push_back(index);
+						}
+					}
+
+					mBuckets[value].clear();
+
+					const bool pending = std::any_of(
+							mBuckets.begin() + value,
+							mBuckets.end(),
+							[](const std::vector<size_t>& bucket)
+							{
+								return !bucket.empty();
+							});
+
+					if (frontier.empty() && !pending)
+					{
+						break;
+					}
+
+					if (value == MaxValue && !frontier.empty())
+					{
+						throw std::logic_error("Distance to mate too long for an endgame table");
+					}
+
+					std::vector<size_t> next;
+
+					forEachChunk(
+							frontier.size(),
+							[this, &frontier, value](const size_t i, std::vector<size_t>& solved)
+							{
+								propagate(frontier[i], static_cast<uint8_t>(value), solved);
+							},
+							&next);
+
+					frontier = std::move(next);
+				}
+
+				std::vector<uint8_t> result(mEnding.size());
+
+				for (size_t i = 0; i < result.size(); ++i)
+				{
+					result[i] = mValues[i].load(std::memory_order_relaxed);
+				}
+
+				return result;
+			}
+
+		private:
+			/**
+			 * What the moves of a position tell about its value.
+			 */
+			struct Resolution
+			{
+				/**
+				 * The value of the best win known, or 0.
+				 */
+				uint8_t win;
+
+				/**
+				 * The value of the position if every move is known to
+				 * lose, or 0.
+				 */
+				uint8_t loss;
+			};
+
+			/**
+			 * Calls \p task for every index in [0, \p count) in
+			 * parallel, and collects the indices it outputs into \p
+			 * output.
+			 */
+			template <typename Task>
+			void forEachChunk(const size_t count, Task task, std::vector<size_t>* output = nullptr)
+			{
+				const size_t chunks = (count + ::ChunkSize - 1) / ::ChunkSize;
+				std::vector<std::vector<size_t>> outputs(chunks);
+
+				mPool.run(
+						chunks,
+						[&task, &outputs, count](const size_t chunk)
+						{
+							const size_t end = std::min(count, (chunk + 1) * ::ChunkSize);
+
+							for (size_t i = chunk * ::ChunkSize; i < end; ++i)
+							{
+								task(i, outputs[chunk]);
+							}
+						});
+
+				if (output)
+				{
+					for (const std::vector<size_t>& chunkOutput : outputs)
+					{
+						output->insert(output->end(), chunkOutput.begin(), chunkOutput.end());
+					}
+				}
+			}
+
+			/**
+			 * Returns the position with index \p index, if it is legal.
+			 */
+			std::optional<Position> decode(const size_t index) const
+			{
+				uint8_t squares[64] = {};
+				Color activeColor;
+
+				if (!mEnding.decode(index, squares, activeColor))
+				{
+					return std::nullopt;
+				}
+
+				const Position position = Position::fromMailbox(
+						squares, activeColor, 0, std::nullopt, 0, 1);
+
+				// The player who has just moved cannot be in check
+				if (position.isAttacked(position.kingSquare(oppositeColor(activeColor)), activeColor))
+				{
+					return std::nullopt;
+				}
+
+				return position;
+			}
+
+			uint8_t valueOf(const Position& position, const Move& move) const
+			{
+				Position next = position;
+				next.makeMove(move);
+
+				if (!::leavesEnding(position, move))
+				{
+					return mValues[mEnding.index(next)].load(std::memory_order_relaxed);
+				}
+
+				const std::optional<uint8_t> value = mSuccessors.probe(next);
+
+				if (!value)
+				{
+					throw std::logic_error("Missing table of " + EndgameTable::nameOf(next, false));
+				}
+
+				return *value;
+			}
+
+			Resolution resolve(const Position& position) const
+			{
+				MoveList moves;
+				position.legalMoves(moves);
+
+				if (moves.size == 0)
+				{
+					// Checkmate, or stalemate (a draw)
+					return {0, static_cast<uint8_t>(position.inCheck() ? 1 : 0)};
+				}
+
+				unsigned bestLoss = MaxValue + 1;
+				unsigned worstWin = 0;
+				bool allWins = true;
+
+				for (const Move& move : moves)
+				{
+					const uint8_t value = valueOf(position, move);
+
+					if (tablebase::isWin(value))
+					{
+						worstWin = std::max<unsigned>(worstWin, value);
+					}
+					else
+					{
+						allWins = false;
+
+						if (tablebase::isLoss(value))
+						{
+							bestLoss = std::min<unsigned>(bestLoss, value);
+						}
+					}
+				}
+
+				if (bestLoss < MaxValue)
+				{
+					return {static_cast<uint8_t>(bestLoss + 1), 0};
+				}
+
+				return {0, static_cast<uint8_t>((allWins && worstWin < MaxValue) ? worstWin + 1 : 0)};
+			}
+
+			void schedule(const size_t index, const uint8_t value)
+			{
+				const std::lock_guard<std::mutex> lock(mBucketsMutex);
+				mBuckets[value].push_back(index);
+			}
+
+			/**
+			 * Sets the value of every index of \p position, and returns
+			 * whether it was not known yet.
+			 */
+			bool finalize(const Position& position, const uint8_t value)
+			{
+				size_t indices[4];
+				const size_t count = mEnding.indices(position, indices);
+				bool result = false;
+
+				for (size_t i = 0; i < count; ++i)
+				{
+					uint8_t expected = tablebase::Draw;
+					const bool changed = mValues[indices[i]].compare_exchange_strong(
+							expected, value, std::memory_order_relaxed);
+
+					result = result || (i == 0 && changed);
+				}
+
+				return result;
+			}
+
+			/**
+			 * Looks at the moves of the position with index \p index
+			 * before any other position is solved, so only checkmates
+			 * and the moves leaving the ending count.
+			 */
+			void initialize(const size_t index)
+			{
+				const std::optional<Position> position = decode(index);
+
+				if (!position)
+				{
+					return;
+				}
+
+				const Resolution resolution = resolve(*position);
+
+				if (resolution.win != 0)
+				{
+					schedule(index, resolution.win);
+				}
+				else if (resolution.loss != 0)
+				{
+					schedule(index, resolution.loss);
+				}
+			}
+
+			/**
+			 * Takes back every move which leads to the position with
+			 * index \p index, whose value \p value has just been found,
+			 * and outputs to \p solved the positions which are solved
+			 * with value \p value + 1.
+			 */
+			void propagate(const size_t index, const uint8_t value, std::vector<size_t>& solved)
+			{
+				const Position position = *decode(index);
+				const Color mover = oppositeColor(position.activeColor());
+				const Bitboard occupied = position.occupied();
+
+				uint8_t squares[64];
+
+				for (uint8_t square = 0; square < 64; ++square)
+				{
+					squares[square] = position.pieceCodeAt(square);
+				}
+
+				for (Bitboard pieces = position.pieces(mover); pieces != 0;)
+				{
+					const uint8_t square = popLsb(pieces);
+					const uint8_t code = squares[square];
+
+					for (Bitboard from = ::origins(code, square, occupied); from != 0;)
+					{
+						const uint8_t origin = popLsb(from);
+
+						squares[origin] = code;
+						squares[square] = NoPiece;
+
+						const Position previous = Position::fromMailbox(
+								squares, mover, 0, std::nullopt, 0, 1);
+
+						squares[square] = code;
+						squares[origin] = NoPiece;
+
+						if (previous.isAttacked(
+									previous.kingSquare(position.activeColor()),
+									mover))
+						{
+							continue;
+						}
+
+						const size_t previousIndex = mEnding.index(previous);
+
+						if (mValues[previousIndex].load(std::memory_order_relaxed) != tablebase::Draw)
+						{
+							continue;
+						}
+
+						const uint8_t next = static_cast<uint8_t>(value + 1);
+
+						if (tablebase::isLoss(value))
+						{
+							if (finalize(previous, next))
+							{
+								solved.push_back(previousIndex);
+							}
+
+							continue;
+						}
+
+						// Lost only once every move is known to lose
+						const uint8_t loss = resolve(previous).loss;
+
+						if (loss == next)
+						{
+							if (finalize(previous, next))
+							{
+								solved.push_back(previousIndex);
+							}
+						}
+						else if (loss > next)
+						{
+							schedule(previousIndex, loss);
+						}
+					}
+				}
+			}
+
+			const EndgameTable& mEnding;
+			const TablebaseData& mSuccessors;
+			const WorkStealingPool& mPool;
+
+			std::unique_ptr<std::atomic<uint8_t>[]> mValues;
+
+			/**
+			 * Indices whose value is known to be the index of the
+			 * bucket, but not before all the smaller values are found.
+			 */
+			std::vector<std::vector<size_t>> mBuckets;
+			std::mutex mBucketsMutex;
+	};
+}
+
+std::vector<uint8_t> TablebaseGenerator::generate(
+		const EndgameTable& ending,
+		const TablebaseData& successors,
+		const WorkStealingPool& pool)
+{
+	return ::Generation(ending, successors, pool).run();
+}
@@ -0,0 +1,52 @@
+#ifndef TABLEBASE_GENERATOR_H_F28C5A13_7E94_4B0D_A16F_8D3E0B52C947
+#define TABLEBASE_GENERATOR_H_F28C5A13_7E94_4B0D_A16F_8D3E0B52C947
+
+#include "EndgameTable.h"
+#include "TablebaseData.h"
+
+#include "../WorkStealingPool.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace simplechess
+{
+	namespace details
+	{
+		/**
+		 * \brief Retrograde analysis of endgame tables.
+		 */
+		class TablebaseGenerator
+		{
+			public:
+				/**
+				 * \brief Returns the values of every index of \p ending
+				 * (see \ref tablebase).
+				 *
+				 * Mates are found first; from then on, the positions
+				 * solved at each distance to mate are taken back one move
+				 * to find the positions solved at the next distance: a
+				 * move into a lost position wins, and a position where
+				 * every move leads to a won position for the opponent is
+				 * lost. Captures and promotions leave the ending, and are
+				 * looked up in \p successors, which must already hold the
+				 * tables of every ending in \ref
+				 * EndgameTable::successors().
+				 *
+				 * Indices which do not describe a legal position are
+				 * draws. The fifty-move rule is ignored.
+				 *
+				 * \param ending The ending to generate.
+				 * \param successors The tables of the endings reachable
+				 * from \p ending.
+				 * \param pool The threads to generate the table with.
+				 */
+				static std::vector<uint8_t> generate(
+						const EndgameTable& ending,
+						const TablebaseData& successors,
+						const WorkStealingPool& pool);
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,181 @@
+#include <cpp/simplechess/SimpleChess.h>
+
+#include "details/UciNotation.h"
+#include "details/bitboard/Perft.h"
+#include "details/bitboard/Position.h"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * Minimal front-end speaking the Universal Chess Interface on stdin/stdout.
+ *
+ * Supported commands: uci, isready, ucinewgame, position, d, go perft and
+ * quit. Any other command is ignored, as mandated by the protocol.
+ */
+
+using namespace simplechess;
+
+namespace
+{
+	const std::string StartingPosition
+		= "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+	/**
+	 * Handles "position [startpos | fen <fen>] [moves <move> ...]".
+	 */
+	Game parsePosition(std::istringstream& arguments)
+	{
+		std::string token;
+		arguments >> token;
+
+		std::string fen;
+
+		if (token == "startpos")
+		{
+			fen = StartingPosition;
+			arguments >> token;
+		}
+		else if (token == "fen")
+		{
+			while (arguments >> token && token != "moves")
+			{
+				fen += (fen.empty() ? "" : " ") + token;
+			}
+		}
+		else
+		{
+			throw std::invalid_argument("Expected startpos or fen");
+		}
+
+		std::vector<std::string> moves;
+
+		if (token == "moves")
+		{
+			while (arguments >> token)
+			{
+				moves.push_back(token);
+			}
+		}
+
+		return createGameFromUciMoves(fen, moves);
+	}
+
+	void display(const Game& game)
+	{
+		const GameStage& stage = game.currentStage();
+		const std::string separator = " +---+---+---+---+---+---+---+---+";
+
+		std::cout << "\n" << separator << "\n";
+
+		for (uint8_t rank = 8; rank >= 1; --rank)
+		{
+			for (char file = 'a'; file <= 'h'; ++file)
+			{
+				const std::optional<Piece> piece
+					= stage.board().pieceAt(Square::fromRankAndFile(rank, file));
+
+				char symbol = ' ';
+				if (piece)
+				{
+					const char letters[] = {'p', 'r', 'n', 'b', 'q', 'k'};
+					symbol = letters[static_cast<int>(piece->type())];
+					if (piece->color() == Color::White)
+					{
+						symbol = static_cast<char>(symbol - 'a' + 'A');
+					}
+				}
+
+				std::cout << " | " << symbol;
+			}
+
+			std::cout << " | " << static_cast<int>(rank) << "\n" << separator << "\n";
+		}
+
+		std::cout << "   a   b   c   d   e   f   g   h\n\n"
+			<< "Fen: " << stage.fen() << "\n" << std::endl;
+	}
+
+	void perft(const Game& game, const unsigned depth)
+	{
+		const details::Position position
+			= details::Position::fromStage(game.currentStage());
+
+		uint64_t nodes = 0;
+
+		if (depth > 0)
+		{
+			for (const auto& [move, count] : details::Perft::divide(position, depth))
+			{
+				std::cout << details::UciNotation::toString(move) << ": " << count << "\n";
+				nodes += count;
+			}
+		}
+		else
+		{
+			nodes = 1;
+		}
+
+		std::cout << "\nNodes searched: " << nodes << "\n" << std::endl;
+	}
+}
+
+int main()
+{
+	Game game = createNewGame();
+	std::string line;
+
+	while (std::getline(std::cin, line))
+	{
+		std::istringstream arguments(line);
+		std::string command;
+		arguments >> command;
+
+		try
+		{
+			if (command == "uci")
+			{
+				std::cout << "id name simple-chess-games\n"
+					<< "uciok" << std::endl;
+			}
+			else if (command == "isready")
+			{
+				std::cout << "readyok" << std::endl;
+			}
+			else if (command == "ucinewgame")
+			{
+				game = createNewGame();
+			}
+			else if (command == "position")
+			{
+				game = ::parsePosition(arguments);
+			}
+			else if (command == "d")
+			{
+				::display(game);
+			}
+			else if (command == "go")
+			{
+				std::string mode;
+				unsigned depth = 0;
+
+				if (arguments >> mode >> depth && mode == "perft")
+				{
+					::perft(game, depth);
+				}
+			}
+			else if (command == "quit")
+			{
+				break;
+			}
+		}
+		catch (const std::exception& e)
+		{
+			std::cout << "info string " << e.what() << std::endl;
+		}
+	}
+
+	return 0;
+}
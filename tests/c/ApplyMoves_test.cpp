@@ -0,0 +1,179 @@
+#include "TestUtils.h"
+
+#include <vector>
+
+namespace {
+    game_t* make_moves_one_by_one(const game_t* game, const std::vector<piece_move_t>& moves) {
+        game_t* current = simple_chess_apply_moves(game, nullptr, 0, nullptr);
+
+        for (const piece_move_t& move : moves) {
+            game_t* next = simple_chess_make_move(current, move);
+            destroy_game(current);
+            current = next;
+
+            if (!current) break;
+        }
+
+        return current;
+    }
+
+    void expect_same_game(const game_t* actual, const game_t* expected) {
+        EXPECT_EQ(actual->state, expected->state);
+        EXPECT_EQ(actual->is_draw_claimable, expected->is_draw_claimable);
+        EXPECT_STREQ(actual->current_stage.fen, expected->current_stage.fen);
+        EXPECT_EQ(actual->available_move_count, expected->available_move_count);
+
+        ASSERT_EQ(actual->history_size, expected->history_size);
+        for (uint16_t i = 0; i < expected->history_size; ++i) {
+            EXPECT_STREQ(actual->history[i].fen, expected->history[i].fen);
+            EXPECT_STREQ(
+                    actual->history[i].played_move.in_algebraic_notation,
+                    expected->history[i].played_move.in_algebraic_notation);
+            EXPECT_EQ(actual->history[i].played_move.check_type, expected->history[i].played_move.check_type);
+        }
+    }
+}
+
+TEST(CApplyMovesTest, MatchesMakingMovesOneByOne) {
+    game_t* game = simple_chess_create_new_game();
+    ASSERT_GAME_NOT_NULL(game);
+
+    const std::vector<piece_move_t> moves = {
+        create_move(PieceTypePawn, ColorWhite, 2, 'e', 4, 'e'),
+        create_move(PieceTypePawn, ColorBlack, 7, 'd', 5, 'd'),
+        create_move(PieceTypePawn, ColorWhite, 4, 'e', 5, 'd'),
+        create_move(PieceTypeQueen, ColorBlack, 8, 'd', 5, 'd'),
+        create_move(PieceTypeKnight, ColorWhite, 1, 'b', 3, 'c'),
+        create_move(PieceTypeQueen, ColorBlack, 5, 'd', 5, 'e'),
+    };
+
+    size_t failed_index = 42;
+    game_t* batch = simple_chess_apply_moves(game, moves.data(), moves.size(), &failed_index);
+    game_t* expected = make_moves_one_by_one(game, moves);
+    ASSERT_GAME_NOT_NULL(batch);
+    ASSERT_GAME_NOT_NULL(expected);
+
+    EXPECT_EQ(failed_index, 42u);
+    expect_same_game(batch, expected);
+    EXPECT_EQ(batch->current_stage.check_status, CheckTypeCheck);
+    EXPECT_LAST_MOVE_NOTATION(batch, "Qe5+");
+
+    game_t* uci = simple_chess_apply_uci_moves(game, "  e2e4 d7d5\te4d5 d8d5\n b1c3 d5e5 ", &failed_index);
+    ASSERT_GAME_NOT_NULL(uci);
+    expect_same_game(uci, expected);
+
+    // The moves are appended to the existing history
+    game_t* more = simple_chess_apply_uci_moves(batch, "g1e2 e5e4", nullptr);
+    ASSERT_GAME_NOT_NULL(more);
+    EXPECT_EQ(more->history_size, 8);
+    EXPECT_STREQ(more->history[5].played_move.in_algebraic_notation, "Qe5+");
+
+    destroy_game(more);
+    destroy_game(uci);
+    destroy_game(expected);
+    destroy_game(batch);
+    destroy_game(game);
+}
+
+TEST(CApplyMovesTest, EmptySequence) {
+    game_t* game = simple_chess_create_new_game();
+    ASSERT_GAME_NOT_NULL(game);
+
+    game_t* copy = simple_chess_apply_moves(game, nullptr, 0, nullptr);
+    ASSERT_GAME_NOT_NULL(copy);
+    EXPECT_NE(copy, game);
+    expect_same_game(copy, game);
+
+    game_t* uci = simple_chess_apply_uci_moves(game, " ", nullptr);
+    ASSERT_GAME_NOT_NULL(uci);
+    expect_same_game(uci, game);
+
+    destroy_game(uci);
+    destroy_game(copy);
+    destroy_game(game);
+}
+
+TEST(CApplyMovesTest, InvalidMovesReportTheirIndex) {
+    game_t* game = simple_chess_create_new_game();
+    ASSERT_GAME_NOT_NULL(game);
+
+    const std::vector<piece_move_t> moves = {
+        create_move(PieceTypePawn, ColorWhite, 2, 'e', 4, 'e'),
+        create_move(PieceTypePawn, ColorBlack, 7, 'e', 5, 'e'),
+        // Wrong piece type
+        create_move(PieceTypeBishop, ColorWhite, 1, 'g', 3, 'f'),
+    };
+
+    size_t failed_index = 0;
+    EXPECT_EQ(simple_chess_apply_moves(game, moves.data(), moves.size(), &failed_index), nullptr);
+    EXPECT_EQ(failed_index, 2u);
+
+    // Malformed moves are reported at their own index too
+    piece_move_t to_king = create_move(PieceTypePawn, ColorBlack, 7, 'e', 5, 'e');
+    to_king.is_promotion = true;
+    to_king.promoted_to = PieceTypeKing;
+    const std::vector<piece_move_t> unconvertible = {moves[0], to_king, moves[2]};
+    failed_index = 0;
+    EXPECT_EQ(simple_chess_apply_moves(game, unconvertible.data(), unconvertible.size(), &failed_index), nullptr);
+    EXPECT_EQ(failed_index, 1u);
+
+    EXPECT_EQ(simple_chess_apply_uci_moves(game, "e2e4 e7e5 e1e3", &failed_index), nullptr);
+    EXPECT_EQ(failed_index, 2u);
+
+    EXPECT_EQ(simple_chess_apply_uci_moves(game, "e2e4 e7e9", &failed_index), nullptr);
+    EXPECT_EQ(failed_index, 1u);
+
+    EXPECT_EQ(simple_chess_apply_moves(nullptr, moves.data(), moves.size(), &failed_index), nullptr);
+    EXPECT_EQ(simple_chess_apply_moves(game, nullptr, 1, &failed_index), nullptr);
+    EXPECT_EQ(simple_chess_apply_uci_moves(game, nullptr, &failed_index), nullptr);
+
+    destroy_game(game);
+}
+
+TEST(CApplyMovesTest, NoMovesAfterTheGameEnds) {
+    game_t* game = simple_chess_create_new_game();
+    ASSERT_GAME_NOT_NULL(game);
+
+    size_t failed_index = 0;
+
+    game_t* mated = simple_chess_apply_uci_moves(game, "f2f3 e7e5 g2g4 d8h4", &failed_index);
+    ASSERT_GAME_NOT_NULL(mated);
+    EXPECT_EQ(mated->state, GameStateBlackWon);
+
+    EXPECT_EQ(simple_chess_apply_uci_moves(game, "f2f3 e7e5 g2g4 d8h4 e1f2", &failed_index), nullptr);
+    EXPECT_EQ(failed_index, 4u);
+
+    EXPECT_EQ(simple_chess_apply_uci_moves(mated, "e1f2", &failed_index), nullptr);
+    EXPECT_EQ(failed_index, 0u);
+
+    // Fivefold repetition ends the game automatically, but not when draws
+    // have to be claimed
+    const char* repetitions =
+        "g1f3 g8f6 f3g1 f6g8 g1f3 g8f6 f3g1 f6g8 "
+        "g1f3 g8f6 f3g1 f6g8 g1f3 g8f6 f3g1 f6g8 e2e4";
+
+    EXPECT_EQ(simple_chess_apply_uci_moves(game, repetitions, &failed_index), nullptr);
+    EXPECT_EQ(failed_index, 16u);
+
+    game_t* claim_only = simple_chess_create_game_from_fen_ex(
+            "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", DrawEnforcementClaimOnly);
+    ASSERT_GAME_NOT_NULL(claim_only);
+
+    game_t* repeated = simple_chess_apply_uci_moves(claim_only, repetitions, &failed_index);
+    ASSERT_GAME_NOT_NULL(repeated);
+    EXPECT_EQ(repeated->state, GameStatePlaying);
+    EXPECT_EQ(repeated->history_size, 17);
+
+    // Insufficient material
+    game_t* endgame = simple_chess_create_game_from_fen("4k3/8/8/8/8/8/3r4/4K1N1 w - - 0 1");
+    ASSERT_GAME_NOT_NULL(endgame);
+
+    EXPECT_EQ(simple_chess_apply_uci_moves(endgame, "e1d2 e8e7", &failed_index), nullptr);
+    EXPECT_EQ(failed_index, 1u);
+
+    destroy_game(endgame);
+    destroy_game(repeated);
+    destroy_game(claim_only);
+    destroy_game(mated);
+    destroy_game(game);
+}
@@ -0,0 +1,140 @@
+#include "TestUtils.h"
+
+#include <cstring>
+
+TEST(CArenaTest, GamesAreLaidOutContiguously) {
+    sc_arena* arena = simple_chess_arena_create(0);
+    ASSERT_NE(arena, nullptr);
+
+    game_t* initial = simple_chess_arena_create_new_game(arena, DrawEnforcementAutomatic);
+    ASSERT_GAME_NOT_NULL(initial);
+    EXPECT_EQ(initial->arena, arena);
+
+    game_t* game = simple_chess_arena_apply_uci_moves(arena, initial, "e2e4 e7e5 g1f3", nullptr);
+    ASSERT_GAME_NOT_NULL(game);
+    EXPECT_EQ(game->arena, arena);
+    ASSERT_EQ(game->history_size, 3);
+
+    // The history follows the game, and the available moves follow the
+    // history, only separated by alignment padding
+    const char* game_end = reinterpret_cast<const char*>(game + 1);
+    const char* history = reinterpret_cast<const char*>(game->history);
+    const char* history_end = reinterpret_cast<const char*>(game->history + game->history_size);
+    const char* available_moves = reinterpret_cast<const char*>(game->available_moves);
+
+    EXPECT_GE(history, game_end);
+    EXPECT_LT(history - game_end, static_cast<ptrdiff_t>(alignof(game_history_entry_t)));
+    EXPECT_GE(available_moves, history_end);
+    EXPECT_LT(available_moves - history_end, static_cast<ptrdiff_t>(alignof(piece_move_t)));
+
+    simple_chess_arena_destroy(arena);
+}
+
+TEST(CArenaTest, GamesMatchHeapGames) {
+    sc_arena* arena = simple_chess_arena_create(0);
+    ASSERT_NE(arena, nullptr);
+
+    const char* fen = "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1";
+    game_t* heap = simple_chess_create_game_from_fen_ex(fen, DrawEnforcementClaimOnly);
+    game_t* pooled = simple_chess_arena_create_game_from_fen(arena, fen, DrawEnforcementClaimOnly);
+    ASSERT_GAME_NOT_NULL(heap);
+    ASSERT_GAME_NOT_NULL(pooled);
+    EXPECT_EQ(heap->arena, nullptr);
+
+    const piece_move_t castle = create_move(PieceTypeKing, ColorWhite, 1, 'e', 1, 'g');
+    game_t* heap_next = simple_chess_make_move(heap, castle);
+    game_t* pooled_next = simple_chess_arena_make_move(arena, pooled, castle, true);
+    ASSERT_GAME_NOT_NULL(heap_next);
+    ASSERT_GAME_NOT_NULL(pooled_next);
+
+    EXPECT_STREQ(pooled_next->current_stage.fen, heap_next->current_stage.fen);
+    EXPECT_EQ(pooled_next->available_move_count, heap_next->available_move_count);
+    EXPECT_EQ(pooled_next->draw_enforcement, DrawEnforcementClaimOnly);
+    ASSERT_EQ(pooled_next->history_size, 1);
+    EXPECT_STREQ(pooled_next->history[0].played_move.in_algebraic_notation, "O-O(=)");
+
+    // Copies from and to the heap
+    game_t* copy = simple_chess_arena_copy_game(arena, heap_next);
+    ASSERT_GAME_NOT_NULL(copy);
+    EXPECT_EQ(copy->arena, arena);
+    EXPECT_STREQ(copy->current_stage.fen, heap_next->current_stage.fen);
+
+    game_t* from_arena = simple_chess_make_move(
+            pooled_next, create_move(PieceTypeKing, ColorBlack, 8, 'e', 8, 'c'));
+    ASSERT_GAME_NOT_NULL(from_arena);
+    EXPECT_EQ(from_arena->arena, nullptr);
+
+    // Does nothing for games allocated from an arena
+    destroy_game(pooled_next);
+
+    destroy_game(from_arena);
+    destroy_game(heap_next);
+    destroy_game(heap);
+    simple_chess_arena_destroy(arena);
+}
+
+TEST(CArenaTest, ResetReusesMemory) {
+    sc_arena* arena = simple_chess_arena_create(4096);
+    ASSERT_NE(arena, nullptr);
+    EXPECT_EQ(simple_chess_arena_bytes_used(arena), 0u);
+
+    game_t* first = simple_chess_arena_create_new_game(arena, DrawEnforcementAutomatic);
+    ASSERT_GAME_NOT_NULL(first);
+
+    const size_t used = simple_chess_arena_bytes_used(arena);
+    EXPECT_GE(used, sizeof(game_t) + 20 * sizeof(piece_move_t));
+
+    // Spans several blocks
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_GAME_NOT_NULL(simple_chess_arena_create_new_game(arena, DrawEnforcementAutomatic));
+    }
+
+    EXPECT_GE(simple_chess_arena_bytes_used(arena), 21 * used);
+
+    simple_chess_arena_reset(arena);
+    EXPECT_EQ(simple_chess_arena_bytes_used(arena), 0u);
+
+    game_t* again = simple_chess_arena_create_new_game(arena, DrawEnforcementAutomatic);
+    ASSERT_GAME_NOT_NULL(again);
+    EXPECT_EQ(again, first);
+    EXPECT_EQ(simple_chess_arena_bytes_used(arena), used);
+
+    simple_chess_arena_reset(nullptr);
+    simple_chess_arena_destroy(nullptr);
+    simple_chess_arena_destroy(arena);
+}
+
+TEST(CArenaTest, InPlaceMovesGrowFromTheArena) {
+    sc_arena* arena = simple_chess_arena_create(0);
+    ASSERT_NE(arena, nullptr);
+
+    game_t* game = simple_chess_arena_create_new_game(arena, DrawEnforcementAutomatic);
+    ASSERT_GAME_NOT_NULL(game);
+
+    const size_t used = simple_chess_arena_bytes_used(arena);
+
+    ASSERT_TRUE(simple_chess_apply_move_inplace(game, create_move(PieceTypePawn, ColorWhite, 2, 'd', 4, 'd')));
+    ASSERT_TRUE(simple_chess_apply_move_inplace(game, create_move(PieceTypePawn, ColorBlack, 7, 'd', 5, 'd')));
+
+    EXPECT_EQ(game->history_size, 2);
+    EXPECT_STREQ(game->history[1].played_move.in_algebraic_notation, "d5");
+    EXPECT_GT(simple_chess_arena_bytes_used(arena), used);
+
+    simple_chess_arena_destroy(arena);
+}
+
+TEST(CArenaTest, NullArguments) {
+    EXPECT_EQ(simple_chess_arena_create_new_game(nullptr, DrawEnforcementAutomatic), nullptr);
+    EXPECT_EQ(simple_chess_arena_create_game_from_fen(nullptr, "8/8/8/8/8/8/8/K1k5 w - - 0 1", DrawEnforcementAutomatic), nullptr);
+    EXPECT_EQ(simple_chess_arena_apply_uci_moves(nullptr, nullptr, "e2e4", nullptr), nullptr);
+
+    sc_arena* arena = simple_chess_arena_create(0);
+    ASSERT_NE(arena, nullptr);
+
+    EXPECT_EQ(simple_chess_arena_create_game_from_fen(arena, nullptr, DrawEnforcementAutomatic), nullptr);
+    EXPECT_EQ(simple_chess_arena_create_game_from_fen(arena, "not a fen", DrawEnforcementAutomatic), nullptr);
+    EXPECT_EQ(simple_chess_arena_copy_game(arena, nullptr), nullptr);
+    EXPECT_EQ(simple_chess_arena_make_move(arena, nullptr, create_move(PieceTypePawn, ColorWhite, 2, 'e', 4, 'e'), false), nullptr);
+
+    simple_chess_arena_destroy(arena);
+}
@@ -0,0 +1,58 @@
+#include "TestUtils.h"
+
+TEST(CErrorCodesTest, CreateGameFromFen) {
+    game_t* game = nullptr;
+
+    EXPECT_EQ(simple_chess_try_create_game_from_fen(nullptr, DrawEnforcementAutomatic, &game), ErrorCodeInvalidArgument);
+    EXPECT_EQ(simple_chess_try_create_game_from_fen("4k3/8/8/8/8/8/8/4K3 w - - 0 1", DrawEnforcementAutomatic, nullptr),
+              ErrorCodeInvalidArgument);
+    EXPECT_EQ(simple_chess_try_create_game_from_fen("not a fen", DrawEnforcementAutomatic, &game), ErrorCodeInvalidFen);
+    EXPECT_EQ(simple_chess_try_create_game_from_fen("8/8/8/8/8/8/8/4K3 w - - 0 1", DrawEnforcementAutomatic, &game),
+              ErrorCodeInvalidPosition);
+    EXPECT_EQ(game, nullptr);
+
+    ASSERT_EQ(simple_chess_try_create_game_from_fen("4k3/8/8/8/8/8/8/4K3 w - - 0 1", DrawEnforcementClaimOnly, &game),
+              ErrorCodeNone);
+    ASSERT_GAME_NOT_NULL(game);
+    EXPECT_EQ(game->draw_enforcement, DrawEnforcementClaimOnly);
+    EXPECT_STREQ(game->current_stage.fen, "4k3/8/8/8/8/8/8/4K3 w - - 0 1");
+
+    destroy_game(game);
+}
+
+TEST(CErrorCodesTest, MakeMove) {
+    game_t* game = simple_chess_create_new_game();
+    ASSERT_GAME_NOT_NULL(game);
+
+    piece_move_t move = game->available_moves[0];
+    game_t* result = nullptr;
+
+    EXPECT_EQ(simple_chess_try_make_move(nullptr, move, false, &result), ErrorCodeInvalidArgument);
+    EXPECT_EQ(simple_chess_try_make_move(game, move, false, nullptr), ErrorCodeInvalidArgument);
+
+    piece_move_t off_board = move;
+    off_board.dst.rank = 9;
+    EXPECT_EQ(simple_chess_try_make_move(game, off_board, false, &result), ErrorCodeIllegalMove);
+
+    piece_move_t illegal = move;
+    illegal.dst.rank = 5;
+    EXPECT_EQ(simple_chess_try_make_move(game, illegal, false, &result), ErrorCodeIllegalMove);
+    EXPECT_EQ(result, nullptr);
+
+    ASSERT_EQ(simple_chess_try_make_move(game, move, true, &result), ErrorCodeNone);
+    ASSERT_GAME_NOT_NULL(result);
+    EXPECT_EQ(result->history_size, 1);
+    EXPECT_TRUE(result->history[0].played_move.offers_draw);
+
+    game_t* resigned = simple_chess_resign(result, ColorBlack);
+    ASSERT_GAME_NOT_NULL(resigned);
+
+    game_t* after_end = nullptr;
+    EXPECT_EQ(simple_chess_try_make_move(resigned, move, false, &after_end),
+              ErrorCodeGameFinished);
+    EXPECT_EQ(after_end, nullptr);
+
+    destroy_game(resigned);
+    destroy_game(result);
+    destroy_game(game);
+}
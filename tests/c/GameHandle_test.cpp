@@ -0,0 +1,200 @@
+#include "TestUtils.h"
+
+#include <vector>
+
+TEST(CGameHandleTest, MovesAreAppliedInPlace) {
+    sc_game_handle* handle = simple_chess_handle_create_new_game(DrawEnforcementAutomatic);
+    ASSERT_NE(handle, nullptr);
+
+    EXPECT_EQ(simple_chess_handle_state(handle), GameStatePlaying);
+    EXPECT_EQ(simple_chess_handle_active_color(handle), ColorWhite);
+    EXPECT_EQ(simple_chess_handle_available_moves(handle, nullptr, 0), 20);
+
+    EXPECT_TRUE(simple_chess_handle_make_move(handle,
+                create_move(PieceTypePawn, ColorWhite, 2, 'e', 4, 'e'), false));
+    EXPECT_TRUE(simple_chess_handle_make_move(handle,
+                create_move(PieceTypePawn, ColorBlack, 7, 'e', 5, 'e'), true));
+
+    EXPECT_STREQ(simple_chess_handle_fen(handle),
+            "rnbqkbnr/pppp1ppp/8/4p3/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 0 2");
+    EXPECT_EQ(simple_chess_handle_active_color(handle), ColorWhite);
+    EXPECT_EQ(simple_chess_handle_history_size(handle), 2);
+
+    game_history_entry_t entry;
+    ASSERT_TRUE(simple_chess_handle_history_entry(handle, 1, &entry));
+    EXPECT_STREQ(entry.played_move.in_algebraic_notation, "e5(=)");
+    EXPECT_TRUE(entry.played_move.offers_draw);
+    EXPECT_FALSE(simple_chess_handle_history_entry(handle, 2, &entry));
+
+    draw_reason_t reason;
+    ASSERT_TRUE(simple_chess_handle_draw_claimable(handle, &reason));
+    EXPECT_EQ(reason, DrawReasonOfferedAndAccepted);
+
+    // Illegal moves leave the game unchanged
+    EXPECT_FALSE(simple_chess_handle_make_move(handle,
+                create_move(PieceTypePawn, ColorWhite, 4, 'e', 5, 'e'), false));
+    EXPECT_EQ(simple_chess_handle_history_size(handle), 2);
+
+    std::vector<piece_move_t> moves(simple_chess_handle_available_moves(handle, nullptr, 0));
+    EXPECT_EQ(simple_chess_handle_available_moves(handle, moves.data(), static_cast<uint16_t>(moves.size())),
+            moves.size());
+
+    game_stage_t stage;
+    simple_chess_handle_current_stage(handle, &stage);
+    EXPECT_STREQ(stage.fen, simple_chess_handle_fen(handle));
+
+    EXPECT_TRUE(simple_chess_handle_claim_draw(handle));
+    EXPECT_EQ(simple_chess_handle_state(handle), GameStateDrawn);
+    ASSERT_TRUE(simple_chess_handle_draw_reason(handle, &reason));
+    EXPECT_EQ(reason, DrawReasonOfferedAndAccepted);
+    EXPECT_FALSE(simple_chess_handle_draw_claimable(handle, &reason));
+    EXPECT_FALSE(simple_chess_handle_resign(handle, ColorWhite));
+
+    simple_chess_handle_destroy(handle);
+}
+
+TEST(CGameHandleTest, SnapshotMatchesImmutableApi) {
+    sc_game_handle* handle = simple_chess_handle_create_from_fen(
+            "4k3/8/8/8/8/8/4P3/4K3 w - - 0 1", DrawEnforcementClaimOnly);
+    ASSERT_NE(handle, nullptr);
+
+    game_t* game = simple_chess_create_game_from_fen_ex(
+            "4k3/8/8/8/8/8/4P3/4K3 w - - 0 1", DrawEnforcementClaimOnly);
+    ASSERT_GAME_NOT_NULL(game);
+
+    const piece_move_t move = create_move(PieceTypePawn, ColorWhite, 2, 'e', 4, 'e');
+    ASSERT_TRUE(simple_chess_handle_make_move(handle, move, false));
+    game_t* next = simple_chess_make_move(game, move);
+    ASSERT_GAME_NOT_NULL(next);
+
+    game_t* snapshot = simple_chess_handle_snapshot(handle);
+    ASSERT_GAME_NOT_NULL(snapshot);
+
+    EXPECT_EQ(snapshot->state, next->state);
+    EXPECT_EQ(snapshot->history_size, next->history_size);
+    EXPECT_EQ(snapshot->available_move_count, next->available_move_count);
+    EXPECT_EQ(snapshot->draw_enforcement, DrawEnforcementClaimOnly);
+    EXPECT_STREQ(snapshot->current_stage.fen, next->current_stage.fen);
+    EXPECT_STREQ(snapshot->history[0].played_move.in_algebraic_notation, "e4");
+
+    sc_game_handle* copy = simple_chess_handle_create_from_game(snapshot);
+    ASSERT_NE(copy, nullptr);
+    EXPECT_STREQ(simple_chess_handle_fen(copy), simple_chess_handle_fen(handle));
+    EXPECT_EQ(simple_chess_handle_history_size(copy), 1);
+
+    EXPECT_TRUE(simple_chess_handle_resign(copy, ColorBlack));
+    EXPECT_EQ(simple_chess_handle_state(copy), GameStateWhiteWon);
+    EXPECT_EQ(simple_chess_handle_state(handle), GameStatePlaying);
+
+    simple_chess_handle_destroy(copy);
+    destroy_game(snapshot);
+    destroy_game(next);
+    destroy_game(game);
+    simple_chess_handle_destroy(handle);
+}
+
+TEST(CGameHandleTest, RepetitionsMatchImmutableApi) {
+    const std::vector<piece_move_t> knightMoves = {
+        create_move(PieceTypeKnight, ColorBlack, 8, 'g', 6, 'f'),
+        create_move(PieceTypeKnight, ColorWhite, 1, 'g', 3, 'f'),
+        create_move(PieceTypeKnight, ColorBlack, 6, 'f', 8, 'g'),
+        create_move(PieceTypeKnight, ColorWhite, 3, 'f', 1, 'g'),
+    };
+
+    for (const draw_enforcement_t enforcement : {DrawEnforcementAutomatic, DrawEnforcementClaimOnly}) {
+        sc_game_handle* handle = simple_chess_handle_create_new_game(enforcement);
+        ASSERT_NE(handle, nullptr);
+
+        game_t* game = simple_chess_create_new_game_ex(enforcement);
+        ASSERT_GAME_NOT_NULL(game);
+
+        // After a pawn move, so that only part of the history can repeat
+        const piece_move_t pawnMove = create_move(PieceTypePawn, ColorWhite, 2, 'e', 4, 'e');
+        ASSERT_TRUE(simple_chess_handle_make_move(handle, pawnMove, false));
+        game_t* next = simple_chess_make_move(game, pawnMove);
+        ASSERT_GAME_NOT_NULL(next);
+        destroy_game(game);
+        game = next;
+
+        for (int i = 0; i < 17 && game->state == GameStatePlaying; ++i) {
+            const piece_move_t move = knightMoves[i % knightMoves.size()];
+            ASSERT_TRUE(simple_chess_handle_make_move(handle, move, false));
+            next = simple_chess_make_move(game, move);
+            ASSERT_GAME_NOT_NULL(next);
+            destroy_game(game);
+            game = next;
+
+            draw_reason_t reason;
+            const bool claimable = simple_chess_handle_draw_claimable(handle, &reason);
+            EXPECT_EQ(simple_chess_handle_state(handle), game->state);
+            EXPECT_EQ(claimable, game->is_draw_claimable);
+            if (claimable) {
+                EXPECT_EQ(reason, game->reason_to_claim_draw);
+            }
+        }
+
+        if (enforcement == DrawEnforcementAutomatic) {
+            draw_reason_t reason;
+            EXPECT_EQ(simple_chess_handle_state(handle), GameStateDrawn);
+            ASSERT_TRUE(simple_chess_handle_draw_reason(handle, &reason));
+            EXPECT_EQ(reason, DrawReasonFiveFoldRepetition);
+        }
+
+        game_t* snapshot = simple_chess_handle_snapshot(handle);
+        ASSERT_GAME_NOT_NULL(snapshot);
+        EXPECT_EQ(snapshot->history_size, game->history_size);
+        destroy_game(snapshot);
+
+        destroy_game(game);
+        simple_chess_handle_destroy(handle);
+    }
+}
+
+TEST(CGameHandleTest, FinishedGames) {
+    game_t* game = simple_chess_create_new_game();
+    ASSERT_GAME_NOT_NULL(game);
+
+    size_t failed_index = 0;
+    game_t* mated = simple_chess_apply_uci_moves(game, "f2f3 e7e5 g2g4 d8h4", &failed_index);
+    game_t* resigned = simple_chess_resign(game, ColorWhite);
+    ASSERT_GAME_NOT_NULL(mated);
+    ASSERT_GAME_NOT_NULL(resigned);
+
+    sc_game_handle* handle = simple_chess_handle_create_from_game(mated);
+    ASSERT_NE(handle, nullptr);
+    EXPECT_EQ(simple_chess_handle_state(handle), GameStateBlackWon);
+    EXPECT_EQ(simple_chess_handle_history_size(handle), 4);
+    EXPECT_EQ(simple_chess_handle_available_moves(handle, nullptr, 0), 0);
+
+    draw_reason_t reason;
+    EXPECT_FALSE(simple_chess_handle_draw_claimable(handle, &reason));
+    EXPECT_FALSE(simple_chess_handle_claim_draw(handle));
+    EXPECT_FALSE(simple_chess_handle_make_move(handle,
+                create_move(PieceTypeKing, ColorWhite, 1, 'e', 2, 'f'), false));
+
+    game_t* snapshot = simple_chess_handle_snapshot(handle);
+    ASSERT_GAME_NOT_NULL(snapshot);
+    EXPECT_EQ(snapshot->state, GameStateBlackWon);
+    destroy_game(snapshot);
+    simple_chess_handle_destroy(handle);
+
+    handle = simple_chess_handle_create_from_game(resigned);
+    ASSERT_NE(handle, nullptr);
+    EXPECT_EQ(simple_chess_handle_state(handle), GameStateBlackWon);
+    EXPECT_FALSE(simple_chess_handle_resign(handle, ColorBlack));
+    simple_chess_handle_destroy(handle);
+
+    destroy_game(mated);
+    destroy_game(resigned);
+    destroy_game(game);
+}
+
+TEST(CGameHandleTest, InvalidArguments) {
+    EXPECT_EQ(simple_chess_handle_create_from_fen(nullptr, DrawEnforcementAutomatic), nullptr);
+    EXPECT_EQ(simple_chess_handle_create_from_fen("invalid", DrawEnforcementAutomatic), nullptr);
+    EXPECT_EQ(simple_chess_handle_create_from_game(nullptr), nullptr);
+    EXPECT_FALSE(simple_chess_handle_make_move(nullptr, piece_move_t{}, false));
+    EXPECT_FALSE(simple_chess_handle_claim_draw(nullptr));
+    EXPECT_FALSE(simple_chess_handle_resign(nullptr, ColorWhite));
+    simple_chess_handle_destroy(nullptr);
+}
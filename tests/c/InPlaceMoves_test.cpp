@@ -0,0 +1,240 @@
+#include "TestUtils.h"
+
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace {
+    // Allocations from the global heap are counted while this is set
+    thread_local bool counting_allocations = false;
+    size_t counted_allocations = 0;
+}
+
+void* operator new(std::size_t size) {
+    if (counting_allocations) ++counted_allocations;
+
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+    void expect_same_game(const game_t* actual, const game_t* expected) {
+        EXPECT_EQ(actual->state, expected->state);
+        if (expected->state == GameStateDrawn) {
+            EXPECT_EQ(actual->draw_reason, expected->draw_reason);
+        }
+        EXPECT_EQ(actual->is_draw_claimable, expected->is_draw_claimable);
+        if (expected->is_draw_claimable) {
+            EXPECT_EQ(actual->reason_to_claim_draw, expected->reason_to_claim_draw);
+        }
+        EXPECT_STREQ(actual->current_stage.fen, expected->current_stage.fen);
+        EXPECT_EQ(actual->current_stage.check_status, expected->current_stage.check_status);
+
+        ASSERT_EQ(actual->available_move_count, expected->available_move_count);
+        for (uint16_t i = 0; i < expected->available_move_count; ++i) {
+            EXPECT_EQ(actual->available_moves[i].src.rank, expected->available_moves[i].src.rank);
+            EXPECT_EQ(actual->available_moves[i].src.file, expected->available_moves[i].src.file);
+            EXPECT_EQ(actual->available_moves[i].dst.rank, expected->available_moves[i].dst.rank);
+            EXPECT_EQ(actual->available_moves[i].dst.file, expected->available_moves[i].dst.file);
+        }
+
+        ASSERT_EQ(actual->history_size, expected->history_size);
+        for (uint16_t i = 0; i < expected->history_size; ++i) {
+            const played_move_t& a = actual->history[i].played_move;
+            const played_move_t& e = expected->history[i].played_move;
+            EXPECT_STREQ(actual->history[i].fen, expected->history[i].fen);
+            EXPECT_STREQ(a.in_algebraic_notation, e.in_algebraic_notation);
+            EXPECT_EQ(a.is_capture, e.is_capture);
+            EXPECT_EQ(a.check_type, e.check_type);
+            EXPECT_EQ(a.offers_draw, e.offers_draw);
+        }
+    }
+
+    /**
+     * Plays every move on both a copy-based game and an in-place game and
+     * checks that both are the same after each move.
+     */
+    void play_and_compare(game_t* in_place, game_t* copied, const std::vector<piece_move_t>& moves) {
+        for (size_t i = 0; i < moves.size(); ++i) {
+            const bool offer_draw = (i % 5 == 4);
+            ASSERT_TRUE(simple_chess_apply_move_inplace_with_draw_offer(in_place, moves[i], offer_draw)) << i;
+
+            game_t* next = simple_chess_make_move_with_draw_offer(copied, moves[i], offer_draw);
+            ASSERT_GAME_NOT_NULL(next);
+            destroy_game(copied);
+            copied = next;
+
+            expect_same_game(in_place, copied);
+        }
+
+        destroy_game(copied);
+    }
+}
+
+TEST(CInPlaceMovesTest, MatchesMakeMove) {
+    // Scholar's mate with castling, a capture and a promotion attempt thrown in
+    game_t* in_place = simple_chess_create_new_game();
+    game_t* copied = simple_chess_create_new_game();
+    ASSERT_GAME_NOT_NULL(in_place);
+    ASSERT_GAME_NOT_NULL(copied);
+
+    play_and_compare(in_place, copied, {
+            create_move(PieceTypePawn, ColorWhite, 2, 'e', 4, 'e'),
+            create_move(PieceTypePawn, ColorBlack, 7, 'e', 5, 'e'),
+            create_move(PieceTypeKnight, ColorWhite, 1, 'g', 3, 'f'),
+            create_move(PieceTypeKnight, ColorBlack, 8, 'b', 6, 'c'),
+            create_move(PieceTypeBishop, ColorWhite, 1, 'f', 4, 'c'),
+            create_move(PieceTypeKnight, ColorBlack, 8, 'g', 6, 'f'),
+            create_move(PieceTypeKing, ColorWhite, 1, 'e', 1, 'g'),
+            create_move(PieceTypeKnight, ColorBlack, 6, 'f', 4, 'e'),
+            create_move(PieceTypeKnight, ColorWhite, 3, 'f', 5, 'e'),
+            create_move(PieceTypeKnight, ColorBlack, 6, 'c', 5, 'e'),
+            create_move(PieceTypeBishop, ColorWhite, 4, 'c', 7, 'f'),
+            create_move(PieceTypeKing, ColorBlack, 8, 'e', 7, 'e'),
+            create_move(PieceTypeQueen, ColorWhite, 1, 'd', 5, 'h'),
+    });
+
+    destroy_game(in_place);
+}
+
+TEST(CInPlaceMovesTest, RepetitionsAndPromotion) {
+    game_t* in_place = simple_chess_create_game_from_fen_ex("4k3/P7/8/8/8/8/8/4K2N w - - 0 1", DrawEnforcementClaimOnly);
+    game_t* copied = simple_chess_create_game_from_fen_ex("4k3/P7/8/8/8/8/8/4K2N w - - 0 1", DrawEnforcementClaimOnly);
+    ASSERT_GAME_NOT_NULL(in_place);
+    ASSERT_GAME_NOT_NULL(copied);
+
+    std::vector<piece_move_t> moves;
+    for (int i = 0; i < 3; ++i) {
+        moves.push_back(create_move(PieceTypeKnight, ColorWhite, 1, 'h', 3, 'g'));
+        moves.push_back(create_move(PieceTypeKing, ColorBlack, 8, 'e', 8, 'd'));
+        moves.push_back(create_move(PieceTypeKnight, ColorWhite, 3, 'g', 1, 'h'));
+        moves.push_back(create_move(PieceTypeKing, ColorBlack, 8, 'd', 8, 'e'));
+    }
+    moves.push_back(create_promotion_move(ColorWhite, 7, 'a', 8, 'a', PieceTypeQueen));
+
+    play_and_compare(in_place, copied, moves);
+    EXPECT_STREQ(in_place->history[in_place->history_size - 1].played_move.in_algebraic_notation, "a8=Q+");
+
+    destroy_game(in_place);
+}
+
+TEST(CInPlaceMovesTest, HistoryGrowsGeometrically) {
+    game_t* game = simple_chess_create_new_game();
+    ASSERT_GAME_NOT_NULL(game);
+
+    ASSERT_TRUE(simple_chess_apply_move_inplace(game, create_move(PieceTypeKnight, ColorWhite, 1, 'g', 3, 'f')));
+    ASSERT_GE(game->history_capacity, 16);
+    const game_history_entry_t* history = game->history;
+    const piece_move_t* available_moves = nullptr;
+
+    for (int i = 0; i < 3; ++i) {
+        if (i == 1) {
+            // Every position of the shuffle has been seen once
+            available_moves = game->available_moves;
+        }
+
+        ASSERT_TRUE(simple_chess_apply_move_inplace(game, create_move(PieceTypeKnight, ColorBlack, 8, 'g', 6, 'f')));
+        ASSERT_TRUE(simple_chess_apply_move_inplace(game, create_move(PieceTypeKnight, ColorWhite, 3, 'f', 1, 'g')));
+        ASSERT_TRUE(simple_chess_apply_move_inplace(game, create_move(PieceTypeKnight, ColorBlack, 6, 'f', 8, 'g')));
+        ASSERT_TRUE(simple_chess_apply_move_inplace(game, create_move(PieceTypeKnight, ColorWhite, 1, 'g', 3, 'f')));
+    }
+
+    EXPECT_EQ(game->history_size, 13);
+    EXPECT_EQ(game->history, history);
+    EXPECT_EQ(game->available_moves, available_moves);
+    EXPECT_GE(game->available_move_capacity, game->available_move_count);
+
+    destroy_game(game);
+}
+
+TEST(CInPlaceMovesTest, InvalidMovesLeaveGameUnchanged) {
+    game_t* game = simple_chess_create_new_game();
+    ASSERT_GAME_NOT_NULL(game);
+
+    EXPECT_FALSE(simple_chess_apply_move_inplace(nullptr, create_move(PieceTypePawn, ColorWhite, 2, 'e', 4, 'e')));
+    EXPECT_FALSE(simple_chess_apply_move_inplace(game, create_move(PieceTypePawn, ColorWhite, 2, 'e', 5, 'e')));
+    EXPECT_FALSE(simple_chess_apply_move_inplace(game, create_move(PieceTypeKnight, ColorWhite, 2, 'e', 4, 'e')));
+    EXPECT_FALSE(simple_chess_apply_move_inplace(game, create_move(PieceTypePawn, ColorBlack, 7, 'e', 5, 'e')));
+    EXPECT_EQ(game->history_size, 0);
+    EXPECT_EQ(game->available_move_count, 20);
+
+    game_t* resigned = simple_chess_resign(game, ColorWhite);
+    ASSERT_GAME_NOT_NULL(resigned);
+    EXPECT_FALSE(simple_chess_apply_move_inplace(resigned, create_move(PieceTypePawn, ColorWhite, 2, 'e', 4, 'e')));
+
+    destroy_game(resigned);
+    destroy_game(game);
+}
+
+TEST(CInPlaceMovesTest, ContinuesGamesWithHistory) {
+    // The initial position is repeated within the history already
+    const char* shuffle = "g1f3 g8f6 f3g1 f6g8 g1f3";
+    game_t* initial = simple_chess_create_new_game();
+    ASSERT_GAME_NOT_NULL(initial);
+    game_t* in_place = simple_chess_apply_uci_moves(initial, shuffle, nullptr);
+    game_t* copied = simple_chess_apply_uci_moves(initial, shuffle, nullptr);
+    destroy_game(initial);
+    ASSERT_GAME_NOT_NULL(in_place);
+    ASSERT_GAME_NOT_NULL(copied);
+
+    std::vector<piece_move_t> moves;
+    for (int i = 0; i < 3; ++i) {
+        moves.push_back(create_move(PieceTypeKnight, ColorBlack, 8, 'g', 6, 'f'));
+        moves.push_back(create_move(PieceTypeKnight, ColorWhite, 3, 'f', 1, 'g'));
+        moves.push_back(create_move(PieceTypeKnight, ColorBlack, 6, 'f', 8, 'g'));
+        moves.push_back(create_move(PieceTypeKnight, ColorWhite, 1, 'g', 3, 'f'));
+    }
+    moves.pop_back();
+
+    // The initial position is reached for the fifth time
+    play_and_compare(in_place, copied, moves);
+    EXPECT_EQ(in_place->state, GameStateDrawn);
+    EXPECT_EQ(in_place->draw_reason, DrawReasonFiveFoldRepetition);
+
+    destroy_game(in_place);
+}
+
+TEST(CInPlaceMovesTest, SteadyStateDoesNotAllocate) {
+    game_t* game = simple_chess_create_new_game_ex(DrawEnforcementClaimOnly);
+    ASSERT_GAME_NOT_NULL(game);
+
+    const piece_move_t shuffle[] = {
+        create_move(PieceTypeKnight, ColorWhite, 1, 'g', 3, 'f'),
+        create_move(PieceTypeKnight, ColorBlack, 8, 'g', 6, 'f'),
+        create_move(PieceTypeKnight, ColorWhite, 3, 'f', 1, 'g'),
+        create_move(PieceTypeKnight, ColorBlack, 6, 'f', 8, 'g'),
+    };
+
+    // The first moves grow the arrays of the game
+    for (const piece_move_t& move : shuffle) {
+        ASSERT_TRUE(simple_chess_apply_move_inplace(game, move));
+    }
+
+    // From here on the threefold repetition can be claimed, which is only
+    // detected by playing every available move
+    counted_allocations = 0;
+    counting_allocations = true;
+    bool all_made = true;
+    for (int i = 0; i < 2; ++i) {
+        for (const piece_move_t& move : shuffle) {
+            all_made = simple_chess_apply_move_inplace(game, move) && all_made;
+        }
+    }
+    counting_allocations = false;
+
+    EXPECT_TRUE(all_made);
+    EXPECT_EQ(counted_allocations, 0);
+    EXPECT_EQ(game->history_size, 12);
+    EXPECT_TRUE(game->is_draw_claimable);
+    EXPECT_EQ(game->reason_to_claim_draw, DrawReasonThreeFoldRepetition);
+
+    destroy_game(game);
+}
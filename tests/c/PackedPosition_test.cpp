@@ -0,0 +1,56 @@
+#include "TestUtils.h"
+
+TEST(CPackedPositionTest, RoundTrip) {
+    game_t* game = simple_chess_create_game_from_fen(
+            "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3");
+    ASSERT_GAME_NOT_NULL(game);
+
+    packed_position_t packed;
+    ASSERT_TRUE(simple_chess_pack_position(&game->current_stage, &packed));
+
+    game_stage_t stage;
+    ASSERT_TRUE(simple_chess_unpack_position(&packed, &stage));
+    EXPECT_STREQ(stage.fen, game->current_stage.fen);
+    EXPECT_EQ(stage.castling_rights, game->current_stage.castling_rights);
+    EXPECT_TRUE(stage.has_en_passant_target);
+
+    for (uint8_t index = 0; index < 64; ++index) {
+        ASSERT_EQ(stage.board.occupied[index], game->current_stage.board.occupied[index]);
+        if (stage.board.occupied[index]) {
+            EXPECT_EQ(stage.board.piece_at[index].type, game->current_stage.board.piece_at[index].type);
+            EXPECT_EQ(stage.board.piece_at[index].color, game->current_stage.board.piece_at[index].color);
+        }
+    }
+
+    game_t* restored = simple_chess_create_game_from_packed_position(
+            &packed, DrawEnforcementClaimOnly);
+    ASSERT_GAME_NOT_NULL(restored);
+    EXPECT_STREQ(restored->current_stage.fen, game->current_stage.fen);
+    EXPECT_EQ(restored->available_move_count, game->available_move_count);
+    EXPECT_EQ(restored->draw_enforcement, DrawEnforcementClaimOnly);
+
+    destroy_game(restored);
+    destroy_game(game);
+}
+
+TEST(CPackedPositionTest, InvalidArguments) {
+    packed_position_t packed = {};
+    game_stage_t stage;
+
+    EXPECT_FALSE(simple_chess_pack_position(nullptr, &packed));
+    EXPECT_FALSE(simple_chess_unpack_position(nullptr, &stage));
+    EXPECT_FALSE(simple_chess_unpack_position(&packed, &stage));
+    EXPECT_EQ(simple_chess_create_game_from_packed_position(nullptr, DrawEnforcementAutomatic), nullptr);
+    EXPECT_EQ(simple_chess_create_game_from_packed_position(&packed, DrawEnforcementAutomatic), nullptr);
+}
+
+TEST(CPackedPositionTest, TooManyPieces) {
+    game_t* game = simple_chess_create_game_from_fen(
+            "qqqqkqqq/qqqqqqqq/8/8/8/P7/QQQQQQQQ/QQQQKQQQ w - - 0 1");
+    ASSERT_GAME_NOT_NULL(game);
+
+    packed_position_t packed;
+    EXPECT_FALSE(simple_chess_pack_position(&game->current_stage, &packed));
+
+    destroy_game(game);
+}
@@ -0,0 +1,53 @@
+#include "TestUtils.h"
+
+TEST(CPositionMovesTest, InitialPosition) {
+    piece_move_t moves[64];
+    check_type_t check_status = CheckTypeCheckMate;
+
+    const int count = simple_chess_position_moves(
+            "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", moves, 64, &check_status);
+
+    ASSERT_EQ(count, 20);
+    EXPECT_EQ(check_status, CheckTypeNone);
+
+    game_t* game = simple_chess_create_new_game();
+    ASSERT_GAME_NOT_NULL(game);
+    ASSERT_EQ(game->available_move_count, 20);
+
+    for (int i = 0; i < count; ++i) {
+        EXPECT_EQ(moves[i].piece.type, game->available_moves[i].piece.type);
+        EXPECT_EQ(moves[i].src.rank, game->available_moves[i].src.rank);
+        EXPECT_EQ(moves[i].src.file, game->available_moves[i].src.file);
+        EXPECT_EQ(moves[i].dst.rank, game->available_moves[i].dst.rank);
+        EXPECT_EQ(moves[i].dst.file, game->available_moves[i].dst.file);
+    }
+
+    destroy_game(game);
+}
+
+TEST(CPositionMovesTest, CapacityAndStatus) {
+    piece_move_t moves[2];
+    check_type_t check_status = CheckTypeNone;
+
+    // Only the count is needed
+    EXPECT_EQ(simple_chess_position_moves("4k3/4R3/8/8/8/8/8/4K3 b - - 0 1", nullptr, 0, &check_status), 3);
+    EXPECT_EQ(check_status, CheckTypeCheck);
+
+    EXPECT_EQ(simple_chess_position_moves("4k3/4R3/8/8/8/8/8/4K3 b - - 0 1", moves, 2, nullptr), 3);
+
+    EXPECT_EQ(simple_chess_position_moves(
+                "rnb1kbnr/pppp1ppp/8/4p3/6Pq/5P2/PPPPP2P/RNBQKBNR w KQkq - 1 3", moves, 2, &check_status), 0);
+    EXPECT_EQ(check_status, CheckTypeCheckMate);
+
+    EXPECT_EQ(simple_chess_position_moves("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1", moves, 2, &check_status), 0);
+    EXPECT_EQ(check_status, CheckTypeNone);
+}
+
+TEST(CPositionMovesTest, InvalidPositions) {
+    piece_move_t moves[8];
+
+    EXPECT_EQ(simple_chess_position_moves(nullptr, moves, 8, nullptr), -1);
+    EXPECT_EQ(simple_chess_position_moves("not a fen", moves, 8, nullptr), -1);
+    EXPECT_EQ(simple_chess_position_moves("4k3/8/8/8/8/8/8/8 w - - 0 1", moves, 8, nullptr), -1);
+    EXPECT_EQ(simple_chess_position_moves("4k3/8/8/8/8/8/8/4K3 w - - 0 1", nullptr, 8, nullptr), -1);
+}
@@ -0,0 +1,179 @@
+#include "TestUtils.h"
+
+#include <cpp/simplechess/Notation.h>
+
+#include <boost/optional/optional_io.hpp>
+
+using namespace simplechess;
+
+TEST(AlgebraicNotationParsingTest, PieceMoveDisambiguatedByFile) {
+	const Game game = createGameFromFen(
+			"rnbqkb1r/ppp2ppp/5n2/3pp3/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1");
+
+	EXPECT_EQ(
+			pieceMoveFromAlgebraicNotation(game.currentStage(), "Nbd7"),
+			PieceMove::regularMove(
+				{PieceType::Knight, Color::Black},
+				Square::fromRankAndFile(8, 'b'),
+				Square::fromRankAndFile(7, 'd')));
+
+	EXPECT_EQ(
+			pieceMoveFromAlgebraicNotation(game.currentStage(), "Nfd7"),
+			PieceMove::regularMove(
+				{PieceType::Knight, Color::Black},
+				Square::fromRankAndFile(6, 'f'),
+				Square::fromRankAndFile(7, 'd')));
+}
+
+TEST(AlgebraicNotationParsingTest, AmbiguousPieceMoveIsRejected) {
+	const Game game = createGameFromFen(
+			"rnbqkb1r/ppp2ppp/5n2/3pp3/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1");
+
+	EXPECT_THROW(
+			pieceMoveFromAlgebraicNotation(game.currentStage(), "Nd7"),
+			std::invalid_argument);
+}
+
+TEST(AlgebraicNotationParsingTest, PinnedPieceMoveIsRejected) {
+	const Game game = createGameFromFen(
+			"4k3/8/8/8/4r3/8/4N3/4K3 w - - 0 1");
+
+	EXPECT_THROW(
+			pieceMoveFromAlgebraicNotation(game.currentStage(), "Nc3"),
+			std::invalid_argument);
+}
+
+TEST(AlgebraicNotationParsingTest, PinResolvesAmbiguity) {
+	// Both knights can reach d2, but the one on f3 is pinned
+	const Game game = createGameFromFen(
+			"4k3/8/8/8/8/r4N1K/8/1N6 w - - 0 1");
+
+	EXPECT_EQ(
+			pieceMoveFromAlgebraicNotation(game.currentStage(), "Nd2"),
+			PieceMove::regularMove(
+				{PieceType::Knight, Color::White},
+				Square::fromRankAndFile(1, 'b'),
+				Square::fromRankAndFile(2, 'd')));
+}
+
+TEST(AlgebraicNotationParsingTest, PawnEnPassantCapture) {
+	const Game game = createGameFromFen(
+			"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 3");
+
+	EXPECT_EQ(
+			pieceMoveFromAlgebraicNotation(game.currentStage(), "exd6"),
+			PieceMove::regularMove(
+				{PieceType::Pawn, Color::White},
+				Square::fromRankAndFile(5, 'e'),
+				Square::fromRankAndFile(6, 'd')));
+
+	EXPECT_THROW(
+			pieceMoveFromAlgebraicNotation(game.currentStage(), "exf6"),
+			std::invalid_argument);
+}
+
+TEST(AlgebraicNotationParsingTest, PawnPushes) {
+	const Game game = createNewGame();
+
+	EXPECT_EQ(
+			pieceMoveFromAlgebraicNotation(game.currentStage(), "e4"),
+			PieceMove::regularMove(
+				{PieceType::Pawn, Color::White},
+				Square::fromRankAndFile(2, 'e'),
+				Square::fromRankAndFile(4, 'e')));
+
+	EXPECT_EQ(
+			pieceMoveFromAlgebraicNotation(game.currentStage(), "a3"),
+			PieceMove::regularMove(
+				{PieceType::Pawn, Color::White},
+				Square::fromRankAndFile(2, 'a'),
+				Square::fromRankAndFile(3, 'a')));
+
+	EXPECT_THROW(
+			pieceMoveFromAlgebraicNotation(game.currentStage(), "e5"),
+			std::invalid_argument);
+}
+
+TEST(AlgebraicNotationParsingTest, PawnPromotion) {
+	const Game game = createGameFromFen(
+			"k7/4P3/8/8/8/8/8/4K3 w - - 0 1");
+
+	const PieceMove expected = PieceMove::pawnPromotion(
+			{PieceType::Pawn, Color::White},
+			Square::fromRankAndFile(7, 'e'),
+			Square::fromRankAndFile(8, 'e'),
+			PieceType::Queen);
+
+	EXPECT_EQ(pieceMoveFromAlgebraicNotation(game.currentStage(), "e8=Q+"), expected);
+	EXPECT_EQ(pieceMoveFromAlgebraicNotation(game.currentStage(), "e8Q"), expected);
+
+	EXPECT_THROW(
+			pieceMoveFromAlgebraicNotation(game.currentStage(), "e8"),
+			std::invalid_argument);
+	EXPECT_THROW(
+			pieceMoveFromAlgebraicNotation(game.currentStage(), "e8=K"),
+			std::invalid_argument);
+}
+
+TEST(AlgebraicNotationParsingTest, Castling) {
+	const Game game = createGameFromFen(
+			"r3k2r/8/8/8/8/8/8/R3K2R b KQkq - 0 1");
+
+	EXPECT_EQ(
+			pieceMoveFromAlgebraicNotation(game.currentStage(), "O-O-O"),
+			PieceMove::regularMove(
+				{PieceType::King, Color::Black},
+				Square::fromRankAndFile(8, 'e'),
+				Square::fromRankAndFile(8, 'c')));
+
+	EXPECT_EQ(
+			pieceMoveFromAlgebraicNotation(game.currentStage(), "O-O"),
+			PieceMove::regularMove(
+				{PieceType::King, Color::Black},
+				Square::fromRankAndFile(8, 'e'),
+				Square::fromRankAndFile(8, 'g')));
+}
+
+TEST(AlgebraicNotationParsingTest, CastlingWithoutRightIsRejected) {
+	const Game game = createGameFromFen(
+			"r3k2r/8/8/8/8/8/8/R3K2R w Kkq - 0 1");
+
+	EXPECT_THROW(
+			pieceMoveFromAlgebraicNotation(game.currentStage(), "O-O-O"),
+			std::invalid_argument);
+}
+
+TEST(AlgebraicNotationParsingTest, MalformedNotationIsRejected) {
+	const Game game = createNewGame();
+
+	for (const std::string san : {"", "N", "Nf9", "Zf3", "e2e4", "Ngf3x", "O-O-"})
+	{
+		EXPECT_THROW(
+				pieceMoveFromAlgebraicNotation(game.currentStage(), san),
+				std::invalid_argument) << san;
+	}
+}
+
+TEST(AlgebraicNotationParsingTest, GeneratedNotationRoundTrip) {
+	const std::vector<std::string> fens = {
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1",
+		"b3bk2/8/2P5/8/b7/5K2/8/8 b - - 0 1",
+		"4k3/8/8/8/8/5N2/P7/1N2K3 w - - 0 1"
+	};
+
+	for (const std::string& fen : fens)
+	{
+		const Game game = createGameFromFen(fen);
+
+		for (const PieceMove& move : game.allAvailableMoves())
+		{
+			const std::string san
+				= makeMove(game, move, true).history().back().second.inAlgebraicNotation();
+
+			EXPECT_EQ(pieceMoveFromAlgebraicNotation(game.currentStage(), san), move)
+				<< fen << " " << san;
+		}
+	}
+}
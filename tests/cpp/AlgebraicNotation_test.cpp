@@ -130,6 +130,20 @@ TEST(AlgebraicNotationTest, PieceMoveCaptureCheckSameFileSameRankAmbiguity) {
 	EXPECT_EQ(updatedGame.history().back().second.inAlgebraicNotation(), "Ba8xc6+");
 }
 
+TEST(AlgebraicNotationTest, PieceMoveNoCaptureNoCheckDifferentRankAndFileAmbiguity) {
+	const Game game = createGameFromFen(
+			"4k3/8/8/8/8/5N2/P7/1N2K3 w - - 0 1");
+
+	const auto updatedGame = makeMove(
+			game,
+			PieceMove::regularMove(
+				{PieceType::Knight, Color::White},
+				Square::fromRankAndFile(1, 'b'),
+				Square::fromRankAndFile(2, 'd')));
+
+	EXPECT_EQ(updatedGame.history().back().second.inAlgebraicNotation(), "Nbd2");
+}
+
 TEST(AlgebraicNotationTest, PawnPromotionNoCaptureNoCheck) {
 	const Game game = createGameFromFen(
 			"2rk4/1P6/8/5K2/8/8/8/8 w - - 0 1");
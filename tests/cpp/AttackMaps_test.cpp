@@ -0,0 +1,236 @@
+#include "TestUtils.h"
+
+#include <cpp/simplechess/AttackMaps.h>
+
+#include "details/bitboard/AttackKernels.h"
+#include "details/bitboard/Bitboard.h"
+
+using namespace simplechess;
+
+namespace
+{
+	uint32_t nextRandom(uint32_t& seed)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		return seed >> 8;
+	}
+
+	/**
+	 * A batch of \p size positions with up to 16 pieces each, placed on
+	 * distinct random squares.
+	 */
+	PositionBatch randomBatch(const size_t size, uint32_t seed)
+	{
+		PositionBatch batch;
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			uint64_t occupied = 0;
+			std::array<std::array<uint64_t, 6>, 2> pieces = {};
+
+			for (uint32_t n = nextRandom(seed) % 17; n > 0; --n)
+			{
+				const uint64_t square = uint64_t(1) << (nextRandom(seed) % 64);
+
+				if ((occupied & square) == 0)
+				{
+					occupied |= square;
+					pieces[nextRandom(seed) % 2][nextRandom(seed) % 6] |= square;
+				}
+			}
+
+			for (size_t color = 0; color < 2; ++color)
+			{
+				for (size_t type = 0; type < 6; ++type)
+				{
+					batch.pieces[color][type].push_back(pieces[color][type]);
+				}
+			}
+		}
+
+		return batch;
+	}
+
+	/**
+	 * The attacks of every piece of type \p type in \p pieces, one square
+	 * at a time.
+	 */
+	uint64_t referenceAttacks(
+			const Color color,
+			const PieceType type,
+			uint64_t pieces,
+			const uint64_t occupied)
+	{
+		uint64_t result = 0;
+
+		while (pieces)
+		{
+			const uint8_t square = details::popLsb(pieces);
+
+			switch (type)
+			{
+				case PieceType::Pawn:
+					result |= details::pawnAttacks(color, square);
+					break;
+				case PieceType::Rook:
+					result |= details::rookAttacks(square, occupied);
+					break;
+				case PieceType::Knight:
+					result |= details::knightAttacks(square);
+					break;
+				case PieceType::Bishop:
+					result |= details::bishopAttacks(square, occupied);
+					break;
+				case PieceType::Queen:
+					result |= details::queenAttacks(square, occupied);
+					break;
+				case PieceType::King:
+					result |= details::kingAttacks(square);
+					break;
+			}
+		}
+
+		return result;
+	}
+
+	void expectReferenceAttacks(const PositionBatch& batch, const AttackMaps& maps)
+	{
+		ASSERT_EQ(maps.byColor[0].size(), batch.size());
+		ASSERT_EQ(maps.byColor[1].size(), batch.size());
+
+		for (size_t i = 0; i < batch.size(); ++i)
+		{
+			uint64_t occupied = 0;
+
+			for (size_t color = 0; color < 2; ++color)
+			{
+				for (size_t type = 0; type < 6; ++type)
+				{
+					occupied |= batch.pieces[color][type][i];
+				}
+			}
+
+			for (size_t color = 0; color < 2; ++color)
+			{
+				uint64_t all = 0;
+
+				for (size_t type = 0; type < 6; ++type)
+				{
+					const uint64_t expected = referenceAttacks(
+							static_cast<Color>(color),
+							static_cast<PieceType>(type),
+							batch.pieces[color][type][i],
+							occupied);
+
+					ASSERT_EQ(maps.byPiece[color][type][i], expected)
+						<< "position " << i << ", color " << color << ", type " << type;
+					all |= expected;
+				}
+
+				ASSERT_EQ(maps.byColor[color][i], all) << "position " << i;
+			}
+		}
+	}
+
+	AttackMaps emptyMaps(const size_t size)
+	{
+		AttackMaps maps;
+
+		for (size_t color = 0; color < 2; ++color)
+		{
+			for (size_t type = 0; type < 6; ++type)
+			{
+				maps.byPiece[color][type].resize(size);
+			}
+
+			maps.byColor[color].resize(size);
+		}
+
+		return maps;
+	}
+}
+
+TEST(AttackMapsTest, EveryKernelMatchesPerSquareAttacks) {
+	using details::attacks::Kernel;
+
+	// Sizes which are not multiples of the vector widths exercise the tail
+	for (const size_t size : {size_t(0), size_t(1), size_t(7), size_t(37), size_t(300)})
+	{
+		const PositionBatch batch = randomBatch(size, static_cast<uint32_t>(size) + 1);
+
+		for (const Kernel kernel : {Kernel::Scalar, Kernel::Avx2, Kernel::Avx512})
+		{
+			if (!details::attacks::isAvailable(kernel))
+			{
+				continue;
+			}
+
+			AttackMaps maps = emptyMaps(size);
+			details::attacks::BatchView view;
+			view.size = size;
+
+			for (size_t color = 0; color < 2; ++color)
+			{
+				for (size_t type = 0; type < 6; ++type)
+				{
+					view.pieces[color][type] = batch.pieces[color][type].data();
+					view.pieceAttacks[color][type] = maps.byPiece[color][type].data();
+				}
+
+				view.colorAttacks[color] = maps.byColor[color].data();
+			}
+
+			details::attacks::compute(kernel, view);
+
+			SCOPED_TRACE(static_cast<int>(kernel));
+			expectReferenceAttacks(batch, maps);
+		}
+	}
+}
+
+TEST(AttackMapsTest, AgreesWithAttackedSquaresOfGames) {
+	const std::vector<std::string> fens = {
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+		"n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1",
+		"r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP3PPP/R2QKB1R w KQ - 0 8"
+	};
+
+	PositionBatch batch;
+	std::vector<Game> games;
+
+	for (const std::string& fen : fens)
+	{
+		games.push_back(createGameFromFen(fen));
+		batch.add(games.back().currentStage());
+	}
+
+	const AttackMaps maps = computeAttackMaps(batch);
+	expectReferenceAttacks(batch, maps);
+
+	// The king never steps on a square attacked by the opponent
+	for (size_t i = 0; i < games.size(); ++i)
+	{
+		const Color active = games[i].activeColor();
+		const uint64_t attacked
+			= maps.byColor[active == Color::White ? 1 : 0][i];
+
+		for (const PieceMove& move : games[i].allAvailableMoves())
+		{
+			if (move.piece().type() == PieceType::King
+					&& std::abs(move.dst().file() - move.src().file()) != 2)
+			{
+				const uint8_t square = details::squareIndex(move.dst());
+				EXPECT_EQ(attacked & details::bit(square), 0u) << fens[i];
+			}
+		}
+	}
+}
+
+TEST(AttackMapsTest, MismatchedSizesAreRejected) {
+	PositionBatch batch = randomBatch(4, 1);
+	batch.pieces[1][3].pop_back();
+
+	EXPECT_THROW(computeAttackMaps(batch), std::invalid_argument);
+}
@@ -0,0 +1,164 @@
+#include "TestUtils.h"
+
+#include <cpp/simplechess/Evaluation.h>
+#include <cpp/simplechess/Notation.h>
+
+#include "details/bitboard/Position.h"
+
+#include <algorithm>
+#include <cctype>
+
+using namespace simplechess;
+
+namespace
+{
+	int evaluateFen(const std::string& fen)
+	{
+		return evaluatePosition(createGameFromFen(fen).currentStage());
+	}
+
+	/**
+	 * Returns the FEN of the position with the colors swapped, for
+	 * positions without castling rights or en passant target.
+	 */
+	std::string mirroredFen(const std::string& fen)
+	{
+		const size_t boardEnd = fen.find(' ');
+		std::vector<std::string> ranks;
+
+		for (size_t start = 0; start <= boardEnd;)
+		{
+			const size_t end = std::min(fen.find('/', start), boardEnd);
+			ranks.push_back(fen.substr(start, end - start));
+			start = end + 1;
+		}
+
+		std::string result;
+
+		for (auto it = ranks.rbegin(); it != ranks.rend(); ++it)
+		{
+			for (const char c : *it)
+			{
+				result += std::isupper(c) ? static_cast<char>(std::tolower(c)) : static_cast<char>(std::toupper(c));
+			}
+
+			result += (it + 1 != ranks.rend()) ? "/" : "";
+		}
+
+		const char color = fen[boardEnd + 1];
+		return result + ' ' + (color == 'w' ? 'b' : 'w') + fen.substr(boardEnd + 2);
+	}
+}
+
+TEST(EvaluationTest, InitialPositionIsBalanced) {
+	EXPECT_EQ(evaluatePosition(createNewGame().currentStage()), 0);
+}
+
+TEST(EvaluationTest, MirroredPositionsHaveOppositeScores) {
+	const std::vector<std::string> fens = {
+		"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+		"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+		"4k3/1P6/8/3p4/8/2P5/P4P2/4K3 b - - 0 40",
+		"2kr3r/ppp2ppp/2n5/8/1b1q4/2N5/PPPQ1PPP/R3KB1R w - - 0 12"
+	};
+
+	for (const std::string& fen : fens)
+	{
+		EXPECT_EQ(::evaluateFen(fen), -::evaluateFen(::mirroredFen(fen))) << fen;
+	}
+}
+
+TEST(EvaluationTest, MaterialAndPawnStructure) {
+	// An extra queen
+	EXPECT_GT(::evaluateFen("4k3/8/8/8/8/8/8/3QK3 w - - 0 1"), 800);
+	EXPECT_LT(::evaluateFen("3qk3/8/8/8/8/8/8/4K3 w - - 0 1"), -800);
+
+	// A pawn is worth more the closer it is to promotion
+	EXPECT_GT(
+			::evaluateFen("4k3/P7/8/8/8/8/8/4K3 w - - 0 1"),
+			::evaluateFen("4k3/8/8/8/8/8/P7/4K3 w - - 0 1"));
+
+	// Doubled and isolated pawns are weaknesses
+	EXPECT_GT(
+			::evaluateFen("4k3/pp6/8/8/8/8/PP6/4K3 w - - 0 1"),
+			::evaluateFen("4k3/pp6/8/8/8/P7/P7/4K3 w - - 0 1"));
+
+	// The king belongs in the centre in the endgame only
+	EXPECT_GT(
+			::evaluateFen("4k3/8/8/8/3K4/8/8/8 w - - 0 1"),
+			::evaluateFen("4k3/8/8/8/8/8/8/K7 w - - 0 1"));
+	EXPECT_LT(
+			::evaluateFen("rnbqkbnr/pppppppp/8/8/3K4/8/PPPPPPPP/RNBQ1BNR w kq - 0 1"),
+			::evaluateFen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"));
+}
+
+TEST(EvaluationTest, BatchMatchesSingleEvaluations) {
+	Game game = createNewGame();
+	std::vector<GameStage> stages = {game.currentStage()};
+
+	for (const std::string& uci : {"e2e4", "c7c5", "g1f3", "d7d6", "d2d4", "c5d4", "f3d4", "g8f6", "b1c3", "a7a6"})
+	{
+		game = makeMove(game, pieceMoveFromUci(game.currentStage(), uci));
+		stages.push_back(game.currentStage());
+	}
+
+	// The same pawn structures again
+	const std::vector<GameStage> played = stages;
+	stages.insert(stages.end(), played.begin(), played.end());
+
+	std::vector<PackedPosition> packed;
+
+	for (const GameStage& stage : stages)
+	{
+		packed.push_back(packPosition(stage));
+	}
+
+	const std::vector<int> scores = evaluatePositions(stages);
+	ASSERT_EQ(scores.size(), stages.size());
+	EXPECT_EQ(evaluatePositions(packed), scores);
+
+	for (size_t i = 0; i < stages.size(); ++i)
+	{
+		EXPECT_EQ(scores[i], evaluatePosition(stages[i])) << i;
+	}
+
+	PackedPosition malformed = packed.front();
+	malformed.bytes.fill(0xFF);
+	packed.push_back(malformed);
+	EXPECT_THROW(evaluatePositions(packed), std::invalid_argument);
+}
+
+TEST(EvaluationTest, IncrementalTermsMatchFromScratch) {
+	const std::vector<std::string> fens = {
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1",
+		"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3"
+	};
+
+	for (const std::string& fen : fens)
+	{
+		details::Position position = details::Position::fromStage(createGameFromFen(fen).currentStage());
+		uint32_t seed = 11;
+
+		for (int ply = 0; ply < 40; ++ply)
+		{
+			details::MoveList moves;
+			position.legalMoves(moves);
+
+			if (moves.size == 0)
+			{
+				break;
+			}
+
+			seed = seed * 1664525u + 1013904223u;
+			position.makeMove(moves.moves[(seed >> 8) % moves.size]);
+
+			const details::Position scratch = details::Position::fromStage(position.toStage());
+
+			ASSERT_EQ(position.middlegameScore(), scratch.middlegameScore()) << fen << ' ' << ply;
+			ASSERT_EQ(position.endgameScore(), scratch.endgameScore()) << fen << ' ' << ply;
+			ASSERT_EQ(position.phase(), scratch.phase()) << fen << ' ' << ply;
+			ASSERT_EQ(position.pawnHash(), scratch.pawnHash()) << fen << ' ' << ply;
+		}
+	}
+}
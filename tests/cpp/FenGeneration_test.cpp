@@ -1,5 +1,8 @@
 #include "TestUtils.h"
 
+#include "details/bitboard/Position.h"
+#include "details/fen/FenUtils.h"
+
 #include <boost/optional/optional_io.hpp>
 
 using namespace simplechess;
@@ -235,3 +238,22 @@ TEST(FenGenerationTest, BlackQueensideCastling) {
 	EXPECT_EQ(result.currentStage().fen(),
 			"2kr3r/8/8/8/8/8/8/R3K2R w KQ - 8 53");
 }
+
+TEST(FenGenerationTest, GeneratedFromPositionWithoutAllocating) {
+	for (const std::string fen : {
+			"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+			"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w Kq - 12 340",
+			"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+			"8/8/8/8/8/8/8/k1K5 b - - 65535 65535"})
+	{
+		const GameStage stage = createGameFromFen(fen).currentStage();
+
+		char output[details::FenUtils::MaxFenLength + 1];
+		const size_t length = details::FenUtils::generateFen(
+				details::Position::fromStage(stage),
+				output);
+
+		EXPECT_EQ(std::string_view(output, length), stage.fen());
+		EXPECT_EQ(output[length], '\0');
+	}
+}
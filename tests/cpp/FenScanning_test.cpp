@@ -0,0 +1,197 @@
+#include "TestUtils.h"
+
+#include "details/bitboard/Position.h"
+#include "details/fen/PlacementScanner.h"
+
+#include <array>
+
+using namespace simplechess;
+using namespace simplechess::details;
+
+namespace
+{
+	const std::vector<std::string> ValidPlacements = {
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R",
+		"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8",
+		"n1n5/PPPk4/8/8/8/8/4Kppp/5N1N",
+		"rnbqkbnr/rnbqkbnr/rnbqkbnr/rnbqkbnr/RNBQKBNR/RNBQKBNR/RNBQKBNR/RNBQKBNR",
+		"1p1p1p1p/p1p1p1p1/1p1p1p1p/p1p1p1p1/1P1P1P1P/P1P1P1P1/1P1P1P1P/P1P1P1P1",
+		// Ranks may be shorter than eight squares
+		"K/8/8/8/8/8/8/k",
+		"///////",
+		"rnbq/pppp/4/3/2/1/PP/RNBQKB"
+	};
+
+	const std::vector<std::string> MalformedPlacements = {
+		"",
+		"8/8/8/8/8/8/8",
+		"8/8/8/8/8/8/8/8/8",
+		"8/8/8/8/8/8/8/8/",
+		"/8/8/8/8/8/8/8/8",
+		// Digits out of range or in a row
+		"0/8/8/8/8/8/8/8",
+		"9/8/8/8/8/8/8/8",
+		"44/8/8/8/8/8/8/8",
+		"12/8/8/8/8/8/8/8",
+		"k6/8/8/8/8/8/8/K11",
+		// More than eight squares in a rank
+		"rnbqkbnrp/8/8/8/8/8/8/8",
+		"7k1/8/8/8/8/8/8/K7",
+		"8K/8/8/8/8/8/8/k7",
+		"k7/8/8/8/8/8/8/K2p2P2",
+		// Characters which are not pieces
+		"x7/8/8/8/8/8/8/8",
+		"k7/8/8/8/8/8/8/K6 ",
+		"k7/8/8/8/8/8/8/K6\t",
+		"k7/8/8/8/8/8/8/K6-",
+		std::string("k7/8/8/8/8/8/8/K6\0", 18),
+		"k7/8/8/8/8/8/8/K\xC2\xA0",
+		"k7/8/8/8/8/8/8/K@",
+		"k7/8/8/8/8/8/8/K`",
+		"k7/8/8/8/8/8/8/Ka",
+		// Longer than any valid field
+		"rnbqkbnr/rnbqkbnr/rnbqkbnr/rnbqkbnr/RNBQKBNR/RNBQKBNR/RNBQKBNR/RNBQKBNRP"
+	};
+
+	std::vector<placement::Kernel> availableKernels()
+	{
+		std::vector<placement::Kernel> result;
+
+		for (const placement::Kernel kernel
+				: {placement::Kernel::Scalar, placement::Kernel::Avx2})
+		{
+			if (placement::isAvailable(kernel))
+			{
+				result.push_back(kernel);
+			}
+		}
+
+		return result;
+	}
+
+	/**
+	 * Expects every available kernel to give the same answer as the scalar
+	 * one for \p placement.
+	 */
+	void expectKernelsAgree(const std::string& placement)
+	{
+		uint8_t expected[64];
+		const bool expectedValid = placement::scanScalar(
+				placement.data(),
+				placement.size(),
+				expected);
+
+		for (const placement::Kernel kernel : availableKernels())
+		{
+			uint8_t squares[64];
+			const bool valid = placement::scan(
+					kernel,
+					placement.data(),
+					placement.size(),
+					squares);
+
+			ASSERT_EQ(valid, expectedValid)
+				<< "\"" << placement << "\", kernel " << static_cast<int>(kernel);
+
+			if (valid)
+			{
+				ASSERT_TRUE(std::equal(std::begin(squares), std::end(squares), expected))
+					<< "\"" << placement << "\", kernel " << static_cast<int>(kernel);
+			}
+		}
+	}
+}
+
+TEST(FenScanningTest, ValidPlacements) {
+	for (const std::string& placement : ValidPlacements)
+	{
+		for (const placement::Kernel kernel : availableKernels())
+		{
+			uint8_t squares[64];
+			EXPECT_TRUE(placement::scan(
+						kernel,
+						placement.data(),
+						placement.size(),
+						squares)) << placement;
+		}
+
+		expectKernelsAgree(placement);
+	}
+
+	uint8_t squares[64];
+	const std::string& initial = ValidPlacements.front();
+	ASSERT_TRUE(placement::scan(initial.data(), initial.size(), squares));
+
+	EXPECT_EQ(squares[squareIndex(1, 'a')], pieceCode(PieceType::Rook, Color::White));
+	EXPECT_EQ(squares[squareIndex(1, 'e')], pieceCode(PieceType::King, Color::White));
+	EXPECT_EQ(squares[squareIndex(2, 'h')], pieceCode(PieceType::Pawn, Color::White));
+	EXPECT_EQ(squares[squareIndex(4, 'd')], NoPiece);
+	EXPECT_EQ(squares[squareIndex(7, 'c')], pieceCode(PieceType::Pawn, Color::Black));
+	EXPECT_EQ(squares[squareIndex(8, 'b')], pieceCode(PieceType::Knight, Color::Black));
+	EXPECT_EQ(squares[squareIndex(8, 'd')], pieceCode(PieceType::Queen, Color::Black));
+	EXPECT_EQ(squares[squareIndex(8, 'f')], pieceCode(PieceType::Bishop, Color::Black));
+}
+
+TEST(FenScanningTest, MalformedPlacementsAreRejected) {
+	for (const std::string& placement : MalformedPlacements)
+	{
+		for (const placement::Kernel kernel : availableKernels())
+		{
+			uint8_t squares[64];
+			EXPECT_FALSE(placement::scan(
+						kernel,
+						placement.data(),
+						placement.size(),
+						squares))
+				<< "\"" << placement << "\", kernel " << static_cast<int>(kernel);
+		}
+
+		EXPECT_THROW(
+				createGameFromFen(placement + " w - - 0 1"),
+				std::invalid_argument) << placement;
+	}
+}
+
+TEST(FenScanningTest, KernelsAgreeOnMutatedPlacements) {
+	const std::string alphabet = "pnbrqkPNBRQK0123456789/ xX@`\x7F\xC2";
+	uint32_t seed = 11;
+
+	const auto next = [&seed](const size_t bound)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		return (seed >> 8) % bound;
+	};
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		std::string placement = ValidPlacements[next(ValidPlacements.size())];
+
+		for (size_t edits = 1 + next(3); edits > 0; --edits)
+		{
+			const char c = alphabet[next(alphabet.size())];
+			const size_t at = next(placement.size() + 1);
+
+			switch (next(3))
+			{
+				case 0:
+					placement.insert(at, 1, c);
+					break;
+				case 1:
+					if (at < placement.size())
+					{
+						placement[at] = c;
+					}
+					break;
+				default:
+					if (at < placement.size())
+					{
+						placement.erase(at, 1);
+					}
+					break;
+			}
+		}
+
+		expectKernelsAgree(placement);
+	}
+}
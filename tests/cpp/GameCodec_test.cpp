@@ -0,0 +1,301 @@
+#include "TestUtils.h"
+
+#include <cpp/simplechess/GameCodec.h>
+#include <cpp/simplechess/Notation.h>
+
+#include <sstream>
+
+using namespace simplechess;
+
+namespace
+{
+	void expectSameGame(const Game& actual, const Game& expected)
+	{
+		ASSERT_EQ(actual.gameState(), expected.gameState());
+
+		if (expected.gameState() == GameState::Drawn)
+		{
+			EXPECT_EQ(actual.drawReason(), expected.drawReason());
+		}
+
+		EXPECT_EQ(actual.drawEnforcement(), expected.drawEnforcement());
+
+		if (expected.gameState() == GameState::Playing)
+		{
+			EXPECT_EQ(actual.reasonToClaimDraw(), expected.reasonToClaimDraw());
+		}
+
+		EXPECT_EQ(actual.currentStage().fen(), expected.currentStage().fen());
+		EXPECT_EQ(
+				actual.currentStage().checkStatus(),
+				expected.currentStage().checkStatus());
+		EXPECT_EQ(actual.allAvailableMoves(), expected.allAvailableMoves());
+
+		ASSERT_EQ(actual.history().size(), expected.history().size());
+
+		for (size_t i = 0; i < expected.history().size(); ++i)
+		{
+			const auto& [actualStage, actualMove] = actual.history()[i];
+			const auto& [expectedStage, expectedMove] = expected.history()[i];
+
+			EXPECT_EQ(actualStage.fen(), expectedStage.fen()) << i;
+			EXPECT_EQ(actualStage.checkStatus(), expectedStage.checkStatus()) << i;
+			EXPECT_EQ(actualMove.pieceMove(), expectedMove.pieceMove()) << i;
+			EXPECT_EQ(actualMove.capturedPiece(), expectedMove.capturedPiece()) << i;
+			EXPECT_EQ(actualMove.checkType(), expectedMove.checkType()) << i;
+			EXPECT_EQ(actualMove.isDrawOffered(), expectedMove.isDrawOffered()) << i;
+			EXPECT_EQ(
+					actualMove.inAlgebraicNotation(),
+					expectedMove.inAlgebraicNotation()) << i;
+		}
+	}
+
+	Game playUciMoves(Game game, const std::vector<std::string>& moves)
+	{
+		for (const std::string& uci : moves)
+		{
+			game = makeMove(game, pieceMoveFromUci(game.currentStage(), uci));
+		}
+
+		return game;
+	}
+
+	/**
+	 * Plays up to \p plies pseudo-random moves, offering a draw every now
+	 * and then.
+	 */
+	Game playPseudoRandomMoves(Game game, const size_t plies, uint32_t seed)
+	{
+		for (size_t i = 0; i < plies && game.gameState() == GameState::Playing; ++i)
+		{
+			seed = seed * 1664525u + 1013904223u;
+
+			const std::pmr::set<PieceMove>& moves = game.allAvailableMoves();
+			auto it = moves.begin();
+			std::advance(it, (seed >> 8) % moves.size());
+
+			game = makeMove(game, *it, (seed >> 4) % 11 == 0);
+		}
+
+		return game;
+	}
+}
+
+TEST(GameCodecTest, NewGameIsThreeBytes) {
+	const Game game = createNewGame();
+	const std::vector<uint8_t> record = encodeGame(game);
+
+	EXPECT_EQ(record.size(), 3u);
+	expectSameGame(decodeGame(record), game);
+}
+
+TEST(GameCodecTest, OneBytePerMove) {
+	const Game game = playUciMoves(
+			createNewGame(),
+			{"e2e4", "e7e5", "g1f3", "b8c6", "f1b5", "a7a6", "b5c6", "d7c6",
+			"e1g1", "f7f6", "d2d4", "e5d4", "f3d4", "c6c5", "d4b3", "d8d1",
+			"f1d1"});
+
+	const std::vector<uint8_t> record = encodeGame(game);
+
+	EXPECT_EQ(record.size(), 3u + game.history().size());
+	expectSameGame(decodeGame(record), game);
+}
+
+TEST(GameCodecTest, PseudoRandomGamesRoundTrip) {
+	const std::vector<std::pair<std::string, DrawEnforcement>> starts = {
+		{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+			DrawEnforcement::ClaimOnly},
+		{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+			DrawEnforcement::Automatic},
+		{"n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1",
+			DrawEnforcement::Automatic}
+	};
+
+	uint32_t seed = 7;
+
+	for (const auto& [fen, enforcement] : starts)
+	{
+		const Game game = playPseudoRandomMoves(
+				createGameFromFen(fen, enforcement),
+				20,
+				seed++);
+
+		expectSameGame(decodeGame(encodeGame(game)), game);
+	}
+}
+
+TEST(GameCodecTest, GameStartingWithEnPassantTarget) {
+	const Game game = playUciMoves(
+			createGameFromFen(
+				"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3"),
+			{"e5f6", "g8f6"});
+
+	expectSameGame(decodeGame(encodeGame(game)), game);
+}
+
+TEST(GameCodecTest, FinalStateIsRestored) {
+	const Game played = playUciMoves(createNewGame(), {"e2e4", "e7e5"});
+
+	expectSameGame(
+			decodeGame(encodeGame(resign(played, Color::White))),
+			resign(played, Color::White));
+
+	const Game offered = makeMove(
+			played,
+			pieceMoveFromUci(played.currentStage(), "g1f3"),
+			true);
+	const Game agreed = claimDraw(offered);
+
+	expectSameGame(decodeGame(encodeGame(offered)), offered);
+	expectSameGame(decodeGame(encodeGame(agreed)), agreed);
+
+	const Game mated = playUciMoves(
+			createNewGame(),
+			{"f2f3", "e7e5", "g2g4", "d8h4"});
+
+	ASSERT_EQ(mated.gameState(), GameState::BlackWon);
+	expectSameGame(decodeGame(encodeGame(mated)), mated);
+}
+
+TEST(GameCodecTest, RepetitionsAreRestored) {
+	const std::vector<std::string> shuffle
+		= {"g1f3", "g8f6", "f3g1", "f6g8"};
+
+	std::vector<std::string> moves;
+
+	for (int i = 0; i < 2; ++i)
+	{
+		moves.insert(moves.end(), shuffle.begin(), shuffle.end());
+	}
+
+	const Game threefold = playUciMoves(
+			createNewGame(DrawEnforcement::ClaimOnly),
+			moves);
+
+	ASSERT_TRUE(threefold.reasonToClaimDraw().has_value());
+	expectSameGame(decodeGame(encodeGame(threefold)), threefold);
+	expectSameGame(
+			decodeGame(encodeGame(claimDraw(threefold))),
+			claimDraw(threefold));
+
+	for (int i = 0; i < 2; ++i)
+	{
+		moves.insert(moves.end(), shuffle.begin(), shuffle.end());
+	}
+
+	const Game fivefold = playUciMoves(createNewGame(), moves);
+
+	ASSERT_EQ(fivefold.gameState(), GameState::Drawn);
+	expectSameGame(decodeGame(encodeGame(fivefold)), fivefold);
+}
+
+TEST(GameCodecTest, ConcatenatedRecords) {
+	const std::vector<Game> games = {
+		createNewGame(),
+		playUciMoves(createNewGame(), {"d2d4", "d7d5", "c2c4"}),
+		createGameFromFen("4k3/8/8/8/8/8/4P3/4K3 w - - 0 1")
+	};
+
+	std::vector<uint8_t> buffer;
+	std::stringstream stream;
+
+	for (const Game& game : games)
+	{
+		encodeGame(game, buffer);
+		encodeGame(game, stream);
+	}
+
+	size_t offset = 0;
+
+	for (const Game& game : games)
+	{
+		size_t consumed = 0;
+		expectSameGame(
+				decodeGame(buffer.data() + offset, buffer.size() - offset, &consumed),
+				game);
+		offset += consumed;
+
+		expectSameGame(decodeGame(stream), game);
+	}
+
+	EXPECT_EQ(offset, buffer.size());
+	EXPECT_THROW(decodeGame(stream), std::invalid_argument);
+}
+
+TEST(GameCodecTest, UnjustifiedFinalStatesAreRejected) {
+	// Overwrites the final state of an encoded record
+	const auto drawn = [](std::vector<uint8_t> record, const DrawReason reason)
+	{
+		record[0] = static_cast<uint8_t>((record[0] & ~0x03) | static_cast<uint8_t>(GameState::Drawn));
+		record[1] = static_cast<uint8_t>(static_cast<uint8_t>(reason) + 1);
+		return record;
+	};
+
+	const Game played = playUciMoves(createNewGame(), {"e2e4", "e7e5"});
+	const std::vector<uint8_t> record = encodeGame(played);
+
+	for (const DrawReason reason : {DrawReason::StaleMate, DrawReason::InsufficientMaterial,
+			DrawReason::OfferedAndAccepted, DrawReason::ThreeFoldRepetition,
+			DrawReason::FiveFoldRepetition, DrawReason::FiftyMoveRule,
+			DrawReason::SeventyFiveMoveRule, DrawReason::OpponentInsufficientMaterial})
+	{
+		EXPECT_THROW(decodeGame(drawn(record, reason)), std::invalid_argument)
+			<< static_cast<int>(reason);
+	}
+
+	// A draw can only be agreed right after it was offered
+	const Game offeredEarlier = playUciMoves(
+			makeMove(played, pieceMoveFromUci(played.currentStage(), "g1f3"), true),
+			{"b8c6"});
+	const std::vector<uint8_t> agreedLate
+		= drawn(encodeGame(offeredEarlier), DrawReason::OfferedAndAccepted);
+	EXPECT_THROW(decodeGame(agreedLate), std::invalid_argument);
+
+	// Only the draw which could be claimed is accepted
+	const Game repeated = playUciMoves(
+			createNewGame(DrawEnforcement::ClaimOnly),
+			{"g1f3", "g8f6", "f3g1", "f6g8", "g1f3", "g8f6", "f3g1", "f6g8"});
+	ASSERT_EQ(repeated.reasonToClaimDraw(), DrawReason::ThreeFoldRepetition);
+
+	const Game claimed = claimDraw(repeated);
+	expectSameGame(decodeGame(encodeGame(claimed)), claimed);
+	EXPECT_THROW(
+			decodeGame(drawn(encodeGame(claimed), DrawReason::FiftyMoveRule)),
+			std::invalid_argument);
+}
+
+TEST(GameCodecTest, MalformedRecordsAreRejected) {
+	const std::vector<uint8_t> record = encodeGame(
+			playUciMoves(createNewGame(), {"e2e4", "e7e5"}));
+
+	for (size_t size = 0; size < record.size(); ++size)
+	{
+		EXPECT_THROW(decodeGame(record.data(), size), std::invalid_argument)
+			<< size;
+	}
+
+	// Reserved flags
+	std::vector<uint8_t> corrupt = record;
+	corrupt[0] |= 0x80;
+	EXPECT_THROW(decodeGame(corrupt), std::invalid_argument);
+
+	// Drawn without a reason
+	corrupt = record;
+	corrupt[0] = static_cast<uint8_t>(GameState::Drawn);
+	EXPECT_THROW(decodeGame(corrupt), std::invalid_argument);
+
+	// Move index out of range
+	corrupt = record;
+	corrupt.back() = 200;
+	EXPECT_THROW(decodeGame(corrupt), std::invalid_argument);
+
+	// Moves after checkmate
+	std::vector<uint8_t> mated = encodeGame(playUciMoves(
+				createNewGame(),
+				{"f2f3", "e7e5", "g2g4", "d8h4"}));
+	mated[0] = static_cast<uint8_t>(GameState::Playing);
+	mated[2] = 5;
+	mated.push_back(0);
+	EXPECT_THROW(decodeGame(mated), std::invalid_argument);
+}
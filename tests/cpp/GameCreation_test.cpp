@@ -18,7 +18,7 @@ TEST(GameCreationTest, RegularGameCreation) {
 	EXPECT_EQ(game.reasonToClaimDraw(), std::optional<DrawReason>());
 
 	// Validate piece positions
-	const std::map<Square, Piece> expectedPositions = {
+	const std::pmr::map<Square, Piece> expectedPositions = {
 		{Square::fromRankAndFile(8, 'a'), {PieceType::Rook,   Color::Black}},
 		{Square::fromRankAndFile(8, 'b'), {PieceType::Knight, Color::Black}},
 		{Square::fromRankAndFile(8, 'c'), {PieceType::Bishop, Color::Black}},
@@ -71,7 +71,7 @@ TEST(GameCreationTest, GameCreationFromPosition1) {
 	EXPECT_EQ(game.reasonToClaimDraw(), std::optional<DrawReason>());
 
 	// Validate piece positions
-	const std::map<Square, Piece> expectedPositions = {
+	const std::pmr::map<Square, Piece> expectedPositions = {
 		{Square::fromRankAndFile(8, 'f'), {PieceType::Rook,   Color::Black}},
 		{Square::fromRankAndFile(8, 'g'), {PieceType::King,   Color::Black}},
 		{Square::fromRankAndFile(7, 'd'), {PieceType::Queen,  Color::White}},
@@ -0,0 +1,192 @@
+#include "TestUtils.h"
+
+#include <cpp/simplechess/Exceptions.h>
+#include <cpp/simplechess/GameManager.h>
+#include <cpp/simplechess/Notation.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace simplechess;
+
+namespace
+{
+	PieceMove uciMove(const Game& game, const std::string& uci)
+	{
+		return pieceMoveFromUci(game.currentStage(), uci);
+	}
+}
+
+TEST(GameManagerTest, HostsGames) {
+	GameManager manager(5);
+	EXPECT_EQ(manager.shards(), 8u);
+
+	const GameManager::GameId first = manager.add(createNewGame());
+	const GameManager::GameId second = manager.add(
+			createGameFromFen("4k3/8/8/8/8/8/4P3/4K3 w - - 0 1"));
+
+	EXPECT_NE(first, second);
+	EXPECT_EQ(manager.size(), 2u);
+
+	const std::shared_ptr<const Game> initial = manager.get(first);
+	ASSERT_NE(initial, nullptr);
+
+	const std::shared_ptr<const Game> moved
+		= manager.makeMove(first, ::uciMove(*initial, "e2e4"), true);
+
+	EXPECT_EQ(manager.get(first), moved);
+	EXPECT_EQ(moved->history().size(), 1u);
+	EXPECT_TRUE(moved->history().back().second.isDrawOffered());
+
+	// Snapshots are not affected by later updates
+	EXPECT_TRUE(initial->history().empty());
+
+	// Failed updates leave the game untouched
+	EXPECT_THROW(
+			manager.makeMove(first, ::uciMove(*initial, "d2d4")),
+			IllegalStateException);
+	EXPECT_EQ(manager.get(first), moved);
+
+	EXPECT_EQ(manager.claimDraw(first)->gameState(), GameState::Drawn);
+	EXPECT_EQ(
+			manager.resign(second, Color::White)->gameState(),
+			GameState::BlackWon);
+	EXPECT_THROW(manager.resign(second, Color::Black), IllegalStateException);
+
+	EXPECT_TRUE(manager.remove(first));
+	EXPECT_FALSE(manager.remove(first));
+	EXPECT_EQ(manager.get(first), nullptr);
+	EXPECT_THROW(manager.claimDraw(first), std::invalid_argument);
+	EXPECT_EQ(manager.size(), 1u);
+}
+
+TEST(GameManagerTest, UpdatesOfAGameAreSerialized) {
+	GameManager manager;
+	const GameManager::GameId id = manager.add(
+			createNewGame(DrawEnforcement::ClaimOnly));
+
+	const std::vector<std::string> shuffle = {"g1f3", "g8f6", "f3g1", "f6g8"};
+
+	// Every thread tries to play the next move of the shuffle, so moves
+	// made on stale snapshots must fail instead of being lost
+	std::atomic<size_t> played(0);
+	std::atomic<size_t> resignations(0);
+	std::vector<std::thread> threads;
+
+	for (int t = 0; t < 4; ++t)
+	{
+		threads.emplace_back([&]()
+				{
+					while (played.load() < 6)
+					{
+						const std::shared_ptr<const Game> game = manager.get(id);
+						const std::string& uci
+							= shuffle[game->history().size() % shuffle.size()];
+
+						try
+						{
+							manager.makeMove(id, ::uciMove(*game, uci));
+							++played;
+						}
+						catch (const IllegalStateException&)
+						{
+						}
+					}
+
+					try
+					{
+						manager.resign(id, Color::White);
+						++resignations;
+					}
+					catch (const IllegalStateException&)
+					{
+					}
+				});
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	const std::shared_ptr<const Game> game = manager.get(id);
+
+	EXPECT_EQ(resignations.load(), 1u);
+	EXPECT_EQ(game->gameState(), GameState::BlackWon);
+	EXPECT_EQ(game->history().size(), played.load());
+
+	for (size_t i = 0; i < game->history().size(); ++i)
+	{
+		EXPECT_EQ(
+				game->history()[i].second.pieceMove(),
+				::uciMove(
+					i == 0 ? createNewGame() : createGameFromFen(std::string(game->history()[i].first.fen())),
+					shuffle[i % shuffle.size()])) << i;
+	}
+}
+
+TEST(GameManagerTest, ConcurrentGamesAndStatistics) {
+	GameManager manager(4);
+
+	constexpr size_t GamesPerThread = 25;
+	std::vector<std::vector<GameManager::GameId>> ids(4);
+	std::vector<std::thread> threads;
+
+	for (size_t t = 0; t < ids.size(); ++t)
+	{
+		threads.emplace_back([&, t]()
+				{
+					for (size_t i = 0; i < GamesPerThread; ++i)
+					{
+						ids[t].push_back(manager.add(createNewGame()));
+					}
+
+					for (const GameManager::GameId id : ids[t])
+					{
+						manager.resign(id, (t % 2 == 0) ? Color::White : Color::Black);
+						manager.get(id);
+					}
+				});
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	EXPECT_EQ(manager.size(), ids.size() * GamesPerThread);
+
+	for (size_t t = 0; t < ids.size(); ++t)
+	{
+		for (const GameManager::GameId id : ids[t])
+		{
+			EXPECT_EQ(
+					manager.get(id)->gameState(),
+					(t % 2 == 0) ? GameState::BlackWon : GameState::WhiteWon);
+		}
+	}
+
+	const std::vector<GameManagerShardStatistics> statistics = manager.statistics();
+	ASSERT_EQ(statistics.size(), 4u);
+
+	size_t games = 0;
+	uint64_t lookups = 0;
+	uint64_t updates = 0;
+
+	for (const GameManagerShardStatistics& shard : statistics)
+	{
+		games += shard.games;
+		lookups += shard.lookups;
+		updates += shard.updates;
+
+		EXPECT_GT(shard.games, 0u);
+		EXPECT_LE(shard.contendedLookups, shard.lookups);
+		EXPECT_LE(shard.contendedUpdates, shard.updates);
+	}
+
+	EXPECT_EQ(games, manager.size());
+	EXPECT_EQ(updates, games);
+
+	// Every game was added, resigned and read twice
+	EXPECT_EQ(lookups, 4 * games);
+}
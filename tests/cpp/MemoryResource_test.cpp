@@ -0,0 +1,247 @@
+#include "TestUtils.h"
+
+#include <cpp/simplechess/Notation.h>
+
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+using namespace simplechess;
+
+namespace
+{
+	// Allocations from the global heap are counted while this is set
+	thread_local bool sCountingAllocations = false;
+	size_t sCountedAllocations = 0;
+}
+
+void* operator new(std::size_t size)
+{
+	if (sCountingAllocations)
+	{
+		++sCountedAllocations;
+	}
+
+	if (void* p = std::malloc(size ? size : 1))
+	{
+		return p;
+	}
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+// The default memory resource allocates with the alignment of the blocks
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	if (sCountingAllocations)
+	{
+		++sCountedAllocations;
+	}
+
+	const std::size_t align = static_cast<std::size_t>(alignment);
+	const std::size_t rounded = ((size ? size : 1) + align - 1) / align * align;
+
+	if (void* p = std::aligned_alloc(align, rounded))
+	{
+		return p;
+	}
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+	std::free(p);
+}
+
+namespace
+{
+	const std::string InitialPositionFen
+		= "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+	/**
+	 * Memory resource which forwards to another one (the global heap by
+	 * default) and keeps track of the blocks still allocated from it.
+	 */
+	class CountingResource : public std::pmr::memory_resource
+	{
+		public:
+			explicit CountingResource(
+					std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+				: mUpstream(upstream)
+			{
+			}
+
+			size_t allocations = 0;
+			size_t outstanding = 0;
+
+		private:
+			std::pmr::memory_resource* mUpstream;
+
+			void* do_allocate(const size_t bytes, const size_t alignment) override
+			{
+				++allocations;
+				++outstanding;
+				return mUpstream->allocate(bytes, alignment);
+			}
+
+			void do_deallocate(
+					void* p,
+					const size_t bytes,
+					const size_t alignment) override
+			{
+				--outstanding;
+				mUpstream->deallocate(p, bytes, alignment);
+			}
+
+			bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+			{
+				return this == &other;
+			}
+	};
+
+	void expectAllocatesFrom(
+			const Game& game,
+			const std::pmr::memory_resource* resource)
+	{
+		EXPECT_EQ(game.get_allocator().resource(), resource);
+	}
+}
+
+TEST(MemoryResourceTest, GamesAllocateFromGivenResource) {
+	CountingResource resource;
+
+	{
+		const Game initial = createNewGame(DrawEnforcement::Automatic, &resource);
+		expectAllocatesFrom(initial, &resource);
+		EXPECT_GT(resource.allocations, 0u);
+
+		const Game game = createGameFromUciMoves(
+				::InitialPositionFen,
+				{"e2e4", "e7e5", "g1f3"},
+				DrawEnforcement::Automatic,
+				&resource);
+		expectAllocatesFrom(game, &resource);
+
+		const Game fromFen = createGameFromFen(
+				"4k3/8/8/8/8/8/4P3/4K3 w - - 0 1",
+				DrawEnforcement::Automatic,
+				&resource);
+		expectAllocatesFrom(fromFen, &resource);
+	}
+
+	EXPECT_EQ(resource.outstanding, 0u);
+}
+
+TEST(MemoryResourceTest, DerivedGamesKeepTheResource) {
+	CountingResource resource;
+
+	{
+		const Game game = createNewGame(DrawEnforcement::Automatic, &resource);
+		const Game next = makeMove(
+				game,
+				pieceMoveFromUci(game.currentStage(), "d2d4"),
+				true);
+		expectAllocatesFrom(next, &resource);
+
+		const Result<Game> tried = tryMakeMove(
+				next,
+				pieceMoveFromUci(next.currentStage(), "d7d5"));
+		ASSERT_TRUE(tried.ok());
+		expectAllocatesFrom(tried.value(), &resource);
+
+		expectAllocatesFrom(claimDraw(next), &resource);
+		expectAllocatesFrom(resign(next, Color::White), &resource);
+	}
+
+	EXPECT_EQ(resource.outstanding, 0u);
+}
+
+TEST(MemoryResourceTest, CopyIntoAnotherResource) {
+	CountingResource source;
+	CountingResource target;
+
+	{
+		const Game game = createGameFromUciMoves(
+				::InitialPositionFen,
+				{"e2e4", "c7c5"},
+				DrawEnforcement::Automatic,
+				&source);
+
+		// A plain copy does not keep the resource
+		const Game copy(game);
+		expectAllocatesFrom(copy, std::pmr::get_default_resource());
+
+		const Game moved(Game(game), &target);
+		expectAllocatesFrom(moved, &target);
+		EXPECT_EQ(moved.currentStage().fen(), game.currentStage().fen());
+		EXPECT_EQ(moved.history().size(), game.history().size());
+		EXPECT_EQ(moved.allAvailableMoves(), game.allAvailableMoves());
+
+		// Containers propagate their resource to the games they hold
+		std::pmr::vector<Game> games(&target);
+		games.push_back(game);
+		games.emplace_back(makeMove(
+					game,
+					pieceMoveFromUci(game.currentStage(), "g1f3")));
+		expectAllocatesFrom(games[0], &target);
+		expectAllocatesFrom(games[1], &target);
+	}
+
+	EXPECT_EQ(source.outstanding, 0u);
+	EXPECT_EQ(target.outstanding, 0u);
+}
+
+TEST(MemoryResourceTest, MovesDoNotAllocateFromTheGlobalHeap) {
+	// The resource of the game takes its memory from a buffer allocated
+	// up front, so that only the allocations of makeMove are counted
+	std::vector<std::byte> buffer(1 << 20);
+	std::pmr::monotonic_buffer_resource arena(
+			buffer.data(),
+			buffer.size(),
+			std::pmr::null_memory_resource());
+	CountingResource resource(&arena);
+
+	Game game = createNewGame(DrawEnforcement::Automatic, &resource);
+
+	// Castling, captures, a pin and a threefold repetition
+	const std::vector<std::string> moves = {
+		"e2e4", "e7e5", "g1f3", "b8c6", "f1c4", "f8c5", "e1g1", "g8f6",
+		"d2d3", "e8g8", "c1g5", "h7h6", "g5f6", "d8f6",
+		"f3e1", "f6e7", "e1f3", "e7f6", "f3e1", "f6e7", "e1f3", "e7f6"};
+
+	sCountedAllocations = 0;
+
+	for (const std::string& uci : moves)
+	{
+		const PieceMove move = pieceMoveFromUci(game.currentStage(), uci);
+		const size_t allocationsBefore = resource.allocations;
+
+		sCountingAllocations = true;
+		game = makeMove(game, move);
+		sCountingAllocations = false;
+
+		EXPECT_GT(resource.allocations, allocationsBefore) << uci;
+	}
+
+	EXPECT_EQ(sCountedAllocations, 0u);
+	expectAllocatesFrom(game, &resource);
+	EXPECT_EQ(game.history().size(), moves.size());
+	EXPECT_EQ(game.reasonToClaimDraw(), DrawReason::ThreeFoldRepetition);
+}
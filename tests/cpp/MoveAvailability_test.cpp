@@ -9,7 +9,7 @@ using namespace simplechess;
 TEST(MoveAvailabilityTest, RegularGameMoves) {
 	const Game game = createNewGame();
 
-	const std::set<PieceMove> expectedAvailableMoves =
+	const std::pmr::set<PieceMove> expectedAvailableMoves =
 	{
 		PieceMove::regularMove(
 				{PieceType::Pawn, Color::White},
@@ -112,7 +112,7 @@ TEST(MoveAvailabilityTest, RegularGameMoves) {
 				Square::fromRankAndFile(3, 'h')),
 	};
 
-	const std::set<PieceMove> availableMoves = game.allAvailableMoves();
+	const std::pmr::set<PieceMove> availableMoves = game.allAvailableMoves();
 	EXPECT_EQ(availableMoves.size(), expectedAvailableMoves.size());
 	EXPECT_EQ(availableMoves, expectedAvailableMoves);
 }
@@ -121,7 +121,7 @@ TEST(MoveAvailabilityTest, KnightMovesUnobstructed) {
 	const Game game = createGameFromFen(
 			"7k/8/8/8/3N4/8/8/K7 w - - 0 1");
 
-	const std::set<PieceMove> expectedAvailableMoves =
+	const std::pmr::set<PieceMove> expectedAvailableMoves =
 	{
 		PieceMove::regularMove(
 				{PieceType::King, Color::White},
@@ -179,7 +179,7 @@ TEST(MoveAvailabilityTest, KnightMovesUnobstructed) {
 				Square::fromRankAndFile(2, 'e'))
 	};
 
-	const std::set<PieceMove> availableMoves = game.allAvailableMoves();
+	const std::pmr::set<PieceMove> availableMoves = game.allAvailableMoves();
 	EXPECT_EQ(availableMoves.size(), expectedAvailableMoves.size());
 	EXPECT_EQ(availableMoves, expectedAvailableMoves);
 }
@@ -190,7 +190,7 @@ TEST(MoveAvailabilityTest, KnightMovesObstructedAttempt) {
 	const Game game = createGameFromFen(
 			"7k/8/8/2rrr3/2rNr3/2rrr3/8/K7 w - - 0 1");
 
-	const std::set<PieceMove> expectedAvailableMoves =
+	const std::pmr::set<PieceMove> expectedAvailableMoves =
 	{
 		PieceMove::regularMove(
 				{PieceType::King, Color::White},
@@ -248,7 +248,7 @@ TEST(MoveAvailabilityTest, KnightMovesObstructedAttempt) {
 				Square::fromRankAndFile(2, 'e'))
 	};
 
-	const std::set<PieceMove> availableMoves = game.allAvailableMoves();
+	const std::pmr::set<PieceMove> availableMoves = game.allAvailableMoves();
 	EXPECT_EQ(availableMoves.size(), expectedAvailableMoves.size());
 	EXPECT_EQ(availableMoves, expectedAvailableMoves);
 }
@@ -257,7 +257,7 @@ TEST(MoveAvailabilityTest, BishopMovesUnobstructed) {
 	const Game game = createGameFromFen(
 			"3k4/8/8/3BB3/8/8/8/3K4 w - - 0 1");
 
-	const std::set<PieceMove> expectedAvailableMoves =
+	const std::pmr::set<PieceMove> expectedAvailableMoves =
 	{
 		PieceMove::regularMove(
 				{PieceType::King, Color::White},
@@ -415,7 +415,7 @@ TEST(MoveAvailabilityTest, BishopMovesUnobstructed) {
 				Square::fromRankAndFile(2, 'h')),
 	};
 
-	const std::set<PieceMove> availableMoves = game.allAvailableMoves();
+	const std::pmr::set<PieceMove> availableMoves = game.allAvailableMoves();
 	EXPECT_EQ(availableMoves.size(), expectedAvailableMoves.size());
 	EXPECT_EQ(availableMoves, expectedAvailableMoves);
 }
@@ -424,7 +424,7 @@ TEST(MoveAvailabilityTest, BishopMovesObstructed) {
 	const Game game = createGameFromFen(
 			"7k/r5r1/3r4/8/1r1B2r1/8/1r3r2/2K5 w - - 0 1");
 
-	const std::set<PieceMove> expectedAvailableMoves =
+	const std::pmr::set<PieceMove> expectedAvailableMoves =
 	{
 		PieceMove::regularMove(
 				{PieceType::King, Color::White},
@@ -482,7 +482,7 @@ TEST(MoveAvailabilityTest, BishopMovesObstructed) {
 				Square::fromRankAndFile(2, 'f'))
 	};
 
-	const std::set<PieceMove> availableMoves = game.allAvailableMoves();
+	const std::pmr::set<PieceMove> availableMoves = game.allAvailableMoves();
 	EXPECT_EQ(availableMoves.size(), expectedAvailableMoves.size());
 	EXPECT_EQ(availableMoves, expectedAvailableMoves);
 }
@@ -491,7 +491,7 @@ TEST(MoveAvailabilityTest, RookMovesUnobstructed) {
 	const Game game = createGameFromFen(
 			"4k3/8/8/3R4/8/8/8/4K3 w - - 0 1");
 
-	const std::set<PieceMove> expectedAvailableMoves =
+	const std::pmr::set<PieceMove> expectedAvailableMoves =
 	{
 		PieceMove::regularMove(
 				{PieceType::King, Color::White},
@@ -589,7 +589,7 @@ TEST(MoveAvailabilityTest, RookMovesUnobstructed) {
 				Square::fromRankAndFile(1, 'd'))
 	};
 
-	const std::set<PieceMove> availableMoves = game.allAvailableMoves();
+	const std::pmr::set<PieceMove> availableMoves = game.allAvailableMoves();
 	EXPECT_EQ(availableMoves.size(), expectedAvailableMoves.size());
 	EXPECT_EQ(availableMoves, expectedAvailableMoves);
 }
@@ -598,7 +598,7 @@ TEST(MoveAvailabilityTest, RookMovesObstructed) {
 	const Game game = createGameFromFen(
 			"7k/r5r1/3r4/8/1r1R2r1/8/1r3r2/2K5 w - - 0 1");
 
-	const std::set<PieceMove> expectedAvailableMoves =
+	const std::pmr::set<PieceMove> expectedAvailableMoves =
 	{
 		PieceMove::regularMove(
 				{PieceType::King, Color::White},
@@ -656,7 +656,7 @@ TEST(MoveAvailabilityTest, RookMovesObstructed) {
 				Square::fromRankAndFile(1, 'd'))
 	};
 
-	const std::set<PieceMove> availableMoves = game.allAvailableMoves();
+	const std::pmr::set<PieceMove> availableMoves = game.allAvailableMoves();
 	EXPECT_EQ(availableMoves.size(), expectedAvailableMoves.size());
 	EXPECT_EQ(availableMoves, expectedAvailableMoves);
 }
@@ -665,7 +665,7 @@ TEST(MoveAvailabilityTest, QueenMovesUnobstructed) {
 	const Game game = createGameFromFen(
 			"4k3/8/8/3Q4/8/8/8/4K3 w - - 0 1");
 
-	const std::set<PieceMove> expectedAvailableMoves =
+	const std::pmr::set<PieceMove> expectedAvailableMoves =
 	{
 		PieceMove::regularMove(
 				{PieceType::King, Color::White},
@@ -828,7 +828,7 @@ TEST(MoveAvailabilityTest, QueenMovesUnobstructed) {
 				Square::fromRankAndFile(1, 'd'))
 	};
 
-	const std::set<PieceMove> availableMoves = game.allAvailableMoves();
+	const std::pmr::set<PieceMove> availableMoves = game.allAvailableMoves();
 	EXPECT_EQ(availableMoves.size(), expectedAvailableMoves.size());
 	EXPECT_EQ(availableMoves, expectedAvailableMoves);
 }
@@ -837,7 +837,7 @@ TEST(MoveAvailabilityTest, QueenMovesObstructed) {
 	const Game game = createGameFromFen(
 			"7k/r5r1/3r4/8/1r1Q2r1/8/1r3r2/2K5 w - - 0 1");
 
-	const std::set<PieceMove> expectedAvailableMoves =
+	const std::pmr::set<PieceMove> expectedAvailableMoves =
 	{
 		PieceMove::regularMove(
 				{PieceType::King, Color::White},
@@ -945,7 +945,7 @@ TEST(MoveAvailabilityTest, QueenMovesObstructed) {
 				Square::fromRankAndFile(2, 'f'))
 	};
 
-	const std::set<PieceMove> availableMoves = game.allAvailableMoves();
+	const std::pmr::set<PieceMove> availableMoves = game.allAvailableMoves();
 	EXPECT_EQ(availableMoves.size(), expectedAvailableMoves.size());
 	EXPECT_EQ(availableMoves, expectedAvailableMoves);
 }
@@ -954,7 +954,7 @@ TEST(MoveAvailabilityTest, WhiteCastlingUnobstructed) {
 	const Game game = createGameFromFen(
 			"1k6/8/8/8/8/8/8/R3K2R w KQ - 0 1");
 
-	const std::set<PieceMove> expectedAvailableMoves =
+	const std::pmr::set<PieceMove> expectedAvailableMoves =
 	{
 		PieceMove::regularMove(
 				{PieceType::Rook, Color::White},
@@ -1062,7 +1062,7 @@ TEST(MoveAvailabilityTest, WhiteCastlingUnobstructed) {
 				Square::fromRankAndFile(1, 'g')),
 	};
 
-	const std::set<PieceMove> availableMoves = game.allAvailableMoves();
+	const std::pmr::set<PieceMove> availableMoves = game.allAvailableMoves();
 	EXPECT_EQ(availableMoves.size(), expectedAvailableMoves.size());
 	EXPECT_EQ(availableMoves, expectedAvailableMoves);
 }
@@ -1071,7 +1071,7 @@ TEST(MoveAvailabilityTest, WhiteCastlingQueensideObstructed) {
 	const Game game = createGameFromFen(
 			"1k6/8/8/6b1/8/8/8/R3K2R w KQ - 0 1");
 
-	const std::set<PieceMove> expectedAvailableMoves =
+	const std::pmr::set<PieceMove> expectedAvailableMoves =
 	{
 		PieceMove::regularMove(
 				{PieceType::Rook, Color::White},
@@ -1171,7 +1171,7 @@ TEST(MoveAvailabilityTest, WhiteCastlingQueensideObstructed) {
 				Square::fromRankAndFile(1, 'g')),
 	};
 
-	const std::set<PieceMove> availableMoves = game.allAvailableMoves();
+	const std::pmr::set<PieceMove> availableMoves = game.allAvailableMoves();
 	EXPECT_EQ(availableMoves.size(), expectedAvailableMoves.size());
 	EXPECT_EQ(availableMoves, expectedAvailableMoves);
 }
@@ -1180,7 +1180,7 @@ TEST(MoveAvailabilityTest, WhiteCastlingBothObstructed) {
 	const Game game = createGameFromFen(
 			"1k6/8/8/6q1/8/8/8/R3K2R w KQ - 0 1");
 
-	const std::set<PieceMove> expectedAvailableMoves =
+	const std::pmr::set<PieceMove> expectedAvailableMoves =
 	{
 		PieceMove::regularMove(
 				{PieceType::Rook, Color::White},
@@ -1276,11 +1276,31 @@ TEST(MoveAvailabilityTest, WhiteCastlingBothObstructed) {
 				Square::fromRankAndFile(1, 'f')),
 	};
 
-	const std::set<PieceMove> availableMoves = game.allAvailableMoves();
+	const std::pmr::set<PieceMove> availableMoves = game.allAvailableMoves();
 	EXPECT_EQ(availableMoves.size(), expectedAvailableMoves.size());
 	EXPECT_EQ(availableMoves, expectedAvailableMoves);
 }
 
+TEST(MoveAvailabilityTest, WhiteCastlingQueensideRookPathObstructed) {
+	// The king's path is clear, but the rook's is not
+	const Game game = createGameFromFen(
+			"1k6/8/8/8/8/8/8/RN2K2R w KQ - 0 1");
+
+	const PieceMove kingSideCastling = PieceMove::regularMove(
+				{PieceType::King, Color::White},
+				Square::fromRankAndFile(1, 'e'),
+				Square::fromRankAndFile(1, 'g'));
+
+	const PieceMove queenSideCastling = PieceMove::regularMove(
+				{PieceType::King, Color::White},
+				Square::fromRankAndFile(1, 'e'),
+				Square::fromRankAndFile(1, 'c'));
+
+	const std::pmr::set<PieceMove> availableMoves = game.allAvailableMoves();
+	EXPECT_EQ(availableMoves.count(kingSideCastling), 1);
+	EXPECT_EQ(availableMoves.count(queenSideCastling), 0);
+}
+
 TEST(MoveAvailabilityTest, WhiteCastlingUnavailable) {
 	const Game game = createGameFromFen(
 			"1k6/8/8/8/8/8/8/R3K2R w - - 0 1");
@@ -1295,7 +1315,7 @@ TEST(MoveAvailabilityTest, WhiteCastlingUnavailable) {
 				Square::fromRankAndFile(1, 'e'),
 				Square::fromRankAndFile(1, 'c'));
 
-	const std::set<PieceMove> availableMoves = game.allAvailableMoves();
+	const std::pmr::set<PieceMove> availableMoves = game.allAvailableMoves();
 	EXPECT_EQ(availableMoves.count(kingSideCastling), 0);
 	EXPECT_EQ(availableMoves.count(queenSideCastling), 0);
 }
@@ -1314,7 +1334,7 @@ TEST(MoveAvailabilityTest, BlackCastlingInCheck) {
 				Square::fromRankAndFile(8, 'e'),
 				Square::fromRankAndFile(8, 'c'));
 
-	const std::set<PieceMove> availableMoves = game.allAvailableMoves();
+	const std::pmr::set<PieceMove> availableMoves = game.allAvailableMoves();
 	EXPECT_EQ(availableMoves.count(kingSideCastling), 0);
 	EXPECT_EQ(availableMoves.count(queenSideCastling), 0);
 }
@@ -1328,7 +1348,7 @@ TEST(MoveAvailabilityTest, EnPassantAvailable) {
 				Square::fromRankAndFile(4, 'e'),
 				Square::fromRankAndFile(3, 'f'));
 
-	const std::set<PieceMove> availableMoves = game.allAvailableMoves();
+	const std::pmr::set<PieceMove> availableMoves = game.allAvailableMoves();
 	EXPECT_EQ(availableMoves.count(enPassant), 1);
 }
 
@@ -1341,7 +1361,7 @@ TEST(MoveAvailabilityTest, EnPassantWouldLeaveInCheck) {
 				Square::fromRankAndFile(5, 'e'),
 				Square::fromRankAndFile(6, 'd'));
 
-	const std::set<PieceMove> availableMoves = game.allAvailableMoves();
+	const std::pmr::set<PieceMove> availableMoves = game.allAvailableMoves();
 	EXPECT_EQ(availableMoves.count(enPassant), 0);
 }
 
@@ -1421,7 +1441,7 @@ TEST(MoveAvailabilityTest, PawnPromotion) {
 				Square::fromRankAndFile(8, 'e'),
 				PieceType::King);
 
-	const std::set<PieceMove> availableMoves = game.allAvailableMoves();
+	const std::pmr::set<PieceMove> availableMoves = game.allAvailableMoves();
 	EXPECT_EQ(availableMoves.count(promotionQueen), 1);
 	EXPECT_EQ(availableMoves.count(promotionQueenWithCapture), 1);
 	EXPECT_EQ(availableMoves.count(promotionRook), 1);
@@ -1435,3 +1455,80 @@ TEST(MoveAvailabilityTest, PawnPromotion) {
 	EXPECT_EQ(availableMoves.count(wrongPromotionPawn), 0);
 	EXPECT_EQ(availableMoves.count(wrongPromotionPawnWithCapture), 0);
 }
+
+TEST(MoveAvailabilityTest, MovesForPieceAreGroupedBySquare) {
+	const std::vector<std::string> fens = {
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1",
+		"rnb1kbnr/pppp1ppp/8/4p3/6Pq/5P2/PPPPP2P/RNBQKBNR w KQkq - 1 3"
+	};
+
+	for (const std::string& fen : fens)
+	{
+		const Game game = createGameFromFen(fen);
+		size_t total = 0;
+
+		for (uint8_t rank = 1; rank <= 8; ++rank)
+		{
+			for (char file = 'a'; file <= 'h'; ++file)
+			{
+				const Square square = Square::fromRankAndFile(rank, file);
+				const PieceMoveRange moves = game.availableMovesForPiece(square);
+
+				std::vector<PieceMove> expected;
+				std::copy_if(
+						game.allAvailableMoves().begin(),
+						game.allAvailableMoves().end(),
+						std::back_inserter(expected),
+						[&square](const PieceMove& move) { return move.src() == square; });
+
+				EXPECT_EQ(std::vector<PieceMove>(moves.begin(), moves.end()), expected)
+					<< fen << " " << square.toString();
+				total += moves.size();
+			}
+		}
+
+		EXPECT_EQ(total, game.allAvailableMoves().size()) << fen;
+	}
+}
+
+TEST(MoveAvailabilityTest, IsLegal) {
+	const Game game = createGameFromFen("n1n5/PPPk4/8/8/8/8/4Kppp/5N1N w - - 0 1");
+
+	for (const PieceMove& move : game.allAvailableMoves())
+	{
+		EXPECT_TRUE(game.isLegal(move));
+	}
+
+	// Capture with promotion
+	EXPECT_TRUE(game.isLegal(PieceMove::pawnPromotion(
+					{PieceType::Pawn, Color::White},
+					Square::fromString("b7"),
+					Square::fromString("a8"),
+					PieceType::Knight)));
+
+	// Same squares without promotion
+	EXPECT_FALSE(game.isLegal(PieceMove::regularMove(
+					{PieceType::Pawn, Color::White},
+					Square::fromString("b7"),
+					Square::fromString("a8"))));
+
+	// Wrong piece on the origin square
+	EXPECT_FALSE(game.isLegal(PieceMove::regularMove(
+					{PieceType::Queen, Color::White},
+					Square::fromString("e2"),
+					Square::fromString("e3"))));
+
+	// Piece of the side not to move
+	EXPECT_FALSE(game.isLegal(PieceMove::regularMove(
+					{PieceType::King, Color::Black},
+					Square::fromString("d7"),
+					Square::fromString("e6"))));
+
+	// Empty origin square
+	EXPECT_FALSE(game.isLegal(PieceMove::regularMove(
+					{PieceType::King, Color::White},
+					Square::fromString("e4"),
+					Square::fromString("e5"))));
+}
@@ -0,0 +1,126 @@
+#include "TestUtils.h"
+
+#include <cpp/simplechess/Evaluation.h>
+#include <cpp/simplechess/PackedPosition.h>
+
+#include <unordered_set>
+
+using namespace simplechess;
+
+namespace
+{
+	const std::vector<std::string> Fens = {
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+		"rnbqkbnr/pppp1ppp/8/8/3pP3/8/PPP2PPP/RNBQKBNR b Kq e3 0 3",
+		"8/8/8/8/8/8/8/K6k w - - 99 300",
+		"4k3/8/8/8/8/8/8/4K2R b K - 1 65535"
+	};
+}
+
+TEST(PackedPositionTest, RoundTrip) {
+	for (const std::string& fen : Fens)
+	{
+		const GameStage stage = createGameFromFen(fen).currentStage();
+		const PackedPosition packed = packPosition(stage);
+		const GameStage unpacked = unpackPosition(packed);
+
+		EXPECT_EQ(std::string_view(unpacked.fen()), fen);
+		EXPECT_EQ(unpacked.checkStatus(), stage.checkStatus());
+		EXPECT_EQ(packPosition(unpacked), packed);
+		EXPECT_EQ(
+				std::string_view(createGameFromPackedPosition(packed).currentStage().fen()),
+				fen);
+	}
+}
+
+TEST(PackedPositionTest, Layout) {
+	const PackedPosition packed
+		= packPosition(createGameFromFen("8/8/8/8/8/8/8/K6k b - - 7 300").currentStage());
+
+	const PackedPosition expected = {{
+		// a1 and h1 occupied
+		0x81, 0, 0, 0, 0, 0, 0, 0,
+		// White king (6), then black king (12)
+		0xC6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		// Black to move, no castling rights, no en passant target
+		0x01, 0x00,
+		// Clocks
+		7, 0, 0x2C, 0x01,
+		0, 0}};
+
+	EXPECT_EQ(packed, expected);
+}
+
+TEST(PackedPositionTest, DistinctStagesHaveDistinctKeys) {
+	std::unordered_set<PackedPosition> keys;
+
+	for (const std::string& fen : Fens)
+	{
+		keys.insert(packPosition(createGameFromFen(fen).currentStage()));
+	}
+
+	EXPECT_EQ(keys.size(), Fens.size());
+}
+
+TEST(PackedPositionTest, MalformedPackedPositionsAreRejected) {
+	const PackedPosition valid
+		= packPosition(createGameFromFen(Fens[0]).currentStage());
+
+	// More than 32 pieces
+	PackedPosition corrupt = valid;
+	corrupt.bytes[3] = 0x01;
+	EXPECT_THROW(unpackPosition(corrupt), std::invalid_argument);
+
+	// Invalid piece code
+	corrupt = valid;
+	corrupt.bytes[8] = 0x0F;
+	EXPECT_THROW(unpackPosition(corrupt), std::invalid_argument);
+
+	// Reserved bits
+	corrupt = valid;
+	corrupt.bytes[31] = 1;
+	EXPECT_THROW(unpackPosition(corrupt), std::invalid_argument);
+
+	// Invalid en passant file
+	corrupt = valid;
+	corrupt.bytes[25] = 9;
+	EXPECT_THROW(unpackPosition(corrupt), std::invalid_argument);
+
+	// No kings
+	PackedPosition empty = {};
+	empty.bytes[28] = 1;
+	EXPECT_THROW(unpackPosition(empty), std::invalid_argument);
+
+	// Well formed, but the side not to move is in check
+	const PackedPosition checking = packPosition(unpackPosition(packPosition(
+					createGameFromFen("4k3/8/8/8/8/8/8/4R1K1 b - - 0 1").currentStage())));
+	PackedPosition wrongSide = checking;
+	wrongSide.bytes[24] ^= 1;
+	EXPECT_NO_THROW(unpackPosition(checking));
+	EXPECT_THROW(unpackPosition(wrongSide), std::invalid_argument);
+	EXPECT_THROW(createGameFromPackedPosition(wrongSide), std::invalid_argument);
+	EXPECT_THROW(evaluatePositions({wrongSide}), std::invalid_argument);
+
+	// Well formed, but with a black pawn on the first rank
+	PackedPosition promotionRank = {};
+	promotionRank.bytes[0] = 0x11;   // a1 and e1
+	promotionRank.bytes[7] = 0x10;   // e8
+	promotionRank.bytes[8] = 0x67;   // Black pawn, white king
+	promotionRank.bytes[9] = 0x0C;   // Black king
+	promotionRank.bytes[28] = 1;
+	EXPECT_THROW(unpackPosition(promotionRank), std::invalid_argument);
+	EXPECT_THROW(evaluatePositions({promotionRank}), std::invalid_argument);
+
+	// Black knight instead
+	promotionRank.bytes[8] = 0x68;
+	EXPECT_NO_THROW(unpackPosition(promotionRank));
+}
+
+TEST(PackedPositionTest, TooManyPiecesToPack) {
+	const GameStage crowded = createGameFromFen(
+			"qqqqkqqq/qqqqqqqq/8/8/8/P7/QQQQQQQQ/QQQQKQQQ w - - 0 1").currentStage();
+
+	EXPECT_THROW(packPosition(crowded), std::invalid_argument);
+}
@@ -0,0 +1,111 @@
+#include "TestUtils.h"
+
+#include "details/GameStageUpdater.h"
+#include "details/bitboard/Perft.h"
+
+using namespace simplechess;
+using namespace simplechess::details;
+
+namespace
+{
+	Position positionFromFen(const std::string& fen)
+	{
+		return Position::fromStage(createGameFromFen(fen).currentStage());
+	}
+}
+
+TEST(PerftTest, InitialPosition) {
+	const Position position = Position::fromStage(createNewGame().currentStage());
+
+	EXPECT_EQ(Perft::count(position, 1), 20);
+	EXPECT_EQ(Perft::count(position, 2), 400);
+	EXPECT_EQ(Perft::count(position, 3), 8902);
+	EXPECT_EQ(Perft::count(position, 4), 197281);
+}
+
+TEST(PerftTest, Kiwipete) {
+	const Position position = ::positionFromFen(
+			"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+
+	EXPECT_EQ(Perft::count(position, 1), 48);
+	EXPECT_EQ(Perft::count(position, 2), 2039);
+	EXPECT_EQ(Perft::count(position, 3), 97862);
+}
+
+TEST(PerftTest, EnPassantAndDiscoveredChecks) {
+	const Position position = ::positionFromFen(
+			"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1");
+
+	EXPECT_EQ(Perft::count(position, 1), 14);
+	EXPECT_EQ(Perft::count(position, 2), 191);
+	EXPECT_EQ(Perft::count(position, 3), 2812);
+	EXPECT_EQ(Perft::count(position, 4), 43238);
+}
+
+TEST(PerftTest, PromotionsAndCastling) {
+	const Position position = ::positionFromFen(
+			"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1");
+
+	EXPECT_EQ(Perft::count(position, 1), 6);
+	EXPECT_EQ(Perft::count(position, 2), 264);
+	EXPECT_EQ(Perft::count(position, 3), 9467);
+}
+
+TEST(PerftTest, Divide) {
+	const Position position = ::positionFromFen(
+			"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8");
+
+	uint64_t total = 0;
+	for (const auto& entry : Perft::divide(position, 3))
+	{
+		total += entry.second;
+	}
+
+	EXPECT_EQ(Perft::divide(position, 1).size(), 44);
+	EXPECT_EQ(Perft::count(position, 2), 1486);
+	EXPECT_EQ(total, 62379);
+}
+
+TEST(PerftTest, LegalMovesMatchAvailableMoves) {
+	const std::vector<std::string> fens = {
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+		"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+		"2k5/6b1/8/3pP3/8/8/1K6/8 w - d6 0 1"
+	};
+
+	for (const std::string& fen : fens)
+	{
+		const Game game = createGameFromFen(fen);
+		const Position position = Position::fromStage(game.currentStage());
+
+		MoveList moves;
+		position.legalMoves(moves);
+
+		std::pmr::set<PieceMove> generated;
+		for (const Move& move : moves)
+		{
+			generated.insert(position.toPieceMove(move));
+		}
+
+		EXPECT_EQ(generated, game.allAvailableMoves()) << fen;
+
+		// The hash is updated incrementally in the same way it is computed
+		// from scratch
+		for (const Move& move : moves)
+		{
+			Position next = position;
+			next.makeMove(move);
+
+			const Position expected = Position::fromStage(
+					GameStageUpdater::makeMove(
+						game.currentStage(),
+						position.toPieceMove(move),
+						false));
+
+			EXPECT_EQ(next.hash(), expected.hash()) << fen;
+			EXPECT_TRUE(next.isRepetitionOf(expected)) << fen;
+		}
+	}
+}
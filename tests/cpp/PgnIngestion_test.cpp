@@ -0,0 +1,257 @@
+#include "TestUtils.h"
+
+#include <cpp/simplechess/Notation.h>
+#include <cpp/simplechess/Pgn.h>
+
+#include "details/PgnParser.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+
+using namespace simplechess;
+
+namespace
+{
+	const std::string Database =
+		"[Event \"Casual game\"]\n"
+		"[White \"Someone \\\"quoted\\\"\"]\n"
+		"[Result \"1-0\"]\n"
+		"\n"
+		"1.e4 {best by test} e5 2. Bc4 (2. Nf3 Nc6 {a comment (not a variation)} 3. Bb5) 2... Nc6\n"
+		"3. Qh5 $2 Nf6?? ; the losing move\n"
+		"4. Qxf7# 1-0\n"
+		"\n"
+		"[Event \"Endgame\"]\n"
+		"[SetUp \"1\"]\n"
+		"[FEN \"4k3/8/8/8/8/8/4P3/4K3 b - - 0 12\"]\n"
+		"\n"
+		"12... Kd7 13. e4 (=) Ke6 14. O-O *\n"
+		"\n"
+		"[Event \"Castling\"]\n"
+		"%escaped line which is ignored\n"
+		"\n"
+		"1. Nf3 d5 2. g3 Nc6 3. Bg2 Bg4 4. 0-0 Qd7 5. d3 0-0-0 1/2-1/2\n";
+
+	std::vector<PgnGameRecord> ingestAll(
+			const std::string& database,
+			const PgnIngestionOptions& options = {})
+	{
+		std::mutex mutex;
+		std::vector<PgnGameRecord> records;
+
+		const size_t count = ingestPgn(
+				database,
+				[&](const PgnGameRecord& record)
+				{
+					const std::lock_guard<std::mutex> lock(mutex);
+					records.push_back(record);
+				},
+				options);
+
+		EXPECT_EQ(count, records.size());
+
+		std::sort(records.begin(), records.end(),
+				[](const PgnGameRecord& lhs, const PgnGameRecord& rhs)
+				{
+					return lhs.index < rhs.index;
+				});
+
+		return records;
+	}
+}
+
+TEST(PgnIngestionTest, ParsesTagsMovesAndResults) {
+	PgnIngestionOptions options;
+	options.threads = 3;
+
+	const std::vector<PgnGameRecord> records = ::ingestAll(::Database, options);
+	ASSERT_EQ(records.size(), 3);
+
+	// Comments, variations, annotations and move numbers are skipped
+	EXPECT_EQ(records[0].tags.size(), 3);
+	EXPECT_EQ(records[0].tags[1].second, "Someone \"quoted\"");
+	EXPECT_EQ(records[0].moves.size(), 7);
+	EXPECT_EQ(records[0].result, "1-0");
+	EXPECT_FALSE(records[0].error);
+	ASSERT_TRUE(records[0].game);
+	EXPECT_EQ(records[0].game->gameState(), GameState::WhiteWon);
+
+	// Custom initial position, and an illegal move
+	EXPECT_EQ(records[1].moves.size(), 3);
+	EXPECT_TRUE(records[1].error);
+	EXPECT_FALSE(records[1].game);
+
+	EXPECT_EQ(records[2].moves.size(), 10);
+	EXPECT_EQ(records[2].result, "1/2-1/2");
+	ASSERT_TRUE(records[2].game);
+	EXPECT_EQ(
+			records[2].game->currentStage().fen(),
+			"2kr1bnr/pppqpppp/2n5/3p4/6b1/3P1NP1/PPP1PPBP/RNBQ1RK1 w - - 1 6");
+	ASSERT_EQ(records[2].game->history().size(), 10);
+	EXPECT_EQ(records[2].game->history()[8].second.inAlgebraicNotation(), "d3");
+	EXPECT_EQ(records[2].game->history()[9].second.inAlgebraicNotation(), "O-O-O");
+}
+
+TEST(PgnIngestionTest, RepetitionsCompletedAfterTheRecord) {
+	const std::vector<PgnGameRecord> records
+		= ::ingestAll("1. Nf3 Nf6 2. Ng1 Ng8 3. Nf3 *\n");
+	ASSERT_EQ(records.size(), 1);
+	ASSERT_TRUE(records[0].game);
+	EXPECT_EQ(records[0].game->history().size(), 5);
+	EXPECT_FALSE(records[0].game->reasonToClaimDraw());
+
+	Game game = *records[0].game;
+	for (const std::string uci : {"g8f6", "f3g1", "f6g8"})
+	{
+		game = makeMove(game, pieceMoveFromUci(game.currentStage(), uci));
+	}
+
+	EXPECT_EQ(game.reasonToClaimDraw(), DrawReason::ThreeFoldRepetition);
+}
+
+TEST(PgnIngestionTest, MovesAfterTheEndAreRejected) {
+	const std::string database =
+		"[FEN \"4k3/8/8/8/8/8/4q3/4K3 w - - 0 1\"]\n"
+		"\n"
+		"1. Kxe2 Ke7 1/2-1/2\n"
+		"\n"
+		"[Event \"Fool's mate\"]\n"
+		"\n"
+		"1. f3 e5 2. g4 Qh4# 3. e4 0-1\n";
+
+	const std::vector<PgnGameRecord> records = ::ingestAll(database);
+	ASSERT_EQ(records.size(), 2);
+
+	// Only the kings are left after the capture
+	EXPECT_EQ(records[0].moves.size(), 1);
+	EXPECT_TRUE(records[0].error);
+	EXPECT_FALSE(records[0].game);
+
+	EXPECT_EQ(records[1].moves.size(), 4);
+	EXPECT_TRUE(records[1].error);
+	EXPECT_FALSE(records[1].game);
+
+	// Unless the draw is only claimable
+	PgnIngestionOptions options;
+	options.drawEnforcement = DrawEnforcement::ClaimOnly;
+
+	const std::vector<PgnGameRecord> claimOnly = ::ingestAll(database, options);
+	ASSERT_EQ(claimOnly.size(), 2);
+	EXPECT_FALSE(claimOnly[0].error);
+	ASSERT_TRUE(claimOnly[0].game);
+	EXPECT_EQ(
+			claimOnly[0].game->reasonToClaimDraw(),
+			DrawReason::InsufficientMaterial);
+}
+
+TEST(PgnIngestionTest, WrittenGamesCanBeReplayed) {
+	std::vector<Game> games;
+
+	for (const std::vector<std::string>& moves : std::vector<std::vector<std::string>>{
+			{"e2e4", "e7e5", "g1f3", "b8c6", "f1b5", "a7a6", "b5c6", "d7c6", "e1g1"},
+			{"d2d4", "d7d5", "c2c4", "d5c4", "e2e4", "b7b5", "a2a4", "c7c6"},
+			{"f2f3", "e7e5", "g2g4", "d8h4"}})
+	{
+		Game game = createNewGame();
+		for (const std::string& uci : moves)
+		{
+			game = makeMove(game, pieceMoveFromUci(game.currentStage(), uci), uci == "c7c6");
+		}
+		games.push_back(game);
+	}
+
+	std::string database;
+	PgnWriter::toString(database).write(games);
+
+	PgnIngestionOptions options;
+	options.threads = 2;
+
+	const std::vector<PgnGameRecord> records = ::ingestAll(database, options);
+	ASSERT_EQ(records.size(), games.size());
+
+	for (size_t i = 0; i < games.size(); ++i)
+	{
+		ASSERT_TRUE(records[i].game) << *records[i].error;
+		EXPECT_EQ(records[i].game->currentStage().fen(), games[i].currentStage().fen());
+		EXPECT_EQ(records[i].game->gameState(), games[i].gameState());
+		EXPECT_EQ(records[i].moves.size(), games[i].history().size());
+
+		for (size_t ply = 0; ply < records[i].moves.size(); ++ply)
+		{
+			EXPECT_EQ(records[i].moves[ply], games[i].history()[ply].second.pieceMove());
+		}
+	}
+}
+
+TEST(PgnIngestionTest, IngestFile) {
+	const std::string path = testing::TempDir() + "simplechess_ingestion_test.pgn";
+
+	{
+		std::ofstream file(path, std::ios::binary);
+		file << ::Database;
+	}
+
+	size_t games = 0;
+	std::mutex mutex;
+
+	EXPECT_EQ(
+			ingestPgnFile(path, [&](const PgnGameRecord&)
+			{
+				const std::lock_guard<std::mutex> lock(mutex);
+				++games;
+			}),
+			3);
+	EXPECT_EQ(games, 3);
+
+	std::remove(path.c_str());
+
+	EXPECT_THROW(
+			ingestPgnFile(path, [](const PgnGameRecord&) {}),
+			std::system_error);
+}
+
+TEST(PgnIngestionTest, CallbackExceptionsArePropagated) {
+	PgnIngestionOptions options;
+	options.threads = 2;
+
+	EXPECT_THROW(
+			ingestPgn(
+				::Database,
+				[](const PgnGameRecord&)
+				{
+					throw std::runtime_error("Stop");
+				},
+				options),
+			std::runtime_error);
+}
+
+TEST(PgnIngestionTest, GameBoundariesDoNotDependOnChunks) {
+	std::string database;
+	for (int i = 0; i < 20; ++i)
+	{
+		database += ::Database + "\n";
+	}
+
+	const std::vector<size_t> expected = details::PgnParser::findGameStarts(
+			database.data(), database.size(), 0, database.size());
+	EXPECT_EQ(expected.size(), 60);
+
+	for (const size_t chunks : {2, 7, 64, 1000})
+	{
+		std::vector<size_t> starts;
+
+		for (size_t chunk = 0; chunk < chunks; ++chunk)
+		{
+			const std::vector<size_t> chunkStarts = details::PgnParser::findGameStarts(
+					database.data(),
+					database.size(),
+					database.size() * chunk / chunks,
+					database.size() * (chunk + 1) / chunks);
+			starts.insert(starts.end(), chunkStarts.begin(), chunkStarts.end());
+		}
+
+		EXPECT_EQ(starts, expected) << chunks;
+	}
+}
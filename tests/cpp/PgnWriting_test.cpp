@@ -0,0 +1,152 @@
+#include "TestUtils.h"
+
+#include <cpp/simplechess/Notation.h>
+#include <cpp/simplechess/Pgn.h>
+
+#include <cstdio>
+#include <sstream>
+
+using namespace simplechess;
+
+namespace
+{
+	Game playMoves(Game game, const std::vector<std::string>& moves)
+	{
+		for (const std::string& san : moves)
+		{
+			game = makeMove(game, pieceMoveFromAlgebraicNotation(game.currentStage(), san));
+		}
+
+		return game;
+	}
+}
+
+TEST(PgnWritingTest, FinishedGame) {
+	const Game game = ::playMoves(
+			createNewGame(),
+			{"e4", "e5", "Bc4", "Nc6", "Qh5", "Nf6", "Qxf7#"});
+
+	EXPECT_EQ(
+			gameToPgn(game),
+			"[Event \"?\"]\n"
+			"[Site \"?\"]\n"
+			"[Date \"????.??.??\"]\n"
+			"[Round \"?\"]\n"
+			"[White \"?\"]\n"
+			"[Black \"?\"]\n"
+			"[Result \"1-0\"]\n"
+			"\n"
+			"1. e4 e5 2. Bc4 Nc6 3. Qh5 Nf6 4. Qxf7# 1-0\n"
+			"\n");
+}
+
+TEST(PgnWritingTest, Tags) {
+	const Game game = resign(createNewGame(), Color::White);
+
+	EXPECT_EQ(
+			gameToPgn(game, {
+				{"Annotator", "Someone"},
+				{"White", "Player \"One\""},
+				{"Result", "1-0"},
+				{"Event", "C:\\Games"}}),
+			"[Event \"C:\\\\Games\"]\n"
+			"[Site \"?\"]\n"
+			"[Date \"????.??.??\"]\n"
+			"[Round \"?\"]\n"
+			"[White \"Player \\\"One\\\"\"]\n"
+			"[Black \"?\"]\n"
+			"[Result \"0-1\"]\n"
+			"[Annotator \"Someone\"]\n"
+			"\n"
+			"0-1\n"
+			"\n");
+}
+
+TEST(PgnWritingTest, CustomInitialPositionAndDrawOffer) {
+	const std::string fen = "4k3/8/8/8/8/8/4P3/4K3 b - - 0 12";
+	Game game = createGameFromFen(fen);
+	game = makeMove(game, pieceMoveFromAlgebraicNotation(game.currentStage(), "Kd7"));
+	game = makeMove(game, pieceMoveFromAlgebraicNotation(game.currentStage(), "e4"), true);
+	game = claimDraw(game);
+
+	EXPECT_EQ(
+			gameToPgn(game),
+			"[Event \"?\"]\n"
+			"[Site \"?\"]\n"
+			"[Date \"????.??.??\"]\n"
+			"[Round \"?\"]\n"
+			"[White \"?\"]\n"
+			"[Black \"?\"]\n"
+			"[Result \"1/2-1/2\"]\n"
+			"[SetUp \"1\"]\n"
+			"[FEN \"" + fen + "\"]\n"
+			"\n"
+			"12... Kd7 13. e4 {draw offer} 1/2-1/2\n"
+			"\n");
+}
+
+TEST(PgnWritingTest, LongLinesAreWrapped) {
+	std::vector<std::string> moves;
+	for (int i = 0; i < 10; ++i)
+	{
+		moves.insert(moves.end(), {"Nf3", "Nf6", "Ng1", "Ng8"});
+	}
+
+	const Game game = ::playMoves(createNewGame(DrawEnforcement::ClaimOnly), moves);
+	std::istringstream pgn(gameToPgn(game));
+
+	std::string line;
+	std::string movetext;
+	size_t lines = 0;
+
+	while (std::getline(pgn, line))
+	{
+		EXPECT_LE(line.size(), 80) << line;
+
+		if (!line.empty() && line[0] != '[')
+		{
+			movetext += (movetext.empty() ? "" : " ") + line;
+			++lines;
+		}
+	}
+
+	EXPECT_GT(lines, 1);
+	EXPECT_EQ(movetext.substr(0, 22), "1. Nf3 Nf6 2. Ng1 Ng8 ");
+	EXPECT_EQ(movetext.substr(movetext.size() - 13), "20. Ng1 Ng8 *");
+}
+
+TEST(PgnWritingTest, BatchToFileDescriptor) {
+	const std::vector<Game> games = {
+		::playMoves(createNewGame(), {"f3", "e5", "g4", "Qh4#"}),
+		::playMoves(createNewGame(), {"d4", "d5"}),
+		resign(createNewGame(), Color::Black)
+	};
+
+	std::string expected;
+	for (const Game& game : games)
+	{
+		expected += gameToPgn(game, {{"Site", "Here"}});
+	}
+
+	std::FILE* file = std::tmpfile();
+	ASSERT_NE(file, nullptr);
+
+	{
+		// A tiny buffer forces many partial flushes
+		PgnWriter writer = PgnWriter::toFileDescriptor(fileno(file), 7);
+		writer.write(games, {{"Site", "Here"}});
+		writer.flush();
+	}
+
+	std::rewind(file);
+	std::string written;
+	char chunk[256];
+	size_t read = 0;
+	while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+	{
+		written.append(chunk, read);
+	}
+	std::fclose(file);
+
+	EXPECT_EQ(written, expected);
+}
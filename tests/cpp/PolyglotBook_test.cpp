@@ -0,0 +1,285 @@
+#include "TestUtils.h"
+
+#include <cpp/simplechess/Notation.h>
+#include <cpp/simplechess/PolyglotBook.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+using namespace simplechess;
+
+namespace
+{
+	/**
+	 * Random numbers for the tests. Real books use the table published
+	 * with the Polyglot format, but the layout of the keys is the same.
+	 */
+	const PolyglotRandom64& testRandom64()
+	{
+		static const PolyglotRandom64 random64 = []()
+		{
+			PolyglotRandom64 result;
+			uint64_t state = 0x0123456789ABCDEFULL;
+
+			for (uint64_t& value : result)
+			{
+				state += 0x9E3779B97F4A7C15ULL;
+				uint64_t z = state;
+				z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+				z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+				value = z ^ (z >> 31);
+			}
+
+			return result;
+		}();
+
+		return random64;
+	}
+
+	uint64_t key(const std::string& fen)
+	{
+		return polyglotKey(createGameFromFen(fen).currentStage(), ::testRandom64());
+	}
+
+	/**
+	 * Index of a piece on a square in the random numbers.
+	 */
+	size_t pieceSquare(const size_t kind, const bool white, const std::string& square)
+	{
+		return 64 * (2 * kind + (white ? 1 : 0))
+			+ 8 * static_cast<size_t>(square[1] - '1')
+			+ static_cast<size_t>(square[0] - 'a');
+	}
+
+	/**
+	 * Path of a temporary book for the current test, so that tests can run
+	 * in parallel.
+	 */
+	std::string temporaryPath()
+	{
+		return testing::TempDir() + "simplechess_polyglot_"
+			+ testing::UnitTest::GetInstance()->current_test_info()->name()
+			+ ".bin";
+	}
+
+	struct Entry
+	{
+		uint64_t key;
+		std::string move;
+		uint16_t weight;
+	};
+
+	uint16_t bookMove(const std::string& uci)
+	{
+		const auto square = [](const char file, const char rank)
+		{
+			return static_cast<uint16_t>((rank - '1') * 8 + (file - 'a'));
+		};
+
+		uint16_t promotion = 0;
+
+		if (uci.size() == 5)
+		{
+			promotion = static_cast<uint16_t>(
+					std::string("nbrq").find(uci[4]) + 1);
+		}
+
+		return static_cast<uint16_t>(
+				(promotion << 12)
+				| (square(uci[0], uci[1]) << 6)
+				| square(uci[2], uci[3]));
+	}
+
+	void writeBook(const std::string& path, std::vector<Entry> entries)
+	{
+		std::stable_sort(
+				entries.begin(),
+				entries.end(),
+				[](const Entry& lhs, const Entry& rhs)
+				{
+					return lhs.key < rhs.key;
+				});
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+		for (const Entry& entry : entries)
+		{
+			const uint16_t move = ::bookMove(entry.move);
+			char bytes[PolyglotBook::EntrySize] = {};
+
+			for (int i = 0; i < 8; ++i)
+			{
+				bytes[i] = static_cast<char>(entry.key >> (56 - 8 * i));
+			}
+
+			bytes[8] = static_cast<char>(move >> 8);
+			bytes[9] = static_cast<char>(move);
+			bytes[10] = static_cast<char>(entry.weight >> 8);
+			bytes[11] = static_cast<char>(entry.weight);
+
+			file.write(bytes, sizeof(bytes));
+		}
+	}
+
+	const std::string StartFen
+		= "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+	const std::string CastlingFen
+		= "r3k2r/pppq1ppp/2npbn2/2b1p3/2B1P3/2NPBN2/PPPQ1PPP/R3K2R w KQkq - 0 1";
+	const std::string PromotionFen = "8/1P6/8/8/8/4k3/8/4K3 w - - 0 1";
+}
+
+TEST(PolyglotBookTest, KeyLayout) {
+	const PolyglotRandom64& random64 = ::testRandom64();
+
+	// No black pawn can capture on e3, so the en passant file is ignored
+	EXPECT_EQ(
+			::key("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1")
+				^ ::key(::StartFen),
+			random64[::pieceSquare(0, true, "e2")]
+				^ random64[::pieceSquare(0, true, "e4")]
+				^ random64[780]);
+
+	EXPECT_EQ(
+			::key("rnbqkbnr/ppp1pppp/8/8/3pP3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1")
+				^ ::key("rnbqkbnr/ppp1pppp/8/8/3pP3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1"),
+			random64[772 + 4]);
+
+	EXPECT_EQ(
+			::key("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1")
+				^ ::key("r3k2r/8/8/8/8/8/8/R3K2R w Kk - 0 1"),
+			random64[769] ^ random64[771]);
+
+	EXPECT_EQ(
+			::key("8/8/8/8/8/4k3/8/4K2q w - - 0 1")
+				^ ::key("8/8/8/8/8/4k3/8/4K2Q w - - 0 1"),
+			random64[::pieceSquare(4, false, "h1")]
+				^ random64[::pieceSquare(4, true, "h1")]);
+}
+
+TEST(PolyglotBookTest, ReferenceKeys) {
+	// The reference positions of the format, with their documented keys
+	const std::vector<std::pair<std::string, uint64_t>> references = {
+		{::StartFen, 0x463B96181691FC9CULL},
+		{"rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1",
+			0x823C9B50FD114196ULL},
+		{"rnbqkbnr/ppp1pppp/8/3p4/4P3/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 2",
+			0x0756B94461C50FB0ULL},
+		{"rnbqkbnr/ppp1pppp/8/3pP3/8/8/PPPP1PPP/RNBQKBNR b KQkq - 0 2",
+			0x662FAFB965DB29D4ULL},
+		{"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+			0x22A48B5A8E47FF78ULL},
+		{"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR b kq - 0 3",
+			0x652A607CA3F242C1ULL},
+		{"rnbq1bnr/ppp1pkpp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR w - - 0 4",
+			0x00FDD303C946BDD9ULL},
+		{"rnbqkbnr/p1pppppp/8/8/PpP4P/8/1P1PPPP1/RNBQKBNR b KQkq c3 0 3",
+			0x3C8123EA7B067637ULL},
+		{"rnbqkbnr/p1pppppp/8/8/P6P/R1p5/1P1PPPP1/1NBQKBNR b Kkq - 0 4",
+			0x5C3F9B829B279560ULL}
+	};
+
+	for (const auto& [fen, key] : references)
+	{
+		const GameStage stage = createGameFromFen(fen).currentStage();
+
+		EXPECT_EQ(polyglotKey(stage), key) << fen;
+		EXPECT_EQ(polyglotKey(stage, polyglotRandom64()), key) << fen;
+	}
+}
+
+TEST(PolyglotBookTest, DefaultBookUsesPublishedKeys) {
+	const std::string path = ::temporaryPath();
+
+	::writeBook(path, {
+		{0x463B96181691FC9CULL, "e2e4", 3},
+		{0x823C9B50FD114196ULL, "d7d5", 1}
+	});
+
+	const PolyglotBook book(path);
+	const Game start = createNewGame();
+	const std::vector<BookMove> startMoves = book.moves(start);
+
+	ASSERT_EQ(startMoves.size(), 1u);
+	EXPECT_EQ(startMoves[0].move, pieceMoveFromUci(start.currentStage(), "e2e4"));
+
+	const Game afterE4 = makeMove(start, startMoves[0].move);
+	EXPECT_EQ(*book.chooseMove(afterE4, 0), pieceMoveFromUci(afterE4.currentStage(), "d7d5"));
+
+	std::remove(path.c_str());
+}
+
+TEST(PolyglotBookTest, LooksUpValidatedMoves) {
+	const std::string path = ::temporaryPath();
+
+	std::vector<Entry> entries = {
+		{::key(::StartFen), "e2e4", 10},
+		{::key(::StartFen), "d2d4", 5},
+		{::key(::StartFen), "e2e5", 7},   // Illegal
+		{::key(::StartFen), "c2c4", 0},   // Never played
+		{::key(::CastlingFen), "e1h1", 3},
+		{::key(::CastlingFen), "e1a1", 1},
+		{::key(::PromotionFen), "b7b8n", 2},
+		{::key(::PromotionFen), "b7b8q", 9}
+	};
+
+	// Unrelated positions around the ones looked up
+	for (uint64_t i = 0; i < 500; ++i)
+	{
+		entries.push_back({i * 0x9E3779B97F4A7C15ULL, "g1f3", 1});
+	}
+
+	::writeBook(path, entries);
+
+	const PolyglotBook book(path, ::testRandom64());
+	EXPECT_EQ(book.size(), entries.size());
+
+	const Game start = createNewGame();
+	const std::vector<BookMove> startMoves = book.moves(start);
+
+	ASSERT_EQ(startMoves.size(), 2u);
+	EXPECT_EQ(startMoves[0].move, pieceMoveFromUci(start.currentStage(), "e2e4"));
+	EXPECT_EQ(startMoves[0].weight, 10u);
+	EXPECT_EQ(startMoves[1].move, pieceMoveFromUci(start.currentStage(), "d2d4"));
+	EXPECT_EQ(startMoves[1].weight, 5u);
+
+	EXPECT_EQ(*book.chooseMove(start, 0), startMoves[0].move);
+	EXPECT_EQ(*book.chooseMove(start, 9), startMoves[0].move);
+	EXPECT_EQ(*book.chooseMove(start, 10), startMoves[1].move);
+	EXPECT_EQ(*book.chooseMove(start, 29), startMoves[1].move);
+
+	const Game castling = createGameFromFen(::CastlingFen);
+	const std::vector<BookMove> castlingMoves = book.moves(castling);
+
+	ASSERT_EQ(castlingMoves.size(), 2u);
+	EXPECT_EQ(castlingMoves[0].move, pieceMoveFromUci(castling.currentStage(), "e1g1"));
+	EXPECT_EQ(castlingMoves[1].move, pieceMoveFromUci(castling.currentStage(), "e1c1"));
+
+	const Game promotion = createGameFromFen(::PromotionFen);
+	const std::vector<BookMove> promotionMoves = book.moves(promotion);
+
+	ASSERT_EQ(promotionMoves.size(), 2u);
+	EXPECT_EQ(promotionMoves[0].move, pieceMoveFromUci(promotion.currentStage(), "b7b8n"));
+	EXPECT_EQ(promotionMoves[1].move, pieceMoveFromUci(promotion.currentStage(), "b7b8q"));
+
+	const Game outOfBook = createGameFromFen("4k3/8/8/8/8/8/4P3/4K3 w - - 0 1");
+	EXPECT_TRUE(book.moves(outOfBook).empty());
+	EXPECT_FALSE(book.chooseMove(outOfBook, 0).has_value());
+
+	std::remove(path.c_str());
+}
+
+TEST(PolyglotBookTest, MalformedBooks) {
+	const std::string path = ::temporaryPath();
+
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file << "not a book";
+	}
+
+	EXPECT_THROW(PolyglotBook(path, ::testRandom64()), std::invalid_argument);
+
+	std::remove(path.c_str());
+
+	EXPECT_THROW(PolyglotBook(path, ::testRandom64()), std::system_error);
+}
@@ -0,0 +1,73 @@
+#include "TestUtils.h"
+
+#include <cpp/simplechess/PositionAnalysis.h>
+
+using namespace simplechess;
+
+TEST(PositionAnalysisTest, MatchesCreatedGames) {
+	const std::vector<std::string> fens = {
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+		"rnbqkbnr/pppp1ppp/8/8/3Pp3/8/PPP1PPPP/RNBQKBNR b KQkq d3 0 2",
+		"n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1",
+		"4k3/8/8/8/8/8/8/4K2R b K - 0 1",
+		"4k3/4R3/8/8/8/8/8/4K3 b - - 0 1"
+	};
+
+	for (const std::string& fen : fens)
+	{
+		const PositionAnalysis analysis = analyzePosition(fen);
+		const Game game = createGameFromFen(fen);
+
+		EXPECT_EQ(analysis.activeColor, game.activeColor()) << fen;
+		EXPECT_EQ(analysis.checkStatus, game.currentStage().checkStatus()) << fen;
+
+		const std::vector<PieceMove> expected(
+				game.allAvailableMoves().begin(),
+				game.allAvailableMoves().end());
+		EXPECT_EQ(analysis.availableMoves, expected) << fen;
+	}
+}
+
+TEST(PositionAnalysisTest, CheckmateAndStalemate) {
+	const PositionAnalysis mate = analyzePosition(
+			"rnb1kbnr/pppp1ppp/8/4p3/6Pq/5P2/PPPPP2P/RNBQKBNR w KQkq - 1 3");
+	EXPECT_TRUE(mate.isCheckmate());
+	EXPECT_FALSE(mate.isStalemate());
+	EXPECT_TRUE(mate.availableMoves.empty());
+
+	const PositionAnalysis stalemate = analyzePosition("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1");
+	EXPECT_FALSE(stalemate.isCheckmate());
+	EXPECT_TRUE(stalemate.isStalemate());
+	EXPECT_EQ(stalemate.checkStatus, CheckType::NoCheck);
+
+	const PositionAnalysis check = analyzePosition("4k3/4R3/8/8/8/8/8/4K3 b - - 0 1");
+	EXPECT_EQ(check.checkStatus, CheckType::Check);
+	EXPECT_FALSE(check.isCheckmate());
+	EXPECT_FALSE(check.isStalemate());
+}
+
+TEST(PositionAnalysisTest, InvalidPositionsAreRejected) {
+	const std::vector<std::string> fens = {
+		"",
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0",
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq - 0 1",
+		"rnbqkbnr/pppppppp/44/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"rnbqkbnr/ppppxppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR x KQkq - 0 1",
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkK - 0 1",
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq e3 0 1",
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQ1BNR w kq - 0 1",
+		"4k3/8/8/8/8/8/8/4K2R w Q - 0 1",
+		"4k3/4R3/8/8/8/8/8/4K3 w - - 0 1",
+		"4k3/8/8/8/4P3/8/8/4K3 w - e3 0 1"
+	};
+
+	for (const std::string& fen : fens)
+	{
+		EXPECT_THROW(analyzePosition(fen), std::invalid_argument) << fen;
+		EXPECT_ANY_THROW(createGameFromFen(fen)) << fen;
+	}
+}
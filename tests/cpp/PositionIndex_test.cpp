@@ -0,0 +1,226 @@
+#include "TestUtils.h"
+
+#include <cpp/simplechess/Exceptions.h>
+#include <cpp/simplechess/Notation.h>
+#include <cpp/simplechess/PositionIndex.h>
+
+#include "details/bitboard/Position.h"
+
+#include <cstdio>
+#include <fstream>
+
+using namespace simplechess;
+
+namespace
+{
+	Game playUciMoves(Game game, const std::vector<std::string>& moves)
+	{
+		for (const std::string& uci : moves)
+		{
+			game = makeMove(game, pieceMoveFromUci(game.currentStage(), uci));
+		}
+
+		return game;
+	}
+
+	GameStage stageOf(const std::string& fen)
+	{
+		return createGameFromFen(fen).currentStage();
+	}
+
+	/**
+	 * Path of a temporary file for the current test, so that tests can
+	 * run in parallel.
+	 */
+	std::string temporaryPath(const std::string& extension)
+	{
+		return testing::TempDir() + "simplechess_position_index_"
+			+ testing::UnitTest::GetInstance()->current_test_info()->name()
+			+ extension;
+	}
+
+	std::string indexPath()
+	{
+		return ::temporaryPath(".scpi");
+	}
+}
+
+TEST(PositionIndexTest, FindsTranspositionsAndRepetitions) {
+	const std::vector<Game> games = {
+		::playUciMoves(createNewGame(), {"e2e4", "e7e5", "g1f3", "b8c6"}),
+		::playUciMoves(createNewGame(), {"g1f3", "b8c6", "e2e4", "e7e5", "f1c4"}),
+		::playUciMoves(createNewGame(), {"g1f3", "g8f6", "f3g1", "f6g8", "d2d4"}),
+		createGameFromFen("4k3/8/8/8/8/8/4P3/4K3 w - - 0 1")
+	};
+
+	{
+		PositionIndexBuilder builder(::indexPath());
+		builder.add(games, 10);
+		builder.finish();
+
+		EXPECT_THROW(builder.finish(), IllegalStateException);
+		EXPECT_THROW(builder.add(games, 20), IllegalStateException);
+	}
+
+	const PositionIndex index(::indexPath());
+	EXPECT_EQ(index.size(), 5u + 6u + 6u + 1u);
+
+	EXPECT_EQ(
+			index.find(createNewGame().currentStage()),
+			std::vector<PositionPosting>({{10, 0}, {11, 0}, {12, 0}, {12, 4}}));
+
+	// Move counters do not matter
+	EXPECT_EQ(
+			index.find(::stageOf(
+					"r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 6 9")),
+			std::vector<PositionPosting>({{10, 4}, {11, 4}}));
+
+	EXPECT_EQ(
+			index.find(::stageOf("4k3/8/8/8/8/8/4P3/4K3 w - - 0 1")),
+			std::vector<PositionPosting>({{13, 0}}));
+
+	EXPECT_TRUE(index.find(::stageOf("4k3/8/8/8/8/8/4P3/4K3 b - - 0 1")).empty());
+
+	std::remove(::indexPath().c_str());
+}
+
+TEST(PositionIndexTest, SpilledPostingsAreMerged) {
+	const std::vector<std::string> moves = {
+		"e2e4", "e7e5", "g1f3", "b8c6", "f1b5", "a7a6", "b5a4", "g8f6",
+		"e1g1", "f8e7", "f1e1", "b7b5", "a4b3", "d7d6", "c2c3", "e8g8",
+		"h2h3", "c6b8", "d2d4", "b8d7"
+	};
+
+	// The same game many times, so that the postings of each position
+	// span several fences
+	constexpr uint64_t NumberOfGames = 15;
+	const std::string pgnPath = ::temporaryPath(".pgn");
+
+	{
+		std::ofstream file(pgnPath, std::ios::binary);
+
+		for (uint64_t i = 0; i < NumberOfGames; ++i)
+		{
+			file << "[Event \"Breyer\"]\n\n1. e4 e5 2. Nf3 Nc6 3. Bb5 a6 4. Ba4 Nf6 "
+				<< "5. O-O Be7 6. Re1 b5 7. Bb3 d6 8. c3 O-O 9. h3 Nb8 "
+				<< "10. d4 Nbd7 *\n\n";
+		}
+	}
+
+	const std::string spilledPath = ::indexPath() + ".spilled";
+
+	{
+		PositionIndexBuilder builder(::indexPath());
+		builder.addPgnFile(pgnPath, 0);
+		builder.finish();
+	}
+
+	{
+		// A few games per temporary file
+		PositionIndexOptions options;
+		options.threads = 2;
+		options.memoryLimit = 1024;
+
+		PositionIndexBuilder builder(spilledPath, options);
+		builder.addPgnFile(pgnPath, 0);
+		builder.finish();
+	}
+
+	const PositionIndex index(::indexPath());
+	const PositionIndex spilled(spilledPath);
+
+	ASSERT_EQ(index.size(), NumberOfGames * (moves.size() + 1));
+	ASSERT_GT(index.size(), 256u);
+	EXPECT_EQ(spilled.size(), index.size());
+
+	details::Position position = details::Position::fromStage(createNewGame().currentStage());
+
+	for (uint32_t ply = 0; ply <= moves.size(); ++ply)
+	{
+		std::vector<PositionPosting> expected;
+
+		for (uint64_t gameId = 0; gameId < NumberOfGames; ++gameId)
+		{
+			expected.push_back({gameId, ply});
+		}
+
+		const GameStage stage = position.toStage();
+
+		EXPECT_EQ(index.find(stage), expected) << ply;
+		EXPECT_EQ(spilled.find(stage), expected) << ply;
+
+		if (ply < moves.size())
+		{
+			const std::string& uci = moves[ply];
+			position.makeMove({
+					static_cast<uint8_t>((uci[1] - '1') * 8 + (uci[0] - 'a')),
+					static_cast<uint8_t>((uci[3] - '1') * 8 + (uci[2] - 'a')),
+					PieceType::Pawn});
+		}
+	}
+
+	std::remove(::indexPath().c_str());
+	std::remove(spilledPath.c_str());
+	std::remove(pgnPath.c_str());
+}
+
+TEST(PositionIndexTest, IndexesPgnDatabases) {
+	const std::string pgnPath = ::temporaryPath(".pgn");
+
+	{
+		std::ofstream file(pgnPath, std::ios::binary);
+		file << "[Event \"First\"]\n\n1. e4 e5 2. Nf3 Nc6 1-0\n\n"
+			<< "[Event \"Broken\"]\n\n1. e4 e4 0-1\n\n"
+			<< "[Event \"Endgame\"]\n[SetUp \"1\"]\n"
+			<< "[FEN \"4k3/8/8/8/8/8/4P3/4K3 w - - 0 1\"]\n\n1. e4 Kd7 *\n";
+	}
+
+	{
+		PositionIndexBuilder builder(::indexPath());
+		EXPECT_EQ(builder.addPgnFile(pgnPath, 100), 3u);
+		builder.finish();
+	}
+
+	const PositionIndex index(::indexPath());
+
+	EXPECT_EQ(index.size(), 5u + 3u);
+	EXPECT_EQ(
+			index.find(::stageOf(
+					"r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3")),
+			std::vector<PositionPosting>({{100, 4}}));
+	EXPECT_EQ(
+			index.find(::stageOf("4k3/8/8/8/4P3/8/8/4K3 b - - 0 1")),
+			std::vector<PositionPosting>({{102, 1}}));
+
+	std::remove(::indexPath().c_str());
+	std::remove(pgnPath.c_str());
+}
+
+TEST(PositionIndexTest, InvalidInput) {
+	{
+		PositionIndexBuilder builder(::indexPath());
+
+		EXPECT_THROW(
+				builder.add({createNewGame()}, PositionIndexBuilder::MaxGameId + 1),
+				std::invalid_argument);
+		EXPECT_THROW(
+				builder.add({createNewGame(), createNewGame()}, PositionIndexBuilder::MaxGameId),
+				std::invalid_argument);
+
+		builder.add({createNewGame()}, PositionIndexBuilder::MaxGameId);
+		builder.finish();
+	}
+
+	EXPECT_EQ(
+			PositionIndex(::indexPath()).find(createNewGame().currentStage()),
+			std::vector<PositionPosting>({{PositionIndexBuilder::MaxGameId, 0}}));
+
+	{
+		std::ofstream file(::indexPath(), std::ios::binary | std::ios::trunc);
+		file << "not an index";
+	}
+	EXPECT_THROW(PositionIndex(::indexPath()), std::invalid_argument);
+
+	std::remove(::indexPath().c_str());
+	EXPECT_THROW(PositionIndex(::indexPath()), std::system_error);
+}
@@ -0,0 +1,370 @@
+#include "TestUtils.h"
+
+#include <cpp/simplechess/Notation.h>
+#include <cpp/simplechess/Search.h>
+
+#include "details/bitboard/Position.h"
+#include "details/search/MateSolver.h"
+
+#include <algorithm>
+#include <thread>
+
+using namespace simplechess;
+
+namespace
+{
+	SearchLimits depthLimit(const unsigned depth)
+	{
+		SearchLimits limits;
+		limits.depth = depth;
+		return limits;
+	}
+}
+
+TEST(SearchTest, FindsMateInOne) {
+	const Game game = createGameFromFen("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1");
+	const SearchResult result = findBestMove(game, depthLimit(3));
+
+	EXPECT_EQ(result.bestMove, pieceMoveFromUci(game.currentStage(), "a1a8"));
+	ASSERT_TRUE(result.mateIn.has_value());
+	EXPECT_EQ(*result.mateIn, 1);
+	EXPECT_EQ(result.principalVariation.size(), 1u);
+}
+
+TEST(SearchTest, AvoidsMate) {
+	const Game game = createGameFromFen("6k1/5ppp/8/8/8/8/8/R5K1 b - - 0 1");
+	const SearchResult result = findBestMove(game, depthLimit(4));
+
+	// Making room for the king prevents the back rank mate
+	EXPECT_TRUE(game.isLegal(result.bestMove));
+	EXPECT_FALSE(result.mateIn.has_value());
+	EXPECT_LT(result.score, -100);
+}
+
+TEST(SearchTest, CapturesHangingQueen) {
+	const Game game = createGameFromFen("4k3/8/8/3q4/8/8/8/3RK3 w - - 0 1");
+	const SearchResult result = findBestMove(game, depthLimit(3));
+
+	EXPECT_EQ(result.bestMove, pieceMoveFromUci(game.currentStage(), "d1d5"));
+	EXPECT_GT(result.score, 300);
+	EXPECT_FALSE(result.mateIn.has_value());
+}
+
+TEST(SearchTest, DrawsAreScoredAsZero) {
+	// Taking the last pawn leaves a lone king against king and knight
+	EXPECT_EQ(findBestMove(createGameFromFen("8/8/8/4k3/8/8/5p2/4K2N w - - 0 1"), depthLimit(3)).score, 0);
+
+	// Any move makes the fifty-move rule claimable
+	EXPECT_EQ(findBestMove(createGameFromFen("4k3/8/8/8/8/8/q7/4K3 w - - 99 80"), depthLimit(3)).score, 0);
+}
+
+TEST(SearchTest, LimitsAreHonored) {
+	const Game game = createNewGame();
+
+	const SearchResult byDepth = findBestMove(game, depthLimit(2));
+	EXPECT_EQ(byDepth.depth, 2u);
+	EXPECT_TRUE(game.isLegal(byDepth.bestMove));
+
+	SearchLimits nodes;
+	nodes.nodes = 5000;
+	const SearchResult byNodes = findBestMove(game, nodes);
+	EXPECT_GE(byNodes.depth, 1u);
+	EXPECT_LT(byNodes.nodes, 10000u);
+	EXPECT_TRUE(game.isLegal(byNodes.bestMove));
+
+	SearchLimits time;
+	time.time = std::chrono::milliseconds(50);
+	const SearchResult byTime = findBestMove(game, time);
+	EXPECT_GE(byTime.depth, 1u);
+	EXPECT_TRUE(game.isLegal(byTime.bestMove));
+}
+
+TEST(SearchTest, SeveralThreads) {
+	const Game game = createGameFromFen(
+			"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+
+	SearchLimits limits = depthLimit(3);
+	limits.threads = 4;
+
+	const SearchResult result = findBestMove(game, limits);
+
+	EXPECT_EQ(result.depth, 3u);
+	EXPECT_TRUE(game.isLegal(result.bestMove));
+
+	// The principal variation is a sequence of legal moves
+	Game line = game;
+
+	for (const PieceMove& move : result.principalVariation)
+	{
+		ASSERT_TRUE(line.isLegal(move));
+		line = makeMove(line, move);
+	}
+}
+
+TEST(SearchTest, ConcurrentSearches) {
+	// Every hardware thread by default, with threads reused across calls
+	EXPECT_EQ(SearchLimits().threads, 0u);
+
+	const Game game = createGameFromFen("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1");
+	const PieceMove mate = pieceMoveFromUci(game.currentStage(), "a1a8");
+
+	// One flag per search, as a vector<bool> could not be written from
+	// several threads
+	std::vector<std::thread> callers;
+	std::vector<int> matching(6, 0);
+
+	for (size_t caller = 0; caller < 3; ++caller)
+	{
+		callers.emplace_back([&game, &mate, &matching, caller]()
+				{
+					for (size_t i = 0; i < 2; ++i)
+					{
+						matching[2 * caller + i]
+							= (findBestMove(game, depthLimit(3)).bestMove == mate) ? 1 : 0;
+					}
+				});
+	}
+
+	for (std::thread& caller : callers)
+	{
+		caller.join();
+	}
+
+	EXPECT_EQ(std::count(matching.begin(), matching.end(), 1), 6);
+}
+
+TEST(SearchTest, FinishedGameThrows) {
+	Game game = createNewGame();
+
+	for (const std::string& uci : std::vector<std::string> {"f2f3", "e7e5", "g2g4", "d8h4"})
+	{
+		game = makeMove(game, pieceMoveFromUci(game.currentStage(), uci));
+	}
+
+	EXPECT_THROW_CUSTOM(findBestMove(game), IllegalStateException);
+}
+
+namespace
+{
+	using details::Move;
+	using details::MoveList;
+	using details::Position;
+
+	bool forcesMate(const Position& position, unsigned moves, bool checksOnly);
+
+	bool matesWith(const Position& position, const Move& move, const unsigned moves, const bool checksOnly)
+	{
+		Position next = position;
+		next.makeMove(move);
+
+		if ((checksOnly || moves == 1) && !next.inCheck())
+		{
+			return false;
+		}
+
+		MoveList replies;
+		next.legalMoves(replies);
+
+		if (replies.size == 0)
+		{
+			return next.inCheck();
+		}
+
+		if (moves == 1)
+		{
+			return false;
+		}
+
+		for (const Move& reply : replies)
+		{
+			Position afterReply = next;
+			afterReply.makeMove(reply);
+
+			if (!forcesMate(afterReply, moves - 1, checksOnly))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool forcesMate(const Position& position, const unsigned moves, const bool checksOnly)
+	{
+		MoveList candidates;
+		position.legalMoves(candidates);
+
+		for (const Move& move : candidates)
+		{
+			if (matesWith(position, move, moves, checksOnly))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
+
+TEST(SearchTest, SolveMateMatchesBruteForce) {
+	const std::vector<std::string> fens = {
+		"6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1",
+		"6k1/8/8/8/8/8/1r3PPP/6K1 b - - 0 1",
+		"7k/8/8/8/8/8/R7/1R4K1 w - - 0 1",
+		"7k/5Q2/6K1/8/8/8/8/8 w - - 0 1",
+		"k7/2P5/1K6/8/8/8/8/8 w - - 0 1",
+		"r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 4 4"
+	};
+
+	for (const std::string& fen : fens)
+	{
+		const GameStage stage = createGameFromFen(fen).currentStage();
+		const Position position = Position::fromStage(stage);
+
+		MoveList candidates;
+		position.legalMoves(candidates);
+
+		for (const bool checksOnly : {true, false})
+		{
+			std::vector<MateSolution> expected;
+
+			for (unsigned moves = 1; moves <= 2; ++moves)
+			{
+				std::vector<MateSolution> found;
+
+				for (const Move& move : candidates)
+				{
+					const PieceMove pieceMove = position.toPieceMove(move);
+					const bool known = std::any_of(
+							expected.begin(),
+							expected.end(),
+							[&pieceMove](const MateSolution& solution)
+							{
+								return solution.move == pieceMove;
+							});
+
+					if (!known && matesWith(position, move, moves, checksOnly))
+					{
+						found.push_back({pieceMove, moves});
+					}
+				}
+
+				std::sort(
+						found.begin(),
+						found.end(),
+						[](const MateSolution& lhs, const MateSolution& rhs)
+						{
+							return lhs.move < rhs.move;
+						});
+
+				expected.insert(expected.end(), found.begin(), found.end());
+			}
+
+			const std::vector<MateSolution> solutions = solveMate(
+					stage,
+					2,
+					checksOnly ? MateMoves::Checks : MateMoves::All);
+
+			ASSERT_EQ(solutions.size(), expected.size()) << fen << ' ' << checksOnly;
+
+			for (size_t i = 0; i < expected.size(); ++i)
+			{
+				EXPECT_EQ(solutions[i].move, expected[i].move) << fen << ' ' << i;
+				EXPECT_EQ(solutions[i].moves, expected[i].moves) << fen << ' ' << i;
+			}
+		}
+	}
+}
+
+TEST(SearchTest, CheckingMovesMatchFilteredLegalMoves) {
+	const std::vector<std::string> fens = {
+		"r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 4 4",
+		// Discovered checks by every piece type, including the king
+		"4k3/8/4N3/8/4B3/8/4R3/4K3 w - - 0 1",
+		"7k/8/5P2/8/3B4/8/8/K7 w - - 0 1",
+		"4k3/8/8/8/4K3/8/8/4R3 w - - 0 1",
+		// Promotions, with and without capture
+		"3r1k2/2P5/8/8/8/8/8/4K3 w - - 0 1",
+		// Castling into check, and a pawn pinned on the king's line
+		"5k2/8/8/8/8/8/8/R3K2R w KQ - 0 1",
+		"3k4/8/8/8/8/8/8/R3K2R w KQ - 0 1",
+		"4k3/8/8/8/8/8/4P3/4K2R w K - 0 1",
+		// En passant, directly and by uncovering the king
+		"8/8/8/2k5/3pP3/8/8/K7 b - e3 0 1",
+		"8/8/8/8/k2pP2Q/8/8/K7 b - e3 0 1",
+		"8/8/8/K2pP2q/8/8/8/7k w - d6 0 1",
+		// Black to move, in check
+		"4k3/8/8/8/8/8/4R2r/K7 b - - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"
+	};
+
+	for (const std::string& fen : fens)
+	{
+		Position position = Position::fromStage(createGameFromFen(fen).currentStage());
+
+		// Also look at the positions one move further
+		MoveList firstMoves;
+		position.legalMoves(firstMoves);
+		std::vector<Position> positions = {position};
+
+		for (const Move& move : firstMoves)
+		{
+			Position next = position;
+			next.makeMove(move);
+			positions.push_back(next);
+		}
+
+		for (const Position& current : positions)
+		{
+			MoveList legal;
+			current.legalMoves(legal);
+
+			std::vector<PieceMove> expected;
+			for (const Move& move : legal)
+			{
+				Position next = current;
+				next.makeMove(move);
+
+				if (next.inCheck())
+				{
+					expected.push_back(current.toPieceMove(move));
+				}
+			}
+
+			MoveList checks;
+			details::MateSolver::checkingMoves(current, checks);
+
+			std::vector<PieceMove> found;
+			for (const Move& move : checks)
+			{
+				found.push_back(current.toPieceMove(move));
+			}
+
+			std::sort(expected.begin(), expected.end());
+			std::sort(found.begin(), found.end());
+
+			EXPECT_EQ(found, expected) << current.toStage().fen();
+		}
+	}
+}
+
+TEST(SearchTest, SolveMateWithQuietMoves) {
+	// The rook ladder needs a quiet first move
+	const GameStage stage = createGameFromFen("7k/8/8/8/8/8/R7/1R4K1 w - - 0 1").currentStage();
+
+	EXPECT_TRUE(solveMate(stage, 2, MateMoves::Checks).empty());
+	EXPECT_FALSE(solveMate(stage, 2, MateMoves::All).empty());
+
+	// Mates are reported at their shortest length
+	const GameStage backRank = createGameFromFen("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1").currentStage();
+	const std::vector<MateSolution> solutions = solveMate(backRank, 3, MateMoves::All);
+
+	ASSERT_FALSE(solutions.empty());
+	EXPECT_EQ(solutions.front().move, pieceMoveFromUci(backRank, "a1a8"));
+	EXPECT_EQ(solutions.front().moves, 1u);
+
+	for (size_t i = 1; i < solutions.size(); ++i)
+	{
+		EXPECT_GT(solutions[i].moves, 1u);
+	}
+}
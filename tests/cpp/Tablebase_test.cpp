@@ -0,0 +1,292 @@
+#include "TestUtils.h"
+
+#include <cpp/simplechess/Tablebase.h>
+
+#include "details/WorkStealingPool.h"
+#include "details/bitboard/Position.h"
+#include "details/tablebase/EndgameTable.h"
+#include "details/tablebase/TablebaseData.h"
+#include "details/tablebase/TablebaseGenerator.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+using namespace simplechess;
+
+namespace
+{
+	const Tablebase& pawnTablebase()
+	{
+		// Also generates KQK, KRK, KBK and KNK
+		static const Tablebase tablebase = Tablebase::generate({"KPK"});
+		return tablebase;
+	}
+
+	TablebaseResult probe(const Tablebase& tablebase, const std::string& fen)
+	{
+		const std::optional<TablebaseResult> result
+			= tablebase.probe(createGameFromFen(fen).currentStage());
+
+		if (!result)
+		{
+			throw std::invalid_argument("Position not in tablebase: " + fen);
+		}
+
+		return *result;
+	}
+
+	/**
+	 * Checks that the result of \p game agrees with the results of its
+	 * successors.
+	 */
+	void expectConsistent(const Tablebase& tablebase, const Game& game)
+	{
+		const TablebaseResult result
+			= *tablebase.probe(game.currentStage());
+
+		if (game.gameState() != GameState::Playing)
+		{
+			EXPECT_EQ(result.pliesToMate, 0u) << game.currentStage().fen();
+			return;
+		}
+
+		std::optional<unsigned> fastestWin;
+		std::optional<unsigned> slowestLoss;
+		bool draw = false;
+
+		for (const PieceMove& move : game.allAvailableMoves())
+		{
+			const std::optional<TablebaseResult> child
+				= tablebase.probe(makeMove(game, move).currentStage());
+
+			// Captures of the last piece lead to bare kings, which are
+			// always a draw
+			ASSERT_TRUE(child.has_value());
+
+			if (child->outcome == TablebaseOutcome::Loss)
+			{
+				fastestWin = std::min(
+						fastestWin.value_or(child->pliesToMate + 1),
+						child->pliesToMate + 1);
+			}
+			else if (child->outcome == TablebaseOutcome::Draw)
+			{
+				draw = true;
+			}
+			else
+			{
+				slowestLoss = std::max(
+						slowestLoss.value_or(0),
+						child->pliesToMate + 1);
+			}
+		}
+
+		const std::string fen(game.currentStage().fen());
+
+		if (fastestWin)
+		{
+			EXPECT_EQ(result.outcome, TablebaseOutcome::Win) << fen;
+			EXPECT_EQ(result.pliesToMate, *fastestWin) << fen;
+		}
+		else if (draw)
+		{
+			EXPECT_EQ(result.outcome, TablebaseOutcome::Draw) << fen;
+		}
+		else
+		{
+			EXPECT_EQ(result.outcome, TablebaseOutcome::Loss) << fen;
+			EXPECT_EQ(result.pliesToMate, *slowestLoss) << fen;
+		}
+	}
+}
+
+TEST(TablebaseTest, GeneratesSuccessors) {
+	std::vector<std::string> endings = ::pawnTablebase().endings();
+	std::sort(endings.begin(), endings.end());
+
+	EXPECT_EQ(
+			endings,
+			std::vector<std::string>({"KBK", "KNK", "KPK", "KQK", "KRK"}));
+}
+
+TEST(TablebaseTest, KnownResults) {
+	const Tablebase& tablebase = ::pawnTablebase();
+
+	const TablebaseResult mated = ::probe(tablebase, "k7/1Q6/1K6/8/8/8/8/8 b - - 0 1");
+	EXPECT_EQ(mated.outcome, TablebaseOutcome::Loss);
+	EXPECT_EQ(mated.pliesToMate, 0u);
+
+	const TablebaseResult mateInOne = ::probe(tablebase, "k7/8/1K6/8/8/8/7Q/8 w - - 0 1");
+	EXPECT_EQ(mateInOne.outcome, TablebaseOutcome::Win);
+	EXPECT_EQ(mateInOne.pliesToMate, 1u);
+
+	EXPECT_EQ(
+			::probe(tablebase, "k7/2Q5/1K6/8/8/8/8/8 b - - 0 1").outcome,
+			TablebaseOutcome::Draw);
+
+	// Same ending with the colors swapped
+	const TablebaseResult swapped = ::probe(tablebase, "8/8/8/8/8/1k6/1q6/K7 w - - 0 1");
+	EXPECT_EQ(swapped.outcome, TablebaseOutcome::Loss);
+	EXPECT_EQ(swapped.pliesToMate, 0u);
+
+	// A king on the sixth rank in front of its pawn always wins
+	EXPECT_EQ(
+			::probe(tablebase, "4k3/8/4K3/4P3/8/8/8/8 w - - 0 1").outcome,
+			TablebaseOutcome::Win);
+	EXPECT_EQ(
+			::probe(tablebase, "4k3/8/4K3/4P3/8/8/8/8 b - - 0 1").outcome,
+			TablebaseOutcome::Loss);
+
+	// But not with a rook pawn
+	EXPECT_EQ(
+			::probe(tablebase, "k7/8/8/8/8/8/P7/K7 w - - 0 1").outcome,
+			TablebaseOutcome::Draw);
+	EXPECT_EQ(
+			::probe(tablebase, "k7/p7/8/8/8/8/8/K7 b - - 0 1").outcome,
+			TablebaseOutcome::Draw);
+
+	// Bare kings
+	const TablebaseResult bare = ::probe(tablebase, "8/8/8/3k4/8/8/8/4K3 w - - 0 1");
+	EXPECT_EQ(bare.outcome, TablebaseOutcome::Draw);
+	EXPECT_EQ(bare.pliesToMate, 0u);
+
+	EXPECT_EQ(
+			::probe(tablebase, "8/8/8/3k4/8/8/8/1B2K3 w - - 0 1").outcome,
+			TablebaseOutcome::Draw);
+}
+
+TEST(TablebaseTest, UncoveredPositions) {
+	const Tablebase& tablebase = ::pawnTablebase();
+
+	EXPECT_FALSE(tablebase.probe(createNewGame().currentStage()).has_value());
+	EXPECT_FALSE(tablebase.probe(
+				createGameFromFen("8/8/8/3k4/8/8/8/R3K3 w Q - 0 1").currentStage()).has_value());
+	EXPECT_FALSE(tablebase.probe(
+				createGameFromFen("8/8/8/3k4/8/8/8/R3K2R w - - 0 1").currentStage()).has_value());
+	EXPECT_FALSE(tablebase.probe(
+				createGameFromFen("8/8/8/3k4/8/8/8/2B1KB2 w - - 0 1").currentStage()).has_value());
+}
+
+TEST(TablebaseTest, LongestMates) {
+	const details::WorkStealingPool pool(0);
+	const details::TablebaseData none;
+
+	// Longest mates are 10 moves with a queen and 16 with a rook, so the
+	// defender can last one more ply if it is to move
+	const std::vector<std::pair<std::string, unsigned>> endings
+		= {{"KQK", 19}, {"KRK", 31}};
+
+	for (const auto& [name, plies] : endings)
+	{
+		const std::vector<uint8_t> values = details::TablebaseGenerator::generate(
+				details::EndgameTable(name),
+				none,
+				pool);
+
+		uint8_t longestWin = 0;
+		uint8_t longestLoss = 0;
+
+		for (const uint8_t value : values)
+		{
+			if (details::tablebase::isWin(value))
+			{
+				longestWin = std::max(longestWin, value);
+			}
+			else if (details::tablebase::isLoss(value))
+			{
+				longestLoss = std::max(longestLoss, value);
+			}
+		}
+
+		EXPECT_EQ(longestWin, plies + 1) << name;
+		EXPECT_EQ(longestLoss, plies + 2) << name;
+	}
+}
+
+TEST(TablebaseTest, ResultsAgreeWithSuccessors) {
+	const Tablebase& tablebase = ::pawnTablebase();
+
+	const std::vector<std::string> starts = {
+		"8/8/8/3k4/8/8/8/R3K3 w - - 0 1",
+		"8/8/2k5/8/8/8/1Q6/6K1 b - - 0 1",
+		"8/8/8/8/3k4/8/4P3/4K3 w - - 0 1",
+		"8/5K2/8/8/8/8/4p3/4k3 b - - 0 1",
+		"8/8/8/2k5/8/1p6/8/1K6 w - - 0 1"
+	};
+
+	uint32_t seed = 11;
+
+	for (const std::string& fen : starts)
+	{
+		Game game = createGameFromFen(fen);
+
+		for (int ply = 0; ply < 12 && game.gameState() == GameState::Playing; ++ply)
+		{
+			::expectConsistent(tablebase, game);
+
+			seed = seed * 1664525u + 1013904223u;
+			const std::pmr::set<PieceMove>& moves = game.allAvailableMoves();
+			auto it = moves.begin();
+			std::advance(it, (seed >> 8) % moves.size());
+			game = makeMove(game, *it);
+		}
+
+		::expectConsistent(tablebase, game);
+	}
+}
+
+TEST(TablebaseTest, SaveAndLoad) {
+	const Tablebase& tablebase = ::pawnTablebase();
+	const std::string path = testing::TempDir() + "simplechess_tablebase_test.sctb";
+
+	tablebase.save(path);
+	const Tablebase loaded = Tablebase::load(path);
+
+	EXPECT_EQ(loaded.endings(), tablebase.endings());
+
+	for (const std::string& fen : {
+			"k7/8/1K6/8/8/8/7Q/8 w - - 0 1",
+			"8/8/8/3k4/8/8/8/R3K3 b - - 0 1",
+			"8/8/8/8/3k4/8/4P3/4K3 w - - 0 1",
+			"k7/p7/8/8/8/8/8/K7 b - - 0 1"})
+	{
+		const GameStage stage = createGameFromFen(fen).currentStage();
+		const TablebaseResult expected = *tablebase.probe(stage);
+		const TablebaseResult actual = *loaded.probe(stage);
+
+		EXPECT_EQ(actual.outcome, expected.outcome) << fen;
+		EXPECT_EQ(actual.pliesToMate, expected.pliesToMate) << fen;
+	}
+
+	// Truncated file
+	std::string contents;
+	{
+		std::ifstream file(path, std::ios::binary);
+		contents.assign(std::istreambuf_iterator<char>(file), {});
+	}
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(contents.data(), static_cast<std::streamsize>(contents.size() / 2));
+	}
+	EXPECT_THROW(Tablebase::load(path), std::invalid_argument);
+
+	// Wrong magic
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file << "not a tablebase";
+	}
+	EXPECT_THROW(Tablebase::load(path), std::invalid_argument);
+
+	std::remove(path.c_str());
+
+	EXPECT_THROW(Tablebase::load(path), std::system_error);
+}
+
+TEST(TablebaseTest, UnsupportedEndings) {
+	EXPECT_THROW(Tablebase::generate({"KPKP"}), std::invalid_argument);
+	EXPECT_THROW(Tablebase::generate({"KQRKR"}), std::invalid_argument);
+	EXPECT_THROW(Tablebase::generate({"KQ"}), std::invalid_argument);
+	EXPECT_THROW(Tablebase::generate({"KXK"}), std::invalid_argument);
+	EXPECT_THROW(Tablebase::generate({"QKK"}), std::invalid_argument);
+}
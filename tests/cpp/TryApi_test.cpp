@@ -0,0 +1,166 @@
+#include "TestUtils.h"
+
+#include <cpp/simplechess/Result.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace simplechess;
+
+TEST(TryApiTest, CreateGameFromFenMatchesThrowingVersion) {
+	const std::vector<std::string> fens = {
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+		"rnbqkbnr/pppp1ppp/8/8/3Pp3/8/PPP1PPPP/RNBQKBNR b KQkq d3 0 2",
+		"4k3/8/8/8/8/8/8/4K2R b K - 0 1"
+	};
+
+	for (const std::string& fen : fens)
+	{
+		const Result<Game> result = tryCreateGameFromFen(fen, DrawEnforcement::ClaimOnly);
+		const Game expected = createGameFromFen(fen, DrawEnforcement::ClaimOnly);
+
+		ASSERT_TRUE(result.ok()) << fen;
+		EXPECT_EQ(result.value().currentStage().fen(), expected.currentStage().fen()) << fen;
+		EXPECT_EQ(result.value().history().size(), expected.history().size()) << fen;
+		EXPECT_EQ(result.value().allAvailableMoves(), expected.allAvailableMoves()) << fen;
+		EXPECT_EQ(result.value().drawEnforcement(), DrawEnforcement::ClaimOnly) << fen;
+	}
+}
+
+TEST(TryApiTest, CreateGameFromFenErrors) {
+	const std::vector<std::pair<std::string, ErrorCode>> cases = {
+		{"", ErrorCode::InvalidFen},
+		{"not a fen", ErrorCode::InvalidFen},
+		{"4k3/8/8/8/8/8/8/4K3 w - - 0", ErrorCode::InvalidFen},
+		{"4k3/8/8/8/8/8/8/4K3 w - - 0 1 ", ErrorCode::InvalidFen},
+		{"4k3/8/8/8/8/8/8/4KX2 w - - 0 1", ErrorCode::InvalidFen},
+		{"4k3/8/8/8/8/8/8/4K4 w - - 0 1", ErrorCode::InvalidFen},
+		{"4k3/8/8/8/8/8/8/4K3 x - - 0 1", ErrorCode::InvalidFen},
+		{"4k3/8/8/8/8/8/8/4K3 w KK - 0 1", ErrorCode::InvalidFen},
+		{"4k3/8/8/8/8/8/8/4K3 w - i3 0 1", ErrorCode::InvalidFen},
+		{"4k3/8/8/8/8/8/8/4K3 w - - x 1", ErrorCode::InvalidFen},
+		{"4k3/8/8/8/8/8/8/4K3 w - - 0 -1", ErrorCode::InvalidFen},
+		{"8/8/8/8/8/8/8/4K3 w - - 0 1", ErrorCode::InvalidPosition},
+		{"4k3/4R3/8/8/8/8/8/4K3 w - - 0 1", ErrorCode::InvalidPosition},
+		{"4k3/8/8/8/8/8/8/4K3 w K - 0 1", ErrorCode::InvalidPosition},
+		{"P3k3/8/8/8/8/8/8/4K3 b - - 0 1", ErrorCode::InvalidPosition},
+		{"4k3/8/8/8/8/8/8/p3K3 w - - 0 1", ErrorCode::InvalidPosition},
+		{"4k3/8/8/8/4P3/8/8/4K3 w - e3 0 1", ErrorCode::InvalidPosition},
+		// The black king would have been in check before e2-e4
+		{"8/8/8/8/R3P2k/8/8/4K3 b - e3 0 1", ErrorCode::InvalidPosition}
+	};
+
+	for (const auto& [fen, error] : cases)
+	{
+		const Result<Game> result = tryCreateGameFromFen(fen);
+
+		ASSERT_FALSE(result) << fen;
+		EXPECT_EQ(result.error(), error) << fen;
+		EXPECT_THROW(createGameFromFen(fen), std::invalid_argument) << fen;
+	}
+}
+
+TEST(TryApiTest, MakeMove) {
+	const Game game = createNewGame();
+	const PieceMove e4 = PieceMove::regularMove(
+			{PieceType::Pawn, Color::White},
+			Square::fromString("e2"),
+			Square::fromString("e4"));
+
+	const Result<Game> played = tryMakeMove(game, e4, true);
+	ASSERT_TRUE(played.ok());
+	EXPECT_EQ(played.value().currentStage().fen(), makeMove(game, e4, true).currentStage().fen());
+	EXPECT_TRUE(played.value().history().back().second.isDrawOffered());
+
+	const Result<Game> illegal = tryMakeMove(played.value(), e4);
+	ASSERT_FALSE(illegal.ok());
+	EXPECT_EQ(illegal.error(), ErrorCode::IllegalMove);
+
+	const Result<Game> finished = tryMakeMove(resign(game, Color::White), e4);
+	ASSERT_FALSE(finished.ok());
+	EXPECT_EQ(finished.error(), ErrorCode::GameFinished);
+}
+
+TEST(TryApiTest, MakeMovesInBatch) {
+	const PieceMove e4 = PieceMove::regularMove(
+			{PieceType::Pawn, Color::White},
+			Square::fromString("e2"),
+			Square::fromString("e4"));
+	const PieceMove kd7 = PieceMove::regularMove(
+			{PieceType::King, Color::Black},
+			Square::fromString("e8"),
+			Square::fromString("d7"));
+
+	const Game start = createNewGame();
+	const Game endgame = createGameFromFen("4k3/8/8/8/8/8/4P3/4K3 b - - 0 1");
+
+	std::vector<Game> games;
+	std::vector<PieceMove> moves;
+
+	for (int i = 0; i < 6; ++i)
+	{
+		games.push_back(start);
+		moves.push_back(e4);
+
+		games.push_back(endgame);
+		moves.push_back(i % 2 == 0 ? kd7 : e4);
+
+		games.push_back(resign(start, Color::Black));
+		moves.push_back(e4);
+	}
+
+	for (const unsigned threads : {1u, 4u})
+	{
+		const std::vector<Result<Game>> results = makeMoves(games, moves, threads);
+		ASSERT_EQ(results.size(), games.size());
+
+		for (size_t i = 0; i < games.size(); ++i)
+		{
+			const Result<Game> expected = tryMakeMove(games[i], moves[i]);
+
+			ASSERT_EQ(results[i].ok(), expected.ok()) << i;
+
+			if (expected.ok())
+			{
+				EXPECT_EQ(
+						results[i].value().currentStage().fen(),
+						expected.value().currentStage().fen()) << i;
+			}
+			else
+			{
+				EXPECT_EQ(results[i].error(), expected.error()) << i;
+			}
+		}
+	}
+
+	EXPECT_TRUE(makeMoves({}, {}).empty());
+	EXPECT_THROW(makeMoves(games, {e4}), std::invalid_argument);
+
+	// The threads of the pool are shared by concurrent calls
+	std::vector<std::thread> callers;
+	std::atomic<size_t> successes(0);
+
+	for (int i = 0; i < 4; ++i)
+	{
+		callers.emplace_back([&]
+				{
+					for (int call = 0; call < 10; ++call)
+					{
+						for (const Result<Game>& result : makeMoves(games, moves, 4))
+						{
+							successes += result.ok() ? 1 : 0;
+						}
+					}
+				});
+	}
+
+	for (std::thread& caller : callers)
+	{
+		caller.join();
+	}
+
+	// e4 in the 6 starting positions and Kd7 in 3 of the endgames
+	EXPECT_EQ(successes.load(), 4u * 10u * 9u);
+}
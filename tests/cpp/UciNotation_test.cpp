@@ -0,0 +1,195 @@
+#include "TestUtils.h"
+
+#include <cpp/simplechess/Notation.h>
+
+#include <boost/optional/optional_io.hpp>
+
+using namespace simplechess;
+
+TEST(UciNotationTest, RegularMove) {
+	const Game game = createNewGame();
+
+	const PieceMove move = PieceMove::regularMove(
+			{PieceType::Pawn, Color::White},
+			Square::fromRankAndFile(2, 'e'),
+			Square::fromRankAndFile(4, 'e'));
+
+	EXPECT_EQ(pieceMoveFromUci(game.currentStage(), "e2e4"), move);
+	EXPECT_EQ(pieceMoveToUci(move), "e2e4");
+}
+
+TEST(UciNotationTest, Promotion) {
+	const Game game = createGameFromFen(
+			"k7/4P3/8/8/8/8/8/4K3 w - - 0 1");
+
+	const PieceMove move = PieceMove::pawnPromotion(
+			{PieceType::Pawn, Color::White},
+			Square::fromRankAndFile(7, 'e'),
+			Square::fromRankAndFile(8, 'e'),
+			PieceType::Knight);
+
+	EXPECT_EQ(pieceMoveFromUci(game.currentStage(), "e7e8n"), move);
+	EXPECT_EQ(pieceMoveToUci(move), "e7e8n");
+
+	EXPECT_THROW(
+			pieceMoveFromUci(game.currentStage(), "e7e8"),
+			std::invalid_argument);
+	EXPECT_THROW(
+			pieceMoveFromUci(game.currentStage(), "e7e8k"),
+			std::invalid_argument);
+}
+
+TEST(UciNotationTest, Castling) {
+	const Game game = createGameFromFen(
+			"r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+
+	const PieceMove move = PieceMove::regularMove(
+			{PieceType::King, Color::White},
+			Square::fromRankAndFile(1, 'e'),
+			Square::fromRankAndFile(1, 'c'));
+
+	EXPECT_EQ(pieceMoveFromUci(game.currentStage(), "e1c1"), move);
+	EXPECT_EQ(pieceMoveToUci(move), "e1c1");
+}
+
+TEST(UciNotationTest, MalformedOrIllegalMovesAreRejected) {
+	const Game game = createNewGame();
+
+	for (const std::string uci : {"", "e2", "e2e9", "i2i4", "e2e4q", "e2e5", "e7e5", "Nf3"})
+	{
+		EXPECT_THROW(
+				pieceMoveFromUci(game.currentStage(), uci),
+				std::invalid_argument) << uci;
+	}
+}
+
+TEST(UciNotationTest, RoundTrip) {
+	const Game game = createGameFromFen(
+			"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+
+	for (const PieceMove& move : game.allAvailableMoves())
+	{
+		EXPECT_EQ(
+				pieceMoveFromUci(game.currentStage(), pieceMoveToUci(move)),
+				move);
+	}
+}
+
+TEST(UciNotationTest, CreateGameFromUciMoves) {
+	const std::string fen = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+	const std::vector<std::string> moves = {
+		"a2a4", "b4a3", "e1c1", "a3b2", "c1b1", "e8g8",
+		"d5e6", "h3g2", "e6d7", "g2h1q"
+	};
+
+	Game expected = createGameFromFen(fen);
+	for (const std::string& uci : moves)
+	{
+		expected = makeMove(expected, pieceMoveFromUci(expected.currentStage(), uci));
+	}
+
+	const Game game = createGameFromUciMoves(fen, moves);
+
+	EXPECT_EQ(game.currentStage().fen(), expected.currentStage().fen());
+	EXPECT_EQ(game.gameState(), expected.gameState());
+	EXPECT_EQ(game.allAvailableMoves(), expected.allAvailableMoves());
+
+	ASSERT_EQ(game.history().size(), expected.history().size());
+	for (std::size_t i = 0; i < game.history().size(); ++i)
+	{
+		EXPECT_EQ(
+				game.history()[i].first.fen(),
+				expected.history()[i].first.fen());
+		EXPECT_EQ(
+				game.history()[i].second.pieceMove(),
+				expected.history()[i].second.pieceMove());
+		EXPECT_EQ(
+				game.history()[i].second.inAlgebraicNotation(),
+				expected.history()[i].second.inAlgebraicNotation());
+	}
+}
+
+TEST(UciNotationTest, CreateGameFromUciMovesDetectsRepetitions) {
+	const std::string fen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+	const std::vector<std::string> shuffle = {"g1f3", "g8f6", "f3g1", "f6g8"};
+
+	std::vector<std::string> moves = {"e2e4", "e7e5"};
+	for (int i = 0; i < 2; ++i)
+	{
+		moves.insert(moves.end(), shuffle.begin(), shuffle.end());
+	}
+
+	const Game threefold = createGameFromUciMoves(fen, moves);
+	EXPECT_EQ(threefold.gameState(), GameState::Playing);
+	EXPECT_EQ(threefold.reasonToClaimDraw(), DrawReason::ThreeFoldRepetition);
+
+	for (int i = 0; i < 2; ++i)
+	{
+		moves.insert(moves.end(), shuffle.begin(), shuffle.end());
+	}
+
+	const Game fivefold = createGameFromUciMoves(fen, moves);
+	EXPECT_EQ(fivefold.gameState(), GameState::Drawn);
+	EXPECT_EQ(fivefold.drawReason(), DrawReason::FiveFoldRepetition);
+
+	// No move can follow the automatic draw
+	moves.push_back("g1f3");
+	EXPECT_THROW(createGameFromUciMoves(fen, moves), IllegalStateException);
+
+	const Game claimOnly
+		= createGameFromUciMoves(fen, moves, DrawEnforcement::ClaimOnly);
+	EXPECT_EQ(claimOnly.gameState(), GameState::Playing);
+}
+
+TEST(UciNotationTest, RepetitionsCompletedAfterUciMoves) {
+	const std::string fen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+	Game game = createGameFromUciMoves(fen, {"g1f3", "g8f6", "f3g1", "f6g8", "g1f3"});
+	EXPECT_EQ(game.history().size(), 5);
+	EXPECT_FALSE(game.reasonToClaimDraw());
+
+	for (const std::string uci : {"g8f6", "f3g1", "f6g8"})
+	{
+		game = makeMove(game, pieceMoveFromUci(game.currentStage(), uci));
+	}
+
+	EXPECT_EQ(game.reasonToClaimDraw(), DrawReason::ThreeFoldRepetition);
+
+	for (const std::string uci : {"g1f3", "g8f6", "f3g1", "f6g8", "g1f3", "g8f6", "f3g1", "f6g8"})
+	{
+		game = makeMove(game, pieceMoveFromUci(game.currentStage(), uci));
+	}
+
+	EXPECT_EQ(game.gameState(), GameState::Drawn);
+	EXPECT_EQ(game.drawReason(), DrawReason::FiveFoldRepetition);
+}
+
+TEST(UciNotationTest, CreateGameFromUciMovesRejectsMovesAfterTheEnd) {
+	const std::string fen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+	// Fool's mate
+	EXPECT_EQ(
+			createGameFromUciMoves(fen, {"f2f3", "e7e5", "g2g4", "d8h4"}).gameState(),
+			GameState::BlackWon);
+	EXPECT_THROW(
+			createGameFromUciMoves(fen, {"f2f3", "e7e5", "g2g4", "d8h4", "e2e4"}),
+			IllegalStateException);
+
+	// Only the kings are left after the capture
+	EXPECT_THROW(
+			createGameFromUciMoves(
+				"4k3/8/8/8/8/8/4q3/4K3 w - - 0 1",
+				{"e1e2", "e8e7"}),
+			IllegalStateException);
+}
+
+TEST(UciNotationTest, CreateGameFromUciMovesRejectsIllegalMoves) {
+	const std::string fen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+	EXPECT_THROW(
+			createGameFromUciMoves(fen, {"e2e4", "e2e4"}),
+			std::invalid_argument);
+	EXPECT_THROW(
+			createGameFromUciMoves(fen, {"e2e4", "e7e5", "e1g1"}),
+			std::invalid_argument);
+}
@@ -0,0 +1,86 @@
+#include "TestUtils.h"
+
+#include "details/WorkStealingPool.h"
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace simplechess;
+
+TEST(WorkStealingPoolTest, WorkersAreReusedAcrossBatches) {
+	const details::WorkStealingPool pool(4);
+	EXPECT_EQ(pool.threads(), 4);
+
+	std::mutex mutex;
+	std::set<std::thread::id> threads;
+
+	for (size_t batch = 0; batch < 50; ++batch)
+	{
+		std::vector<std::atomic<int>> calls(batch * 7);
+
+		pool.run(calls.size(), [&](const size_t i)
+				{
+					++calls[i];
+
+					const std::lock_guard<std::mutex> lock(mutex);
+					threads.insert(std::this_thread::get_id());
+				});
+
+		for (const std::atomic<int>& count : calls)
+		{
+			EXPECT_EQ(count.load(), 1);
+		}
+	}
+
+	// The caller and the three threads started by the pool
+	EXPECT_LE(threads.size(), 4u);
+	EXPECT_TRUE(threads.count(std::this_thread::get_id()));
+}
+
+TEST(WorkStealingPoolTest, ExceptionsAreRethrown) {
+	const details::WorkStealingPool pool(3);
+
+	EXPECT_THROW(
+			pool.run(100, [](const size_t i)
+				{
+					if (i == 42)
+					{
+						throw std::runtime_error("Task failed");
+					}
+				}),
+			std::runtime_error);
+
+	// The pool can still be used afterwards
+	std::atomic<size_t> completed(0);
+	pool.run(100, [&](size_t) { ++completed; });
+	EXPECT_EQ(completed.load(), 100u);
+}
+
+TEST(WorkStealingPoolTest, ConcurrentBatchesAreSerialised) {
+	const details::WorkStealingPool pool(2);
+	std::atomic<size_t> completed(0);
+
+	std::vector<std::thread> submitters;
+
+	for (int i = 0; i < 4; ++i)
+	{
+		submitters.emplace_back([&]
+				{
+					for (int batch = 0; batch < 20; ++batch)
+					{
+						pool.run(10, [&](size_t) { ++completed; });
+					}
+				});
+	}
+
+	for (std::thread& submitter : submitters)
+	{
+		submitter.join();
+	}
+
+	EXPECT_EQ(completed.load(), 4u * 20u * 10u);
+}